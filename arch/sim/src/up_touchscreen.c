@@ -219,7 +219,7 @@ static void up_notify(FAR struct up_dev_s *priv)
         {
           fds->revents |= POLLIN;
           iinfo("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
     }
 #endif
@@ -180,6 +180,41 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index,
 int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym,
                  FAR const struct symtab_s *exports, int nexports);
 
+/****************************************************************************
+ * Name: elf_cachesymtab
+ *
+ * Description:
+ *   Read the symbol table and its string table into memory, if there is
+ *   enough memory to do so.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+int elf_cachesymtab(FAR struct elf_loadinfo_s *loadinfo);
+#endif
+
+/****************************************************************************
+ * Name: elf_freesymtab
+ *
+ * Description:
+ *   Release the symbol table and string table cached by elf_cachesymtab().
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+void elf_freesymtab(FAR struct elf_loadinfo_s *loadinfo);
+#endif
+
 /****************************************************************************
  * Name: elf_freebuffers
  *
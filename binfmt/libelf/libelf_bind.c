@@ -46,6 +46,7 @@
 #include <debug.h>
 
 #include <nuttx/elf.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/binfmt/elf.h>
 #include <nuttx/binfmt/symtab.h>
 
@@ -82,34 +83,48 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: elf_readrel
+ * Name: elf_readrels
  *
  * Description:
- *   Read the ELF32_Rel structure into memory.
+ *   Read up to 'nrels' ELF32_Rel structures, starting with the entry at
+ *   'index', into memory with one read.
+ *
+ * Returned Value:
+ *   The number of entries read on success; a negated errno value on
+ *   failure.
  *
  ****************************************************************************/
 
-static inline int elf_readrel(FAR struct elf_loadinfo_s *loadinfo,
-                              FAR const Elf32_Shdr *relsec,
-                              int index, FAR Elf32_Rel *rel)
+static int elf_readrels(FAR struct elf_loadinfo_s *loadinfo,
+                        FAR const Elf32_Shdr *relsec,
+                        int index, FAR Elf32_Rel *rels, int nrels)
 {
+  int total = relsec->sh_size / sizeof(Elf32_Rel);
   off_t offset;
+  int ret;
 
-  /* Verify that the symbol table index lies within symbol table */
+  /* Verify that the index lies within the relocation section */
 
-  if (index < 0 || index > (relsec->sh_size / sizeof(Elf32_Rel)))
+  if (index < 0 || index >= total)
     {
-      berr("Bad relocation symbol index: %d\n", index);
+      berr("Bad relocation index: %d\n", index);
       return -EINVAL;
     }
 
-  /* Get the file offset to the symbol table entry */
+  if (nrels > total - index)
+    {
+      nrels = total - index;
+    }
+
+  /* Get the file offset to the first relocation entry */
 
   offset = relsec->sh_offset + sizeof(Elf32_Rel) * index;
 
-  /* And, finally, read the symbol table entry into memory */
+  /* And, finally, read the relocation entries into memory */
 
-  return elf_read(loadinfo, (FAR uint8_t *)rel, sizeof(Elf32_Rel), offset);
+  ret = elf_read(loadinfo, (FAR uint8_t *)rels, sizeof(Elf32_Rel) * nrels,
+                 offset);
+  return ret < 0 ? ret : nrels;
 }
 
 /****************************************************************************
@@ -130,100 +145,137 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 {
   FAR Elf32_Shdr *relsec = &loadinfo->shdr[relidx];
   FAR Elf32_Shdr *dstsec = &loadinfo->shdr[relsec->sh_info];
-  Elf32_Rel       rel;
+  FAR Elf32_Rel  *rels;
+  FAR Elf32_Rel  *rel;
   Elf32_Sym       sym;
   FAR Elf32_Sym  *psym;
   uintptr_t       addr;
   int             symidx;
+  int             nrels;
   int             ret;
   int             i;
+  int             j;
+
+  /* Allocate a buffer to hold a batch of relocation entries */
+
+  rels = (FAR Elf32_Rel *)
+    kmm_malloc(CONFIG_ELF_RELOCATION_BUFFERCOUNT * sizeof(Elf32_Rel));
+  if (rels == NULL)
+    {
+      berr("Failed to allocate the relocation buffer\n");
+      return -ENOMEM;
+    }
 
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
    */
 
-  for (i = 0; i < relsec->sh_size / sizeof(Elf32_Rel); i++)
+  ret = OK;
+  for (i = 0; i < relsec->sh_size / sizeof(Elf32_Rel); i += nrels)
     {
-      psym = &sym;
-
-      /* Read the relocation entry into memory */
+      /* Read the next batch of relocation entries into memory */
 
-      ret = elf_readrel(loadinfo, relsec, i, &rel);
-      if (ret < 0)
+      nrels = elf_readrels(loadinfo, relsec, i, rels,
+                           CONFIG_ELF_RELOCATION_BUFFERCOUNT);
+      if (nrels < 0)
         {
-          berr("Section %d reloc %d: Failed to read relocation entry: %d\n",
-               relidx, i, ret);
-          return ret;
+          berr("Section %d reloc %d: Failed to read relocation entries: %d\n",
+               relidx, i, nrels);
+          ret = nrels;
+          break;
         }
 
-      /* Get the symbol table index for the relocation.  This is contained
-       * in a bit-field within the r_info element.
-       */
+      for (j = 0; j < nrels; j++)
+        {
+          rel  = &rels[j];
+          psym = &sym;
 
-      symidx = ELF32_R_SYM(rel.r_info);
+          /* Get the symbol table index for the relocation.  This is
+           * contained in a bit-field within the r_info element.
+           */
 
-      /* Read the symbol table entry into memory */
+          symidx = ELF32_R_SYM(rel->r_info);
 
-      ret = elf_readsym(loadinfo, symidx, &sym);
-      if (ret < 0)
-        {
-          berr("Section %d reloc %d: Failed to read symbol[%d]: %d\n",
-               relidx, i, symidx, ret);
-          return ret;
-        }
+          /* Read the symbol table entry into memory */
 
-      /* Get the value of the symbol (in sym.st_value) */
+          ret = elf_readsym(loadinfo, symidx, &sym);
+          if (ret < 0)
+            {
+              berr("Section %d reloc %d: Failed to read symbol[%d]: %d\n",
+                   relidx, i + j, symidx, ret);
+              goto errout;
+            }
 
-      ret = elf_symvalue(loadinfo, &sym, exports, nexports);
-      if (ret < 0)
-        {
-          /* The special error -ESRCH is returned only in one condition:  The
-           * symbol has no name.
-           *
-           * There are a few relocations for a few architectures that do
-           * no depend upon a named symbol.  We don't know if that is the
-           * case here, but we will use a NULL symbol pointer to indicate
-           * that case to up_relocate().  That function can then do what
-           * is best.
-           */
+          /* Get the value of the symbol (in sym.st_value) */
 
-          if (ret == -ESRCH)
+          ret = elf_symvalue(loadinfo, &sym, exports, nexports);
+          if (ret < 0)
             {
-              berr("Section %d reloc %d: Undefined symbol[%d] has no name: %d\n",
-                  relidx, i, symidx, ret);
-              psym = NULL;
+              /* The special error -ESRCH is returned only in one condition:
+               * The symbol has no name.
+               *
+               * There are a few relocations for a few architectures that do
+               * no depend upon a named symbol.  We don't know if that is the
+               * case here, but we will use a NULL symbol pointer to indicate
+               * that case to up_relocate().  That function can then do what
+               * is best.
+               */
+
+              if (ret == -ESRCH)
+                {
+                  berr("Section %d reloc %d: Undefined symbol[%d] has no name: %d\n",
+                      relidx, i + j, symidx, ret);
+                  psym = NULL;
+                }
+              else
+                {
+                  berr("Section %d reloc %d: Failed to get value of symbol[%d]: %d\n",
+                      relidx, i + j, symidx, ret);
+                  goto errout;
+                }
             }
-          else
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+          else if (loadinfo->symcache != NULL)
             {
-              berr("Section %d reloc %d: Failed to get value of symbol[%d]: %d\n",
-                  relidx, i, symidx, ret);
-              return ret;
+              /* Remember the resolved value in the cached symbol table.
+               * The symbol is now absolute so it will not be looked up
+               * again by later relocations.
+               */
+
+              sym.st_shndx = SHN_ABS;
+              loadinfo->symcache[symidx] = sym;
             }
-        }
+#endif
 
-      /* Calculate the relocation address. */
+          /* Calculate the relocation address. */
 
-      if (rel.r_offset < 0 || rel.r_offset > dstsec->sh_size - sizeof(uint32_t))
-        {
-          berr("Section %d reloc %d: Relocation address out of range, offset %d size %d\n",
-               relidx, i, rel.r_offset, dstsec->sh_size);
-          return -EINVAL;
-        }
+          if (rel->r_offset < 0 ||
+              rel->r_offset > dstsec->sh_size - sizeof(uint32_t))
+            {
+              berr("Section %d reloc %d: Relocation address out of range, offset %d size %d\n",
+                   relidx, i + j, rel->r_offset, dstsec->sh_size);
+              ret = -EINVAL;
+              goto errout;
+            }
 
-      addr = dstsec->sh_addr + rel.r_offset;
+          addr = dstsec->sh_addr + rel->r_offset;
 
-      /* Now perform the architecture-specific relocation */
+          /* Now perform the architecture-specific relocation */
 
-      ret = up_relocate(&rel, psym, addr);
-      if (ret < 0)
-        {
-          berr("ERROR: Section %d reloc %d: Relocation failed: %d\n", relidx, i, ret);
-          return ret;
+          ret = up_relocate(rel, psym, addr);
+          if (ret < 0)
+            {
+              berr("ERROR: Section %d reloc %d: Relocation failed: %d\n",
+                   relidx, i + j, ret);
+              goto errout;
+            }
         }
     }
 
-  return OK;
+errout:
+  kmm_free(rels);
+  return ret;
 }
 
 static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
@@ -278,6 +330,16 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
       return ret;
     }
 
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+  /* Bring the symbol table and its string table into memory, if possible */
+
+  ret = elf_cachesymtab(loadinfo);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
 #ifdef CONFIG_ARCH_ADDRENV
   /* If CONFIG_ARCH_ADDRENV=y, then the loaded ELF lies in a virtual address
    * space that may not be in place now.  elf_addrenv_select() will
@@ -288,6 +350,9 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
   if (ret < 0)
     {
       berr("ERROR: elf_addrenv_select() failed: %d\n", ret);
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+      elf_freesymtab(loadinfo);
+#endif
       return ret;
     }
 #endif
@@ -330,6 +395,12 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
         }
     }
 
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+  /* The cached tables are no longer needed */
+
+  elf_freesymtab(loadinfo);
+#endif
+
 #if defined(CONFIG_ARCH_ADDRENV)
   /* Ensure that the I and D caches are coherent before starting the newly
    * loaded module by cleaning the D cache (i.e., flushing the D cache
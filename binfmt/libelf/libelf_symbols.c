@@ -44,6 +44,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/binfmt/elf.h>
 #include <nuttx/binfmt/symtab.h>
 
@@ -65,7 +66,8 @@
  * Name: elf_symname
  *
  * Description:
- *   Get the symbol name in loadinfo->iobuffer[].
+ *   Get the symbol name.  The name is taken from the cached string table if
+ *   there is one; otherwise it is read into loadinfo->iobuffer[].
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -78,7 +80,7 @@
  ****************************************************************************/
 
 static int elf_symname(FAR struct elf_loadinfo_s *loadinfo,
-                       FAR const Elf32_Sym *sym)
+                       FAR const Elf32_Sym *sym, FAR const char **name)
 {
   FAR uint8_t *buffer;
   off_t  offset;
@@ -96,6 +98,26 @@ static int elf_symname(FAR struct elf_loadinfo_s *loadinfo,
       return -ESRCH;
     }
 
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+  if (loadinfo->strcache != NULL)
+    {
+      size_t strsize = loadinfo->shdr[loadinfo->strtabidx].sh_size;
+
+      /* The string table was verified to be NUL terminated when it was
+       * cached.
+       */
+
+      if (sym->st_name >= strsize)
+        {
+          berr("Symbol name offset out of range\n");
+          return -EINVAL;
+        }
+
+      *name = &loadinfo->strcache[sym->st_name];
+      return OK;
+    }
+#endif
+
   offset = loadinfo->shdr[loadinfo->strtabidx].sh_offset + sym->st_name;
 
   /* Loop until we get the entire symbol name into memory */
@@ -136,6 +158,7 @@ static int elf_symname(FAR struct elf_loadinfo_s *loadinfo,
         {
           /* Yes, the buffer contains a NUL terminator. */
 
+          *name = (FAR const char *)loadinfo->iobuffer;
           return OK;
         }
 
@@ -222,12 +245,22 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index,
 
   /* Verify that the symbol table index lies within symbol table */
 
-  if (index < 0 || index > (symtab->sh_size / sizeof(Elf32_Sym)))
+  if (index < 0 || index >= (symtab->sh_size / sizeof(Elf32_Sym)))
     {
       berr("Bad relocation symbol index: %d\n", index);
       return -EINVAL;
     }
 
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+  /* Take the entry from the cached symbol table if there is one */
+
+  if (loadinfo->symcache != NULL)
+    {
+      *sym = loadinfo->symcache[index];
+      return OK;
+    }
+#endif
+
   /* Get the file offset to the symbol table entry */
 
   offset = symtab->sh_offset + sizeof(Elf32_Sym) * index;
@@ -264,6 +297,7 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym,
                  FAR const struct symtab_s *exports, int nexports)
 {
   FAR const struct symtab_s *symbol;
+  FAR const char *name;
   uintptr_t secbase;
   int ret;
 
@@ -289,7 +323,7 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym,
       {
         /* Get the name of the undefined symbol */
 
-        ret = elf_symname(loadinfo, sym);
+        ret = elf_symname(loadinfo, sym, &name);
         if (ret < 0)
           {
             /* There are a few relocations for a few architectures that do
@@ -304,21 +338,23 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym,
 
         /* Check if the base code exports a symbol of this name */
 
-#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
-        symbol = symtab_findorderedbyname(exports, (FAR char *)loadinfo->iobuffer, nexports);
+#if defined(CONFIG_SYMTAB_ORDEREDBYNAME)
+        symbol = symtab_findorderedbyname(exports, name, nexports);
+#elif defined(CONFIG_SYMTAB_HASHED)
+        symbol = symtab_findhashedbyname(exports, name, nexports);
 #else
-        symbol = symtab_findbyname(exports, (FAR char *)loadinfo->iobuffer, nexports);
+        symbol = symtab_findbyname(exports, name, nexports);
 #endif
         if (!symbol)
           {
-            berr("SHN_UNDEF: Exported symbol \"%s\" not found\n", loadinfo->iobuffer);
+            berr("SHN_UNDEF: Exported symbol \"%s\" not found\n", name);
             return -ENOENT;
           }
 
         /* Yes... add the exported symbol value to the ELF symbol table entry */
 
         binfo("SHN_UNDEF: name=%s %08x+%08x=%08x\n",
-              loadinfo->iobuffer, sym->st_value, symbol->sym_value,
+              name, sym->st_value, symbol->sym_value,
               sym->st_value + symbol->sym_value);
 
         sym->st_value += (Elf32_Word)((uintptr_t)symbol->sym_value);
@@ -339,3 +375,86 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym,
 
   return OK;
 }
+
+/****************************************************************************
+ * Name: elf_cachesymtab
+ *
+ * Description:
+ *   Read the whole symbol table and its string table into memory so that
+ *   binding does not have to read each symbol and each symbol name from
+ *   the file.  This is only an optimization:  If the memory cannot be
+ *   allocated, the tables are simply accessed in the file as before.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure to read the file.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+int elf_cachesymtab(FAR struct elf_loadinfo_s *loadinfo)
+{
+  FAR Elf32_Shdr *symtab = &loadinfo->shdr[loadinfo->symtabidx];
+  FAR Elf32_Shdr *strtab = &loadinfo->shdr[loadinfo->strtabidx];
+  int ret;
+
+  if (strtab->sh_size == 0 || symtab->sh_size < sizeof(Elf32_Sym))
+    {
+      return OK;
+    }
+
+  loadinfo->symcache = (FAR Elf32_Sym *)kmm_malloc(symtab->sh_size);
+  loadinfo->strcache = (FAR char *)kmm_malloc(strtab->sh_size);
+  if (loadinfo->symcache == NULL || loadinfo->strcache == NULL)
+    {
+      binfo("Not enough memory to cache the symbol table\n");
+      elf_freesymtab(loadinfo);
+      return OK;
+    }
+
+  ret = elf_read(loadinfo, (FAR uint8_t *)loadinfo->symcache,
+                 symtab->sh_size, symtab->sh_offset);
+  if (ret >= 0)
+    {
+      ret = elf_read(loadinfo, (FAR uint8_t *)loadinfo->strcache,
+                     strtab->sh_size, strtab->sh_offset);
+    }
+
+  if (ret < 0)
+    {
+      berr("Failed to read the symbol table: %d\n", ret);
+      elf_freesymtab(loadinfo);
+      return ret;
+    }
+
+  /* Make sure that no name runs off the end of the string table */
+
+  loadinfo->strcache[strtab->sh_size - 1] = '\0';
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: elf_freesymtab
+ *
+ * Description:
+ *   Release the symbol table and string table cached by elf_cachesymtab().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+void elf_freesymtab(FAR struct elf_loadinfo_s *loadinfo)
+{
+  if (loadinfo->symcache != NULL)
+    {
+      kmm_free(loadinfo->symcache);
+      loadinfo->symcache = NULL;
+    }
+
+  if (loadinfo->strcache != NULL)
+    {
+      kmm_free(loadinfo->strcache);
+      loadinfo->strcache = NULL;
+    }
+}
+#endif
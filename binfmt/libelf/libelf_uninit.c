@@ -122,5 +122,9 @@ int elf_freebuffers(struct elf_loadinfo_s *loadinfo)
       loadinfo->buflen    = 0;
     }
 
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+  elf_freesymtab(loadinfo);
+#endif
+
   return OK;
 }
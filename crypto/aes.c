@@ -40,11 +40,75 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 
+#include <nuttx/crypto/crypto.h>
 #include <nuttx/crypto/aes.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define AES_BLOCKWORDS 4
+
+/* Big-endian load/store of a 32-bit word */
+
+#define GETU32(p) \
+  (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+   ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+#define PUTU32(p, v) \
+  do \
+    { \
+      (p)[0] = (uint8_t)((v) >> 24); \
+      (p)[1] = (uint8_t)((v) >> 16); \
+      (p)[2] = (uint8_t)((v) >> 8); \
+      (p)[3] = (uint8_t)(v); \
+    } \
+  while (0)
+
+#ifdef CONFIG_CRYPTO_SW_AES_TTABLE
+#  define ROR32(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+/* The four T-tables of the classic formulation, as rotations of one */
+
+#  define TE0(x)       (g_te[(x) & 0xff])
+#  define TE1(x)       ROR32(g_te[(x) & 0xff], 8)
+#  define TE2(x)       ROR32(g_te[(x) & 0xff], 16)
+#  define TE3(x)       ROR32(g_te[(x) & 0xff], 24)
+
+#  define TD0(x)       (g_td[(x) & 0xff])
+#  define TD1(x)       ROR32(g_td[(x) & 0xff], 8)
+#  define TD2(x)       ROR32(g_td[(x) & 0xff], 16)
+#  define TD3(x)       ROR32(g_td[(x) & 0xff], 24)
+
+#  define SUBWORD(w) \
+  (((uint32_t)g_sbox[(w) >> 24] << 24) | \
+   ((uint32_t)g_sbox[((w) >> 16) & 0xff] << 16) | \
+   ((uint32_t)g_sbox[((w) >> 8) & 0xff] << 8) | \
+   (uint32_t)g_sbox[(w) & 0xff])
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* GHASH state.  The hash key H is expanded into a 4-bit multiplication
+ * table (Shoup's method) so that each 16-byte block costs 32 table lookups
+ * rather than 128 conditional shift-and-xor steps.
+ */
+
+struct aes_ghash_s
+{
+  uint64_t hl[16];                /* Low 64 bits of i * H */
+  uint64_t hh[16];                /* High 64 bits of i * H */
+  uint8_t y[AES_BLOCK_SIZE];      /* Running hash */
+};
+
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -101,12 +165,339 @@ static const uint8_t g_rcon[11] =
   0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
 };
 
+/* GHASH reduction constants for the four bits shifted out of the 128-bit
+ * accumulator in each step of the 4-bit multiplication.
+ */
+
+static const uint16_t g_ghash_last4[16] =
+{
+  0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+  0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+#ifdef CONFIG_CRYPTO_SW_AES_TTABLE
+/* Encryption T-table:  Each entry combines SubBytes with one column of
+ * MixColumns, {02, 01, 01, 03} * S[x].  The other three tables of the
+ * classic formulation are byte rotations of this one.
+ */
+
+static const uint32_t g_te[256] =
+{
+  0xc66363a5, 0xf87c7c84, 0xee777799, 0xf67b7b8d, 0xfff2f20d, 0xd66b6bbd,
+  0xde6f6fb1, 0x91c5c554, 0x60303050, 0x02010103, 0xce6767a9, 0x562b2b7d,
+  0xe7fefe19, 0xb5d7d762, 0x4dababe6, 0xec76769a, 0x8fcaca45, 0x1f82829d,
+  0x89c9c940, 0xfa7d7d87, 0xeffafa15, 0xb25959eb, 0x8e4747c9, 0xfbf0f00b,
+  0x41adadec, 0xb3d4d467, 0x5fa2a2fd, 0x45afafea, 0x239c9cbf, 0x53a4a4f7,
+  0xe4727296, 0x9bc0c05b, 0x75b7b7c2, 0xe1fdfd1c, 0x3d9393ae, 0x4c26266a,
+  0x6c36365a, 0x7e3f3f41, 0xf5f7f702, 0x83cccc4f, 0x6834345c, 0x51a5a5f4,
+  0xd1e5e534, 0xf9f1f108, 0xe2717193, 0xabd8d873, 0x62313153, 0x2a15153f,
+  0x0804040c, 0x95c7c752, 0x46232365, 0x9dc3c35e, 0x30181828, 0x379696a1,
+  0x0a05050f, 0x2f9a9ab5, 0x0e070709, 0x24121236, 0x1b80809b, 0xdfe2e23d,
+  0xcdebeb26, 0x4e272769, 0x7fb2b2cd, 0xea75759f, 0x1209091b, 0x1d83839e,
+  0x582c2c74, 0x341a1a2e, 0x361b1b2d, 0xdc6e6eb2, 0xb45a5aee, 0x5ba0a0fb,
+  0xa45252f6, 0x763b3b4d, 0xb7d6d661, 0x7db3b3ce, 0x5229297b, 0xdde3e33e,
+  0x5e2f2f71, 0x13848497, 0xa65353f5, 0xb9d1d168, 0x00000000, 0xc1eded2c,
+  0x40202060, 0xe3fcfc1f, 0x79b1b1c8, 0xb65b5bed, 0xd46a6abe, 0x8dcbcb46,
+  0x67bebed9, 0x7239394b, 0x944a4ade, 0x984c4cd4, 0xb05858e8, 0x85cfcf4a,
+  0xbbd0d06b, 0xc5efef2a, 0x4faaaae5, 0xedfbfb16, 0x864343c5, 0x9a4d4dd7,
+  0x66333355, 0x11858594, 0x8a4545cf, 0xe9f9f910, 0x04020206, 0xfe7f7f81,
+  0xa05050f0, 0x783c3c44, 0x259f9fba, 0x4ba8a8e3, 0xa25151f3, 0x5da3a3fe,
+  0x804040c0, 0x058f8f8a, 0x3f9292ad, 0x219d9dbc, 0x70383848, 0xf1f5f504,
+  0x63bcbcdf, 0x77b6b6c1, 0xafdada75, 0x42212163, 0x20101030, 0xe5ffff1a,
+  0xfdf3f30e, 0xbfd2d26d, 0x81cdcd4c, 0x180c0c14, 0x26131335, 0xc3ecec2f,
+  0xbe5f5fe1, 0x359797a2, 0x884444cc, 0x2e171739, 0x93c4c457, 0x55a7a7f2,
+  0xfc7e7e82, 0x7a3d3d47, 0xc86464ac, 0xba5d5de7, 0x3219192b, 0xe6737395,
+  0xc06060a0, 0x19818198, 0x9e4f4fd1, 0xa3dcdc7f, 0x44222266, 0x542a2a7e,
+  0x3b9090ab, 0x0b888883, 0x8c4646ca, 0xc7eeee29, 0x6bb8b8d3, 0x2814143c,
+  0xa7dede79, 0xbc5e5ee2, 0x160b0b1d, 0xaddbdb76, 0xdbe0e03b, 0x64323256,
+  0x743a3a4e, 0x140a0a1e, 0x924949db, 0x0c06060a, 0x4824246c, 0xb85c5ce4,
+  0x9fc2c25d, 0xbdd3d36e, 0x43acacef, 0xc46262a6, 0x399191a8, 0x319595a4,
+  0xd3e4e437, 0xf279798b, 0xd5e7e732, 0x8bc8c843, 0x6e373759, 0xda6d6db7,
+  0x018d8d8c, 0xb1d5d564, 0x9c4e4ed2, 0x49a9a9e0, 0xd86c6cb4, 0xac5656fa,
+  0xf3f4f407, 0xcfeaea25, 0xca6565af, 0xf47a7a8e, 0x47aeaee9, 0x10080818,
+  0x6fbabad5, 0xf0787888, 0x4a25256f, 0x5c2e2e72, 0x381c1c24, 0x57a6a6f1,
+  0x73b4b4c7, 0x97c6c651, 0xcbe8e823, 0xa1dddd7c, 0xe874749c, 0x3e1f1f21,
+  0x964b4bdd, 0x61bdbddc, 0x0d8b8b86, 0x0f8a8a85, 0xe0707090, 0x7c3e3e42,
+  0x71b5b5c4, 0xcc6666aa, 0x904848d8, 0x06030305, 0xf7f6f601, 0x1c0e0e12,
+  0xc26161a3, 0x6a35355f, 0xae5757f9, 0x69b9b9d0, 0x17868691, 0x99c1c158,
+  0x3a1d1d27, 0x279e9eb9, 0xd9e1e138, 0xebf8f813, 0x2b9898b3, 0x22111133,
+  0xd26969bb, 0xa9d9d970, 0x078e8e89, 0x339494a7, 0x2d9b9bb6, 0x3c1e1e22,
+  0x15878792, 0xc9e9e920, 0x87cece49, 0xaa5555ff, 0x50282878, 0xa5dfdf7a,
+  0x038c8c8f, 0x59a1a1f8, 0x09898980, 0x1a0d0d17, 0x65bfbfda, 0xd7e6e631,
+  0x844242c6, 0xd06868b8, 0x824141c3, 0x299999b0, 0x5a2d2d77, 0x1e0f0f11,
+  0x7bb0b0cb, 0xa85454fc, 0x6dbbbbd6, 0x2c16163a
+};
+
+/* Decryption T-table:  {0e, 09, 0d, 0b} * InvS[x] */
+
+static const uint32_t g_td[256] =
+{
+  0x51f4a750, 0x7e416553, 0x1a17a4c3, 0x3a275e96, 0x3bab6bcb, 0x1f9d45f1,
+  0xacfa58ab, 0x4be30393, 0x2030fa55, 0xad766df6, 0x88cc7691, 0xf5024c25,
+  0x4fe5d7fc, 0xc52acbd7, 0x26354480, 0xb562a38f, 0xdeb15a49, 0x25ba1b67,
+  0x45ea0e98, 0x5dfec0e1, 0xc32f7502, 0x814cf012, 0x8d4697a3, 0x6bd3f9c6,
+  0x038f5fe7, 0x15929c95, 0xbf6d7aeb, 0x955259da, 0xd4be832d, 0x587421d3,
+  0x49e06929, 0x8ec9c844, 0x75c2896a, 0xf48e7978, 0x99583e6b, 0x27b971dd,
+  0xbee14fb6, 0xf088ad17, 0xc920ac66, 0x7dce3ab4, 0x63df4a18, 0xe51a3182,
+  0x97513360, 0x62537f45, 0xb16477e0, 0xbb6bae84, 0xfe81a01c, 0xf9082b94,
+  0x70486858, 0x8f45fd19, 0x94de6c87, 0x527bf8b7, 0xab73d323, 0x724b02e2,
+  0xe31f8f57, 0x6655ab2a, 0xb2eb2807, 0x2fb5c203, 0x86c57b9a, 0xd33708a5,
+  0x302887f2, 0x23bfa5b2, 0x02036aba, 0xed16825c, 0x8acf1c2b, 0xa779b492,
+  0xf307f2f0, 0x4e69e2a1, 0x65daf4cd, 0x0605bed5, 0xd134621f, 0xc4a6fe8a,
+  0x342e539d, 0xa2f355a0, 0x058ae132, 0xa4f6eb75, 0x0b83ec39, 0x4060efaa,
+  0x5e719f06, 0xbd6e1051, 0x3e218af9, 0x96dd063d, 0xdd3e05ae, 0x4de6bd46,
+  0x91548db5, 0x71c45d05, 0x0406d46f, 0x605015ff, 0x1998fb24, 0xd6bde997,
+  0x894043cc, 0x67d99e77, 0xb0e842bd, 0x07898b88, 0xe7195b38, 0x79c8eedb,
+  0xa17c0a47, 0x7c420fe9, 0xf8841ec9, 0x00000000, 0x09808683, 0x322bed48,
+  0x1e1170ac, 0x6c5a724e, 0xfd0efffb, 0x0f853856, 0x3daed51e, 0x362d3927,
+  0x0a0fd964, 0x685ca621, 0x9b5b54d1, 0x24362e3a, 0x0c0a67b1, 0x9357e70f,
+  0xb4ee96d2, 0x1b9b919e, 0x80c0c54f, 0x61dc20a2, 0x5a774b69, 0x1c121a16,
+  0xe293ba0a, 0xc0a02ae5, 0x3c22e043, 0x121b171d, 0x0e090d0b, 0xf28bc7ad,
+  0x2db6a8b9, 0x141ea9c8, 0x57f11985, 0xaf75074c, 0xee99ddbb, 0xa37f60fd,
+  0xf701269f, 0x5c72f5bc, 0x44663bc5, 0x5bfb7e34, 0x8b432976, 0xcb23c6dc,
+  0xb6edfc68, 0xb8e4f163, 0xd731dcca, 0x42638510, 0x13972240, 0x84c61120,
+  0x854a247d, 0xd2bb3df8, 0xaef93211, 0xc729a16d, 0x1d9e2f4b, 0xdcb230f3,
+  0x0d8652ec, 0x77c1e3d0, 0x2bb3166c, 0xa970b999, 0x119448fa, 0x47e96422,
+  0xa8fc8cc4, 0xa0f03f1a, 0x567d2cd8, 0x223390ef, 0x87494ec7, 0xd938d1c1,
+  0x8ccaa2fe, 0x98d40b36, 0xa6f581cf, 0xa57ade28, 0xdab78e26, 0x3fadbfa4,
+  0x2c3a9de4, 0x5078920d, 0x6a5fcc9b, 0x547e4662, 0xf68d13c2, 0x90d8b8e8,
+  0x2e39f75e, 0x82c3aff5, 0x9f5d80be, 0x69d0937c, 0x6fd52da9, 0xcf2512b3,
+  0xc8ac993b, 0x10187da7, 0xe89c636e, 0xdb3bbb7b, 0xcd267809, 0x6e5918f4,
+  0xec9ab701, 0x834f9aa8, 0xe6956e65, 0xaaffe67e, 0x21bccf08, 0xef15e8e6,
+  0xbae79bd9, 0x4a6f36ce, 0xea9f09d4, 0x29b07cd6, 0x31a4b2af, 0x2a3f2331,
+  0xc6a59430, 0x35a266c0, 0x744ebc37, 0xfc82caa6, 0xe090d0b0, 0x33a7d815,
+  0xf104984a, 0x41ecdaf7, 0x7fcd500e, 0x1791f62f, 0x764dd68d, 0x43efb04d,
+  0xccaa4d54, 0xe49604df, 0x9ed1b5e3, 0x4c6a881b, 0xc12c1fb8, 0x4665517f,
+  0x9d5eea04, 0x018c355d, 0xfa877473, 0xfb0b412e, 0xb3671d5a, 0x92dbd252,
+  0xe9105633, 0x6dd64713, 0x9ad7618c, 0x37a10c7a, 0x59f8148e, 0xeb133c89,
+  0xcea927ee, 0xb761c935, 0xe11ce5ed, 0x7a47b13c, 0x9cd2df59, 0x55f2733f,
+  0x1814ce79, 0x73c737bf, 0x53f7cdea, 0x5ffdaa5b, 0xdf3d6f14, 0x7844db86,
+  0xcaaff381, 0xb968c43e, 0x3824342c, 0xc2a3405f, 0x161dc372, 0xbce2250c,
+  0x283c498b, 0xff0d9541, 0x39a80171, 0x080cb3de, 0xd8b4e49c, 0x6456c190,
+  0x7bcb8461, 0xd532b670, 0x486c5c74, 0xd0b85742
+};
+#endif
+
 static struct aes_state_s g_aes_state;
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_CRYPTO_SW_AES_TTABLE
+/****************************************************************************
+ * Name: aes_expandkey
+ *
+ * Description:
+ *   Compute the encryption round keys for a 128-, 192- or 256-bit key and
+ *   the decryption round keys of the equivalent inverse cipher (FIPS-197,
+ *   section 5.3.5):  The encryption keys in reverse order with
+ *   InvMixColumns applied to all but the first and last round key.
+ *
+ * Input Parameters:
+ *   state - The AES context to initialize
+ *   key   - The key
+ *   len   - Length of the key in bytes: 16, 24 or 32
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void aes_expandkey(FAR struct aes_state_s *state,
+                          FAR const uint8_t *key, int len)
+{
+  FAR uint32_t *ek = state->ek;
+  FAR uint32_t *dk = state->dk;
+  uint32_t tmp;
+  int nk = len / 4;
+  int nw;
+  int i;
+  int j;
+
+  state->nr = nk + 6;
+  nw        = AES_BLOCKWORDS * (state->nr + 1);
+
+  for (i = 0; i < nk; i++)
+    {
+      ek[i] = GETU32(key + 4 * i);
+    }
+
+  for (; i < nw; i++)
+    {
+      tmp = ek[i - 1];
+      if (i % nk == 0)
+        {
+          tmp = SUBWORD(ROR32(tmp, 24)) ^ ((uint32_t)g_rcon[i / nk] << 24);
+        }
+      else if (nk > 6 && i % nk == 4)
+        {
+          tmp = SUBWORD(tmp);
+        }
+
+      ek[i] = ek[i - nk] ^ tmp;
+    }
+
+  for (i = 0; i <= state->nr; i++)
+    {
+      for (j = 0; j < AES_BLOCKWORDS; j++)
+        {
+          tmp = ek[AES_BLOCKWORDS * (state->nr - i) + j];
+          if (i > 0 && i < state->nr)
+            {
+              /* InvMixColumns(w) = Td[S[w]], since Td includes InvS */
+
+              tmp = TD0(g_sbox[tmp >> 24]) ^
+                    TD1(g_sbox[(tmp >> 16) & 0xff]) ^
+                    TD2(g_sbox[(tmp >> 8) & 0xff]) ^
+                    TD3(g_sbox[tmp & 0xff]);
+            }
+
+          dk[AES_BLOCKWORDS * i + j] = tmp;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: aes_encrypt_block
+ *
+ * Description:
+ *   Encrypt one 16-byte block.  Each round is sixteen table lookups and
+ *   sixteen XORs on 32-bit words.  'in' and 'out' may be the same buffer.
+ *
+ ****************************************************************************/
+
+static void aes_encrypt_block(FAR const struct aes_state_s *state,
+                              FAR const uint8_t *in, FAR uint8_t *out)
+{
+  FAR const uint32_t *rk = state->ek;
+  uint32_t s0;
+  uint32_t s1;
+  uint32_t s2;
+  uint32_t s3;
+  uint32_t t0;
+  uint32_t t1;
+  uint32_t t2;
+  uint32_t t3;
+  int round;
+
+  s0 = GETU32(in)      ^ rk[0];
+  s1 = GETU32(in + 4)  ^ rk[1];
+  s2 = GETU32(in + 8)  ^ rk[2];
+  s3 = GETU32(in + 12) ^ rk[3];
+
+  for (round = 1; round < state->nr; round++)
+    {
+      rk += AES_BLOCKWORDS;
+
+      t0 = TE0(s0 >> 24) ^ TE1(s1 >> 16) ^ TE2(s2 >> 8) ^ TE3(s3) ^ rk[0];
+      t1 = TE0(s1 >> 24) ^ TE1(s2 >> 16) ^ TE2(s3 >> 8) ^ TE3(s0) ^ rk[1];
+      t2 = TE0(s2 >> 24) ^ TE1(s3 >> 16) ^ TE2(s0 >> 8) ^ TE3(s1) ^ rk[2];
+      t3 = TE0(s3 >> 24) ^ TE1(s0 >> 16) ^ TE2(s1 >> 8) ^ TE3(s2) ^ rk[3];
+
+      s0 = t0;
+      s1 = t1;
+      s2 = t2;
+      s3 = t3;
+    }
+
+  /* The last round has no MixColumns */
+
+  rk += AES_BLOCKWORDS;
+
+  t0 = ((uint32_t)g_sbox[s0 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s1 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s2 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_sbox[s3 & 0xff] ^ rk[0];
+  t1 = ((uint32_t)g_sbox[s1 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s2 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s3 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_sbox[s0 & 0xff] ^ rk[1];
+  t2 = ((uint32_t)g_sbox[s2 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s3 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s0 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_sbox[s1 & 0xff] ^ rk[2];
+  t3 = ((uint32_t)g_sbox[s3 >> 24] << 24) ^
+       ((uint32_t)g_sbox[(s0 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_sbox[(s1 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_sbox[s2 & 0xff] ^ rk[3];
+
+  PUTU32(out, t0);
+  PUTU32(out + 4, t1);
+  PUTU32(out + 8, t2);
+  PUTU32(out + 12, t3);
+}
+
+/****************************************************************************
+ * Name: aes_decrypt_block
+ *
+ * Description:
+ *   Decrypt one 16-byte block with the equivalent inverse cipher.  'in' and
+ *   'out' may be the same buffer.
+ *
+ ****************************************************************************/
+
+static void aes_decrypt_block(FAR const struct aes_state_s *state,
+                              FAR const uint8_t *in, FAR uint8_t *out)
+{
+  FAR const uint32_t *rk = state->dk;
+  uint32_t s0;
+  uint32_t s1;
+  uint32_t s2;
+  uint32_t s3;
+  uint32_t t0;
+  uint32_t t1;
+  uint32_t t2;
+  uint32_t t3;
+  int round;
+
+  s0 = GETU32(in)      ^ rk[0];
+  s1 = GETU32(in + 4)  ^ rk[1];
+  s2 = GETU32(in + 8)  ^ rk[2];
+  s3 = GETU32(in + 12) ^ rk[3];
+
+  for (round = 1; round < state->nr; round++)
+    {
+      rk += AES_BLOCKWORDS;
+
+      t0 = TD0(s0 >> 24) ^ TD1(s3 >> 16) ^ TD2(s2 >> 8) ^ TD3(s1) ^ rk[0];
+      t1 = TD0(s1 >> 24) ^ TD1(s0 >> 16) ^ TD2(s3 >> 8) ^ TD3(s2) ^ rk[1];
+      t2 = TD0(s2 >> 24) ^ TD1(s1 >> 16) ^ TD2(s0 >> 8) ^ TD3(s3) ^ rk[2];
+      t3 = TD0(s3 >> 24) ^ TD1(s2 >> 16) ^ TD2(s1 >> 8) ^ TD3(s0) ^ rk[3];
+
+      s0 = t0;
+      s1 = t1;
+      s2 = t2;
+      s3 = t3;
+    }
+
+  rk += AES_BLOCKWORDS;
+
+  t0 = ((uint32_t)g_rsbox[s0 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s3 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s2 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_rsbox[s1 & 0xff] ^ rk[0];
+  t1 = ((uint32_t)g_rsbox[s1 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s0 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s3 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_rsbox[s2 & 0xff] ^ rk[1];
+  t2 = ((uint32_t)g_rsbox[s2 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s1 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s0 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_rsbox[s3 & 0xff] ^ rk[2];
+  t3 = ((uint32_t)g_rsbox[s3 >> 24] << 24) ^
+       ((uint32_t)g_rsbox[(s2 >> 16) & 0xff] << 16) ^
+       ((uint32_t)g_rsbox[(s1 >> 8) & 0xff] << 8) ^
+       (uint32_t)g_rsbox[s0 & 0xff] ^ rk[3];
+
+  PUTU32(out, t0);
+  PUTU32(out + 4, t1);
+  PUTU32(out + 8, t2);
+  PUTU32(out + 12, t3);
+}
+
+#else /* CONFIG_CRYPTO_SW_AES_TTABLE */
+
 /****************************************************************************
  * Name: expand_key
  *
@@ -535,6 +926,340 @@ static void aes_decr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
     }
 }
 
+/****************************************************************************
+ * Name: aes_expandkey
+ *
+ * Description:
+ *   Compute the round keys.  Only 128-bit keys are supported by the
+ *   byte-oriented implementation.
+ *
+ ****************************************************************************/
+
+static void aes_expandkey(FAR struct aes_state_s *state,
+                          FAR const uint8_t *key, int len)
+{
+  expand_key(state->expanded_key, key);
+}
+
+/****************************************************************************
+ * Name: aes_encrypt_block
+ *
+ * Description:
+ *   Encrypt one 16-byte block.  'in' and 'out' may be the same buffer.
+ *
+ ****************************************************************************/
+
+static void aes_encrypt_block(FAR const struct aes_state_s *state,
+                              FAR const uint8_t *in, FAR uint8_t *out)
+{
+  if (out != in)
+    {
+      memcpy(out, in, AES_BLOCK_SIZE);
+    }
+
+  aes_encr(out, state->expanded_key);
+}
+
+/****************************************************************************
+ * Name: aes_decrypt_block
+ *
+ * Description:
+ *   Decrypt one 16-byte block.  'in' and 'out' may be the same buffer.
+ *
+ ****************************************************************************/
+
+static void aes_decrypt_block(FAR const struct aes_state_s *state,
+                              FAR const uint8_t *in, FAR uint8_t *out)
+{
+  if (out != in)
+    {
+      memcpy(out, in, AES_BLOCK_SIZE);
+    }
+
+  aes_decr(out, state->expanded_key);
+}
+#endif /* CONFIG_CRYPTO_SW_AES_TTABLE */
+
+/****************************************************************************
+ * Name: aes_ctr_xcrypt
+ *
+ * Description:
+ *   Encrypt or decrypt 'len' bytes in counter mode.  The low 'incbytes'
+ *   bytes of the counter block are incremented as a big-endian integer
+ *   after each block:  16 for plain CTR mode, 4 for GCM.
+ *
+ ****************************************************************************/
+
+static void aes_ctr_xcrypt(FAR const struct aes_state_s *state,
+                           FAR uint8_t *ctr, FAR const uint8_t *in,
+                           FAR uint8_t *out, size_t len, int incbytes)
+{
+  uint8_t keystream[AES_BLOCK_SIZE];
+  size_t nbytes;
+  size_t i;
+
+  while (len > 0)
+    {
+      aes_encrypt_block(state, ctr, keystream);
+
+      nbytes = len < AES_BLOCK_SIZE ? len : AES_BLOCK_SIZE;
+      for (i = 0; i < nbytes; i++)
+        {
+          out[i] = in[i] ^ keystream[i];
+        }
+
+      for (i = AES_BLOCK_SIZE; i > AES_BLOCK_SIZE - incbytes; i--)
+        {
+          if (++ctr[i - 1] != 0)
+            {
+              break;
+            }
+        }
+
+      in  += nbytes;
+      out += nbytes;
+      len -= nbytes;
+    }
+}
+
+/****************************************************************************
+ * Name: aes_ghash_init
+ *
+ * Description:
+ *   Build the 4-bit multiplication table for the hash key 'h' and clear the
+ *   running hash.
+ *
+ ****************************************************************************/
+
+static void aes_ghash_init(FAR struct aes_ghash_s *ghash,
+                           FAR const uint8_t *h)
+{
+  uint64_t vh;
+  uint64_t vl;
+  int i;
+  int j;
+
+  vh = ((uint64_t)GETU32(h) << 32) | GETU32(h + 4);
+  vl = ((uint64_t)GETU32(h + 8) << 32) | GETU32(h + 12);
+
+  ghash->hl[0] = 0;
+  ghash->hh[0] = 0;
+  ghash->hl[8] = vl;
+  ghash->hh[8] = vh;
+
+  /* hl/hh[4], [2] and [1] are H * x, x^2 and x^3 (bit-reflected) */
+
+  for (i = 4; i > 0; i >>= 1)
+    {
+      uint32_t t = (vl & 1) ? 0xe1000000 : 0;
+
+      vl = (vh << 63) | (vl >> 1);
+      vh = (vh >> 1) ^ ((uint64_t)t << 32);
+
+      ghash->hl[i] = vl;
+      ghash->hh[i] = vh;
+    }
+
+  /* The remaining entries are sums of those */
+
+  for (i = 2; i <= 8; i *= 2)
+    {
+      for (j = 1; j < i; j++)
+        {
+          ghash->hh[i + j] = ghash->hh[i] ^ ghash->hh[j];
+          ghash->hl[i + j] = ghash->hl[i] ^ ghash->hl[j];
+        }
+    }
+
+  memset(ghash->y, 0, AES_BLOCK_SIZE);
+}
+
+/****************************************************************************
+ * Name: aes_ghash_mult
+ *
+ * Description:
+ *   y = y * H in GF(2^128)
+ *
+ ****************************************************************************/
+
+static void aes_ghash_mult(FAR struct aes_ghash_s *ghash)
+{
+  FAR uint8_t *y = ghash->y;
+  uint64_t zh;
+  uint64_t zl;
+  uint8_t rem;
+  uint8_t lo;
+  uint8_t hi;
+  int i;
+
+  lo = y[15] & 0x0f;
+  zh = ghash->hh[lo];
+  zl = ghash->hl[lo];
+
+  for (i = 15; i >= 0; i--)
+    {
+      lo = y[i] & 0x0f;
+      hi = y[i] >> 4;
+
+      if (i != 15)
+        {
+          rem = (uint8_t)zl & 0x0f;
+          zl  = (zh << 60) | (zl >> 4);
+          zh  = (zh >> 4) ^ ((uint64_t)g_ghash_last4[rem] << 48);
+          zh ^= ghash->hh[lo];
+          zl ^= ghash->hl[lo];
+        }
+
+      rem = (uint8_t)zl & 0x0f;
+      zl  = (zh << 60) | (zl >> 4);
+      zh  = (zh >> 4) ^ ((uint64_t)g_ghash_last4[rem] << 48);
+      zh ^= ghash->hh[hi];
+      zl ^= ghash->hl[hi];
+    }
+
+  PUTU32(y, (uint32_t)(zh >> 32));
+  PUTU32(y + 4, (uint32_t)zh);
+  PUTU32(y + 8, (uint32_t)(zl >> 32));
+  PUTU32(y + 12, (uint32_t)zl);
+}
+
+/****************************************************************************
+ * Name: aes_ghash_update
+ *
+ * Description:
+ *   Hash 'len' bytes of data.  A final partial block is zero padded.
+ *
+ ****************************************************************************/
+
+static void aes_ghash_update(FAR struct aes_ghash_s *ghash,
+                             FAR const uint8_t *data, size_t len)
+{
+  size_t nbytes;
+  size_t i;
+
+  while (len > 0)
+    {
+      nbytes = len < AES_BLOCK_SIZE ? len : AES_BLOCK_SIZE;
+      for (i = 0; i < nbytes; i++)
+        {
+          ghash->y[i] ^= data[i];
+        }
+
+      aes_ghash_mult(ghash);
+
+      data += nbytes;
+      len  -= nbytes;
+    }
+}
+
+/****************************************************************************
+ * Name: aes_ghash_lengths
+ *
+ * Description:
+ *   Hash the final block holding the bit lengths of the two hashed strings.
+ *
+ ****************************************************************************/
+
+static void aes_ghash_lengths(FAR struct aes_ghash_s *ghash,
+                              uint64_t alen, uint64_t clen)
+{
+  uint8_t block[AES_BLOCK_SIZE];
+
+  alen <<= 3;
+  clen <<= 3;
+
+  PUTU32(block, (uint32_t)(alen >> 32));
+  PUTU32(block + 4, (uint32_t)alen);
+  PUTU32(block + 8, (uint32_t)(clen >> 32));
+  PUTU32(block + 12, (uint32_t)clen);
+
+  aes_ghash_update(ghash, block, AES_BLOCK_SIZE);
+}
+
+/****************************************************************************
+ * Name: aes_gcm_start
+ *
+ * Description:
+ *   Common start of GCM encryption and decryption:  Derive the hash key,
+ *   compute the pre-counter block J0 and the first counter block from the
+ *   IV and hash the additional authenticated data.
+ *
+ ****************************************************************************/
+
+static int aes_gcm_start(FAR const struct aes_state_s *state,
+                         FAR struct aes_ghash_s *ghash,
+                         FAR uint8_t *j0, FAR uint8_t *ctr,
+                         FAR const uint8_t *iv, size_t ivlen,
+                         FAR const uint8_t *aad, size_t aadlen,
+                         size_t taglen)
+{
+  uint8_t h[AES_BLOCK_SIZE];
+  int i;
+
+  if (ivlen == 0 || taglen < 4 || taglen > AES_BLOCK_SIZE)
+    {
+      return -EINVAL;
+    }
+
+  memset(h, 0, AES_BLOCK_SIZE);
+  aes_encrypt_block(state, h, h);
+  aes_ghash_init(ghash, h);
+
+  if (ivlen == 12)
+    {
+      memcpy(j0, iv, 12);
+      j0[12] = 0;
+      j0[13] = 0;
+      j0[14] = 0;
+      j0[15] = 1;
+    }
+  else
+    {
+      aes_ghash_update(ghash, iv, ivlen);
+      aes_ghash_lengths(ghash, 0, ivlen);
+      memcpy(j0, ghash->y, AES_BLOCK_SIZE);
+      memset(ghash->y, 0, AES_BLOCK_SIZE);
+    }
+
+  /* The first counter block is inc32(J0) */
+
+  memcpy(ctr, j0, AES_BLOCK_SIZE);
+  for (i = AES_BLOCK_SIZE; i > AES_BLOCK_SIZE - 4; i--)
+    {
+      if (++ctr[i - 1] != 0)
+        {
+          break;
+        }
+    }
+
+  aes_ghash_update(ghash, aad, aadlen);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_tag
+ *
+ * Description:
+ *   Finish the hash and compute the full authentication tag.  J0 is
+ *   consumed.
+ *
+ ****************************************************************************/
+
+static void aes_gcm_tag(FAR const struct aes_state_s *state,
+                        FAR struct aes_ghash_s *ghash, FAR uint8_t *j0,
+                        size_t aadlen, size_t len)
+{
+  int i;
+
+  aes_ghash_lengths(ghash, aadlen, len);
+  aes_encrypt_block(state, j0, j0);
+
+  for (i = 0; i < AES_BLOCK_SIZE; i++)
+    {
+      j0[i] ^= ghash->y[i];
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -547,25 +1272,29 @@ static void aes_decr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
  *
  * Input Parameters:
  *  state  an AES context that can be used for AES operations
- *  key    a pointer to a 16-byte buffer holding the AES-128 key
- *  len    length of the key, must be 16
- *
- * TODO: Support other key lengths of 24 (AES-192) and 32 (AES-256)
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key:  16 (AES-128) or, with
+ *         CONFIG_CRYPTO_SW_AES_TTABLE, 24 (AES-192) or 32 (AES-256)
  *
  * Returned Value:
  *   0 if OK
- *   -EINVAL if len is not 16
+ *   -EINVAL if the key length is not supported
  *
  ****************************************************************************/
 
 int aes_setupkey(FAR struct aes_state_s *state, FAR const uint8_t *key, int len)
 {
-  if (len != 16)
+#ifdef CONFIG_CRYPTO_SW_AES_TTABLE
+  if (len != AES128_KEY_SIZE && len != AES192_KEY_SIZE &&
+      len != AES256_KEY_SIZE)
+#else
+  if (len != AES128_KEY_SIZE)
+#endif
     {
       return -EINVAL;
     }
 
-  expand_key(state->expanded_key, key);
+  aes_expandkey(state, key, len);
   return 0;
 }
 
@@ -586,12 +1315,11 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
                   int nblk)
 {
   int i;
-  uint32_t off = 0;
 
   for (i = 0; i < nblk; i++)
     {
-      aes_encr(blocks + off, state->expanded_key);
-      off += 16;
+      aes_encrypt_block(state, blocks, blocks);
+      blocks += AES_BLOCK_SIZE;
     }
 }
 
@@ -612,15 +1340,214 @@ void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
                   int nblk)
 {
   int i;
-  uint32_t off = 0;
 
   for (i = 0; i < nblk; i++)
     {
-      aes_decr(blocks + off, state->expanded_key);
-      off += 16;
+      aes_decrypt_block(state, blocks, blocks);
+      blocks += AES_BLOCK_SIZE;
     }
 }
 
+/****************************************************************************
+ * Name: aes_cbc_encrypt
+ *
+ * Description:
+ *   Encrypt 'nblk' 16-byte blocks in CBC mode.  On return, 'iv' holds the
+ *   last cipher text block so that a long message may be encrypted with
+ *   several calls.  'in' and 'out' may be the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_cbc_encrypt(FAR const struct aes_state_s *state, FAR uint8_t *iv,
+                     FAR const uint8_t *in, FAR uint8_t *out, size_t nblk)
+{
+  int i;
+
+  while (nblk-- > 0)
+    {
+      for (i = 0; i < AES_BLOCK_SIZE; i++)
+        {
+          out[i] = in[i] ^ iv[i];
+        }
+
+      aes_encrypt_block(state, out, out);
+      memcpy(iv, out, AES_BLOCK_SIZE);
+
+      in  += AES_BLOCK_SIZE;
+      out += AES_BLOCK_SIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: aes_cbc_decrypt
+ *
+ * Description:
+ *   Decrypt 'nblk' 16-byte blocks in CBC mode.  On return, 'iv' holds the
+ *   last cipher text block.  'in' and 'out' may be the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_cbc_decrypt(FAR const struct aes_state_s *state, FAR uint8_t *iv,
+                     FAR const uint8_t *in, FAR uint8_t *out, size_t nblk)
+{
+  uint8_t cipher[AES_BLOCK_SIZE];
+  int i;
+
+  while (nblk-- > 0)
+    {
+      memcpy(cipher, in, AES_BLOCK_SIZE);
+      aes_decrypt_block(state, in, out);
+
+      for (i = 0; i < AES_BLOCK_SIZE; i++)
+        {
+          out[i] ^= iv[i];
+        }
+
+      memcpy(iv, cipher, AES_BLOCK_SIZE);
+
+      in  += AES_BLOCK_SIZE;
+      out += AES_BLOCK_SIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: aes_ctr_crypt
+ *
+ * Description:
+ *   Encrypt or decrypt 'len' bytes in CTR mode.  'ctr' is the 16-byte
+ *   initial counter block; it is incremented as a 128-bit big-endian
+ *   integer for each block.  On return it holds the next unused counter so
+ *   that a long message may be processed with several calls, all but the
+ *   last of which must be a multiple of 16 bytes.  'in' and 'out' may be
+ *   the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_ctr_crypt(FAR const struct aes_state_s *state, FAR uint8_t *ctr,
+                   FAR const uint8_t *in, FAR uint8_t *out, size_t len)
+{
+  aes_ctr_xcrypt(state, ctr, in, out, len, AES_BLOCK_SIZE);
+}
+
+/****************************************************************************
+ * Name: aes_gcm_encrypt
+ *
+ * Description:
+ *   Encrypt 'len' bytes and authenticate them together with 'aadlen' bytes
+ *   of additional data in GCM mode (NIST SP 800-38D).  'in' and 'out' may
+ *   be the same buffer.
+ *
+ * Input Parameters:
+ *   state  - An AES context initialized by aes_setupkey()
+ *   iv     - The initialization vector; 12 bytes is recommended
+ *   ivlen  - The size of the IV
+ *   aad    - Additional authenticated data (may be NULL if aadlen is 0)
+ *   aadlen - The size of the additional data
+ *   in     - The plain text
+ *   out    - The cipher text
+ *   len    - The size of the plain text
+ *   tag    - The location to return the authentication tag
+ *   taglen - The size of the tag, 4 to 16 bytes
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if the IV or tag size is invalid
+ *
+ ****************************************************************************/
+
+int aes_gcm_encrypt(FAR const struct aes_state_s *state,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR uint8_t *tag, size_t taglen)
+{
+  struct aes_ghash_s ghash;
+  uint8_t j0[AES_BLOCK_SIZE];
+  uint8_t ctr[AES_BLOCK_SIZE];
+  int ret;
+
+  ret = aes_gcm_start(state, &ghash, j0, ctr, iv, ivlen, aad, aadlen,
+                      taglen);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  aes_ctr_xcrypt(state, ctr, in, out, len, 4);
+  aes_ghash_update(&ghash, out, len);
+
+  aes_gcm_tag(state, &ghash, j0, aadlen, len);
+  memcpy(tag, j0, taglen);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_decrypt
+ *
+ * Description:
+ *   Verify and decrypt 'len' bytes in GCM mode.  The authentication tag is
+ *   checked before any plain text is produced; nothing is written to 'out'
+ *   if it does not match.  'in' and 'out' may be the same buffer.
+ *
+ * Input Parameters:
+ *   As for aes_gcm_encrypt() but 'in' is the cipher text, 'out' the plain
+ *   text and 'tag' the tag to verify.
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if the IV or tag size is invalid
+ *   -EBADMSG if the authentication tag does not match
+ *
+ ****************************************************************************/
+
+int aes_gcm_decrypt(FAR const struct aes_state_s *state,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR const uint8_t *tag, size_t taglen)
+{
+  struct aes_ghash_s ghash;
+  uint8_t j0[AES_BLOCK_SIZE];
+  uint8_t ctr[AES_BLOCK_SIZE];
+  uint8_t diff;
+  size_t i;
+  int ret;
+
+  ret = aes_gcm_start(state, &ghash, j0, ctr, iv, ivlen, aad, aadlen,
+                      taglen);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  aes_ghash_update(&ghash, in, len);
+  aes_gcm_tag(state, &ghash, j0, aadlen, len);
+
+  /* Compare in constant time */
+
+  for (diff = 0, i = 0; i < taglen; i++)
+    {
+      diff |= j0[i] ^ tag[i];
+    }
+
+  if (diff != 0)
+    {
+      return -EBADMSG;
+    }
+
+  aes_ctr_xcrypt(state, ctr, in, out, len, 4);
+  return OK;
+}
+
 /****************************************************************************
  * Name: aes_encrypt
  *
@@ -643,7 +1570,7 @@ void aes_encrypt(FAR uint8_t *state, FAR const uint8_t *key)
   /* Expand the key into 176 bytes */
 
   aes_setupkey(&g_aes_state, key, 16);
-  aes_encr(state, g_aes_state.expanded_key);
+  aes_encrypt_block(&g_aes_state, state, state);
 }
 
 /****************************************************************************
@@ -668,5 +1595,97 @@ void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key)
   /* Expand the key into 176 bytes */
 
   aes_setupkey(&g_aes_state, key, 16);
-  aes_decr(state, g_aes_state.expanded_key);
+  aes_decrypt_block(&g_aes_state, state, state);
+}
+
+/****************************************************************************
+ * Name: aes_cypher
+ *
+ * Description:
+ *   Software implementation of the aes_cypher() interface of
+ *   include/nuttx/crypto/crypto.h for platforms without AES hardware.
+ *   ECB and CBC require a multiple of 16 bytes; CTR accepts any size.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CRYPTO_SW_AES_CYPHER
+int aes_cypher(FAR void *out, FAR const void *in, uint32_t size,
+               FAR const void *iv, FAR const void *key, uint32_t keysize,
+               int mode, int encrypt)
+{
+  struct aes_state_s state;
+  uint8_t ivbuf[AES_BLOCK_SIZE];
+  FAR const uint8_t *src = (FAR const uint8_t *)in;
+  FAR uint8_t *dest = (FAR uint8_t *)out;
+  int ret;
+
+  if ((mode & AES_MODE_MAC) != 0)
+    {
+      return -EINVAL;
+    }
+
+  mode &= AES_MODE_MASK;
+  if (mode != AES_MODE_CTR && (size % AES_BLOCK_SIZE) != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (mode != AES_MODE_ECB)
+    {
+      if (iv == NULL)
+        {
+          return -EINVAL;
+        }
+
+      memcpy(ivbuf, iv, AES_BLOCK_SIZE);
+    }
+
+  ret = aes_setupkey(&state, key, keysize);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (mode)
+    {
+      case AES_MODE_ECB:
+        for (; size > 0; size -= AES_BLOCK_SIZE)
+          {
+            if (encrypt)
+              {
+                aes_encrypt_block(&state, src, dest);
+              }
+            else
+              {
+                aes_decrypt_block(&state, src, dest);
+              }
+
+            src  += AES_BLOCK_SIZE;
+            dest += AES_BLOCK_SIZE;
+          }
+        break;
+
+      case AES_MODE_CBC:
+        if (encrypt)
+          {
+            aes_cbc_encrypt(&state, ivbuf, src, dest, size / AES_BLOCK_SIZE);
+          }
+        else
+          {
+            aes_cbc_decrypt(&state, ivbuf, src, dest, size / AES_BLOCK_SIZE);
+          }
+        break;
+
+      case AES_MODE_CTR:
+        aes_ctr_crypt(&state, ivbuf, src, dest, size);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  memset(&state, 0, sizeof(struct aes_state_s));
+  return ret;
 }
+#endif /* CONFIG_CRYPTO_SW_AES_CYPHER */
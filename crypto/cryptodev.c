@@ -43,30 +43,76 @@
 #include <stdbool.h>
 #include <string.h>
 #include <poll.h>
+#include <queue.h>
+#include <assert.h>
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/drivers/drivers.h>
 
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/crypto/cryptodev.h>
+#include <nuttx/crypto/aes.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#ifdef CONFIG_CRYPTO_AES
-#  define AES_CYPHER(mode) \
-  aes_cypher(op->dst, op->src, op->len, op->iv, ses->key, ses->keylen, \
-             mode, encrypt)
+/* ECB, CBC and CTR use the software AES library directly, with the key
+ * expanded once per session, unless aes_cypher() is provided by AES
+ * hardware.  GCM is only available with the software library.
+ */
+
+#if defined(CONFIG_CRYPTO_SW_AES) && \
+    (defined(CONFIG_CRYPTO_SW_AES_CYPHER) || !defined(CONFIG_CRYPTO_AES))
+#  define CRYPTODEV_SW_CIPHER 1
+#endif
+
+#if defined(CONFIG_CRYPTO_AES) || defined(CONFIG_CRYPTO_SW_AES)
+#  define CRYPTODEV_HAVE_AES 1
 #endif
 
+#define CRYPTODEV_MAXKEY 32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One session created by CIOCGSESSION */
+
+struct cryptodev_session_s
+{
+  FAR struct cryptodev_session_s *flink;
+  uint32_t ses;                    /* Session ID */
+  uint32_t cipher;                 /* E.g. CRYPTO_AES_CBC */
+  uint32_t keylen;
+  uint8_t key[CRYPTODEV_MAXKEY];
+#ifdef CONFIG_CRYPTO_SW_AES
+  struct aes_state_s aes;          /* Expanded key */
+#endif
+};
+
+/* The state of one open of /dev/crypto.  Sessions belong to the open file
+ * and are released when it is closed.
+ */
+
+struct cryptodev_fcrypt_s
+{
+  sem_t lock;                      /* Protects the session list */
+  sq_queue_t sessions;             /* List of struct cryptodev_session_s */
+  uint32_t nextses;                /* Next session ID to assign */
+};
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
 /* Character driver methods */
 
+static int cryptodev_open(FAR struct file *filep);
+static int cryptodev_close(FAR struct file *filep);
 static ssize_t cryptodev_read(FAR struct file *filep, FAR char *buffer,
                               size_t len);
 static ssize_t cryptodev_write(FAR struct file *filep, FAR const char *buffer,
@@ -80,8 +126,8 @@ static int cryptodev_ioctl(FAR struct file *filep, int cmd,
 
 static const struct file_operations g_cryptodevops =
 {
-  0,                  /* open   */
-  0,                  /* close  */
+  cryptodev_open,     /* open   */
+  cryptodev_close,    /* close  */
   cryptodev_read,     /* read   */
   cryptodev_write,    /* write  */
   0,                  /* seek   */
@@ -98,6 +144,356 @@ static const struct file_operations g_cryptodevops =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cryptodev_semtake
+ ****************************************************************************/
+
+static void cryptodev_semtake(FAR sem_t *sem)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait(sem);
+
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+/****************************************************************************
+ * Name: cryptodev_free_session
+ ****************************************************************************/
+
+static void cryptodev_free_session(FAR struct cryptodev_session_s *session)
+{
+  /* Do not leave the key behind in the heap */
+
+  memset(session, 0, sizeof(struct cryptodev_session_s));
+  kmm_free(session);
+}
+
+/****************************************************************************
+ * Name: cryptodev_find_session
+ *
+ * Description:
+ *   Find the session with ID 'ses'.  The caller holds the lock.
+ *
+ ****************************************************************************/
+
+static FAR struct cryptodev_session_s *
+cryptodev_find_session(FAR struct cryptodev_fcrypt_s *fcr, uint32_t ses)
+{
+  FAR sq_entry_t *entry;
+
+  for (entry = sq_peek(&fcr->sessions); entry != NULL; entry = sq_next(entry))
+    {
+      FAR struct cryptodev_session_s *session =
+        (FAR struct cryptodev_session_s *)entry;
+
+      if (session->ses == ses)
+        {
+          return session;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: cryptodev_new_session
+ *
+ * Description:
+ *   Handle CIOCGSESSION.  The key is copied (and, for the software
+ *   library, expanded) once here rather than for every operation.
+ *
+ ****************************************************************************/
+
+static int cryptodev_new_session(FAR struct cryptodev_fcrypt_s *fcr,
+                                 FAR struct session_op *sop)
+{
+  FAR struct cryptodev_session_s *session;
+#ifdef CONFIG_CRYPTO_SW_AES
+  int ret;
+#endif
+
+  switch (sop->cipher)
+    {
+#ifdef CRYPTODEV_HAVE_AES
+      case CRYPTO_AES_ECB:
+      case CRYPTO_AES_CBC:
+      case CRYPTO_AES_CTR:
+        break;
+#endif
+
+#ifdef CONFIG_CRYPTO_SW_AES
+      case CRYPTO_AES_GCM:
+        break;
+#endif
+
+      default:
+        return -EINVAL;
+    }
+
+  if (sop->keylen == 0 || sop->keylen > CRYPTODEV_MAXKEY ||
+      sop->key == NULL)
+    {
+      return -EINVAL;
+    }
+
+  session = (FAR struct cryptodev_session_s *)
+    kmm_zalloc(sizeof(struct cryptodev_session_s));
+  if (session == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  session->cipher = sop->cipher;
+  session->keylen = sop->keylen;
+  memcpy(session->key, sop->key, sop->keylen);
+
+#ifdef CONFIG_CRYPTO_SW_AES
+#ifndef CRYPTODEV_SW_CIPHER
+  if (session->cipher == CRYPTO_AES_GCM)
+#endif
+    {
+      ret = aes_setupkey(&session->aes, session->key, session->keylen);
+      if (ret < 0)
+        {
+          cryptodev_free_session(session);
+          return ret;
+        }
+    }
+#endif
+
+  /* Assign a non-zero session ID that is not in use */
+
+  do
+    {
+      if (++fcr->nextses == 0)
+        {
+          fcr->nextses = 1;
+        }
+    }
+  while (cryptodev_find_session(fcr, fcr->nextses) != NULL);
+
+  session->ses = fcr->nextses;
+  sq_addlast((FAR sq_entry_t *)session, &fcr->sessions);
+
+  sop->ses = session->ses;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cryptodev_crypt
+ *
+ * Description:
+ *   Perform one CIOCCRYPT operation.  The caller holds the lock.
+ *
+ ****************************************************************************/
+
+#ifdef CRYPTODEV_HAVE_AES
+static int cryptodev_crypt(FAR struct cryptodev_fcrypt_s *fcr,
+                           FAR struct crypt_op *op)
+{
+  FAR struct cryptodev_session_s *session;
+#ifdef CRYPTODEV_SW_CIPHER
+  uint8_t iv[AES_BLOCK_SIZE];
+#else
+  int mode;
+#endif
+  int encrypt;
+
+  session = cryptodev_find_session(fcr, op->ses);
+  if (session == NULL)
+    {
+      return -EINVAL;
+    }
+
+  switch (op->op)
+    {
+    case COP_ENCRYPT:
+      encrypt = 1;
+      break;
+
+    case COP_DECRYPT:
+      encrypt = 0;
+      break;
+
+    default:
+      return -EINVAL;
+    }
+
+#ifdef CRYPTODEV_SW_CIPHER
+  if (session->cipher != CRYPTO_AES_CTR && (op->len % AES_BLOCK_SIZE) != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (session->cipher != CRYPTO_AES_ECB)
+    {
+      if (op->iv == NULL)
+        {
+          return -EINVAL;
+        }
+
+      memcpy(iv, op->iv, AES_BLOCK_SIZE);
+    }
+
+  switch (session->cipher)
+    {
+    case CRYPTO_AES_ECB:
+      if (op->dst != op->src)
+        {
+          memcpy(op->dst, op->src, op->len);
+        }
+
+      if (encrypt)
+        {
+          aes_encipher(&session->aes, (FAR uint8_t *)op->dst,
+                       op->len / AES_BLOCK_SIZE);
+        }
+      else
+        {
+          aes_decipher(&session->aes, (FAR uint8_t *)op->dst,
+                       op->len / AES_BLOCK_SIZE);
+        }
+
+      return OK;
+
+    case CRYPTO_AES_CBC:
+      if (encrypt)
+        {
+          aes_cbc_encrypt(&session->aes, iv, (FAR const uint8_t *)op->src,
+                          (FAR uint8_t *)op->dst, op->len / AES_BLOCK_SIZE);
+        }
+      else
+        {
+          aes_cbc_decrypt(&session->aes, iv, (FAR const uint8_t *)op->src,
+                          (FAR uint8_t *)op->dst, op->len / AES_BLOCK_SIZE);
+        }
+
+      return OK;
+
+    case CRYPTO_AES_CTR:
+      aes_ctr_crypt(&session->aes, iv, (FAR const uint8_t *)op->src,
+                    (FAR uint8_t *)op->dst, op->len);
+      return OK;
+
+    default:
+      return -EINVAL;
+    }
+#else
+  switch (session->cipher)
+    {
+    case CRYPTO_AES_ECB:
+      mode = AES_MODE_ECB;
+      break;
+
+    case CRYPTO_AES_CBC:
+      mode = AES_MODE_CBC;
+      break;
+
+    case CRYPTO_AES_CTR:
+      mode = AES_MODE_CTR;
+      break;
+
+    default:
+      return -EINVAL;
+    }
+
+  return aes_cypher(op->dst, op->src, op->len, op->iv, session->key,
+                    session->keylen, mode, encrypt);
+#endif
+}
+#endif /* CRYPTODEV_HAVE_AES */
+
+/****************************************************************************
+ * Name: cryptodev_authcrypt
+ *
+ * Description:
+ *   Perform one CIOCAUTHCRYPT operation.  The caller holds the lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CRYPTO_SW_AES
+static int cryptodev_authcrypt(FAR struct cryptodev_fcrypt_s *fcr,
+                               FAR struct crypt_auth_op *op)
+{
+  FAR struct cryptodev_session_s *session;
+
+  session = cryptodev_find_session(fcr, op->ses);
+  if (session == NULL || session->cipher != CRYPTO_AES_GCM ||
+      op->iv == NULL || op->tag == NULL)
+    {
+      return -EINVAL;
+    }
+
+  switch (op->op)
+    {
+    case COP_ENCRYPT:
+      return aes_gcm_encrypt(&session->aes, (FAR const uint8_t *)op->iv,
+                             op->iv_len, (FAR const uint8_t *)op->auth_src,
+                             op->auth_len, (FAR const uint8_t *)op->src,
+                             (FAR uint8_t *)op->dst, op->len,
+                             (FAR uint8_t *)op->tag, op->tag_len);
+
+    case COP_DECRYPT:
+      return aes_gcm_decrypt(&session->aes, (FAR const uint8_t *)op->iv,
+                             op->iv_len, (FAR const uint8_t *)op->auth_src,
+                             op->auth_len, (FAR const uint8_t *)op->src,
+                             (FAR uint8_t *)op->dst, op->len,
+                             (FAR const uint8_t *)op->tag, op->tag_len);
+
+    default:
+      return -EINVAL;
+    }
+}
+#endif
+
+static int cryptodev_open(FAR struct file *filep)
+{
+  FAR struct cryptodev_fcrypt_s *fcr;
+
+  fcr = (FAR struct cryptodev_fcrypt_s *)
+    kmm_zalloc(sizeof(struct cryptodev_fcrypt_s));
+  if (fcr == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxsem_init(&fcr->lock, 0, 1);
+  sq_init(&fcr->sessions);
+
+  filep->f_priv = fcr;
+  return OK;
+}
+
+static int cryptodev_close(FAR struct file *filep)
+{
+  FAR struct cryptodev_fcrypt_s *fcr = filep->f_priv;
+  FAR sq_entry_t *entry;
+
+  DEBUGASSERT(fcr != NULL);
+
+  while ((entry = sq_remfirst(&fcr->sessions)) != NULL)
+    {
+      cryptodev_free_session((FAR struct cryptodev_session_s *)entry);
+    }
+
+  nxsem_destroy(&fcr->lock);
+  kmm_free(fcr);
+
+  filep->f_priv = NULL;
+  return OK;
+}
+
 static ssize_t cryptodev_read(FAR struct file *filep, FAR char *buffer,
                               size_t len)
 {
@@ -112,61 +508,80 @@ static ssize_t cryptodev_write(FAR struct file *filep, FAR const char *buffer,
 
 static int cryptodev_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
+  FAR struct cryptodev_fcrypt_s *fcr = filep->f_priv;
+  int ret;
+
+  DEBUGASSERT(fcr != NULL);
+  cryptodev_semtake(&fcr->lock);
+
   switch (cmd)
   {
   case CIOCGSESSION:
     {
-      FAR struct session_op *ses = (FAR struct session_op *)arg;
-      ses->ses = (uint32_t)ses;
-      return OK;
+      FAR struct session_op *sop = (FAR struct session_op *)arg;
+      ret = cryptodev_new_session(fcr, sop);
     }
+    break;
 
   case CIOCFSESSION:
     {
-      return OK;
+      FAR struct cryptodev_session_s *session;
+
+      session = cryptodev_find_session(fcr, *(FAR uint32_t *)arg);
+      if (session == NULL)
+        {
+          ret = -EINVAL;
+          break;
+        }
+
+      sq_rem((FAR sq_entry_t *)session, &fcr->sessions);
+      cryptodev_free_session(session);
+      ret = OK;
     }
+    break;
 
-#ifdef CONFIG_CRYPTO_AES
+#ifdef CRYPTODEV_HAVE_AES
   case CIOCCRYPT:
     {
-      FAR struct crypt_op *op    = (FAR struct crypt_op *)arg;
-      FAR struct session_op *ses = (FAR struct session_op *)op->ses;
-      int encrypt;
+      ret = cryptodev_crypt(fcr, (FAR struct crypt_op *)arg);
+    }
+    break;
 
-      switch (op->op)
-        {
-        case COP_ENCRYPT:
-          encrypt = 1;
-          break;
+  case CIOCCRYPTM:
+    {
+      /* Perform a batch of operations with one call */
 
-        case COP_DECRYPT:
-          encrypt = 0;
-          break;
+      FAR struct crypt_mop *mop = (FAR struct crypt_mop *)arg;
+      unsigned i;
 
-        default:
-          return -EINVAL;
+      for (i = 0, ret = OK; i < mop->count && ret >= 0; i++)
+        {
+          ret = cryptodev_crypt(fcr, &mop->reqs[i]);
         }
 
-      switch (ses->cipher)
+      if (ret < 0)
         {
-        case CRYPTO_AES_ECB:
-          return AES_CYPHER(AES_MODE_ECB);
-
-        case CRYPTO_AES_CBC:
-          return AES_CYPHER(AES_MODE_CBC);
-
-        case CRYPTO_AES_CTR:
-          return AES_CYPHER(AES_MODE_CTR);
-
-        default:
-           return -EINVAL;
+          mop->count = i - 1;
         }
     }
+    break;
+#endif
+
+#ifdef CONFIG_CRYPTO_SW_AES
+  case CIOCAUTHCRYPT:
+    {
+      ret = cryptodev_authcrypt(fcr, (FAR struct crypt_auth_op *)arg);
+    }
+    break;
 #endif
 
   default:
-    return -ENOTTY;
+    ret = -ENOTTY;
+    break;
   }
+
+  nxsem_post(&fcr->lock);
+  return ret;
 }
 
 /****************************************************************************
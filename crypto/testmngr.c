@@ -44,11 +44,14 @@
 #include <string.h>
 #include <poll.h>
 #include <errno.h>
+#include <syslog.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/crypto/crypto.h>
+#include <nuttx/crypto/aes.h>
 
 #ifdef CONFIG_CRYPTO_ALGTEST
 
@@ -62,12 +65,15 @@
 #  define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 #endif
 
-#if defined(CONFIG_CRYPTO_AES)
+#define BENCH_BUFSIZE  4096
+#define BENCH_MSEC     500
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if defined(CONFIG_CRYPTO_AES)
+
 static int do_test_aes(FAR struct cipher_testvec *test, int mode, int encrypt)
 {
   FAR void *out = kmm_zalloc(test->rlen);
@@ -121,6 +127,170 @@ static int test_aes(void)
 }
 #endif
 
+#if defined(CONFIG_CRYPTO_SW_AES)
+static int do_test_aes_gcm(FAR struct aead_testvec *test)
+{
+  struct aes_state_s state;
+  uint8_t tag[AES_BLOCK_SIZE];
+  FAR uint8_t *out;
+  int res;
+
+  out = kmm_zalloc(test->ilen);
+  if (out == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  res = aes_setupkey(&state, (FAR const uint8_t *)test->key, test->klen);
+  if (res == OK)
+    {
+      res = aes_gcm_encrypt(&state, (FAR const uint8_t *)test->iv,
+                            test->ivlen, (FAR const uint8_t *)test->assoc,
+                            test->alen, (FAR const uint8_t *)test->input,
+                            out, test->ilen, tag, test->tlen);
+    }
+
+  if (res == OK)
+    {
+      res = memcmp(out, test->result, test->ilen) ||
+            memcmp(tag, test->tag, test->tlen);
+    }
+
+  /* Decrypt in place and verify the tag */
+
+  if (res == OK)
+    {
+      res = aes_gcm_decrypt(&state, (FAR const uint8_t *)test->iv,
+                            test->ivlen, (FAR const uint8_t *)test->assoc,
+                            test->alen, out, out, test->ilen, tag,
+                            test->tlen);
+    }
+
+  if (res == OK)
+    {
+      res = memcmp(out, test->input, test->ilen);
+    }
+
+  /* A modified tag must be rejected */
+
+  if (res == OK)
+    {
+      tag[0] ^= 1;
+      if (aes_gcm_decrypt(&state, (FAR const uint8_t *)test->iv,
+                          test->ivlen, (FAR const uint8_t *)test->assoc,
+                          test->alen, (FAR const uint8_t *)test->result,
+                          out, test->ilen, tag, test->tlen) != -EBADMSG)
+        {
+          res = -1;
+        }
+    }
+
+  kmm_free(out);
+  return res;
+}
+
+static int test_aes_gcm(void)
+{
+  int i;
+
+  for (i = 0; i < ARRAY_SIZE(aes_gcm_tv_template); i++)
+    {
+      if (do_test_aes_gcm(aes_gcm_tv_template + i))
+        {
+          crypterr("ERROR: Failed GCM test #%i\n", i);
+          return -1;
+        }
+    }
+
+  return OK;
+}
+#endif
+
+#if defined(CONFIG_CRYPTO_ALGTEST_BENCHMARK)
+/****************************************************************************
+ * Name: bench_aes
+ *
+ * Description:
+ *   Report the throughput of the software AES library in each mode with a
+ *   128-bit key.  Each mode processes a BENCH_BUFSIZE buffer repeatedly for
+ *   at least BENCH_MSEC milliseconds.
+ *
+ ****************************************************************************/
+
+static void bench_aes(void)
+{
+  static const char * const modes[] =
+  {
+    "ECB", "CBC encrypt", "CBC decrypt", "CTR", "GCM encrypt"
+  };
+
+  struct aes_state_s state;
+  uint8_t key[AES128_KEY_SIZE];
+  uint8_t iv[AES_BLOCK_SIZE];
+  uint8_t tag[AES_BLOCK_SIZE];
+  FAR uint8_t *buffer;
+  clock_t start;
+  clock_t elapsed;
+  uint32_t nbytes;
+  int mode;
+
+  buffer = kmm_zalloc(BENCH_BUFSIZE);
+  if (buffer == NULL)
+    {
+      return;
+    }
+
+  memset(key, 0x5a, AES128_KEY_SIZE);
+  memset(iv, 0xa5, AES_BLOCK_SIZE);
+  aes_setupkey(&state, key, AES128_KEY_SIZE);
+
+  for (mode = 0; mode < ARRAY_SIZE(modes); mode++)
+    {
+      nbytes = 0;
+      start  = clock_systimer();
+
+      do
+        {
+          switch (mode)
+            {
+              case 0:
+                aes_encipher(&state, buffer, BENCH_BUFSIZE / AES_BLOCK_SIZE);
+                break;
+
+              case 1:
+                aes_cbc_encrypt(&state, iv, buffer, buffer,
+                                BENCH_BUFSIZE / AES_BLOCK_SIZE);
+                break;
+
+              case 2:
+                aes_cbc_decrypt(&state, iv, buffer, buffer,
+                                BENCH_BUFSIZE / AES_BLOCK_SIZE);
+                break;
+
+              case 3:
+                aes_ctr_crypt(&state, iv, buffer, buffer, BENCH_BUFSIZE);
+                break;
+
+              default:
+                aes_gcm_encrypt(&state, iv, 12, NULL, 0, buffer, buffer,
+                                BENCH_BUFSIZE, tag, AES_BLOCK_SIZE);
+                break;
+            }
+
+          nbytes += BENCH_BUFSIZE;
+          elapsed = clock_systimer() - start;
+        }
+      while (elapsed < MSEC2TICK(BENCH_MSEC));
+
+      syslog(LOG_INFO, "AES-128 %s: %lu KiB/s\n", modes[mode],
+             (unsigned long)((uint64_t)nbytes * 1000 /
+                             (TICK2MSEC(elapsed) * 1024)));
+    }
+
+  kmm_free(buffer);
+}
+#endif
+
 int crypto_test(void)
 {
 #if defined(CONFIG_CRYPTO_AES)
@@ -130,6 +300,17 @@ int crypto_test(void)
     }
 #endif
 
+#if defined(CONFIG_CRYPTO_SW_AES)
+  if (test_aes_gcm())
+    {
+      return -1;
+    }
+#endif
+
+#if defined(CONFIG_CRYPTO_ALGTEST_BENCHMARK)
+  bench_aes();
+#endif
+
   return OK;
 }
 
@@ -472,7 +472,7 @@ static void adc_pollnotify(FAR struct adc_dev_s *dev, uint32_t type)
       if (fds)
         {
           fds->revents |= type;
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
     }
 }
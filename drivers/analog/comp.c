@@ -138,7 +138,7 @@ static void comp_pollnotify(FAR struct comp_dev_s *dev,
           if (fds->revents != 0)
             {
               ainfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_post(fds);
             }
         }
     }
@@ -47,6 +47,7 @@
 #include <stdbool.h>
 #include <semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/drivers/drivers.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -55,10 +56,30 @@
 #define bchlib_semgive(d) nxsem_post(&(d)->sem)  /* To match bchlib_semtake */
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+#ifdef CONFIG_BCH_CACHE
+#  if CONFIG_BCH_CACHE_READAHEAD >= CONFIG_BCH_CACHE_NSECTORS
+#    error CONFIG_BCH_CACHE_READAHEAD must be less than CONFIG_BCH_CACHE_NSECTORS
+#  endif
+#  define BCH_NSLOTS      CONFIG_BCH_CACHE_NSECTORS
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_BCH_CACHE
+/* One sector of the cache.  The slot that is the current sector buffer is
+ * described by the sector and dirty fields of struct bchlib_s instead;
+ * the slot is brought up to date when another slot is selected.
+ */
+
+struct bchlib_slot_s
+{
+  size_t sector;           /* The sector in the slot ((size_t)-1: none) */
+  bool dirty;              /* true: The slot must be written back */
+};
+#endif
+
 struct bchlib_s
 {
   FAR struct inode *inode; /* I-node of the block driver */
@@ -72,6 +93,15 @@ struct bchlib_s
   bool unlinked;           /* true: The driver has been unlinked */
   FAR uint8_t *buffer;     /* One sector buffer */
 
+#ifdef CONFIG_BCH_CACHE
+  FAR uint8_t *cache;      /* BCH_NSLOTS sector buffers; buffer is one of them */
+  size_t nextsector;       /* The sector that a sequential read would access */
+  uint8_t current;         /* The slot that is buffer */
+  uint8_t next;            /* The next slot to be replaced */
+  struct bch_cachestats_s stats;
+  struct bchlib_slot_s slot[BCH_NSLOTS];
+#endif
+
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
 #endif
@@ -98,6 +128,13 @@ EXTERN const struct file_operations bch_fops;
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+#ifdef CONFIG_BCH_CACHE
+EXTERN void bchlib_cacheinit(FAR struct bchlib_s *bch);
+EXTERN void bchlib_cacheoverlay(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                                size_t sector, size_t nsectors);
+EXTERN void bchlib_cacheinvalidate(FAR struct bchlib_s *bch, size_t sector,
+                                   size_t nsectors);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -41,6 +41,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -74,10 +75,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, FAR uint8_t *sectbuf,
+                      size_t sector, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)sectbuf;
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -85,7 +87,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -103,62 +105,313 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 }
 #endif
 
+/****************************************************************************
+ * Name: bch_writesectors
+ *
+ * Description:
+ *   Write consecutive sectors from consecutive sector buffers to the media,
+ *   encrypting them as necessary.
+ *
+ ****************************************************************************/
+
+static int bch_writesectors(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                            size_t sector, size_t nsectors)
+{
+  FAR struct inode *inode = bch->inode;
+  ssize_t ret;
+#if defined(CONFIG_BCH_ENCRYPTION)
+  size_t i;
+
+  /* Encrypt data as necessary */
+
+  for (i = 0; i < nsectors; i++)
+    {
+      bch_cypher(bch, buffer + i * bch->sectsize, sector + i,
+                 CYPHER_ENCRYPT);
+    }
+#endif
+
+  /* Write the sectors to the media */
+
+  ret = inode->u.i_bops->write(inode, buffer, sector, nsectors);
+  if (ret < 0)
+    {
+      ferr("Write failed: %d\n", (int)ret);
+    }
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+  /* Computation overhead to save memory for extra sector buffer
+   * TODO: Add configuration switch for extra sector buffer
+   */
+
+  for (i = 0; i < nsectors; i++)
+    {
+      bch_cypher(bch, buffer + i * bch->sectsize, sector + i,
+                 CYPHER_DECRYPT);
+    }
+#endif
+
+#ifdef CONFIG_BCH_CACHE
+  bch->stats.writes++;
+  bch->stats.wsectors += nsectors;
+#endif
+
+  return ret < 0 ? (int)ret : OK;
+}
+
+#ifdef CONFIG_BCH_CACHE
+/****************************************************************************
+ * Name: bch_slotbuffer
+ ****************************************************************************/
+
+static inline FAR uint8_t *bch_slotbuffer(FAR struct bchlib_s *bch, int ndx)
+{
+  return bch->cache + ndx * bch->sectsize;
+}
+
+/****************************************************************************
+ * Name: bch_park
+ *
+ * Description:
+ *   Save the state of the current slot in the slot itself.
+ *
+ ****************************************************************************/
+
+static void bch_park(FAR struct bchlib_s *bch)
+{
+  bch->slot[bch->current].sector = bch->sector;
+  bch->slot[bch->current].dirty  = bch->dirty;
+}
+
+/****************************************************************************
+ * Name: bch_select
+ *
+ * Description:
+ *   Make a slot the current sector buffer.  The current slot must have
+ *   been parked by the caller.
+ *
+ ****************************************************************************/
+
+static void bch_select(FAR struct bchlib_s *bch, int ndx)
+{
+  bch->current = ndx;
+  bch->buffer  = bch_slotbuffer(bch, ndx);
+  bch->sector  = bch->slot[ndx].sector;
+  bch->dirty   = bch->slot[ndx].dirty;
+}
+
+/****************************************************************************
+ * Name: bch_find
+ *
+ * Description:
+ *   Return the slot holding a sector or -1 if the sector is not cached.
+ *   The current slot must have been parked by the caller.
+ *
+ ****************************************************************************/
+
+static int bch_find(FAR struct bchlib_s *bch, size_t sector)
+{
+  int i;
+
+  for (i = 0; i < BCH_NSLOTS; i++)
+    {
+      if (bch->slot[i].sector == sector)
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: bch_flushslots
+ *
+ * Description:
+ *   Write back the dirty slots among the nslots slots beginning with slot
+ *   first.  A dirty slot that is followed by dirty slots holding the
+ *   following sectors is written together with them in one request, even
+ *   if those slots are beyond the range:  Sequentially written sectors
+ *   occupy consecutive slots and would be written back next anyway.
+ *
+ ****************************************************************************/
+
+static int bch_flushslots(FAR struct bchlib_s *bch, int first, int nslots)
+{
+  int last = first + nslots;
+  int ret;
+  int i;
+  int j;
+
+  for (i = first; i < last; i = j)
+    {
+      j = i + 1;
+      if (!bch->slot[i].dirty)
+        {
+          continue;
+        }
+
+      while (j < BCH_NSLOTS && bch->slot[j].dirty &&
+             bch->slot[j].sector == bch->slot[j - 1].sector + 1)
+        {
+          j++;
+        }
+
+      ret = bch_writesectors(bch, bch_slotbuffer(bch, i),
+                             bch->slot[i].sector, j - i);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      while (i < j)
+        {
+          bch->slot[i++].dirty = false;
+        }
+    }
+
+  return OK;
+}
+#endif /* CONFIG_BCH_CACHE */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_BCH_CACHE
 /****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bchlib_cacheinit
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Set up the (empty) cache.  bch->cache must hold BCH_NSLOTS sector
+ *   buffers.
+ *
+ ****************************************************************************/
+
+void bchlib_cacheinit(FAR struct bchlib_s *bch)
+{
+  int i;
+
+  for (i = 0; i < BCH_NSLOTS; i++)
+    {
+      bch->slot[i].sector = (size_t)-1;
+      bch->slot[i].dirty  = false;
+    }
+
+  memset(&bch->stats, 0, sizeof(struct bch_cachestats_s));
+  bch->stats.nsectors = BCH_NSLOTS;
+  bch->nextsector     = (size_t)-1;
+  bch->next           = 0;
+
+  bch_select(bch, 0);
+}
+
+/****************************************************************************
+ * Name: bchlib_cacheoverlay
+ *
+ * Description:
+ *   Sectors read directly from the media into a user buffer may be stale
+ *   if they are modified in the cache.  Copy the modified sectors over the
+ *   data read.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
  *
  ****************************************************************************/
 
-int bchlib_flushsector(FAR struct bchlib_s *bch)
+void bchlib_cacheoverlay(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                         size_t sector, size_t nsectors)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
+  FAR struct bchlib_slot_s *slot;
+  int i;
 
-  /* Check if the sector has been modified and is out of synch with the
-   * media.
-   */
+  bch_park(bch);
 
-  if (bch->dirty)
+  for (i = 0; i < BCH_NSLOTS; i++)
     {
-      inode = bch->inode;
+      slot = &bch->slot[i];
+      if (slot->dirty && slot->sector >= sector &&
+          slot->sector < sector + nsectors)
+        {
+          memcpy(buffer + (slot->sector - sector) * bch->sectsize,
+                 bch_slotbuffer(bch, i), bch->sectsize);
+        }
+    }
+}
 
-#if defined(CONFIG_BCH_ENCRYPTION)
-      /* Encrypt data as necessary */
+/****************************************************************************
+ * Name: bchlib_cacheinvalidate
+ *
+ * Description:
+ *   Discard the cached copies of sectors that were written directly to the
+ *   media from a user buffer.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
-#endif
+void bchlib_cacheinvalidate(FAR struct bchlib_s *bch, size_t sector,
+                            size_t nsectors)
+{
+  FAR struct bchlib_slot_s *slot;
+  int i;
 
-      /* Write the sector to the media */
+  bch_park(bch);
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
+  for (i = 0; i < BCH_NSLOTS; i++)
+    {
+      slot = &bch->slot[i];
+      if (slot->sector >= sector && slot->sector < sector + nsectors)
         {
-          ferr("Write failed: %d\n");
+          slot->sector = (size_t)-1;
+          slot->dirty  = false;
         }
+    }
 
-#if defined(CONFIG_BCH_ENCRYPTION)
-      /* Computation overhead to save memory for extra sector buffer
-       * TODO: Add configuration switch for extra sector buffer
-       */
+  bch_select(bch, bch->current);
+}
+#endif /* CONFIG_BCH_CACHE */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
-#endif
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush the current contents of the sector buffer (if dirty).  With
+ *   CONFIG_BCH_CACHE, all dirty sectors in the cache are flushed.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushsector(FAR struct bchlib_s *bch)
+{
+#ifdef CONFIG_BCH_CACHE
+  int ret;
+
+  bch_park(bch);
+  ret = bch_flushslots(bch, 0, BCH_NSLOTS);
+  bch->dirty = bch->slot[bch->current].dirty;
+  return ret;
+#else
+  int ret = OK;
+
+  /* Check if the sector has been modified and is out of synch with the
+   * media.
+   */
+
+  if (bch->dirty)
+    {
+      ret = bch_writesectors(bch, bch->buffer, bch->sector, 1);
 
       /* The sector is now in sync with the media */
 
       bch->dirty = false;
     }
 
-  return (int)ret;
+  return ret;
+#endif
 }
 
 /****************************************************************************
@@ -176,6 +429,116 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
   FAR struct inode *inode;
   ssize_t ret = OK;
+#ifdef CONFIG_BCH_CACHE
+  size_t nsectors;
+  size_t i;
+  int ndx;
+
+  if (bch->sector == sector)
+    {
+      bch->stats.hits++;
+      return OK;
+    }
+
+  /* Is the sector in some other slot? */
+
+  bch_park(bch);
+
+  ndx = bch_find(bch, sector);
+  if (ndx >= 0)
+    {
+      bch_select(bch, ndx);
+      bch->stats.hits++;
+      return OK;
+    }
+
+  /* No.. If this continues a sequential read, then read ahead into the
+   * following slots as well.  Read-ahead stops at the end of the slots, at
+   * the end of the media and at the first sector that is already cached.
+   */
+
+  nsectors = 1;
+  if (sector == bch->nextsector)
+    {
+      nsectors += CONFIG_BCH_CACHE_READAHEAD;
+      if (nsectors > BCH_NSLOTS - bch->next)
+        {
+          nsectors = BCH_NSLOTS - bch->next;
+        }
+
+      if (nsectors > bch->nsectors - sector)
+        {
+          nsectors = bch->nsectors - sector;
+        }
+
+      for (i = 1; i < nsectors; i++)
+        {
+          if (bch_find(bch, sector + i) >= 0)
+            {
+              nsectors = i;
+              break;
+            }
+        }
+    }
+
+  /* Write back the slots that will be replaced */
+
+  ndx = bch->next;
+  ret = bch_flushslots(bch, ndx, nsectors);
+  if (ret < 0)
+    {
+      return (int)ret;
+    }
+
+  for (i = 0; i < nsectors; i++)
+    {
+      bch->slot[ndx + i].sector = (size_t)-1;
+    }
+
+  inode = bch->inode;
+  ret   = inode->u.i_bops->read(inode, bch_slotbuffer(bch, ndx), sector,
+                                nsectors);
+  if (ret < 0)
+    {
+      /* Keep the current slot (it may no longer hold a sector) */
+
+      ferr("Read failed: %d\n", (int)ret);
+      bch_select(bch, bch->current);
+      return (int)ret;
+    }
+  else if (ret == 0)
+    {
+      ferr("Read failed: no sectors\n");
+      bch_select(bch, bch->current);
+      return -EIO;
+    }
+
+  /* The driver may read fewer sectors than requested.  Only the sectors
+   * actually read are valid; the remaining slots stay invalid.
+   */
+
+  if ((size_t)ret < nsectors)
+    {
+      nsectors = (size_t)ret;
+    }
+
+  for (i = 0; i < nsectors; i++)
+    {
+      bch->slot[ndx + i].sector = sector + i;
+#if defined(CONFIG_BCH_ENCRYPTION)
+      bch_cypher(bch, bch_slotbuffer(bch, ndx + i), sector + i,
+                 CYPHER_DECRYPT);
+#endif
+    }
+
+  bch->stats.misses++;
+  bch->stats.rasectors += nsectors - 1;
+  bch->nextsector       = sector + nsectors;
+  bch->next             = (ndx + nsectors) % BCH_NSLOTS;
+
+  bch_select(bch, ndx);
+  return OK;
+#else
 
   if (bch->sector != sector)
     {
@@ -191,9 +554,9 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
         }
       bch->sector = sector;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, bch->buffer, sector, CYPHER_DECRYPT);
 #endif
     }
   return (int)ret;
+#endif
 }
-
@@ -162,6 +162,12 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
           return ret;
         }
 
+#ifdef CONFIG_BCH_CACHE
+      /* Some of the sectors may have been modified in the cache */
+
+      bchlib_cacheoverlay(bch, (FAR uint8_t *)buffer, sector, nsectors);
+#endif
+
       /* Adjust pointers and counts */
 
       sector    += nsectors;
@@ -124,6 +124,19 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
   bch->sector   = (size_t)-1;
   bch->readonly = readonly;
 
+#ifdef CONFIG_BCH_CACHE
+  /* Allocate the sector cache */
+
+  bch->cache = (FAR uint8_t *)kmm_malloc(BCH_NSLOTS * bch->sectsize);
+  if (!bch->cache)
+    {
+      ferr("ERROR: Failed to allocate sector cache\n");
+      ret = -ENOMEM;
+      goto errout_with_bch;
+    }
+
+  bchlib_cacheinit(bch);
+#else
   /* Allocate the sector I/O buffer */
 
   bch->buffer = (FAR uint8_t *)kmm_malloc(bch->sectsize);
@@ -133,6 +146,7 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
       ret = -ENOMEM;
       goto errout_with_bch;
     }
+#endif
 
   *handle = bch;
   return OK;
@@ -151,6 +151,12 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           return ret;
         }
 
+#ifdef CONFIG_BCH_CACHE
+      /* Any cached copies of these sectors are now stale */
+
+      bchlib_cacheinvalidate(bch, sector, nsectors);
+#endif
+
       /* Adjust pointers and counts */
 
       sector       += nsectors;
@@ -184,7 +190,11 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
       byteswritten += len;
     }
 
-  /* Finally, flush any cached writes to the device as well */
+#ifndef CONFIG_BCH_CACHE
+  /* Finally, flush any cached writes to the device as well.  The sector
+   * cache, on the other hand, writes back modified sectors when they are
+   * replaced, when the device is closed or on BIOC_FLUSH.
+   */
 
   ret = bchlib_flushsector(bch);
   if (ret < 0)
@@ -192,6 +202,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
       ferr("ERROR: Flush failed: %d\n", ret);
       return ret;
     }
+#endif
 
   return byteswritten;
 }
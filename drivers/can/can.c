@@ -220,7 +220,7 @@ static void can_pollnotify(FAR struct can_dev_s *dev, pollevent_t eventset)
           if (fds->revents != 0)
             {
               caninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_post(fds);
             }
         }
     }
@@ -258,7 +258,7 @@ static void ft5x06_notify(FAR struct ft5x06_dev_s *priv)
         {
           fds->revents |= POLLIN;
           iinfo("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
     }
 #endif
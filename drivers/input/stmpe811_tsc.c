@@ -198,7 +198,7 @@ static void stmpe811_notify(FAR struct stmpe811_dev_s *priv)
         {
           fds->revents |= POLLIN;
           iinfo("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
     }
 #endif
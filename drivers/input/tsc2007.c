@@ -281,7 +281,7 @@ static void tsc2007_notify(FAR struct tsc2007_dev_s *priv)
         {
           fds->revents |= POLLIN;
           iinfo("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
     }
 #endif
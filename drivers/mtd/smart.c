@@ -110,6 +110,7 @@
 #define SMART_FMT_VERSION_POS     (SMART_FMT_POS1 + 4)
 #define SMART_FMT_NAMESIZE_POS    (SMART_FMT_POS1 + 5)
 #define SMART_FMT_ROOTDIRS_POS    (SMART_FMT_POS1 + 6)
+#define SMART_FMT_CPBLOCKS_POS    (SMART_FMT_POS1 + 7)
 #define SMARTFS_FMT_WEAR_POS      36
 #define SMART_WEAR_LEVEL_FORMAT_SIG 32
 #define SMART_PARTNAME_SIZE         4
@@ -137,6 +138,29 @@
 
 #define SMART_MAX_ALLOCS        10
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+#  define SMART_CP_MAGIC          "SMCP"
+#  define SMART_CP_VERSION        1
+#  define SMART_CP_NSLOTS         2
+
+/* Layout of a checkpoint slot:  The header, the dirty erase block bit map
+ * and a copy of the sector map followed by the release and free counts.
+ */
+
+#  define SMART_CP_BITMAP_POS     sizeof(struct smart_cphdr_s)
+#  define SMART_CP_BITMAPSIZE(d)  (((d)->neraseblocks + 7) >> 3)
+#  define SMART_CP_MAP_POS(d)     (SMART_CP_BITMAP_POS + SMART_CP_BITMAPSIZE(d))
+#  define SMART_CP_MAPSIZE(d)     ((d)->totalsectors * sizeof(uint16_t) + \
+                                   ((d)->neraseblocks << 1))
+
+/* Sectors of the last erase block that are counted as released, but do
+ * not exist, when the sector count was clipped to 65534.
+ */
+
+#  define SMART_CP_PRERELEASE(d,b) \
+     ((b) == (d)->neraseblocks - 1 && (d)->totalsectors == 65534 ? 2 : 0)
+#endif
+
 #ifndef CONFIG_MTD_SMART_ALLOC_DEBUG
 #define smart_malloc(d, b, n)   kmm_malloc(b)
 #define smart_zalloc(d, b, n)   kmm_zalloc(b)
@@ -217,6 +241,23 @@ struct smart_allocsector_s
 };
 #endif
 
+/* Header of a checkpoint slot */
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+struct smart_cphdr_s
+{
+  uint8_t               magic[4];         /* SMART_CP_MAGIC, cleared when superseded */
+  uint8_t               version;          /* Checkpoint format version */
+  uint8_t               reserved[3];
+  uint32_t              seq;              /* Incrementing checkpoint sequence number */
+  uint32_t              crc;              /* CRC-32 of the header and the sector map */
+  uint16_t              sectorsize;       /* Sector size on device */
+  uint16_t              totalsectors;     /* Total number of sectors on device */
+  uint16_t              neraseblocks;     /* Number of erase blocks holding sectors */
+  uint16_t              reserved2;
+};
+#endif
+
 struct smart_struct_s
 {
   FAR struct mtd_dev_s *mtd;              /* Contained MTD interface */
@@ -258,6 +299,16 @@ struct smart_struct_s
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
   FAR struct smart_allocsector_s  *allocsector; /* Pointer to first alloc sector */
 #endif
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  int8_t                cpslot;           /* Slot of the current checkpoint or -1 */
+  uint16_t              cpblocks;         /* Number of erase blocks per checkpoint slot */
+  uint16_t              cpdefblocks;      /* Number of erase blocks per slot when formatting */
+  uint16_t              cpfmtblocks;      /* Number of erase blocks per slot in the format */
+  uint16_t              cpndirty;         /* Erase blocks modified since the checkpoint */
+  uint32_t              cpseq;            /* Sequence number of the newest checkpoint */
+  FAR uint8_t          *cpdirty;          /* Bit map of the modified erase blocks */
+  FAR uint8_t          *cpbuffer;         /* MTD block buffer for checkpoint I/O */
+#endif
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
   FAR uint16_t         *sMap;             /* Virtual to physical sector map */
 #else
@@ -391,6 +442,19 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 static int smart_relocate_sector(FAR struct smart_struct_s *dev,
                  uint16_t oldsector, uint16_t newsector);
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int     smart_cp_touch(FAR struct smart_struct_s *dev, uint16_t block);
+static int     smart_mtderase(FAR struct smart_struct_s *dev, off_t block);
+static ssize_t smart_mtdbwrite(FAR struct smart_struct_s *dev,
+                 off_t startblock, size_t nblocks, FAR const uint8_t *buffer);
+#ifdef CONFIG_FS_WRITABLE
+static int     smart_cp_write(FAR struct smart_struct_s *dev);
+#endif
+#else
+#  define smart_mtderase(d,b)       MTD_ERASE((d)->mtd, b, 1)
+#  define smart_mtdbwrite(d,s,n,b)  MTD_BWRITE((d)->mtd, s, n, b)
+#endif
+
 #ifdef CONFIG_SMART_DEV_LOOP
 static ssize_t smart_loop_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
@@ -458,7 +522,29 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#if defined(CONFIG_MTD_SMART_FASTMOUNT) && defined(CONFIG_FS_WRITABLE)
+  FAR struct smart_struct_s *dev;
+#endif
+
   finfo("Entry\n");
+
+#if defined(CONFIG_MTD_SMART_FASTMOUNT) && defined(CONFIG_FS_WRITABLE)
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+  dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+  /* Checkpoint any changes so that the next mount does not need to scan
+   * the device.
+   */
+
+  if (dev->cpslot < 0 || dev->cpndirty > 0)
+    {
+      (void)smart_cp_write(dev);
+    }
+#endif
+
   return OK;
 }
 
@@ -910,7 +996,7 @@ static ssize_t smart_write(FAR struct inode *inode,
           /* Erase the erase block */
 
           eraseblock = alignedblock / mtdBlksPerErase;
-          ret = MTD_ERASE(dev->mtd, eraseblock, 1);
+          ret = smart_mtderase(dev, eraseblock);
           if (ret < 0)
             {
               ferr("ERROR: Erase block=%d failed: %d\n", eraseblock, ret);
@@ -937,7 +1023,7 @@ static ssize_t smart_write(FAR struct inode *inode,
       /* Try to write to the sector. */
 
       finfo("Write MTD block %d from offset %d\n", nextblock, offset);
-      nxfrd = MTD_BWRITE(dev->mtd, nextblock, blkstowrite, &buffer[offset]);
+      nxfrd = smart_mtdbwrite(dev, nextblock, blkstowrite, &buffer[offset]);
       if (nxfrd != blkstowrite)
         {
           /* The block is not empty!!  What to do? */
@@ -1321,6 +1407,14 @@ static ssize_t smart_bytewrite(FAR struct smart_struct_s *dev, size_t offset,
 {
   ssize_t       ret;
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  ret = smart_cp_touch(dev, offset / dev->geo.erasesize);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+#endif
 #ifdef CONFIG_MTD_BYTE_WRITE
   /* Check if the underlying MTD device supports write */
 
@@ -1824,20 +1918,132 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev, uint16_t block,
 #endif
 
 /****************************************************************************
- * Name: smart_scan
+ * Name: smart_scanformat
  *
- * Description: Performs a scan of the MTD device searching for format
- *              information and fills in logical sector mapping, freesector
- *              count, etc.
+ * Description: Validates the format signature in the physical sector that
+ *              holds logical sector zero and, if it is valid, marks the
+ *              volume as formatted.
+ *
+ * Returned Value:
+ *   OK if the signature is valid, -ENOENT if it is not, or a negated errno
+ *   on failure.
  *
  ****************************************************************************/
 
-static int smart_scan(FAR struct smart_struct_s *dev)
+static int smart_scanformat(FAR struct smart_struct_s *dev, uint16_t sector)
+{
+  uint32_t  readaddress;
+  int       ret;
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  int       x;
+  char      devname[22];
+  FAR struct smart_multiroot_device_s *rootdirdev;
+#endif
+
+  readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
+
+  /* Read the sector data */
+
+  ret = MTD_READ(dev->mtd, readaddress, 32,
+                 (FAR uint8_t *)dev->rwbuffer);
+  if (ret != 32)
+    {
+      ferr("ERROR: Error reading physical sector %d.\n", sector);
+      return -EIO;
+    }
+
+  /* Validate the format signature */
+
+  if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
+      dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
+      dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
+      dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
+    {
+      /* Invalid signature on a sector claiming to be sector 0!
+       * What should we do?  Release it?
+       */
+
+      return -ENOENT;
+    }
+
+  /* Mark the volume as formatted and set the sector size */
+
+  dev->formatstatus = SMART_FMT_STAT_FORMATTED;
+  dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
+  dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  /* Get the size of the checkpoint slots reserved when the volume was
+   * formatted.  This reads as zero on volumes formatted without them.
+   */
+
+  dev->cpfmtblocks =
+    (uint16_t)((uint8_t)dev->rwbuffer[SMART_FMT_CPBLOCKS_POS] ^
+               CONFIG_SMARTFS_ERASEDSTATE) |
+    (uint16_t)((uint8_t)dev->rwbuffer[SMART_FMT_CPBLOCKS_POS + 1] ^
+               CONFIG_SMARTFS_ERASEDSTATE) << 8;
+#endif
+
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
+
+  /* If rootdirentries is greater than 1, then we need to register
+   * additional block devices.
+   */
+
+  for (x = 1; x < dev->rootdirentries; x++)
+    {
+      if (dev->partname[0] != '\0')
+        {
+          snprintf(dev->rwbuffer, sizeof(devname), "/dev/smart%d%sd%d",
+                  dev->minor, dev->partname, x+1);
+        }
+      else
+        {
+          snprintf(devname, sizeof(devname), "/dev/smart%dd%d", dev->minor,
+                   x + 1);
+        }
+
+      /* Inode private data is a reference to a struct containing
+       * the SMART device structure and the root directory number.
+       */
+
+      rootdirdev = (struct smart_multiroot_device_s *)
+        smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
+      if (rootdirdev == NULL)
+        {
+          ferr("ERROR: Memory alloc failed\n");
+          return -ENOMEM;
+        }
+
+      /* Populate the rootdirdev */
+
+      rootdirdev->dev = dev;
+      rootdirdev->rootdirnum = x;
+      ret = register_blockdriver(dev->rwbuffer, &g_bops, 0, rootdirdev);
+
+      /* Inode private data is a reference to the SMART device structure */
+
+      ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smart_scansector
+ *
+ * Description: Reads the header of a physical sector and accounts for it in
+ *              the logical sector mapping and in the free and release counts
+ *              of its erase block.  Duplicate logical sectors are resolved
+ *              using the sequence numbers.
+ *
+ ****************************************************************************/
+
+static int smart_scansector(FAR struct smart_struct_s *dev, int sector)
 {
-  int       sector;
   int       ret;
-  uint16_t  totalsectors;
-  uint16_t  sectorsize, prerelease;
   uint16_t  logicalsector;
   uint16_t  loser;
   uint32_t  readaddress;
@@ -1849,10 +2055,1042 @@ static int smart_scan(FAR struct smart_struct_s *dev)
   int       dupsector;
   uint16_t  duplogsector;
 #endif
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-  int       x;
-  char      devname[22];
-  FAR struct smart_multiroot_device_s *rootdirdev;
+
+  finfo("Scan sector %d\n", sector);
+
+  /* Calculate the read address for this sector */
+
+  readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
+
+  /* Read the header for this sector */
+
+  ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
+                 (FAR uint8_t *) &header);
+  if (ret != sizeof(struct smart_sect_header_s))
+    {
+      goto err_out;
+    }
+
+  /* Get the logical sector number for this physical sector */
+
+  logicalsector = *((FAR uint16_t *) header.logicalsector);
+#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
+  if (logicalsector == 0)
+    {
+      logicalsector = -1;
+    }
+#endif
+
+  /* Test if this sector has been committed */
+
+  if ((header.status & SMART_STATUS_COMMITTED) ==
+          (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_COMMITTED))
+    {
+      return OK;
+    }
+
+  /* This block is commited, therefore not free.  Update the
+   * erase block's freecount.
+   */
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+  smart_add_count(dev, dev->freecount, sector / dev->sectorsPerBlk, -1);
+#else
+  dev->freecount[sector / dev->sectorsPerBlk]--;
+#endif
+  dev->freesectors--;
+
+  /* Test if this sector has been release and if it has,
+   * update the erase block's releasecount.
+   */
+
+  if ((header.status & SMART_STATUS_RELEASED) !=
+          (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_RELEASED))
+    {
+      /* Keep track of the total number of released sectors and
+       * released sectors per erase block.
+       */
+
+      dev->releasesectors++;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      smart_add_count(dev, dev->releasecount, sector / dev->sectorsPerBlk, 1);
+#else
+      dev->releasecount[sector / dev->sectorsPerBlk]++;
+#endif
+      return OK;
+    }
+
+  if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION)
+    {
+      return OK;
+    }
+
+  /* Validate the logical sector number is in bounds */
+
+  if (logicalsector >= dev->totalsectors)
+    {
+      /* Error in logical sector read from the MTD device */
+
+      ferr("ERROR: Invalid logical sector %d at physical %d.\n",
+           logicalsector, sector);
+      return OK;
+    }
+
+  /* If this is logical sector zero, then read in the signature
+   * information to validate the format signature.
+   */
+
+  if (logicalsector == 0)
+    {
+      ret = smart_scanformat(dev, sector);
+      if (ret == -ENOENT)
+        {
+          /* Invalid signature on a sector claiming to be sector 0!
+           * What should we do?  Release it?
+           */
+
+          return OK;
+        }
+      else if (ret < 0)
+        {
+          goto err_out;
+        }
+    }
+
+
+  /* Test for duplicate logical sectors on the device */
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+  if (dev->sMap[logicalsector] != 0xffff)
+#else
+  if (dev->sBitMap[logicalsector >> 3] & (1 << (logicalsector & 0x07)))
+#endif
+    {
+      /* Uh-oh, we found more than 1 physical sector claiming to be
+       * the same logical sector.  Use the sequence number information
+       * to resolve who wins.
+       */
+
+#if SMART_STATUS_VERSION == 1
+      if (header.status & SMART_STATUS_CRC)
+        {
+          seq2 = header.seq;
+        }
+      else
+        {
+          seq2 = *((FAR uint16_t *) &header.seq);
+        }
+#else
+      seq2 = header.seq;
+#endif
+
+      /* We must re-read the 1st physical sector to get it's seq number */
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+      readaddress = dev->sMap[logicalsector]  * dev->mtdBlksPerSector * dev->geo.blocksize;
+#else
+      /* For minimize RAM, we have to rescan to find the 1st sector claiming to
+       * be this logical sector.
+       */
+
+      for (dupsector = 0; dupsector < sector; dupsector++)
+        {
+          /* Calculate the read address for this sector */
+
+          readaddress = dupsector * dev->mtdBlksPerSector * dev->geo.blocksize;
+
+          /* Read the header for this sector */
+
+          ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
+                         (FAR uint8_t *) &header);
+          if (ret != sizeof(struct smart_sect_header_s))
+            {
+              goto err_out;
+            }
+
+          /* Get the logical sector number for this physical sector */
+
+          duplogsector = *((FAR uint16_t *) header.logicalsector);
+
+#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
+          if (duplogsector == 0)
+            {
+              duplogsector = -1;
+            }
+#endif
+
+          /* Test if this sector has been committed */
+
+          if ((header.status & SMART_STATUS_COMMITTED) ==
+                  (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_COMMITTED))
+            {
+              continue;
+            }
+
+          /* Test if this sector has been release and skip it if it has */
+
+          if ((header.status & SMART_STATUS_RELEASED) !=
+                  (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_RELEASED))
+            {
+              continue;
+            }
+
+          if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION)
+            {
+              continue;
+            }
+
+          /* Now compare if this logical sector matches the current sector */
+
+          if (duplogsector == logicalsector)
+            {
+              break;
+            }
+        }
+#endif
+
+      ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
+              (FAR uint8_t *) &header);
+      if (ret != sizeof(struct smart_sect_header_s))
+        {
+          goto err_out;
+        }
+
+#if SMART_STATUS_VERSION == 1
+      if (header.status & SMART_STATUS_CRC)
+        {
+          seq1 = header.seq;
+        }
+      else
+        {
+          seq1 = *((FAR uint16_t *) &header.seq);
+        }
+#else
+      seq1 = header.seq;
+#endif
+
+      /* Now determine who wins */
+
+      if ((seq1 > 0xfff0 && seq2 < 10) || seq2 > seq1)
+        {
+          /* Seq 2 is the winner ... bigger or it wrapped */
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+          loser = dev->sMap[logicalsector];
+          dev->sMap[logicalsector] = sector;
+#else
+          loser = dupsector;
+#endif
+        }
+      else
+        {
+          /* We keep the original mapping and seq2 is the loser */
+
+          loser = sector;
+        }
+
+      /* Now release the loser sector */
+
+      readaddress = loser  * dev->mtdBlksPerSector * dev->geo.blocksize;
+      ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
+              (FAR uint8_t *) &header);
+      if (ret != sizeof(struct smart_sect_header_s))
+        {
+          goto err_out;
+        }
+
+#if CONFIG_SMARTFS_ERASEDSTATE == 0xff
+      header.status &= ~SMART_STATUS_RELEASED;
+#else
+      header.status |= SMART_STATUS_RELEASED;
+#endif
+      offset = readaddress + offsetof(struct smart_sect_header_s, status);
+      ret = smart_bytewrite(dev, offset, 1, &header.status);
+      if (ret < 0)
+        {
+          ferr("ERROR: Error %d releasing duplicate sector\n", -ret);
+          goto err_out;
+        }
+
+      /* Account for the released sector so that the counts match what a
+       * later scan will find.
+       */
+
+      dev->releasesectors++;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      smart_add_count(dev, dev->releasecount, loser / dev->sectorsPerBlk, 1);
+#else
+      dev->releasecount[loser / dev->sectorsPerBlk]++;
+#endif
+
+      /* Keep the original mapping if this sector lost */
+
+      if (loser == sector)
+        {
+          return OK;
+        }
+    }
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+  /* Update the logical to physical sector map */
+
+  dev->sMap[logicalsector] = sector;
+#else
+  /* Mark the logical sector as used in the bitmap */
+
+  dev->sBitMap[logicalsector >> 3] |= 1 << (logicalsector & 0x07);
+
+  if (logicalsector < SMART_FIRST_ALLOC_SECTOR)
+    {
+      smart_add_sector_to_cache(dev, logicalsector, sector, __LINE__);
+    }
+#endif
+
+  return OK;
+
+err_out:
+  return ret;
+}
+
+/****************************************************************************
+ * Name: smart_cp_slotaddr
+ *
+ * Description: Returns the byte address of a checkpoint slot.  The slots
+ *              follow the erase blocks that hold sectors.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static inline uint32_t smart_cp_slotaddr(FAR struct smart_struct_s *dev,
+                                         int slot)
+{
+  return (dev->geo.neraseblocks + slot * dev->cpblocks) * dev->geo.erasesize;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_program
+ *
+ * Description: Programs a single byte of a checkpoint slot.  The read-
+ *              modify-write uses cpbuffer since rwbuffer may hold sector
+ *              data of the caller.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_program(FAR struct smart_struct_s *dev, uint32_t offset,
+                            uint8_t value)
+{
+  off_t     block;
+  ssize_t   ret;
+
+#ifdef CONFIG_MTD_BYTE_WRITE
+  if (dev->mtd->write != NULL)
+    {
+      ret = dev->mtd->write(dev->mtd, offset, 1, &value);
+      return ret < 0 ? ret : OK;
+    }
+#endif
+
+  block = offset / dev->geo.blocksize;
+  ret   = MTD_BREAD(dev->mtd, block, 1, dev->cpbuffer);
+  if (ret == 1)
+    {
+      dev->cpbuffer[offset - block * dev->geo.blocksize] = value;
+      ret = MTD_BWRITE(dev->mtd, block, 1, dev->cpbuffer);
+    }
+
+  if (ret != 1)
+    {
+      return ret < 0 ? ret : -EIO;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_invalidate
+ *
+ * Description: Clears the magic of the current checkpoint so that it is
+ *              never used again.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_invalidate(FAR struct smart_struct_s *dev)
+{
+  int ret = OK;
+
+  if (dev->cpslot >= 0)
+    {
+      ret = smart_cp_program(dev, smart_cp_slotaddr(dev, dev->cpslot),
+                             (uint8_t)~CONFIG_SMARTFS_ERASEDSTATE);
+      dev->cpslot = -1;
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_touch
+ *
+ * Description: Records that an erase block is about to be modified.  The
+ *              first time a block is touched after a checkpoint, its bit is
+ *              programmed in the dirty bit map of the checkpoint so that
+ *              the block is rescanned when the checkpoint is restored.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_touch(FAR struct smart_struct_s *dev, uint16_t block)
+{
+  uint8_t   mask = 1 << (block & 0x07);
+  int       ret;
+
+  if (dev->cpslot < 0 || block >= dev->neraseblocks ||
+      (dev->cpdirty[block >> 3] & mask) != 0)
+    {
+      return OK;
+    }
+
+  dev->cpdirty[block >> 3] |= mask;
+  dev->cpndirty++;
+
+  ret = smart_cp_program(dev, smart_cp_slotaddr(dev, dev->cpslot) +
+                         SMART_CP_BITMAP_POS + (block >> 3),
+                         dev->cpdirty[block >> 3] ^
+                         CONFIG_SMARTFS_ERASEDSTATE);
+  if (ret < 0)
+    {
+      /* The checkpoint no longer describes the device.  Make sure that
+       * it is not used.
+       */
+
+      ferr("ERROR: Error %d marking block %d in checkpoint\n", -ret, block);
+      ret = smart_cp_invalidate(dev);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_mtderase
+ *
+ * Description: Erases one erase block of the MTD device.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_mtderase(FAR struct smart_struct_s *dev, off_t block)
+{
+  int ret;
+
+  ret = smart_cp_touch(dev, block);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return MTD_ERASE(dev->mtd, block, 1);
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_mtdbwrite
+ *
+ * Description: Writes blocks to the MTD device.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static ssize_t smart_mtdbwrite(FAR struct smart_struct_s *dev,
+                               off_t startblock, size_t nblocks,
+                               FAR const uint8_t *buffer)
+{
+  uint32_t  blkspererase = dev->geo.erasesize / dev->geo.blocksize;
+  int       ret;
+
+  ret = smart_cp_touch(dev, startblock / blkspererase);
+  if (ret >= 0 && nblocks > 1)
+    {
+      ret = smart_cp_touch(dev, (startblock + nblocks - 1) / blkspererase);
+    }
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return MTD_BWRITE(dev->mtd, startblock, nblocks, buffer);
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_crc
+ *
+ * Description: Calculates the CRC of a checkpoint.  The CRC covers the
+ *              header (with a zero crc field) and the sector map, but not
+ *              the dirty bit map which changes after the checkpoint was
+ *              written.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static uint32_t smart_cp_crc(FAR const struct smart_cphdr_s *hdr,
+                             FAR const uint8_t *map, size_t mapsize)
+{
+  struct smart_cphdr_s tmp;
+
+  memcpy(&tmp, hdr, sizeof(struct smart_cphdr_s));
+  tmp.crc = 0;
+
+  return crc32part(map, mapsize,
+                   crc32((FAR const uint8_t *)&tmp, sizeof(struct smart_cphdr_s)));
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_write
+ *
+ * Description: Writes a checkpoint of the sector map and of the free and
+ *              release counts to the checkpoint slot that is not current.
+ *              The header is written last so that an interrupted write
+ *              leaves the previous checkpoint in effect.  The previous
+ *              checkpoint is invalidated once the new one is complete.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_MTD_SMART_FASTMOUNT) && defined(CONFIG_FS_WRITABLE)
+static int smart_cp_write(FAR struct smart_struct_s *dev)
+{
+  struct smart_cphdr_s hdr;
+  FAR const uint8_t *map = (FAR const uint8_t *)dev->sMap;
+  uint32_t  mapsize;
+  uint32_t  start;
+  uint32_t  end;
+  uint32_t  pos;
+  off_t     firstblock;
+  size_t    nblocks;
+  size_t    i;
+  int       slot;
+  int       ret;
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+  FAR struct smart_allocsector_s *allocsect;
+#endif
+
+  /* Never write a checkpoint unless the format sector of the volume
+   * records the same reservation.  Otherwise the slots may hold sectors.
+   */
+
+  if (dev->cpblocks == 0 || dev->formatstatus != SMART_FMT_STAT_FORMATTED ||
+      dev->cpfmtblocks != dev->cpblocks)
+    {
+      return OK;
+    }
+
+  mapsize = SMART_CP_MAPSIZE(dev);
+  if (SMART_CP_MAP_POS(dev) + mapsize > dev->cpblocks * dev->geo.erasesize)
+    {
+      finfo("Sector map too large for a checkpoint\n");
+      return OK;
+    }
+
+  /* Build the header */
+
+  memset(&hdr, 0, sizeof(struct smart_cphdr_s));
+  memcpy(hdr.magic, SMART_CP_MAGIC, sizeof(hdr.magic));
+  hdr.version      = SMART_CP_VERSION;
+  hdr.seq          = dev->cpseq + 1;
+  hdr.sectorsize   = dev->sectorsize;
+  hdr.totalsectors = dev->totalsectors;
+  hdr.neraseblocks = dev->neraseblocks;
+  hdr.crc          = smart_cp_crc(&hdr, map, mapsize);
+
+  /* Erase the slot that does not hold the current checkpoint */
+
+  slot = dev->cpslot == 0 ? 1 : 0;
+  firstblock = smart_cp_slotaddr(dev, slot) / dev->geo.erasesize;
+  ret = MTD_ERASE(dev->mtd, firstblock, dev->cpblocks);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  /* Sectors allocated, but not yet written, are in the map but not on the
+   * device.  Their erase blocks are marked dirty in the new checkpoint
+   * from the start so that they are rescanned when it is restored.
+   */
+
+  memset(dev->cpdirty, 0, SMART_CP_BITMAPSIZE(dev));
+  dev->cpndirty = 0;
+
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+  for (allocsect = dev->allocsector; allocsect; allocsect = allocsect->next)
+    {
+      i = allocsect->physical / dev->sectorsPerBlk;
+      if ((dev->cpdirty[i >> 3] & (1 << (i & 0x07))) == 0)
+        {
+          dev->cpdirty[i >> 3] |= 1 << (i & 0x07);
+          dev->cpndirty++;
+        }
+    }
+#endif
+
+  /* Write the MTD blocks of the slot.  Block zero holds the header and is
+   * written last.
+   */
+
+  firstblock = smart_cp_slotaddr(dev, slot) / dev->geo.blocksize;
+  nblocks    = (SMART_CP_MAP_POS(dev) + mapsize + dev->geo.blocksize - 1) /
+               dev->geo.blocksize;
+
+  for (i = 1; i <= nblocks; i++)
+    {
+      pos = (i % nblocks) * dev->geo.blocksize;
+      memset(dev->cpbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->geo.blocksize);
+
+      /* Copy the parts of the header, the dirty bit map and the sector map
+       * that fall in this block.
+       */
+
+      if (pos == 0)
+        {
+          memcpy(dev->cpbuffer, &hdr, sizeof(struct smart_cphdr_s));
+        }
+
+      start = pos > SMART_CP_BITMAP_POS ? pos : SMART_CP_BITMAP_POS;
+      end   = SMART_CP_MAP_POS(dev);
+      if (end > pos + dev->geo.blocksize)
+        {
+          end = pos + dev->geo.blocksize;
+        }
+
+      for (; start < end; start++)
+        {
+          dev->cpbuffer[start - pos] =
+            dev->cpdirty[start - SMART_CP_BITMAP_POS] ^
+            CONFIG_SMARTFS_ERASEDSTATE;
+        }
+
+      start = pos > SMART_CP_MAP_POS(dev) ? pos : SMART_CP_MAP_POS(dev);
+      end   = SMART_CP_MAP_POS(dev) + mapsize;
+      if (end > pos + dev->geo.blocksize)
+        {
+          end = pos + dev->geo.blocksize;
+        }
+
+      if (start < end)
+        {
+          memcpy(&dev->cpbuffer[start - pos],
+                 &map[start - SMART_CP_MAP_POS(dev)], end - start);
+        }
+
+      ret = MTD_BWRITE(dev->mtd, firstblock + i % nblocks, 1, dev->cpbuffer);
+      if (ret != 1)
+        {
+          ret = ret < 0 ? ret : -EIO;
+          goto errout;
+        }
+    }
+
+  /* The new checkpoint is complete.  Retire the previous one. */
+
+  (void)smart_cp_invalidate(dev);
+  dev->cpslot = slot;
+  dev->cpseq  = hdr.seq;
+
+  finfo("Checkpoint %lu written to slot %d\n", (unsigned long)hdr.seq, slot);
+  return OK;
+
+errout:
+
+  /* The dirty bit map in RAM was reset, so the previous checkpoint cannot
+   * be trusted any longer.
+   */
+
+  ferr("ERROR: Error %d writing checkpoint\n", -ret);
+  (void)smart_cp_invalidate(dev);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_replay
+ *
+ * Description: Rescans the erase blocks that were modified after the
+ *              restored checkpoint was written, then recalculates the total
+ *              free and release counts.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_replay(FAR struct smart_struct_s *dev)
+{
+  FAR uint8_t *dirty;
+  uint32_t  freesectors = 0;
+  uint32_t  releasesectors = 0;
+  uint16_t  logical;
+  uint16_t  block;
+  uint8_t   prerelease;
+  int       sector;
+  int       ret = OK;
+
+  /* Resolving duplicates may release sectors and so mark more blocks as
+   * dirty.  Those are already accounted for, so work from a copy of the
+   * dirty bit map.
+   */
+
+  dirty = (FAR uint8_t *)kmm_malloc(SMART_CP_BITMAPSIZE(dev));
+  if (dirty == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(dirty, dev->cpdirty, SMART_CP_BITMAPSIZE(dev));
+
+  /* Forget the mappings to sectors in the dirty blocks */
+
+  for (logical = 0; logical < dev->totalsectors; logical++)
+    {
+      block = dev->sMap[logical] / dev->sectorsPerBlk;
+      if (dev->sMap[logical] != 0xffff &&
+          (dirty[block >> 3] & (1 << (block & 0x07))) != 0)
+        {
+          dev->sMap[logical] = 0xffff;
+        }
+    }
+
+  for (block = 0; block < dev->neraseblocks; block++)
+    {
+      if ((dirty[block >> 3] & (1 << (block & 0x07))) == 0)
+        {
+          continue;
+        }
+
+      finfo("Replay block %d\n", block);
+
+      prerelease = SMART_CP_PRERELEASE(dev, block);
+      dev->freecount[block] = dev->availSectPerBlk - prerelease;
+      dev->releasecount[block] = prerelease;
+
+      for (sector = block * dev->sectorsPerBlk;
+           sector < (block + 1) * dev->sectorsPerBlk &&
+           sector < dev->totalsectors;
+           sector++)
+        {
+          ret = smart_scansector(dev, sector);
+          if (ret != OK)
+            {
+              goto errout;
+            }
+        }
+    }
+
+  /* Recalculate the totals.  This is done last since releasing duplicate
+   * sectors may update the counts of blocks that were not replayed.
+   */
+
+  for (block = 0; block < dev->neraseblocks; block++)
+    {
+      prerelease      = SMART_CP_PRERELEASE(dev, block);
+      freesectors    += dev->freecount[block] + prerelease;
+      releasesectors += dev->releasecount[block] - prerelease;
+    }
+
+  dev->freesectors    = freesectors;
+  dev->releasesectors = releasesectors;
+
+  /* Logical sector zero was only scanned if its block was dirty */
+
+  if (dev->formatstatus != SMART_FMT_STAT_FORMATTED &&
+      dev->sMap[0] != 0xffff)
+    {
+      ret = smart_scanformat(dev, dev->sMap[0]);
+      if (ret == -ENOENT)
+        {
+          ret = OK;
+        }
+    }
+
+errout:
+  kmm_free(dirty);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_load
+ *
+ * Description: Loads the sector map, the free and release counts and the
+ *              dirty bit map from a checkpoint slot and verifies them.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_load(FAR struct smart_struct_s *dev, int slot,
+                         FAR const struct smart_cphdr_s *hdr)
+{
+  uint32_t  slotaddr = smart_cp_slotaddr(dev, slot);
+  uint32_t  mapsize;
+  uint16_t  block;
+  int       ret;
+
+  ret = smart_setsectorsize(dev, hdr->sectorsize);
+  if (ret != OK)
+    {
+      return ret;
+    }
+
+  mapsize = SMART_CP_MAPSIZE(dev);
+  if (dev->totalsectors != hdr->totalsectors ||
+      dev->neraseblocks != hdr->neraseblocks ||
+      SMART_CP_MAP_POS(dev) + mapsize > dev->cpblocks * dev->geo.erasesize)
+    {
+      return -EINVAL;
+    }
+
+  ret = MTD_READ(dev->mtd, slotaddr + SMART_CP_MAP_POS(dev), mapsize,
+                 (FAR uint8_t *)dev->sMap);
+  if (ret != (int)mapsize)
+    {
+      return -EIO;
+    }
+
+  if (smart_cp_crc(hdr, (FAR const uint8_t *)dev->sMap, mapsize) != hdr->crc)
+    {
+      ferr("ERROR: Bad CRC in checkpoint slot %d\n", slot);
+      return -EINVAL;
+    }
+
+  ret = MTD_READ(dev->mtd, slotaddr + SMART_CP_BITMAP_POS,
+                 SMART_CP_BITMAPSIZE(dev), dev->cpdirty);
+  if (ret != (int)SMART_CP_BITMAPSIZE(dev))
+    {
+      return -EIO;
+    }
+
+  for (block = 0; block < SMART_CP_BITMAPSIZE(dev); block++)
+    {
+      dev->cpdirty[block] ^= CONFIG_SMARTFS_ERASEDSTATE;
+    }
+
+  dev->cpndirty = 0;
+  for (block = 0; block < dev->neraseblocks; block++)
+    {
+      if ((dev->cpdirty[block >> 3] & (1 << (block & 0x07))) != 0)
+        {
+          dev->cpndirty++;
+        }
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_restore
+ *
+ * Description: Restores the state of the device from the newest valid
+ *              checkpoint instead of scanning all sectors.  Only the erase
+ *              blocks modified after the checkpoint was written are
+ *              rescanned.
+ *
+ * Returned Value:
+ *   OK if the state was restored.  Otherwise the caller must scan the
+ *   whole device.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_restore(FAR struct smart_struct_s *dev)
+{
+  struct smart_cphdr_s hdr[SMART_CP_NSLOTS];
+  bool      valid[SMART_CP_NSLOTS];
+  int       slot;
+  int       ret;
+
+  dev->cpslot = -1;
+  if (dev->cpblocks == 0)
+    {
+      return -ENOENT;
+    }
+
+  for (slot = 0; slot < SMART_CP_NSLOTS; slot++)
+    {
+      ret = MTD_READ(dev->mtd, smart_cp_slotaddr(dev, slot),
+                     sizeof(struct smart_cphdr_s), (FAR uint8_t *)&hdr[slot]);
+      valid[slot] = ret == sizeof(struct smart_cphdr_s) &&
+                    memcmp(hdr[slot].magic, SMART_CP_MAGIC,
+                           sizeof(hdr[slot].magic)) == 0 &&
+                    hdr[slot].version == SMART_CP_VERSION;
+
+      if (valid[slot] && hdr[slot].seq > dev->cpseq)
+        {
+          dev->cpseq = hdr[slot].seq;
+        }
+    }
+
+  /* Normally only one slot is valid.  Both are valid only if the previous
+   * checkpoint was not yet invalidated when power was lost, in which case
+   * the older one is still up to date.
+   */
+
+  while (valid[0] || valid[1])
+    {
+      slot = valid[0] && (!valid[1] || hdr[0].seq > hdr[1].seq) ? 0 : 1;
+      valid[slot] = false;
+
+      ret = smart_cp_load(dev, slot, &hdr[slot]);
+      if (ret == OK)
+        {
+          dev->cpslot = slot;
+          ret = smart_cp_replay(dev);
+          if (ret == OK)
+            {
+              finfo("Restored checkpoint %lu, %d blocks replayed\n",
+                    (unsigned long)hdr[slot].seq, dev->cpndirty);
+              return OK;
+            }
+
+          dev->cpslot = -1;
+        }
+    }
+
+  return -ENOENT;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_resize
+ *
+ * Description: Sets the number of erase blocks per checkpoint slot, moves
+ *              the end of the sector area accordingly and (re)allocates the
+ *              checkpoint buffers.  Zero disables the checkpoints.  The
+ *              sector size is reset so that the next call to
+ *              smart_setsectorsize() rebuilds the sector map for the new
+ *              geometry.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_resize(FAR struct smart_struct_s *dev, uint16_t cpblocks)
+{
+  uint32_t  nblocks;
+
+  /* Don't give more than half of the device to the checkpoints */
+
+  nblocks = dev->geo.neraseblocks + SMART_CP_NSLOTS * dev->cpblocks;
+  if (2 * SMART_CP_NSLOTS * (uint32_t)cpblocks > nblocks)
+    {
+      ferr("ERROR: Device too small for checkpoints\n");
+      cpblocks = 0;
+    }
+
+  dev->cpslot   = -1;
+  dev->cpndirty = 0;
+
+  if (cpblocks == dev->cpblocks && (cpblocks == 0 || dev->cpdirty != NULL))
+    {
+      return OK;
+    }
+
+  dev->geo.neraseblocks = nblocks - SMART_CP_NSLOTS * cpblocks;
+  dev->cpblocks         = cpblocks;
+  dev->sectorsize       = 0;
+
+  if (dev->cpdirty != NULL)
+    {
+      smart_free(dev, dev->cpdirty);
+      dev->cpdirty = NULL;
+    }
+
+  if (cpblocks == 0)
+    {
+      return OK;
+    }
+
+  dev->cpdirty = (FAR uint8_t *)smart_zalloc(dev,
+                   (dev->geo.neraseblocks + 7) >> 3, "Checkpoint map");
+  if (dev->cpbuffer == NULL)
+    {
+      dev->cpbuffer = (FAR uint8_t *)smart_malloc(dev, dev->geo.blocksize,
+                        "Checkpoint buffer");
+    }
+
+  if (dev->cpdirty == NULL || dev->cpbuffer == NULL)
+    {
+      ferr("ERROR: Error allocating checkpoint buffers\n");
+      return -ENOMEM;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cp_initialize
+ *
+ * Description: Reserves the checkpoint slots at the end of the device and
+ *              allocates the checkpoint buffers.  The slots are sized for
+ *              the sector map of a volume with CONFIG_MTD_SMART_SECTOR_SIZE
+ *              sectors.  This is only the default used when a volume is
+ *              formatted:  The scan adjusts the reservation to the one
+ *              recorded in the format sector of the volume.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+static int smart_cp_initialize(FAR struct smart_struct_s *dev)
+{
+  uint32_t  totalsectors;
+  uint32_t  size;
+  int       ret;
+
+  dev->cpslot   = -1;
+  dev->cpblocks = 0;
+
+  totalsectors = dev->geo.neraseblocks *
+                 (dev->geo.erasesize / CONFIG_MTD_SMART_SECTOR_SIZE);
+  if (totalsectors > 65536)
+    {
+      totalsectors = 65536;
+    }
+
+  size = sizeof(struct smart_cphdr_s) + ((dev->geo.neraseblocks + 7) >> 3) +
+         (totalsectors << 1) + (dev->geo.neraseblocks << 1);
+
+  ret = smart_cp_resize(dev, (size + dev->geo.erasesize - 1) /
+                             dev->geo.erasesize);
+
+  dev->cpdefblocks = dev->cpblocks;
+  dev->cpfmtblocks = 0;
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_scan
+ *
+ * Description: Performs a scan of the MTD device searching for format
+ *              information and fills in logical sector mapping, freesector
+ *              count, etc.
+ *
+ ****************************************************************************/
+
+static int smart_scan(FAR struct smart_struct_s *dev)
+{
+  int       sector;
+  int       ret;
+  uint16_t  totalsectors;
+  uint16_t  sectorsize, prerelease;
+  uint32_t  readaddress;
+  uint32_t  offset;
+  struct    smart_sect_header_s header;
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  bool      rescanned = false;
 #endif
   static const short sizetbl[8] =
   {
@@ -1862,6 +3100,19 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
   finfo("Entry\n");
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  /* Restore the state from the newest valid checkpoint.  Only the erase
+   * blocks modified after it was written need to be scanned.
+   */
+
+  if (smart_cp_restore(dev) == OK)
+    {
+      goto scan_done;
+    }
+
+rescan:
+#endif
+
   /* Find the sector size on the volume by reading headers from
    * sectors of decreasing size.  On a formatted volume, the sector
    * size is saved in the header status byte of seach sector, so
@@ -1967,338 +3218,44 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
   for (sector = 0; sector < totalsectors; sector++)
     {
-      finfo("Scan sector %d\n", sector);
-
-      /* Calculate the read address for this sector */
-
-      readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
-
-      /* Read the header for this sector */
-
-      ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
-                     (FAR uint8_t *) &header);
-      if (ret != sizeof(struct smart_sect_header_s))
+      ret = smart_scansector(dev, sector);
+      if (ret != OK)
         {
           goto err_out;
         }
+    }
 
-      /* Get the logical sector number for this physical sector */
-
-      logicalsector = *((FAR uint16_t *) header.logicalsector);
-#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
-      if (logicalsector == 0)
-        {
-          logicalsector = -1;
-        }
-#endif
-
-      /* Test if this sector has been committed */
-
-      if ((header.status & SMART_STATUS_COMMITTED) ==
-              (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_COMMITTED))
-        {
-          continue;
-        }
-
-      /* This block is commited, therefore not free.  Update the
-       * erase block's freecount.
-       */
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-      smart_add_count(dev, dev->freecount, sector / dev->sectorsPerBlk, -1);
-#else
-      dev->freecount[sector / dev->sectorsPerBlk]--;
-#endif
-      dev->freesectors--;
-
-      /* Test if this sector has been release and if it has,
-       * update the erase block's releasecount.
-       */
-
-      if ((header.status & SMART_STATUS_RELEASED) !=
-              (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_RELEASED))
-        {
-          /* Keep track of the total number of released sectors and
-           * released sectors per erase block.
-           */
-
-          dev->releasesectors++;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-          smart_add_count(dev, dev->releasecount, sector / dev->sectorsPerBlk, 1);
-#else
-          dev->releasecount[sector / dev->sectorsPerBlk]++;
-#endif
-          continue;
-        }
-
-      if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION)
-        {
-          continue;
-        }
-
-      /* Validate the logical sector number is in bounds */
-
-      if (logicalsector >= totalsectors)
-        {
-          /* Error in logical sector read from the MTD device */
-
-          ferr("ERROR: Invalid logical sector %d at physical %d.\n",
-               logicalsector, sector);
-          continue;
-        }
-
-      /* If this is logical sector zero, then read in the signature
-       * information to validate the format signature.
-       */
-
-      if (logicalsector == 0)
-        {
-          /* Read the sector data */
-
-          ret = MTD_READ(dev->mtd, readaddress, 32,
-                         (FAR uint8_t *)dev->rwbuffer);
-          if (ret != 32)
-            {
-              ferr("ERROR: Error reading physical sector %d.\n", sector);
-              goto err_out;
-            }
-
-          /* Validate the format signature */
-
-          if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
-              dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
-              dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
-              dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
-            {
-              /* Invalid signature on a sector claiming to be sector 0!
-               * What should we do?  Release it?
-               */
-
-              continue;
-            }
-
-          /* Mark the volume as formatted and set the sector size */
-
-          dev->formatstatus = SMART_FMT_STAT_FORMATTED;
-          dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
-          dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
-
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-          dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
-
-          /* If rootdirentries is greater than 1, then we need to register
-           * additional block devices.
-           */
-
-          for (x = 1; x < dev->rootdirentries; x++)
-            {
-              if (dev->partname[0] != '\0')
-                {
-                  snprintf(dev->rwbuffer, sizeof(devname), "/dev/smart%d%sd%d",
-                          dev->minor, dev->partname, x+1);
-                }
-              else
-                {
-                  snprintf(devname, sizeof(devname), "/dev/smart%dd%d", dev->minor,
-                           x + 1);
-                }
-
-              /* Inode private data is a reference to a struct containing
-               * the SMART device structure and the root directory number.
-               */
-
-              rootdirdev = (struct smart_multiroot_device_s *)
-                smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
-              if (rootdirdev == NULL)
-                {
-                  ferr("ERROR: Memory alloc failed\n");
-                  ret = -ENOMEM;
-                  goto err_out;
-                }
-
-              /* Populate the rootdirdev */
-
-              rootdirdev->dev = dev;
-              rootdirdev->rootdirnum = x;
-              ret = register_blockdriver(dev->rwbuffer, &g_bops, 0, rootdirdev);
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+scan_done:
 
-              /* Inode private data is a reference to the SMART device structure */
+  /* The erase blocks at the end of the device may only be used for the
+   * checkpoints if they were reserved when the volume was formatted.
+   * Otherwise they may hold sectors of the volume, possibly even the
+   * format sector:  Change the reservation to the one recorded in the
+   * format sector (or to none if no format sector was found) and scan the
+   * device again.
+   */
 
-              ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
-            }
-#endif
-        }
+  if (dev->formatstatus != SMART_FMT_STAT_FORMATTED)
+    {
+      dev->cpfmtblocks = 0;
+    }
 
-      /* Test for duplicate logical sectors on the device */
+  if (dev->cpfmtblocks != dev->cpblocks && !rescanned)
+    {
+      finfo("Volume has %d checkpoint blocks, not %d\n",
+            dev->cpfmtblocks, dev->cpblocks);
 
-#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-      if (dev->sMap[logicalsector] != 0xffff)
-#else
-      if (dev->sBitMap[logicalsector >> 3] & (1 << (logicalsector & 0x07)))
-#endif
+      ret = smart_cp_resize(dev, dev->cpfmtblocks);
+      if (ret != OK)
         {
-          /* Uh-oh, we found more than 1 physical sector claiming to be
-           * the same logical sector.  Use the sequence number information
-           * to resolve who wins.
-           */
-
-#if SMART_STATUS_VERSION == 1
-          if (header.status & SMART_STATUS_CRC)
-            {
-              seq2 = header.seq;
-            }
-          else
-            {
-              seq2 = *((FAR uint16_t *) &header.seq);
-            }
-#else
-          seq2 = header.seq;
-#endif
-
-          /* We must re-read the 1st physical sector to get it's seq number */
-
-#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-          readaddress = dev->sMap[logicalsector]  * dev->mtdBlksPerSector * dev->geo.blocksize;
-#else
-          /* For minimize RAM, we have to rescan to find the 1st sector claiming to
-           * be this logical sector.
-           */
-
-          for (dupsector = 0; dupsector < sector; dupsector++)
-            {
-              /* Calculate the read address for this sector */
-
-              readaddress = dupsector * dev->mtdBlksPerSector * dev->geo.blocksize;
-
-              /* Read the header for this sector */
-
-              ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
-                             (FAR uint8_t *) &header);
-              if (ret != sizeof(struct smart_sect_header_s))
-                {
-                  goto err_out;
-                }
-
-              /* Get the logical sector number for this physical sector */
-
-              duplogsector = *((FAR uint16_t *) header.logicalsector);
-
-#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
-              if (duplogsector == 0)
-                {
-                  duplogsector = -1;
-                }
-#endif
-
-              /* Test if this sector has been committed */
-
-              if ((header.status & SMART_STATUS_COMMITTED) ==
-                      (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_COMMITTED))
-                {
-                  continue;
-                }
-
-              /* Test if this sector has been release and skip it if it has */
-
-              if ((header.status & SMART_STATUS_RELEASED) !=
-                      (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_RELEASED))
-                {
-                  continue;
-                }
-
-              if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION)
-                {
-                  continue;
-                }
-
-              /* Now compare if this logical sector matches the current sector */
-
-              if (duplogsector == logicalsector)
-                {
-                  break;
-                }
-            }
-#endif
-
-          ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
-                  (FAR uint8_t *) &header);
-          if (ret != sizeof(struct smart_sect_header_s))
-            {
-              goto err_out;
-            }
-
-#if SMART_STATUS_VERSION == 1
-          if (header.status & SMART_STATUS_CRC)
-            {
-              seq1 = header.seq;
-            }
-          else
-            {
-              seq1 = *((FAR uint16_t *) &header.seq);
-            }
-#else
-          seq1 = header.seq;
-#endif
-
-          /* Now determine who wins */
-
-          if ((seq1 > 0xfff0 && seq2 < 10) || seq2 > seq1)
-            {
-              /* Seq 2 is the winner ... bigger or it wrapped */
-
-#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-              loser = dev->sMap[logicalsector];
-              dev->sMap[logicalsector] = sector;
-#else
-              loser = dupsector;
-#endif
-            }
-          else
-            {
-              /* We keep the original mapping and seq2 is the loser */
-
-              loser = sector;
-            }
-
-          /* Now release the loser sector */
-
-          readaddress = loser  * dev->mtdBlksPerSector * dev->geo.blocksize;
-          ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s),
-                  (FAR uint8_t *) &header);
-          if (ret != sizeof(struct smart_sect_header_s))
-            {
-              goto err_out;
-            }
-
-#if CONFIG_SMARTFS_ERASEDSTATE == 0xff
-          header.status &= ~SMART_STATUS_RELEASED;
-#else
-          header.status |= SMART_STATUS_RELEASED;
-#endif
-          offset = readaddress + offsetof(struct smart_sect_header_s, status);
-          ret = smart_bytewrite(dev, offset, 1, &header.status);
-          if (ret < 0)
-            {
-              ferr("ERROR: Error %d releasing duplicate sector\n", -ret);
-              goto err_out;
-            }
+          goto err_out;
         }
 
-#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-      /* Update the logical to physical sector map */
-
-      dev->sMap[logicalsector] = sector;
-#else
-      /* Mark the logical sector as used in the bitmap */
-
-      dev->sBitMap[logicalsector >> 3] |= 1 << (logicalsector & 0x07);
-
-      if (logicalsector < SMART_FIRST_ALLOC_SECTOR)
-        {
-          smart_add_sector_to_cache(dev, logicalsector, sector, __LINE__);
-        }
-#endif
+      rescanned = true;
+      goto rescan;
     }
+#endif
 
 #if defined (CONFIG_MTD_SMART_WEAR_LEVEL) && (SMART_STATUS_VERSION == 1)
 #ifdef CONFIG_MTD_SMART_CONVERT_WEAR_FORMAT
@@ -2519,7 +3476,7 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev,
       dev->unusedsectors += freecount;
       dev->blockerases++;
 #endif
-      MTD_ERASE(dev->mtd, block, 1);
+      smart_mtderase(dev, block);
 
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
       if (dev->erasecounts)
@@ -2912,6 +3869,18 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
       sectorsize = CONFIG_MTD_SMART_SECTOR_SIZE;
     }
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  /* Reserve the default checkpoint slots on the new volume */
+
+  ret = smart_cp_resize(dev, dev->cpdefblocks);
+  if (ret != OK)
+    {
+      return ret;
+    }
+
+  dev->cpfmtblocks = dev->cpblocks;
+#endif
+
   /* Set the sector size for the device */
 
   ret = smart_setsectorsize(dev, sectorsize);
@@ -2942,6 +3911,12 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
       return ret;
     }
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  /* The checkpoints were erased, too */
+
+  dev->cpslot = -1;
+#endif
+
   /* Now construct a logical sector zero header to write to the device. */
 
   sectorheader = (FAR struct smart_sect_header_s *) dev->rwbuffer;
@@ -3001,6 +3976,17 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 
   dev->rwbuffer[SMART_FMT_ROOTDIRS_POS] = (uint8_t) (arg & 0xff);
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  /* Record the size of the checkpoint slots reserved at the end of the
+   * device so that they are only used on volumes that have them.
+   */
+
+  dev->rwbuffer[SMART_FMT_CPBLOCKS_POS] =
+    (uint8_t)(dev->cpblocks & 0xff) ^ CONFIG_SMARTFS_ERASEDSTATE;
+  dev->rwbuffer[SMART_FMT_CPBLOCKS_POS + 1] =
+    (uint8_t)(dev->cpblocks >> 8) ^ CONFIG_SMARTFS_ERASEDSTATE;
+#endif
+
 #ifdef CONFIG_SMART_CRC_8
   sectorheader->crc8 = smart_calc_sector_crc(dev);
 #elif defined(CONFIG_SMART_CRC_16)
@@ -3011,7 +3997,7 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 
   /* Write the sector to the flash */
 
-  wrcount = MTD_BWRITE(dev->mtd, 0, dev->mtdBlksPerSector,
+  wrcount = smart_mtdbwrite(dev, 0, dev->mtdBlksPerSector,
           (FAR uint8_t *) dev->rwbuffer);
   if (wrcount != dev->mtdBlksPerSector)
     {
@@ -3170,7 +4156,7 @@ static int smart_relocate_sector(FAR struct smart_struct_s *dev,
 
   /* Write the data to the new physical sector location */
 
-  ret = MTD_BWRITE(dev->mtd, newsector * dev->mtdBlksPerSector,
+  ret = smart_mtdbwrite(dev, newsector * dev->mtdBlksPerSector,
                    dev->mtdBlksPerSector, (FAR uint8_t *) dev->rwbuffer);
 
 #else   /* CONFIG_MTD_SMART_ENABLE_CRC */
@@ -3183,7 +4169,7 @@ static int smart_relocate_sector(FAR struct smart_struct_s *dev,
 
   /* Write the data to the new physical sector location */
 
-  ret = MTD_BWRITE(dev->mtd, newsector * dev->mtdBlksPerSector,
+  ret = smart_mtdbwrite(dev, newsector * dev->mtdBlksPerSector,
                    dev->mtdBlksPerSector, (FAR uint8_t *) dev->rwbuffer);
 
   /* Commit the sector */
@@ -3398,7 +4384,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 
   /* Now erase the erase block */
 
-  MTD_ERASE(dev->mtd, block, 1);
+  smart_mtderase(dev, block);
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
   dev->unusedsectors += freecount;
   dev->blockerases++;
@@ -4186,7 +5172,7 @@ static int smart_write_alloc_sector(FAR struct smart_struct_s *dev,
 
 #ifndef CONFIG_MTD_SMART_ENABLE_CRC
   finfo("Write MTD block %d\n", physical * dev->mtdBlksPerSector);
-  ret = MTD_BWRITE(dev->mtd, physical * dev->mtdBlksPerSector, 1,
+  ret = smart_mtdbwrite(dev, physical * dev->mtdBlksPerSector, 1,
       (FAR uint8_t *) dev->rwbuffer);
   if (ret != 1)
     {
@@ -4536,7 +5522,7 @@ static int smart_writesector(FAR struct smart_struct_s *dev,
     {
       /* Write the entire sector to the new physical location, uncommitted. */
 
-      ret = MTD_BWRITE(dev->mtd, physsector * dev->mtdBlksPerSector,
+      ret = smart_mtdbwrite(dev, physsector * dev->mtdBlksPerSector,
               dev->mtdBlksPerSector, (FAR uint8_t *) dev->rwbuffer);
       if (ret != dev->mtdBlksPerSector)
         {
@@ -4620,7 +5606,7 @@ static int smart_writesector(FAR struct smart_struct_s *dev,
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
       /* Write the entire sector to FLASH when CRC enabled */
 
-      ret = MTD_BWRITE(dev->mtd, physsector * dev->mtdBlksPerSector,
+      ret = smart_mtdbwrite(dev, physsector * dev->mtdBlksPerSector,
               dev->mtdBlksPerSector, (FAR uint8_t *) dev->rwbuffer);
       if (ret != dev->mtdBlksPerSector)
         {
@@ -5323,6 +6309,24 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       goto ok_out;
 #endif
 
+#if defined(CONFIG_MTD_SMART_FASTMOUNT) && defined(CONFIG_FS_WRITABLE)
+    case BIOC_FLUSH:
+
+      /* Write a new checkpoint once enough erase blocks were modified.
+       * This bounds the work of the next mount without wearing out the
+       * checkpoint slots on every sync.  The command is then passed on to
+       * the MTD driver.
+       */
+
+      if (dev->cpndirty >= CONFIG_MTD_SMART_FASTMOUNT_THRESHOLD ||
+          (dev->cpslot < 0 && dev->cpblocks > 0))
+        {
+          (void)smart_cp_write(dev);
+        }
+
+      break;
+#endif
+
     case BIOC_DEBUGCMD:
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
       debug_data = (FAR struct mtd_smart_debug_data_s *) arg;
@@ -5414,6 +6418,16 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
           goto errout;
         }
 
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+      /* Reserve the checkpoint slots at the end of the device */
+
+      ret = smart_cp_initialize(dev);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+#endif
       /* Set the sector size to the default for now */
 
       dev->sectorsize = 0;
@@ -5541,6 +6555,10 @@ errout:
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
   smart_free(dev, dev->erasecounts);
 #endif
+#ifdef CONFIG_MTD_SMART_FASTMOUNT
+  smart_free(dev, dev->cpdirty);
+  smart_free(dev, dev->cpbuffer);
+#endif
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
   if (rootdirdev)
     {
@@ -1113,7 +1113,7 @@ static int telnet_poll(FAR struct file *filep, FAR struct pollfd *fds,
       /* Yes.. then signal the poll logic */
 
       fds->revents |= (POLLRDNORM & fds->events);
-      nxsem_post(fds->sem);
+      poll_post(fds);
     }
 
   /* Then let psock_poll() do the heavy lifting */
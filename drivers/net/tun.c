@@ -61,6 +61,7 @@
 #endif
 
 #include <nuttx/arch.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
@@ -329,7 +330,7 @@ static void tun_pollnotify(FAR struct tun_device_s *priv, pollevent_t eventset)
   if (eventset != 0)
     {
       fds->revents |= eventset;
-      nxsem_post(fds->sem);
+      poll_post(fds);
     }
 }
 #else
@@ -113,6 +113,183 @@ static void pipecommon_semtake(FAR sem_t *sem)
   while (ret == -EINTR);
 }
 
+/****************************************************************************
+ * Name: pipecommon_wakeup
+ *
+ * Description:
+ *   Wake up all of the threads waiting on a read or write semaphore.
+ *
+ ****************************************************************************/
+
+static void pipecommon_wakeup(FAR sem_t *sem)
+{
+  int sval;
+
+  while (nxsem_getvalue(sem, &sval) == 0 && sval < 0)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: pipecommon_rdlen and pipecommon_wrlen
+ *
+ * Description:
+ *   Return the number of bytes that can be read from d_rdndx, or written
+ *   at d_wrndx, without wrapping around the end of the circular buffer.
+ *   One byte of the buffer is always left unused so that a full buffer can
+ *   be distinguished from an empty one.
+ *
+ ****************************************************************************/
+
+static inline size_t pipecommon_rdlen(FAR struct pipe_dev_s *dev)
+{
+  if (dev->d_wrndx >= dev->d_rdndx)
+    {
+      return dev->d_wrndx - dev->d_rdndx;
+    }
+
+  return dev->d_bufsize - dev->d_rdndx;
+}
+
+static inline size_t pipecommon_wrlen(FAR struct pipe_dev_s *dev)
+{
+  if (dev->d_rdndx > dev->d_wrndx)
+    {
+      return dev->d_rdndx - dev->d_wrndx - 1;
+    }
+  else if (dev->d_rdndx == 0)
+    {
+      return dev->d_bufsize - dev->d_wrndx - 1;
+    }
+
+  return dev->d_bufsize - dev->d_wrndx;
+}
+
+/****************************************************************************
+ * Name: pipecommon_rdadvance and pipecommon_wradvance
+ *
+ * Description:
+ *   Advance the read or write index past 'n' bytes.
+ *
+ ****************************************************************************/
+
+static inline void pipecommon_rdadvance(FAR struct pipe_dev_s *dev,
+                                        size_t n)
+{
+  n += dev->d_rdndx;
+  dev->d_rdndx = n >= dev->d_bufsize ? n - dev->d_bufsize : n;
+}
+
+static inline void pipecommon_wradvance(FAR struct pipe_dev_s *dev,
+                                        size_t n)
+{
+  n += dev->d_wrndx;
+  dev->d_wrndx = n >= dev->d_bufsize ? n - dev->d_bufsize : n;
+}
+
+/****************************************************************************
+ * Name: pipecommon_rdwait
+ *
+ * Description:
+ *   Wait until there is data in the pipe and no splice() is taking data out
+ *   of it.  Called with d_bfsem held.
+ *
+ * Returned Value:
+ *   One if there is data in the pipe; d_bfsem is still held.  Zero on end
+ *   of file (there is no data and no writer) or a negated errno value on
+ *   failure; d_bfsem has been released in both cases.
+ *
+ ****************************************************************************/
+
+static int pipecommon_rdwait(FAR struct pipe_dev_s *dev, bool nonblock)
+{
+  int ret;
+
+  while (dev->d_wrndx == dev->d_rdndx || PIPE_IS_RDSPLICE(dev->d_flags))
+    {
+      /* If O_NONBLOCK was set, then return EGAIN */
+
+      if (nonblock)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return -EAGAIN;
+        }
+
+      /* If there are no writers on the pipe, then return end of file */
+
+      if (dev->d_nwriters <= 0 && !PIPE_IS_RDSPLICE(dev->d_flags))
+        {
+          nxsem_post(&dev->d_bfsem);
+          return 0;
+        }
+
+      /* Otherwise, wait for something to be written to the pipe */
+
+      sched_lock();
+      nxsem_post(&dev->d_bfsem);
+      ret = nxsem_wait(&dev->d_rdsem);
+      sched_unlock();
+
+      if (ret < 0 || (ret = nxsem_wait(&dev->d_bfsem)) < 0)
+        {
+          return ret;
+        }
+    }
+
+  return 1;
+}
+
+/****************************************************************************
+ * Name: pipecommon_wrwait
+ *
+ * Description:
+ *   Wait until there is free space in the pipe and no splice() is putting
+ *   data into it.  Called with d_bfsem held.
+ *
+ * Returned Value:
+ *   Zero (OK) if there is space in the pipe; d_bfsem is still held.  A
+ *   negated errno value on failure; d_bfsem has been released.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPLICE
+static int pipecommon_wrwait(FAR struct pipe_dev_s *dev, bool nonblock)
+{
+  int ret;
+
+  for (; ; )
+    {
+      if (dev->d_nreaders <= 0)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return -EPIPE;
+        }
+
+      if (pipecommon_wrlen(dev) > 0 && !PIPE_IS_WRSPLICE(dev->d_flags))
+        {
+          return OK;
+        }
+
+      if (nonblock)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return -EAGAIN;
+        }
+
+      sched_lock();
+      nxsem_post(&dev->d_bfsem);
+      ret = nxsem_wait(&dev->d_wrsem);
+      sched_unlock();
+
+      if (ret < 0 || (ret = nxsem_wait(&dev->d_bfsem)) < 0)
+        {
+          return ret;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: pipecommon_pollnotify
  ****************************************************************************/
@@ -146,7 +323,7 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
           if (fds->revents != 0)
             {
               finfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_post(fds);
             }
         }
     }
@@ -214,7 +391,6 @@ int pipecommon_open(FAR struct file *filep)
 {
   FAR struct inode      *inode = filep->f_inode;
   FAR struct pipe_dev_s *dev   = inode->i_private;
-  int                    sval;
   int                    ret;
 
   DEBUGASSERT(dev != NULL);
@@ -261,10 +437,7 @@ int pipecommon_open(FAR struct file *filep)
 
       if (dev->d_nwriters == 1)
         {
-          while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-            {
-              nxsem_post(&dev->d_rdsem);
-            }
+          pipecommon_wakeup(&dev->d_rdsem);
         }
     }
 
@@ -323,7 +496,6 @@ int pipecommon_close(FAR struct file *filep)
 {
   FAR struct inode      *inode = filep->f_inode;
   FAR struct pipe_dev_s *dev   = inode->i_private;
-  int                    sval;
 
   DEBUGASSERT(dev && dev->d_refs > 0);
 
@@ -354,10 +526,7 @@ int pipecommon_close(FAR struct file *filep)
 
           if (--dev->d_nwriters <= 0)
             {
-              while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  nxsem_post(&dev->d_rdsem);
-                }
+              pipecommon_wakeup(&dev->d_rdsem);
 
               /* Inform poll readers that other end closed. */
 
@@ -433,7 +602,7 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
   FAR uint8_t           *start  = (FAR uint8_t *)buffer;
 #endif
   ssize_t                nread  = 0;
-  int                    sval;
+  size_t                 n;
   int                    ret;
 
   DEBUGASSERT(dev);
@@ -453,57 +622,35 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   /* If the pipe is empty, then wait for something to be written to it */
 
-  while (dev->d_wrndx == dev->d_rdndx)
+  ret = pipecommon_rdwait(dev, (filep->f_oflags & O_NONBLOCK) != 0);
+  if (ret <= 0)
     {
-      /* If O_NONBLOCK was set, then return EGAIN */
-
-      if (filep->f_oflags & O_NONBLOCK)
-        {
-          nxsem_post(&dev->d_bfsem);
-          return -EAGAIN;
-        }
-
-      /* If there are no writers on the pipe, then return end of file */
-
-      if (dev->d_nwriters <= 0)
-        {
-          nxsem_post(&dev->d_bfsem);
-          return 0;
-        }
-
-      /* Otherwise, wait for something to be written to the pipe */
-
-      sched_lock();
-      nxsem_post(&dev->d_bfsem);
-      ret = nxsem_wait(&dev->d_rdsem);
-      sched_unlock();
-
-      if (ret < 0 || (ret = nxsem_wait(&dev->d_bfsem)) < 0)
-        {
-          return ret;
-        }
+      return ret;
     }
 
-  /* Then return whatever is available in the pipe (which is at least one byte) */
+  /* Then return whatever is available in the pipe (which is at least one
+   * byte).  The data may wrap around the end of the circular buffer so
+   * this takes at most two copies.
+   */
 
   nread = 0;
-  while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
+  while ((size_t)nread < len && (n = pipecommon_rdlen(dev)) > 0)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
+      if (n > len - nread)
         {
-          dev->d_rdndx = 0;
+          n = len - nread;
         }
 
-      nread++;
+      memcpy(buffer, &dev->d_buffer[dev->d_rdndx], n);
+      pipecommon_rdadvance(dev, n);
+
+      buffer += n;
+      nread  += n;
     }
 
   /* Notify all waiting writers that bytes have been removed from the buffer */
 
-  while (nxsem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0)
-    {
-      nxsem_post(&dev->d_wrsem);
-    }
+  pipecommon_wakeup(&dev->d_wrsem);
 
   /* Notify all poll/select waiters that they can write to the FIFO */
 
@@ -525,8 +672,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
-  int                    nxtwrndx;
-  int                    sval;
+  size_t                 n;
   int                    ret;
 
   DEBUGASSERT(dev);
@@ -578,86 +724,87 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   last = 0;
   for (; ; )
     {
-      /* Calculate the write index AFTER the next byte is written */
+      /* Copy as much as will fit in the circular buffer.  The free space
+       * may wrap around the end of the buffer so this takes at most two
+       * copies.  Nothing can be added while splice() is adding data.
+       */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
+      while ((size_t)nwritten < len && !PIPE_IS_WRSPLICE(dev->d_flags) &&
+             (n = pipecommon_wrlen(dev)) > 0)
         {
-          nxtwrndx = 0;
+          if (n > len - nwritten)
+            {
+              n = len - nwritten;
+            }
+
+          memcpy(&dev->d_buffer[dev->d_wrndx], buffer, n);
+          pipecommon_wradvance(dev, n);
+
+          buffer   += n;
+          nwritten += n;
         }
 
-      /* Would the next write overflow the circular buffer? */
+      /* Is the write complete? */
 
-      if (nxtwrndx != dev->d_rdndx)
+      if ((size_t)nwritten >= len)
         {
-          /* No... copy the byte */
-
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
+          /* Yes.. Notify all of the waiting readers that more data is
+           * available.
+           */
 
-          /* Is the write complete? */
+          pipecommon_wakeup(&dev->d_rdsem);
 
-          nwritten++;
-          if ((size_t)nwritten >= len)
-            {
-              /* Yes.. Notify all of the waiting readers that more data is available */
+          /* Notify all poll/select waiters that they can read from the FIFO */
 
-              while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  nxsem_post(&dev->d_rdsem);
-                }
+          pipecommon_pollnotify(dev, POLLIN);
 
-              /* Notify all poll/select waiters that they can read from the FIFO */
+          /* Return the number of bytes written */
 
-              pipecommon_pollnotify(dev, POLLIN);
+          nxsem_post(&dev->d_bfsem);
+          return len;
+        }
 
-              /* Return the number of bytes written */
+      /* There is not enough room for the rest of the data.  Was anything
+       * written in this pass?
+       */
 
-              nxsem_post(&dev->d_bfsem);
-              return len;
-            }
-        }
-      else
+      if (last < nwritten)
         {
-          /* There is not enough room for the next byte.  Was anything written in this pass? */
-
-          if (last < nwritten)
-            {
-              /* Yes.. Notify all of the waiting readers that more data is available */
+          /* Yes.. Notify all of the waiting readers that more data is
+           * available.
+           */
 
-              while (nxsem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  nxsem_post(&dev->d_rdsem);
-                }
+          pipecommon_wakeup(&dev->d_rdsem);
 
-              /* Notify all poll/select waiters that they can read from the FIFO */
+          /* Notify all poll/select waiters that they can read from the FIFO */
 
-              pipecommon_pollnotify(dev, POLLIN);
-            }
+          pipecommon_pollnotify(dev, POLLIN);
+        }
 
-          last = nwritten;
+      last = nwritten;
 
-          /* If O_NONBLOCK was set, then return partial bytes written or EGAIN */
+      /* If O_NONBLOCK was set, then return partial bytes written or EGAIN */
 
-          if (filep->f_oflags & O_NONBLOCK)
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          if (nwritten == 0)
             {
-              if (nwritten == 0)
-                {
-                  nwritten = -EAGAIN;
-                }
-
-              nxsem_post(&dev->d_bfsem);
-              return nwritten;
+              nwritten = -EAGAIN;
             }
 
-          /* There is more to be written.. wait for data to be removed from the pipe */
-
-          sched_lock();
           nxsem_post(&dev->d_bfsem);
-          pipecommon_semtake(&dev->d_wrsem);
-          sched_unlock();
-          pipecommon_semtake(&dev->d_bfsem);
+          return nwritten;
         }
+
+      /* There is more to be written.. wait for data to be removed from the
+       * pipe.
+       */
+
+      sched_lock();
+      nxsem_post(&dev->d_bfsem);
+      pipecommon_semtake(&dev->d_wrsem);
+      sched_unlock();
+      pipecommon_semtake(&dev->d_bfsem);
     }
 }
 
@@ -884,6 +1031,417 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   return ret;
 }
 
+/****************************************************************************
+ * Name: pipecommon_ispipe
+ *
+ * Description:
+ *   Return true if the open file is a pipe or a FIFO.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPLICE
+bool pipecommon_ispipe(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  return inode != NULL && INODE_IS_DRIVER(inode) &&
+         inode->u.i_ops->read == pipecommon_read;
+}
+
+/****************************************************************************
+ * Name: pipecommon_splicefrom
+ *
+ * Description:
+ *   Remove up to 'len' bytes from the pipe, passing them to 'xfer' directly
+ *   from the circular buffer.  'xfer' is called at most twice and may
+ *   accept fewer bytes than offered.  Only the bytes accepted are removed.
+ *
+ *   The pipe is not locked while 'xfer' runs since it may block on the
+ *   other descriptor.  Instead, the pipe is marked so that other readers
+ *   wait until the transfer is complete.  Writers only add data after the
+ *   bytes being transferred, so those stay in place.
+ *
+ * Input Parameters:
+ *   filep    - The pipe, open for reading
+ *   xfer     - The function that consumes the data
+ *   arg      - The argument passed to 'xfer'
+ *   len      - The maximum number of bytes to transfer
+ *   nonblock - True: Do not wait for data if the pipe is empty
+ *
+ * Returned Value:
+ *   The number of bytes transferred, zero at end of file or a negated
+ *   errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pipecommon_splicefrom(FAR struct file *filep, pipe_xfer_t xfer,
+                              FAR void *arg, size_t len, bool nonblock)
+{
+  FAR struct pipe_dev_s *dev   = filep->f_inode->i_private;
+  ssize_t                nxfer = 0;
+  ssize_t                ret;
+  pipe_ndx_t             ndx;
+  size_t                 n;
+
+  DEBUGASSERT(dev != NULL && xfer != NULL);
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  ret = nxsem_wait(&dev->d_bfsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = pipecommon_rdwait(dev, nonblock);
+  if (ret <= 0)
+    {
+      return ret;
+    }
+
+  dev->d_flags |= PIPE_FLAG_RDSPLICE;
+
+  while ((size_t)nxfer < len && (n = pipecommon_rdlen(dev)) > 0)
+    {
+      if (n > len - nxfer)
+        {
+          n = len - nxfer;
+        }
+
+      /* Unlock the pipe while 'xfer' runs.  Only this thread can move the
+       * read index, so it is unchanged when the pipe is locked again.
+       */
+
+      ndx = dev->d_rdndx;
+      nxsem_post(&dev->d_bfsem);
+
+      ret = xfer(arg, &dev->d_buffer[ndx], n);
+
+      pipecommon_semtake(&dev->d_bfsem);
+      DEBUGASSERT(dev->d_rdndx == ndx);
+
+      if (ret <= 0)
+        {
+          if (nxfer == 0)
+            {
+              nxfer = ret;
+            }
+
+          break;
+        }
+
+      pipecommon_rdadvance(dev, ret);
+      nxfer += ret;
+
+      if ((size_t)ret < n)
+        {
+          break;
+        }
+    }
+
+  /* Let other readers that waited for the transfer try again */
+
+  dev->d_flags &= ~PIPE_FLAG_RDSPLICE;
+  pipecommon_wakeup(&dev->d_rdsem);
+
+  if (nxfer > 0)
+    {
+      /* Notify all waiting writers that bytes have been removed from the
+       * buffer and all poll/select waiters that they can write to the FIFO.
+       */
+
+      pipecommon_wakeup(&dev->d_wrsem);
+      pipecommon_pollnotify(dev, POLLOUT);
+    }
+
+  nxsem_post(&dev->d_bfsem);
+  return nxfer;
+}
+
+/****************************************************************************
+ * Name: pipecommon_spliceto
+ *
+ * Description:
+ *   Add up to 'len' bytes to the pipe, letting 'xfer' produce them
+ *   directly into the free space of the circular buffer.  'xfer' is called
+ *   at most twice and may produce fewer bytes than there is room for.
+ *
+ *   The pipe is not locked while 'xfer' runs since it may block on the
+ *   other descriptor.  Instead, the pipe is marked so that other writers
+ *   wait until the transfer is complete.  Readers only remove data before
+ *   the space being filled, so that space stays free.
+ *
+ * Input Parameters:
+ *   filep    - The pipe, open for writing
+ *   xfer     - The function that produces the data
+ *   arg      - The argument passed to 'xfer'
+ *   len      - The maximum number of bytes to transfer
+ *   nonblock - True: Do not wait for space if the pipe is full
+ *
+ * Returned Value:
+ *   The number of bytes transferred, zero if 'xfer' reported end of file
+ *   or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pipecommon_spliceto(FAR struct file *filep, pipe_xfer_t xfer,
+                            FAR void *arg, size_t len, bool nonblock)
+{
+  FAR struct pipe_dev_s *dev   = filep->f_inode->i_private;
+  ssize_t                nxfer = 0;
+  ssize_t                ret;
+  pipe_ndx_t             ndx;
+  size_t                 n;
+
+  DEBUGASSERT(dev != NULL && xfer != NULL);
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  ret = nxsem_wait(&dev->d_bfsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = pipecommon_wrwait(dev, nonblock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  dev->d_flags |= PIPE_FLAG_WRSPLICE;
+
+  while ((size_t)nxfer < len && (n = pipecommon_wrlen(dev)) > 0)
+    {
+      if (n > len - nxfer)
+        {
+          n = len - nxfer;
+        }
+
+      /* Unlock the pipe while 'xfer' runs.  Only this thread can move the
+       * write index, so it is unchanged when the pipe is locked again.
+       */
+
+      ndx = dev->d_wrndx;
+      nxsem_post(&dev->d_bfsem);
+
+      ret = xfer(arg, &dev->d_buffer[ndx], n);
+
+      pipecommon_semtake(&dev->d_bfsem);
+      DEBUGASSERT(dev->d_wrndx == ndx);
+
+      if (ret <= 0)
+        {
+          if (nxfer == 0)
+            {
+              nxfer = ret;
+            }
+
+          break;
+        }
+
+      pipecommon_wradvance(dev, ret);
+      nxfer += ret;
+
+      if ((size_t)ret < n)
+        {
+          break;
+        }
+    }
+
+  /* Let other writers that waited for the transfer try again */
+
+  dev->d_flags &= ~PIPE_FLAG_WRSPLICE;
+  pipecommon_wakeup(&dev->d_wrsem);
+
+  if (nxfer > 0)
+    {
+      /* Notify all waiting readers and all poll/select waiters that more
+       * data is available.
+       */
+
+      pipecommon_wakeup(&dev->d_rdsem);
+      pipecommon_pollnotify(dev, POLLIN);
+    }
+
+  nxsem_post(&dev->d_bfsem);
+  return nxfer;
+}
+
+/****************************************************************************
+ * Name: pipecommon_splicepipe
+ *
+ * Description:
+ *   Copy up to 'len' bytes from one pipe to another, directly between the
+ *   two circular buffers.  If 'move' is true the bytes are removed from
+ *   the source pipe (splice), otherwise they are left in it (tee).
+ *
+ *   The two pipes are always locked in the same (address) order so that
+ *   transfers in opposite directions cannot deadlock.
+ *
+ * Input Parameters:
+ *   src      - The source pipe, open for reading
+ *   dest     - The destination pipe, open for writing
+ *   len      - The maximum number of bytes to transfer
+ *   move     - True: Remove the bytes from the source pipe
+ *   nonblock - True: Do not wait for data or for space
+ *
+ * Returned Value:
+ *   The number of bytes transferred, zero at end of file on the source
+ *   pipe or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pipecommon_splicepipe(FAR struct file *src, FAR struct file *dest,
+                              size_t len, bool move, bool nonblock)
+{
+  FAR struct pipe_dev_s *sdev = src->f_inode->i_private;
+  FAR struct pipe_dev_s *ddev = dest->f_inode->i_private;
+  FAR struct pipe_dev_s *first;
+  FAR struct pipe_dev_s *second;
+  FAR sem_t             *waitsem;
+  pipe_ndx_t             rdndx;
+  ssize_t                nxfer;
+  size_t                 n;
+  size_t                 m;
+  int                    ret;
+
+  DEBUGASSERT(sdev != NULL && ddev != NULL);
+
+  if (sdev == ddev)
+    {
+      return -EINVAL;
+    }
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  first  = sdev < ddev ? sdev : ddev;
+  second = sdev < ddev ? ddev : sdev;
+
+  for (; ; )
+    {
+      ret = nxsem_wait(&first->d_bfsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = nxsem_wait(&second->d_bfsem);
+      if (ret < 0)
+        {
+          nxsem_post(&first->d_bfsem);
+          return ret;
+        }
+
+      /* Is there data in the source pipe and space in the destination? */
+
+      if (sdev->d_wrndx == sdev->d_rdndx || PIPE_IS_RDSPLICE(sdev->d_flags))
+        {
+          if (sdev->d_nwriters <= 0 && !PIPE_IS_RDSPLICE(sdev->d_flags))
+            {
+              ret = 0;
+              goto errout_with_lock;
+            }
+
+          waitsem = &sdev->d_rdsem;
+        }
+      else if (ddev->d_nreaders <= 0)
+        {
+          ret = -EPIPE;
+          goto errout_with_lock;
+        }
+      else if (pipecommon_wrlen(ddev) == 0 ||
+               PIPE_IS_WRSPLICE(ddev->d_flags))
+        {
+          waitsem = &ddev->d_wrsem;
+        }
+      else
+        {
+          break;
+        }
+
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          goto errout_with_lock;
+        }
+
+      /* No.. wait for the source to be written or the destination to be
+       * read.
+       */
+
+      sched_lock();
+      nxsem_post(&second->d_bfsem);
+      nxsem_post(&first->d_bfsem);
+      ret = nxsem_wait(waitsem);
+      sched_unlock();
+
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Copy between the circular buffers.  Both the data in the source and the
+   * space in the destination may wrap so this takes at most three copies.
+   */
+
+  rdndx = sdev->d_rdndx;
+  nxfer = 0;
+
+  while ((size_t)nxfer < len &&
+         (n = pipecommon_rdlen(sdev)) > 0 &&
+         (m = pipecommon_wrlen(ddev)) > 0)
+    {
+      if (n > m)
+        {
+          n = m;
+        }
+
+      if (n > len - nxfer)
+        {
+          n = len - nxfer;
+        }
+
+      memcpy(&ddev->d_buffer[ddev->d_wrndx], &sdev->d_buffer[sdev->d_rdndx],
+             n);
+      pipecommon_rdadvance(sdev, n);
+      pipecommon_wradvance(ddev, n);
+      nxfer += n;
+    }
+
+  if (move)
+    {
+      pipecommon_wakeup(&sdev->d_wrsem);
+      pipecommon_pollnotify(sdev, POLLOUT);
+    }
+  else
+    {
+      /* tee() leaves the data in the source pipe */
+
+      sdev->d_rdndx = rdndx;
+    }
+
+  pipecommon_wakeup(&ddev->d_rdsem);
+  pipecommon_pollnotify(ddev, POLLIN);
+  ret = nxfer;
+
+errout_with_lock:
+  nxsem_post(&second->d_bfsem);
+  nxsem_post(&first->d_bfsem);
+  return ret;
+}
+#endif /* CONFIG_DEV_PIPE_SPLICE */
+
 /****************************************************************************
  * Name: pipecommon_unlink
  ****************************************************************************/
@@ -98,6 +98,8 @@
 
 #define PIPE_FLAG_POLICY    (1 << 0) /* Bit 0: Policy=Free buffer when empty */
 #define PIPE_FLAG_UNLINKED  (1 << 1) /* Bit 1: The driver has been unlinked */
+#define PIPE_FLAG_RDSPLICE  (1 << 2) /* Bit 2: splice() is taking data out */
+#define PIPE_FLAG_WRSPLICE  (1 << 3) /* Bit 3: splice() is putting data in */
 
 #define PIPE_POLICY_0(f)    do { (f) &= ~PIPE_FLAG_POLICY; } while (0)
 #define PIPE_POLICY_1(f)    do { (f) |= PIPE_FLAG_POLICY; } while (0)
@@ -107,6 +109,14 @@
 #define PIPE_UNLINK(f)      do { (f) |= PIPE_FLAG_UNLINKED; } while (0)
 #define PIPE_IS_UNLINKED(f) (((f) & PIPE_FLAG_UNLINKED) != 0)
 
+#ifdef CONFIG_DEV_PIPE_SPLICE
+#  define PIPE_IS_RDSPLICE(f) (((f) & PIPE_FLAG_RDSPLICE) != 0)
+#  define PIPE_IS_WRSPLICE(f) (((f) & PIPE_FLAG_WRSPLICE) != 0)
+#else
+#  define PIPE_IS_RDSPLICE(f) false
+#  define PIPE_IS_WRSPLICE(f) false
+#endif
+
 
 /****************************************************************************
  * Public Types
@@ -152,6 +162,16 @@ struct pipe_dev_s
 #endif
 };
 
+/* Used by splice() and tee() to move data directly into or out of the
+ * circular buffer of a pipe.  Returns the number of bytes transferred,
+ * zero at end of file or a negated errno value.
+ */
+
+#ifdef CONFIG_DEV_PIPE_SPLICE
+typedef CODE ssize_t (*pipe_xfer_t)(FAR void *arg, FAR uint8_t *buffer,
+                                    size_t len);
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -181,6 +201,15 @@ int     pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
 int     pipecommon_unlink(FAR struct inode *priv);
 #endif
+#ifdef CONFIG_DEV_PIPE_SPLICE
+bool    pipecommon_ispipe(FAR struct file *filep);
+ssize_t pipecommon_splicefrom(FAR struct file *filep, pipe_xfer_t xfer,
+                              FAR void *arg, size_t len, bool nonblock);
+ssize_t pipecommon_spliceto(FAR struct file *filep, pipe_xfer_t xfer,
+                            FAR void *arg, size_t len, bool nonblock);
+ssize_t pipecommon_splicepipe(FAR struct file *src, FAR struct file *dest,
+                              size_t len, bool move, bool nonblock);
+#endif
 
 #undef EXTERN
 #ifdef __cplusplus
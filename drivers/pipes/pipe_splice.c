@@ -0,0 +1,374 @@
+/****************************************************************************
+ * drivers/pipes/pipe_splice.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "pipe_common.h"
+
+#ifdef CONFIG_DEV_PIPE_SPLICE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+#  define HAVE_SPLICE_SOCKET 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The file or socket at the other end of a splice() */
+
+struct splice_file_s
+{
+  FAR struct file *filep;      /* The file (NULL if a socket) */
+  FAR off_t *offset;           /* The file position to use (may be NULL) */
+  int fd;                      /* The socket descriptor */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: splice_write
+ *
+ * Description:
+ *   Write data taken from a pipe to the file or socket.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_write(FAR void *arg, FAR uint8_t *buffer, size_t len)
+{
+  FAR struct splice_file_s *sf = (FAR struct splice_file_s *)arg;
+  ssize_t ret;
+
+#ifdef HAVE_SPLICE_SOCKET
+  if (sf->filep == NULL)
+    {
+      return nx_send(sf->fd, buffer, len, 0);
+    }
+#endif
+
+  if (sf->offset == NULL)
+    {
+      return file_write(sf->filep, buffer, len);
+    }
+
+  ret = file_pwrite(sf->filep, buffer, len, *sf->offset);
+  if (ret > 0)
+    {
+      *sf->offset += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: splice_read
+ *
+ * Description:
+ *   Read data from the file or socket into a pipe.
+ *
+ ****************************************************************************/
+
+static ssize_t splice_read(FAR void *arg, FAR uint8_t *buffer, size_t len)
+{
+  FAR struct splice_file_s *sf = (FAR struct splice_file_s *)arg;
+  ssize_t ret;
+
+#ifdef HAVE_SPLICE_SOCKET
+  if (sf->filep == NULL)
+    {
+      return nx_recv(sf->fd, buffer, len, 0);
+    }
+#endif
+
+  if (sf->offset == NULL)
+    {
+      return file_read(sf->filep, buffer, len);
+    }
+
+  ret = file_pread(sf->filep, buffer, len, *sf->offset);
+  if (ret > 0)
+    {
+      *sf->offset += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: splice_getfile
+ *
+ * Description:
+ *   Set up the description of a file or socket descriptor.
+ *
+ ****************************************************************************/
+
+static int splice_getfile(int fd, FAR off_t *offset,
+                          FAR struct splice_file_s *sf)
+{
+  sf->filep  = NULL;
+  sf->offset = offset;
+  sf->fd     = fd;
+
+  if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS)
+    {
+      return fs_getfilep(fd, &sf->filep);
+    }
+
+#ifdef HAVE_SPLICE_SOCKET
+  if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS +
+                         CONFIG_NSOCKET_DESCRIPTORS)
+    {
+      /* Sockets have no file position */
+
+      return offset != NULL ? -ESPIPE : OK;
+    }
+#endif
+
+  return -EBADF;
+}
+
+/****************************************************************************
+ * Name: splice_ispipe
+ ****************************************************************************/
+
+static inline bool splice_ispipe(FAR struct splice_file_s *sf)
+{
+  return sf->filep != NULL && pipecommon_ispipe(sf->filep);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: splice
+ *
+ * Description:
+ *   splice() moves up to 'len' bytes between two descriptors where at least
+ *   one of them is a pipe (or FIFO).  The data is copied directly into or
+ *   out of the circular buffer of the pipe, without going through a user
+ *   buffer.  The other descriptor may be a file, a socket or another pipe.
+ *
+ *   NOTE: This interface is *not* specified in POSIX.  It is similar to
+ *   the Linux splice() interface but NuttX has no pages to move, so the
+ *   data is always copied once.
+ *
+ * Input Parameters:
+ *   fd_in   - The descriptor to read from
+ *   off_in  - If 'fd_in' is a file, the file offset from which to read
+ *             (updated on return) or NULL to use and update the current
+ *             file position.  Must be NULL for pipes and sockets.
+ *   fd_out  - The descriptor to write to
+ *   off_out - Likewise for 'fd_out'
+ *   len     - The maximum number of bytes to move
+ *   flags   - SPLICE_F_NONBLOCK: Do not block on the pipe.  The other
+ *             flags are ignored.
+ *
+ * Returned Value:
+ *   The number of bytes moved, zero at end of input or, on failure, -1
+ *   with errno set appropriately:
+ *
+ *   EBADF  - A descriptor is not valid or not open for the right access.
+ *   EINVAL - Neither descriptor is a pipe, or both refer to the same pipe.
+ *   ESPIPE - An offset was given for a pipe or a socket.
+ *   EAGAIN - SPLICE_F_NONBLOCK was given and the pipe is empty or full.
+ *
+ ****************************************************************************/
+
+ssize_t splice(int fd_in, FAR off_t *off_in, int fd_out, FAR off_t *off_out,
+               size_t len, unsigned int flags)
+{
+  struct splice_file_s in;
+  struct splice_file_s out;
+  bool nonblock = (flags & SPLICE_F_NONBLOCK) != 0;
+  bool inpipe;
+  bool outpipe;
+  ssize_t ret;
+
+  ret = splice_getfile(fd_in, off_in, &in);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = splice_getfile(fd_out, off_out, &out);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  inpipe  = splice_ispipe(&in);
+  outpipe = splice_ispipe(&out);
+
+  if ((inpipe && off_in != NULL) || (outpipe && off_out != NULL))
+    {
+      ret = -ESPIPE;
+      goto errout;
+    }
+
+  if ((in.filep != NULL && (in.filep->f_oflags & O_RDOK) == 0) ||
+      (out.filep != NULL && (out.filep->f_oflags & O_WROK) == 0))
+    {
+      ret = -EBADF;
+      goto errout;
+    }
+
+  if (inpipe)
+    {
+      nonblock |= (in.filep->f_oflags & O_NONBLOCK) != 0;
+    }
+
+  if (outpipe)
+    {
+      nonblock |= (out.filep->f_oflags & O_NONBLOCK) != 0;
+    }
+
+  if (inpipe && outpipe)
+    {
+      ret = pipecommon_splicepipe(in.filep, out.filep, len, true, nonblock);
+    }
+  else if (inpipe)
+    {
+      ret = pipecommon_splicefrom(in.filep, splice_write, &out, len,
+                                  nonblock);
+    }
+  else if (outpipe)
+    {
+      ret = pipecommon_spliceto(out.filep, splice_read, &in, len,
+                                nonblock);
+    }
+  else
+    {
+      ret = -EINVAL;
+    }
+
+  if (ret >= 0)
+    {
+      return ret;
+    }
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: tee
+ *
+ * Description:
+ *   tee() copies up to 'len' bytes from one pipe to another without
+ *   removing them from the first pipe, so that a following splice() or
+ *   read() sees the same data.
+ *
+ *   NOTE: This interface is *not* specified in POSIX.  It is similar to
+ *   the Linux tee() interface.
+ *
+ * Input Parameters:
+ *   fd_in  - The pipe to copy from
+ *   fd_out - The pipe to copy to
+ *   len    - The maximum number of bytes to copy
+ *   flags  - SPLICE_F_NONBLOCK: Do not block.  The other flags are ignored.
+ *
+ * Returned Value:
+ *   The number of bytes copied, zero at end of input or, on failure, -1
+ *   with errno set appropriately (see splice()).
+ *
+ ****************************************************************************/
+
+ssize_t tee(int fd_in, int fd_out, size_t len, unsigned int flags)
+{
+  struct splice_file_s in;
+  struct splice_file_s out;
+  bool nonblock = (flags & SPLICE_F_NONBLOCK) != 0;
+  ssize_t ret;
+
+  ret = splice_getfile(fd_in, NULL, &in);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = splice_getfile(fd_out, NULL, &out);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  if (!splice_ispipe(&in) || !splice_ispipe(&out))
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  if ((in.filep->f_oflags & O_RDOK) == 0 ||
+      (out.filep->f_oflags & O_WROK) == 0)
+    {
+      ret = -EBADF;
+      goto errout;
+    }
+
+  nonblock |= ((in.filep->f_oflags | out.filep->f_oflags) & O_NONBLOCK) != 0;
+
+  ret = pipecommon_splicepipe(in.filep, out.filep, len, false, nonblock);
+  if (ret >= 0)
+    {
+      return ret;
+    }
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+#endif /* CONFIG_DEV_PIPE_SPLICE */
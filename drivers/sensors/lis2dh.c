@@ -49,6 +49,7 @@
 #include <poll.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/random.h>
@@ -773,7 +774,7 @@ static void lis2dh_notify(FAR struct lis2dh_dev_s *priv)
         {
           fds->revents |= POLLIN;
           lis2dh_dbg("lis2dh: Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
     }
 }
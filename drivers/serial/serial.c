@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <unistd.h>
@@ -101,16 +102,29 @@ static void    uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset);
 /* Write support */
 
 static int     uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock);
+static size_t  uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                               size_t buflen);
+static size_t  uart_rawlen(FAR uart_dev_t *dev, FAR const char *buffer,
+                           size_t buflen);
 static inline ssize_t uart_irqwrite(FAR uart_dev_t *dev, FAR const char *buffer,
                                     size_t buflen);
+static ssize_t uart_xmitbuffer(FAR uart_dev_t *dev, FAR const char *buffer,
+                               size_t buflen, bool oktoblock);
 static int     uart_tcdrain(FAR uart_dev_t *dev, clock_t timeout);
 
+/* Read support */
+
+static size_t  uart_getrecvbuf(FAR uart_dev_t *dev, FAR char *buffer,
+                               size_t buflen);
+
 /* Character driver methods */
 
 static int     uart_open(FAR struct file *filep);
 static int     uart_close(FAR struct file *filep);
 static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
 static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer, size_t buflen);
+static ssize_t uart_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                           int iovcnt);
 static int     uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
 #ifndef CONFIG_DISABLE_POLL
 static int     uart_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
@@ -134,6 +148,8 @@ static const struct file_operations g_serialops =
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL      /* unlink */
 #endif
+  , NULL      /* readv */
+  , uart_writev /* writev */
 };
 
 /************************************************************************************
@@ -204,7 +220,7 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
           if (fds->revents != 0)
             {
               finfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_post(fds);
             }
         }
     }
@@ -351,6 +367,163 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
   return OK;
 }
 
+/************************************************************************************
+ * Name: uart_putxmitbuf
+ *
+ * Description:
+ *   Copy as much of the user buffer as will fit into the TX circular buffer without
+ *   waiting.  The data is copied in at most two contiguous blocks and the head index
+ *   is updated only once.  Returns the number of bytes copied; zero means that the
+ *   TX buffer is full.
+ *
+ *   The tail index may be advanced asynchronously by the lower half while the data
+ *   is copied.  That only makes more space available, so the local copy of the tail
+ *   index is safe.
+ *
+ ************************************************************************************/
+
+static size_t uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                              size_t buflen)
+{
+  FAR struct uart_buffer_s *txbuf = &dev->xmit;
+  int16_t head = txbuf->head;
+  int16_t tail = txbuf->tail;
+  size_t ncopied = 0;
+  size_t nfree;
+
+  while (ncopied < buflen)
+    {
+      /* How much contiguous space is there at the head of the buffer?  One byte
+       * must remain unused to distinguish a full buffer from an empty one.
+       */
+
+      if (head >= tail)
+        {
+          nfree = txbuf->size - head;
+          if (tail == 0)
+            {
+              nfree--;
+            }
+        }
+      else
+        {
+          nfree = tail - head - 1;
+        }
+
+      if (nfree == 0)
+        {
+          break;
+        }
+
+      if (nfree > buflen - ncopied)
+        {
+          nfree = buflen - ncopied;
+        }
+
+      memcpy(&txbuf->buffer[head], &buffer[ncopied], nfree);
+      ncopied += nfree;
+
+      head += nfree;
+      if (head >= txbuf->size)
+        {
+          head = 0;
+        }
+    }
+
+  txbuf->head = head;
+  return ncopied;
+}
+
+/************************************************************************************
+ * Name: uart_rawlen
+ *
+ * Description:
+ *   Return the number of bytes at the beginning of the user buffer that need no
+ *   output post-processing and may be copied into the TX buffer as they are.
+ *
+ ************************************************************************************/
+
+static size_t uart_rawlen(FAR uart_dev_t *dev, FAR const char *buffer,
+                          size_t buflen)
+{
+#ifdef CONFIG_SERIAL_TERMIOS
+  bool mapcr;
+  bool mapnl;
+  size_t i;
+
+  if ((dev->tc_oflag & OPOST) == 0)
+    {
+      return buflen;
+    }
+
+  mapcr = (dev->tc_oflag & OCRNL) != 0;
+  mapnl = (dev->tc_oflag & (ONLCR | ONLRET)) != 0;
+  if (!mapcr && !mapnl)
+    {
+      return buflen;
+    }
+
+  for (i = 0; i < buflen; i++)
+    {
+      if ((mapnl && buffer[i] == '\n') || (mapcr && buffer[i] == '\r'))
+        {
+          break;
+        }
+    }
+
+  return i;
+
+#else
+  FAR const char *nl;
+
+  /* Only the console converts \n -> \r\n */
+
+  if (!dev->isconsole)
+    {
+      return buflen;
+    }
+
+  nl = (FAR const char *)memchr(buffer, '\n', buflen);
+  return nl != NULL ? (size_t)(nl - buffer) : buflen;
+#endif
+}
+
+/************************************************************************************
+ * Name: uart_getrecvbuf
+ *
+ * Description:
+ *   Copy the contiguous data at the tail of the RX circular buffer (up to the head
+ *   index or the end of the buffer) into the user buffer and update the tail index
+ *   once.  Returns the number of bytes copied.
+ *
+ ************************************************************************************/
+
+static size_t uart_getrecvbuf(FAR uart_dev_t *dev, FAR char *buffer,
+                              size_t buflen)
+{
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+  int16_t head = rxbuf->head;
+  int16_t tail = rxbuf->tail;
+  size_t nbytes;
+
+  nbytes = (head >= tail ? head : rxbuf->size) - tail;
+  if (nbytes > buflen)
+    {
+      nbytes = buflen;
+    }
+
+  memcpy(buffer, &rxbuf->buffer[tail], nbytes);
+
+  tail += nbytes;
+  if (tail >= rxbuf->size)
+    {
+      tail = 0;
+    }
+
+  rxbuf->tail = tail;
+  return nbytes;
+}
+
 /************************************************************************************
  * Name: uart_putc
  ************************************************************************************/
@@ -727,8 +900,11 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #endif
   irqstate_t flags;
   ssize_t recvd = 0;
+  size_t nbytes;
+#ifdef CONFIG_SERIAL_TERMIOS
   int16_t tail;
   char ch;
+#endif
   int ret;
 
   /* Only one user can access rxbuf->tail at a time */
@@ -778,31 +954,29 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
        * 8-bit accesses to obtain the 16-bit head index.
        */
 
-      tail = rxbuf->tail;
-      if (rxbuf->head != tail)
+      if (rxbuf->head != rxbuf->tail)
         {
-          /* Take the next character from the tail of the buffer */
-
-          ch = rxbuf->buffer[tail];
+#ifdef CONFIG_SERIAL_TERMIOS
+          if ((dev->tc_iflag & (INLCR | IGNCR | ICRNL)) != 0)
+            {
+              /* Take the next character from the tail of the buffer */
 
-          /* Increment the tail index.  Most operations are done using the
-           * local variable 'tail' so that the final rxbuf->tail update
-           * is atomic.
-           */
+              tail = rxbuf->tail;
+              ch   = rxbuf->buffer[tail];
 
-          if (++tail >= rxbuf->size)
-            {
-              tail = 0;
-            }
+              /* Increment the tail index.  Most operations are done using
+               * the local variable 'tail' so that the final rxbuf->tail
+               * update is atomic.
+               */
 
-          rxbuf->tail = tail;
+              if (++tail >= rxbuf->size)
+                {
+                  tail = 0;
+                }
 
-#ifdef CONFIG_SERIAL_TERMIOS
-          /* Do input processing if any is enabled */
+              rxbuf->tail = tail;
 
-          if (dev->tc_iflag & (INLCR | IGNCR | ICRNL))
-            {
-              /* \n -> \r or \r -> \n translation? */
+              /* Do input processing:  \n -> \r or \r -> \n translation? */
 
               if ((ch == '\n') && (dev->tc_iflag & INLCR))
                 {
@@ -819,22 +993,32 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
                 {
                   continue;
                 }
-            }
 
-          /* Specifically not handled:
-           *
-           * All of the local modes; echo, line editing, etc.
-           * Anything to do with break or parity errors.
-           * ISTRIP - we should be 8-bit clean.
-           * IUCLC - Not Posix
-           * IXON/OXOFF - no xon/xoff flow control.
-           */
-#endif
+              /* Specifically not handled:
+               *
+               * All of the local modes; echo, line editing, etc.
+               * Anything to do with break or parity errors.
+               * ISTRIP - we should be 8-bit clean.
+               * IUCLC - Not Posix
+               * IXON/OXOFF - no xon/xoff flow control.
+               */
 
-          /* Store the received character */
+              /* Store the received character */
+
+              *buffer++ = ch;
+              recvd++;
+            }
+          else
+#endif
+            {
+              /* No input processing is needed.  Copy as much of the received
+               * data as is contiguous in the circular buffer.
+               */
 
-          *buffer++ = ch;
-          recvd++;
+              nbytes  = uart_getrecvbuf(dev, buffer, buflen - recvd);
+              buffer += nbytes;
+              recvd  += nbytes;
+            }
         }
 
 #ifdef CONFIG_DEV_SERIAL_FULLBLOCKS
@@ -1056,87 +1240,43 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 }
 
 /************************************************************************************
- * Name: uart_write
+ * Name: uart_xmitbuffer
+ *
+ * Description:
+ *   Copy a user buffer into the TX buffer, performing any output processing and
+ *   waiting for space if 'oktoblock' is true.  The caller must hold xmit.sem and
+ *   must have disabled TX interrupts.  Returns the number of bytes transferred or,
+ *   if nothing was transferred, a negated errno value.
+ *
  ************************************************************************************/
 
-static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
-                          size_t buflen)
+static ssize_t uart_xmitbuffer(FAR uart_dev_t *dev, FAR const char *buffer,
+                               size_t buflen, bool oktoblock)
 {
-  FAR struct inode *inode    = filep->f_inode;
-  FAR uart_dev_t   *dev      = inode->i_private;
-  ssize_t           nwritten = buflen;
-  bool              oktoblock;
-  int               ret;
-  char              ch;
+  ssize_t nwritten = buflen;
+  size_t  nraw;
+  int     ret;
+  char    ch;
 
-  /* We may receive serial writes through this path from interrupt handlers and
-   * from debug output in the IDLE task!  In these cases, we will need to do things
-   * a little differently.
-   */
-
-  if (up_interrupt_context() || sched_idletask())
+  while (buflen > 0)
     {
-      irqstate_t flags;
-
-#ifdef CONFIG_SERIAL_REMOVABLE
-      /* If the removable device is no longer connected, refuse to write to
-       * the device.
+      /* Copy the data that needs no output processing directly into the TX
+       * buffer as a block.  If the TX buffer is full, fall through and let
+       * uart_putxmitchar() wait for space.
        */
 
-      if (dev->disconnected)
+      nraw = uart_rawlen(dev, buffer, buflen);
+      if (nraw > 0)
         {
-          return -ENOTCONN;
+          nraw = uart_putxmitbuf(dev, buffer, nraw);
+          if (nraw > 0)
+            {
+              buffer += nraw;
+              buflen -= nraw;
+              continue;
+            }
         }
-#endif
-
-      flags = enter_critical_section();
-      ret = uart_irqwrite(dev, buffer, buflen);
-      leave_critical_section(flags);
-
-      return ret;
-    }
-
-  /* Only one user can access dev->xmit.head at a time */
-
-  ret = (ssize_t)uart_takesem(&dev->xmit.sem, true);
-  if (ret < 0)
-    {
-      /* A signal received while waiting for access to the xmit.head will
-       * abort the transfer.  After the transfer has started, we are committed
-       * and signals will be ignored.
-       */
-
-      return ret;
-    }
-
-#ifdef CONFIG_SERIAL_REMOVABLE
-  /* If the removable device is no longer connected, refuse to write to the
-   * device.  This check occurs after taking the xmit.sem because the
-   * disconnection event might have occurred while we were waiting for
-   * access to the transmit buffers.
-   */
-
-  if (dev->disconnected)
-    {
-      uart_givesem(&dev->xmit.sem);
-      return -ENOTCONN;
-    }
-#endif
-
-  /* Can the following loop block, waiting for space in the TX
-   * buffer?
-   */
 
-  oktoblock = ((filep->f_oflags & O_NONBLOCK) == 0);
-
-  /* Loop while we still have data to copy to the transmit buffer.
-   * we add data to the head of the buffer; uart_xmitchars takes the
-   * data from the end of the buffer.
-   */
-
-  uart_disabletxint(dev);
-  for (; buflen; buflen--)
-    {
       ch  = *buffer++;
       ret = OK;
 
@@ -1220,6 +1360,138 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
 
           break;
         }
+
+      buflen--;
+    }
+
+  return nwritten;
+}
+
+/************************************************************************************
+ * Name: uart_writev
+ *
+ * Description:
+ *   Write all of the buffers of an I/O vector while holding xmit.sem and with TX
+ *   interrupts disabled only once, so that the data is queued contiguously and TX
+ *   is started only once.
+ *
+ ************************************************************************************/
+
+static ssize_t uart_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                           int iovcnt)
+{
+  FAR struct inode *inode    = filep->f_inode;
+  FAR uart_dev_t   *dev      = inode->i_private;
+  ssize_t           nwritten = 0;
+  ssize_t           nsent;
+  irqstate_t        flags;
+  bool              oktoblock;
+  int               ret;
+  int               i;
+
+  /* We may receive serial writes through this path from interrupt handlers and
+   * from debug output in the IDLE task!  In these cases, we will need to do things
+   * a little differently.
+   */
+
+  if (up_interrupt_context() || sched_idletask())
+    {
+#ifdef CONFIG_SERIAL_REMOVABLE
+      /* If the removable device is no longer connected, refuse to write to
+       * the device.
+       */
+
+      if (dev->disconnected)
+        {
+          return -ENOTCONN;
+        }
+#endif
+
+      flags = enter_critical_section();
+      for (i = 0; i < iovcnt; i++)
+        {
+          nwritten += uart_irqwrite(dev, iov[i].iov_base, iov[i].iov_len);
+        }
+
+      leave_critical_section(flags);
+      return nwritten;
+    }
+
+  /* Only one user can access dev->xmit.head at a time */
+
+  ret = (ssize_t)uart_takesem(&dev->xmit.sem, true);
+  if (ret < 0)
+    {
+      /* A signal received while waiting for access to the xmit.head will
+       * abort the transfer.  After the transfer has started, we are committed
+       * and signals will be ignored.
+       */
+
+      return ret;
+    }
+
+#ifdef CONFIG_SERIAL_REMOVABLE
+  /* If the removable device is no longer connected, refuse to write to the
+   * device.  This check occurs after taking the xmit.sem because the
+   * disconnection event might have occurred while we were waiting for
+   * access to the transmit buffers.
+   */
+
+  if (dev->disconnected)
+    {
+      uart_givesem(&dev->xmit.sem);
+      return -ENOTCONN;
+    }
+#endif
+
+  /* Can the following loops block, waiting for space in the TX
+   * buffer?
+   */
+
+  oktoblock = ((filep->f_oflags & O_NONBLOCK) == 0);
+
+  /* We add data to the head of the buffer; uart_xmitchars takes the
+   * data from the end of the buffer.
+   */
+
+  uart_disabletxint(dev);
+
+  /* If the TX buffer is empty, restart at the beginning of the buffer so that
+   * the new data is contiguous and can be handed to the lower half as a single
+   * region.
+   */
+
+  flags = enter_critical_section();
+  if (dev->xmit.head == dev->xmit.tail)
+    {
+      dev->xmit.head = 0;
+      dev->xmit.tail = 0;
+    }
+
+  leave_critical_section(flags);
+
+  /* Copy each buffer in turn, stopping at the first short transfer */
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      nsent = uart_xmitbuffer(dev, iov[i].iov_base, iov[i].iov_len, oktoblock);
+      if (nsent < 0)
+        {
+          /* Return the error only if no data was transferred */
+
+          if (nwritten == 0)
+            {
+              nwritten = nsent;
+            }
+
+          break;
+        }
+
+      nwritten += nsent;
+      if ((size_t)nsent < iov[i].iov_len)
+        {
+          break;
+        }
     }
 
   if (dev->xmit.head != dev->xmit.tail)
@@ -1234,6 +1506,21 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
   return nwritten;
 }
 
+/************************************************************************************
+ * Name: uart_write
+ ************************************************************************************/
+
+static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
+                          size_t buflen)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buffer;
+  iov.iov_len  = buflen;
+
+  return uart_writev(filep, &iov, 1);
+}
+
 /************************************************************************************
  * Name: uart_ioctl
  ************************************************************************************/
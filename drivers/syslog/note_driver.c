@@ -56,6 +56,8 @@
 
 static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+static int     note_ioctl(FAR struct file *filep, int cmd,
+                         unsigned long arg);
 
 /****************************************************************************
  * Private Data
@@ -68,7 +70,7 @@ static const struct file_operations note_fops =
   note_read,     /* read */
   0,             /* write */
   0,             /* seek */
-  0              /* ioctl */
+  note_ioctl     /* ioctl */
 #ifndef CONFIG_DISABLE_POLL
   , 0            /* poll */
 #endif
@@ -141,6 +143,34 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
   return retlen;
 }
 
+/****************************************************************************
+ * Name: note_ioctl
+ ****************************************************************************/
+
+static int note_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  switch (cmd)
+    {
+      /* Get the number of notes dropped because the buffer was full */
+
+      case NOTEIOC_GETDROPPED:
+        {
+          FAR unsigned long *dropped = (FAR unsigned long *)((uintptr_t)arg);
+
+          if (dropped == NULL)
+            {
+              return -EINVAL;
+            }
+
+          *dropped = sched_note_dropped();
+          return OK;
+        }
+
+      default:
+        return -ENOTTY;
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -44,6 +44,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <fcntl.h>
@@ -61,8 +62,59 @@
 
 #include <nuttx/irq.h>
 
+#ifdef CONFIG_RAMLOG_BINARY
+#  include <nuttx/init.h>
+#  include <nuttx/clock.h>
+#  include <nuttx/streams.h>
+#  include "syslog.h"
+#endif
+
 #ifdef CONFIG_RAMLOG
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_BINARY
+/* In the binary mode, the circular buffer holds a sequence of records.  Each
+ * record begins with a two byte header:  The record type and the length of
+ * the payload that follows.
+ *
+ * The payload of a text record is just the text.  The payload of a binary
+ * record holds the system time, the address of the format string and the
+ * raw values of the arguments.  Strings are copied into the record because
+ * they may not persist until the record is formatted.
+ */
+
+#  define RAMLOG_TYPE_TEXT     0
+#  define RAMLOG_TYPE_BINARY   1
+
+#  define RAMLOG_HDRSIZE       2
+#  define RAMLOG_NOTEXT        SIZE_MAX
+
+/* Text records are limited by the size of the length field and by the size
+ * of the line buffer where they are copied when read.
+ */
+
+#  if CONFIG_RAMLOG_BINARY_LINESIZE < UINT8_MAX
+#    define RAMLOG_TEXTMAX     CONFIG_RAMLOG_BINARY_LINESIZE
+#  else
+#    define RAMLOG_TEXTMAX     UINT8_MAX
+#  endif
+
+/* Argument types, as they are taken from the variable argument list by
+ * lib_vsprintf().
+ */
+
+#  define RAMLOG_ARG_NONE      0
+#  define RAMLOG_ARG_INT       1
+#  define RAMLOG_ARG_LONG      2
+#  define RAMLOG_ARG_LLONG     3
+#  define RAMLOG_ARG_PTR       4
+#  define RAMLOG_ARG_DOUBLE    5
+#  define RAMLOG_ARG_STRING    6
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -72,14 +124,21 @@ struct ramlog_dev_s
 #ifndef CONFIG_RAMLOG_NONBLOCKING
   volatile uint8_t  rl_nwaiters;     /* Number of threads waiting for data */
 #endif
-  volatile uint16_t rl_head;         /* The head index (where data is added) */
-  volatile uint16_t rl_tail;         /* The tail index (where data is removed) */
+  volatile size_t   rl_head;         /* The head index (where data is added) */
+  volatile size_t   rl_tail;         /* The tail index (where data is removed) */
   sem_t             rl_exclsem;      /* Enforces mutually exclusive access */
 #ifndef CONFIG_RAMLOG_NONBLOCKING
   sem_t             rl_waitsem;      /* Used to wait for data */
 #endif
   size_t            rl_bufsize;      /* Size of the RAM buffer */
   FAR char         *rl_buffer;       /* Circular RAM buffer */
+#ifdef CONFIG_RAMLOG_BINARY
+  volatile size_t   rl_textrec;      /* Index of the last record, if text */
+  uint16_t          rl_linepos;      /* Read position in rl_line[] */
+  uint16_t          rl_linelen;      /* Number of characters in rl_line[] */
+  char              rl_line[CONFIG_RAMLOG_BINARY_LINESIZE];
+                                     /* The last record read, formatted */
+#endif
 
   /* The following is a list if poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -91,6 +150,16 @@ struct ramlog_dev_s
 #endif
 };
 
+#ifdef CONFIG_RAMLOG_BINARY
+/* The output stream used to format a binary record into the line buffer */
+
+struct ramlog_linestream_s
+{
+  struct lib_outstream_s public;
+  FAR struct ramlog_dev_s *priv;
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -107,7 +176,13 @@ static int ramlog_flush(void);
 static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                               pollevent_t eventset);
 #endif
+#if !defined(CONFIG_RAMLOG_NONBLOCKING) || !defined(CONFIG_DISABLE_POLL)
+static void ramlog_readnotify(FAR struct ramlog_dev_s *priv);
+#endif
 static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+#ifdef CONFIG_RAMLOG_BINARY
+static int     ramlog_getchar(FAR struct ramlog_dev_s *priv);
+#endif
 
 /* Character driver methods */
 
@@ -178,6 +253,9 @@ static struct ramlog_dev_s g_sysdev =
 #endif
   CONFIG_RAMLOG_BUFSIZE,         /* rl_bufsize */
   g_sysbuffer                    /* rl_buffer */
+#ifdef CONFIG_RAMLOG_BINARY
+  , RAMLOG_NOTEXT                /* rl_textrec */
+#endif
 };
 #endif
 
@@ -219,7 +297,7 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
           fds->revents |= (fds->events & eventset);
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_post(fds);
             }
         }
       leave_critical_section(flags);
@@ -229,6 +307,611 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
 #  define ramlog_pollnotify(priv,event)
 #endif
 
+/****************************************************************************
+ * Name: ramlog_readnotify
+ *
+ * Description:
+ *   Wake up the readers waiting for data and notify all poll/select waiters
+ *   that data is available.  This function may be called from an interrupt
+ *   handler.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_RAMLOG_NONBLOCKING) || !defined(CONFIG_DISABLE_POLL)
+static void ramlog_readnotify(FAR struct ramlog_dev_s *priv)
+{
+  irqstate_t flags;
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  int i;
+#endif
+
+  /* Are there threads waiting for read data? */
+
+  flags = enter_critical_section();
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  for (i = 0; i < priv->rl_nwaiters; i++)
+    {
+      /* Yes.. Notify all of the waiting readers that more data is available */
+
+      nxsem_post(&priv->rl_waitsem);
+    }
+#endif
+
+  /* Notify all poll/select waiters that they can write to the FIFO */
+
+  ramlog_pollnotify(priv, POLLIN);
+  leave_critical_section(flags);
+}
+#else
+#  define ramlog_readnotify(priv)
+#endif
+
+#ifdef CONFIG_RAMLOG_BINARY
+/****************************************************************************
+ * Name: ramlog_space
+ *
+ * Description:
+ *   Return the number of free bytes in the circular buffer.  Interrupts
+ *   must be disabled.
+ *
+ ****************************************************************************/
+
+static size_t ramlog_space(FAR struct ramlog_dev_s *priv)
+{
+  size_t used;
+
+  if (priv->rl_head >= priv->rl_tail)
+    {
+      used = priv->rl_head - priv->rl_tail;
+    }
+  else
+    {
+      used = priv->rl_bufsize - priv->rl_tail + priv->rl_head;
+    }
+
+  return priv->rl_bufsize - used - 1;
+}
+
+/****************************************************************************
+ * Name: ramlog_copyin and ramlog_copyout
+ *
+ * Description:
+ *   Copy data into or out of the circular buffer at the given index,
+ *   handling the wrap-around at the end of the buffer.  The index after the
+ *   data is returned.
+ *
+ ****************************************************************************/
+
+static size_t ramlog_copyin(FAR struct ramlog_dev_s *priv, size_t ndx,
+                            FAR const uint8_t *src, size_t len)
+{
+  size_t nbytes = priv->rl_bufsize - ndx;
+
+  if (nbytes > len)
+    {
+      nbytes = len;
+    }
+
+  memcpy(&priv->rl_buffer[ndx], src, nbytes);
+  memcpy(priv->rl_buffer, src + nbytes, len - nbytes);
+
+  ndx += len;
+  return ndx >= priv->rl_bufsize ? ndx - priv->rl_bufsize : ndx;
+}
+
+static size_t ramlog_copyout(FAR struct ramlog_dev_s *priv, size_t ndx,
+                             FAR uint8_t *dest, size_t len)
+{
+  size_t nbytes = priv->rl_bufsize - ndx;
+
+  if (nbytes > len)
+    {
+      nbytes = len;
+    }
+
+  memcpy(dest, &priv->rl_buffer[ndx], nbytes);
+  memcpy(dest + nbytes, priv->rl_buffer, len - nbytes);
+
+  ndx += len;
+  return ndx >= priv->rl_bufsize ? ndx - priv->rl_bufsize : ndx;
+}
+
+/****************************************************************************
+ * Name: ramlog_addrecord
+ *
+ * Description:
+ *   Add one complete record to the circular buffer.  The record is dropped
+ *   if there is not enough space for it.
+ *
+ ****************************************************************************/
+
+static int ramlog_addrecord(FAR struct ramlog_dev_s *priv,
+                            FAR const uint8_t *record, size_t len)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (ramlog_space(priv) < len)
+    {
+      leave_critical_section(flags);
+      return -EBUSY;
+    }
+
+  priv->rl_head    = ramlog_copyin(priv, priv->rl_head, record, len);
+  priv->rl_textrec = RAMLOG_NOTEXT;
+  leave_critical_section(flags);
+
+  ramlog_readnotify(priv);
+  return len;
+}
+
+/****************************************************************************
+ * Name: ramlog_addchar
+ *
+ * Description:
+ *   Add one character of text to the circular buffer.  The character is
+ *   appended to the last record if that is a text record with room for it;
+ *   otherwise a new text record is started.
+ *
+ ****************************************************************************/
+
+static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch)
+{
+  irqstate_t flags;
+  uint8_t record[RAMLOG_HDRSIZE + 1];
+  size_t lenndx;
+
+  /* Disable interrupts (in case we are NOT called from interrupt handler) */
+
+  flags = enter_critical_section();
+
+  if (priv->rl_textrec != RAMLOG_NOTEXT)
+    {
+      lenndx = priv->rl_textrec + 1;
+      if (lenndx >= priv->rl_bufsize)
+        {
+          lenndx = 0;
+        }
+
+      if ((uint8_t)priv->rl_buffer[lenndx] < RAMLOG_TEXTMAX &&
+          ramlog_space(priv) >= 1)
+        {
+          /* Add the character and then update the length of the record */
+
+          priv->rl_head = ramlog_copyin(priv, priv->rl_head,
+                                        (FAR const uint8_t *)&ch, 1);
+          priv->rl_buffer[lenndx]++;
+          leave_critical_section(flags);
+          return OK;
+        }
+    }
+
+  if (ramlog_space(priv) < sizeof(record))
+    {
+      /* The buffer is full.  Return an indication that nothing was saved */
+
+      leave_critical_section(flags);
+      return -EBUSY;
+    }
+
+  record[0] = RAMLOG_TYPE_TEXT;
+  record[1] = 1;
+  record[2] = (uint8_t)ch;
+
+  priv->rl_textrec = priv->rl_head;
+  priv->rl_head    = ramlog_copyin(priv, priv->rl_head, record,
+                                   sizeof(record));
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ramlog_scanspec
+ *
+ * Description:
+ *   Scan one conversion specification of a format string and return the
+ *   type of the argument that lib_vsprintf() will take for it and the
+ *   number of '*' field widths that precede that argument.  This must
+ *   follow the parsing in lib_vsprintf() exactly.
+ *
+ * Input Parameters:
+ *   fmt    - The format string, just after the '%'
+ *   type   - The location to return the argument type
+ *   nstars - The location to return the number of '*' field widths
+ *
+ * Returned Value:
+ *   A pointer to the conversion character that ends the specification or
+ *   to the terminating NUL of a truncated specification.
+ *
+ ****************************************************************************/
+
+static FAR const char *ramlog_scanspec(FAR const char *fmt,
+                                       FAR uint8_t *type, FAR int *nstars)
+{
+  bool islong = false;
+  bool islonglong = false;
+
+  *type   = RAMLOG_ARG_NONE;
+  *nstars = 0;
+
+  /* Skip over the flags, field width and precision */
+
+  for (; *fmt != '\0'; fmt++)
+    {
+      if (strchr("diuxXpobeEfgGlLsc%", *fmt) != NULL)
+        {
+          break;
+        }
+      else if (*fmt == '*')
+        {
+          (*nstars)++;
+        }
+    }
+
+  if (*fmt == 's')
+    {
+      *type = RAMLOG_ARG_STRING;
+      return fmt;
+    }
+  else if (*fmt == 'c')
+    {
+      *type = RAMLOG_ARG_INT;
+      return fmt;
+    }
+
+  /* Check for the length modifiers */
+
+  if (*fmt == 'L')
+    {
+      islonglong = true;
+      fmt++;
+    }
+  else if (*fmt == 'l')
+    {
+      islong = true;
+      fmt++;
+      if (*fmt == 'l')
+        {
+          islonglong = true;
+          fmt++;
+        }
+    }
+
+  if (*fmt == '\0')
+    {
+      return fmt;
+    }
+
+  if (strchr("diuxXpob", *fmt) != NULL)
+    {
+#if defined(CONFIG_HAVE_LONG_LONG) && defined(CONFIG_LIBC_LONG_LONG)
+      if (islonglong && *fmt != 'p')
+        {
+          *type = RAMLOG_ARG_LLONG;
+        }
+      else
+#endif
+#ifdef CONFIG_LONG_IS_NOT_INT
+      if (islong && *fmt != 'p')
+        {
+          *type = RAMLOG_ARG_LONG;
+        }
+      else
+#endif
+#ifdef CONFIG_PTR_IS_NOT_INT
+      if (*fmt == 'p')
+        {
+          *type = RAMLOG_ARG_PTR;
+        }
+      else
+#endif
+        {
+          *type = RAMLOG_ARG_INT;
+        }
+    }
+#ifdef CONFIG_LIBC_FLOATINGPOINT
+  else if (strchr("eEfgG", *fmt) != NULL)
+    {
+      *type = RAMLOG_ARG_DOUBLE;
+    }
+#endif
+
+  UNUSED(islong);
+  UNUSED(islonglong);
+  return fmt;
+}
+
+/****************************************************************************
+ * Name: ramlog_lineputc
+ *
+ * Description:
+ *   The put method of the output stream used to format a binary record into
+ *   the line buffer.  Output beyond the end of the line buffer is lost.
+ *
+ ****************************************************************************/
+
+static void ramlog_lineputc(FAR struct lib_outstream_s *this, int ch)
+{
+  FAR struct ramlog_dev_s *priv =
+    ((FAR struct ramlog_linestream_s *)this)->priv;
+
+#ifdef CONFIG_RAMLOG_CRLF
+  /* Ignore carriage returns and pre-pend a carriage return before a
+   * linefeed, as is done for the text.
+   */
+
+  if (ch == '\r')
+    {
+      return;
+    }
+
+  if (ch == '\n' && priv->rl_linelen < CONFIG_RAMLOG_BINARY_LINESIZE)
+    {
+      priv->rl_line[priv->rl_linelen++] = '\r';
+    }
+#endif
+
+  if (priv->rl_linelen < CONFIG_RAMLOG_BINARY_LINESIZE)
+    {
+      priv->rl_line[priv->rl_linelen++] = ch;
+      this->nput++;
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_format
+ *
+ * Description:
+ *   Format the payload of a binary record into the line buffer.  The
+ *   format string is parsed again to recover the argument types and each
+ *   conversion is formatted separately with lib_sprintf().
+ *
+ ****************************************************************************/
+
+static void ramlog_format(FAR struct ramlog_dev_s *priv,
+                          FAR const uint8_t *payload, size_t len)
+{
+  struct ramlog_linestream_s stream;
+  FAR const uint8_t *end = payload + len;
+  FAR const char *fmt;
+  FAR const char *conv;
+  char spec[32];
+  clock_t systime;
+  uint8_t type;
+  size_t speclen;
+  int nstars;
+
+  stream.public.put   = ramlog_lineputc;
+  stream.public.flush = lib_noflush;
+  stream.public.nput  = 0;
+  stream.priv         = priv;
+
+  if (len < sizeof(clock_t) + sizeof(FAR const char *))
+    {
+      return;
+    }
+
+  memcpy(&systime, payload, sizeof(clock_t));
+  payload += sizeof(clock_t);
+  memcpy(&fmt, payload, sizeof(FAR const char *));
+  payload += sizeof(FAR const char *);
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  /* Pre-pend the message with the time that the record was saved */
+
+  lib_sprintf(&stream.public, "[%5d.%06d] ", (int)(systime / TICK_PER_SEC),
+              (int)((systime % TICK_PER_SEC) * USEC_PER_TICK));
+#else
+  UNUSED(systime);
+#endif
+
+#ifdef CONFIG_SYSLOG_PREFIX
+  /* Pre-pend the prefix, if available */
+
+  lib_sprintf(&stream.public, "%s", CONFIG_SYSLOG_PREFIX_STRING);
+#endif
+
+/* Take the next raw argument value from the record */
+
+#define RAMLOG_GETARG(v) \
+  do \
+    { \
+      if ((size_t)(end - payload) < sizeof(v)) \
+        { \
+          return; \
+        } \
+      memcpy(&(v), payload, sizeof(v)); \
+      payload += sizeof(v); \
+    } \
+  while (0)
+
+  while (*fmt != '\0')
+    {
+      if (*fmt != '%')
+        {
+          stream.public.put(&stream.public, *fmt++);
+          continue;
+        }
+
+      conv = ramlog_scanspec(fmt + 1, &type, &nstars);
+      if (*conv == '\0')
+        {
+          return;
+        }
+
+      /* Copy the conversion specification, replacing each '*' field width
+       * with the value that was saved for it.
+       */
+
+      for (speclen = 0; fmt <= conv; fmt++)
+        {
+          if (speclen >= sizeof(spec) - 12)
+            {
+              return;
+            }
+
+          if (*fmt == '*')
+            {
+              int width;
+
+              RAMLOG_GETARG(width);
+              speclen += snprintf(&spec[speclen], sizeof(spec) - speclen,
+                                  "%d", width);
+            }
+          else
+            {
+              spec[speclen++] = *fmt;
+            }
+        }
+
+      spec[speclen] = '\0';
+
+      switch (type)
+        {
+          case RAMLOG_ARG_NONE:
+            if (*conv == '%')
+              {
+                stream.public.put(&stream.public, '%');
+              }
+            break;
+
+          case RAMLOG_ARG_INT:
+            {
+              int value;
+
+              RAMLOG_GETARG(value);
+              lib_sprintf(&stream.public, spec, value);
+            }
+            break;
+
+#ifdef CONFIG_LONG_IS_NOT_INT
+          case RAMLOG_ARG_LONG:
+            {
+              long value;
+
+              RAMLOG_GETARG(value);
+              lib_sprintf(&stream.public, spec, value);
+            }
+            break;
+#endif
+
+#if defined(CONFIG_HAVE_LONG_LONG) && defined(CONFIG_LIBC_LONG_LONG)
+          case RAMLOG_ARG_LLONG:
+            {
+              long long value;
+
+              RAMLOG_GETARG(value);
+              lib_sprintf(&stream.public, spec, value);
+            }
+            break;
+#endif
+
+#ifdef CONFIG_PTR_IS_NOT_INT
+          case RAMLOG_ARG_PTR:
+            {
+              FAR void *value;
+
+              RAMLOG_GETARG(value);
+              lib_sprintf(&stream.public, spec, value);
+            }
+            break;
+#endif
+
+#ifdef CONFIG_LIBC_FLOATINGPOINT
+          case RAMLOG_ARG_DOUBLE:
+            {
+              double value;
+
+              RAMLOG_GETARG(value);
+              lib_sprintf(&stream.public, spec, value);
+            }
+            break;
+#endif
+
+          case RAMLOG_ARG_STRING:
+            {
+              size_t slen = strnlen((FAR const char *)payload, end - payload);
+
+              if (slen >= (size_t)(end - payload))
+                {
+                  return;
+                }
+
+              lib_sprintf(&stream.public, spec, (FAR const char *)payload);
+              payload += slen + 1;
+            }
+            break;
+
+          default:
+            break;
+        }
+    }
+
+#undef RAMLOG_GETARG
+}
+
+/****************************************************************************
+ * Name: ramlog_getchar
+ *
+ * Description:
+ *   Return the next character of the formatted output, taking the next
+ *   record out of the circular buffer when the line buffer is exhausted.
+ *   The caller holds rl_exclsem.
+ *
+ * Returned Value:
+ *   The next character or -ENODATA if the RAM log is empty.
+ *
+ ****************************************************************************/
+
+static int ramlog_getchar(FAR struct ramlog_dev_s *priv)
+{
+  uint8_t record[RAMLOG_HDRSIZE + UINT8_MAX];
+  irqstate_t flags;
+  size_t ndx;
+
+  while (priv->rl_linepos >= priv->rl_linelen)
+    {
+      /* Take the next record out of the circular buffer */
+
+      flags = enter_critical_section();
+      if (priv->rl_head == priv->rl_tail)
+        {
+          leave_critical_section(flags);
+          return -ENODATA;
+        }
+
+      ndx = ramlog_copyout(priv, priv->rl_tail, record, RAMLOG_HDRSIZE);
+      ndx = ramlog_copyout(priv, ndx, &record[RAMLOG_HDRSIZE], record[1]);
+
+      /* No more text may be appended to a text record once it is read */
+
+      if (priv->rl_textrec == priv->rl_tail)
+        {
+          priv->rl_textrec = RAMLOG_NOTEXT;
+        }
+
+      priv->rl_tail = ndx;
+      leave_critical_section(flags);
+
+      /* Then format it into the line buffer */
+
+      priv->rl_linepos = 0;
+      priv->rl_linelen = 0;
+
+      if (record[0] == RAMLOG_TYPE_TEXT)
+        {
+          memcpy(priv->rl_line, &record[RAMLOG_HDRSIZE], record[1]);
+          priv->rl_linelen = record[1];
+        }
+      else
+        {
+          ramlog_format(priv, &record[RAMLOG_HDRSIZE], record[1]);
+        }
+    }
+
+  return (uint8_t)priv->rl_line[priv->rl_linepos++];
+}
+#else
 /****************************************************************************
  * Name: ramlog_addchar
  ****************************************************************************/
@@ -267,6 +950,7 @@ static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch)
   leave_critical_section(flags);
   return OK;
 }
+#endif /* CONFIG_RAMLOG_BINARY */
 
 /****************************************************************************
  * Name: ramlog_read
@@ -305,7 +989,12 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
     {
       /* Get the next byte from the buffer */
 
+#ifdef CONFIG_RAMLOG_BINARY
+      ret = ramlog_getchar(priv);
+      if (ret < 0)
+#else
       if (priv->rl_head == priv->rl_tail)
+#endif
         {
           /* The circular buffer is empty. */
 
@@ -396,6 +1085,11 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
         }
       else
         {
+#ifdef CONFIG_RAMLOG_BINARY
+          /* ramlog_getchar() returned the next formatted character */
+
+          ch = (char)ret;
+#else
           /* The circular buffer is not empty, get the next byte from the
            * tail index.
            */
@@ -408,6 +1102,7 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
             {
               priv->rl_tail = 0;
             }
+#endif
 
           /* Add the character to the user buffer */
 
@@ -511,32 +1206,10 @@ static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer, size
 
   /* Was anything written? */
 
-#if !defined(CONFIG_RAMLOG_NONBLOCKING) || !defined(CONFIG_DISABLE_POLL)
   if (nwritten > 0)
     {
-      irqstate_t flags;
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-      int i;
-#endif
-
-      /* Are there threads waiting for read data? */
-
-      flags = enter_critical_section();
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-      for (i = 0; i < priv->rl_nwaiters; i++)
-        {
-          /* Yes.. Notify all of the waiting readers that more data is available */
-
-          nxsem_post(&priv->rl_waitsem);
-        }
-#endif
-
-      /* Notify all poll/select waiters that they can write to the FIFO */
-
-      ramlog_pollnotify(priv, POLLIN);
-      leave_critical_section(flags);
+      ramlog_readnotify(priv);
     }
-#endif
 
   /* We always have to return the number of bytes requested and NOT the
    * number of bytes that were actually written.  Otherwise, callers
@@ -621,7 +1294,12 @@ int ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 
       /* Check if the receive buffer is empty */
 
+#ifdef CONFIG_RAMLOG_BINARY
+      if (priv->rl_head != priv->rl_tail ||
+          priv->rl_linepos < priv->rl_linelen)
+#else
       if (priv->rl_head != priv->rl_tail)
+#endif
        {
          eventset |= POLLIN;
        }
@@ -816,4 +1494,160 @@ int ramlog_putc(int ch)
 }
 #endif
 
+/****************************************************************************
+ * Name: ramlog_vsyslog
+ *
+ * Description:
+ *   Save a SYSLOG message as a binary record without formatting it.  The
+ *   record holds the system time, the address of the format string and the
+ *   raw argument values; the message is formatted only when the RAM log is
+ *   read.  This function may be called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   fmt - The format string.  It must persist until the record is read.
+ *   ap  - The arguments of the format string
+ *
+ * Returned Value:
+ *   The size of the record on success; -ENOSYS if the RAMLOG is not the
+ *   current SYSLOG channel (in which case nothing has been taken from
+ *   'ap'); -EBUSY if the RAM log is full and the message was dropped.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_BINARY
+int ramlog_vsyslog(FAR const char *fmt, FAR va_list *ap)
+{
+  uint8_t record[RAMLOG_HDRSIZE + CONFIG_RAMLOG_BINARY_RECSIZE];
+  FAR const char *conv;
+  clock_t systime = 0;
+  size_t len;
+  uint8_t type;
+  int nstars;
+
+  if (g_syslog_channel != &g_ramlog_syslog_channel)
+    {
+      return -ENOSYS;
+    }
+
+  /* Hardware timer support may not yet be available early in the start-up
+   * sequence.
+   */
+
+  if (OSINIT_HW_READY())
+    {
+      systime = clock_systimer();
+    }
+
+  record[0] = RAMLOG_TYPE_BINARY;
+  len       = RAMLOG_HDRSIZE;
+
+  memcpy(&record[len], &systime, sizeof(clock_t));
+  len += sizeof(clock_t);
+  memcpy(&record[len], &fmt, sizeof(FAR const char *));
+  len += sizeof(FAR const char *);
+
+/* Save the next argument value.  Arguments that do not fit in the record
+ * are lost; the formatting stops at the first missing argument.
+ */
+
+#define RAMLOG_PUTARG(t) \
+  do \
+    { \
+      t value = va_arg(*ap, t); \
+      if (len + sizeof(t) > sizeof(record)) \
+        { \
+          goto done; \
+        } \
+      memcpy(&record[len], &value, sizeof(t)); \
+      len += sizeof(t); \
+    } \
+  while (0)
+
+  while (*fmt != '\0')
+    {
+      if (*fmt++ != '%')
+        {
+          continue;
+        }
+
+      conv = ramlog_scanspec(fmt, &type, &nstars);
+      while (nstars-- > 0)
+        {
+          RAMLOG_PUTARG(int);
+        }
+
+      switch (type)
+        {
+          case RAMLOG_ARG_INT:
+            RAMLOG_PUTARG(int);
+            break;
+
+#ifdef CONFIG_LONG_IS_NOT_INT
+          case RAMLOG_ARG_LONG:
+            RAMLOG_PUTARG(long);
+            break;
+#endif
+
+#if defined(CONFIG_HAVE_LONG_LONG) && defined(CONFIG_LIBC_LONG_LONG)
+          case RAMLOG_ARG_LLONG:
+            RAMLOG_PUTARG(long long);
+            break;
+#endif
+
+#ifdef CONFIG_PTR_IS_NOT_INT
+          case RAMLOG_ARG_PTR:
+            RAMLOG_PUTARG(FAR void *);
+            break;
+#endif
+
+#ifdef CONFIG_LIBC_FLOATINGPOINT
+          case RAMLOG_ARG_DOUBLE:
+            RAMLOG_PUTARG(double);
+            break;
+#endif
+
+          case RAMLOG_ARG_STRING:
+            {
+              FAR const char *str = va_arg(*ap, FAR const char *);
+              size_t slen;
+
+              if (len >= sizeof(record))
+                {
+                  goto done;
+                }
+
+              /* Copy the string, truncated to fit in the record */
+
+              if (str == NULL)
+                {
+                  str = "(null)";
+                }
+
+              slen = strnlen(str, sizeof(record) - len - 1);
+              memcpy(&record[len], str, slen);
+              record[len + slen] = '\0';
+              len += slen + 1;
+            }
+            break;
+
+          default:
+            break;
+        }
+
+      if (*conv == '\0')
+        {
+          break;
+        }
+
+      fmt = conv + 1;
+    }
+
+#undef RAMLOG_PUTARG
+
+done:
+  record[1] = len - RAMLOG_HDRSIZE;
+  return ramlog_addrecord(&g_sysdev, record, len);
+}
+#endif
+
 #endif /* CONFIG_RAMLOG */
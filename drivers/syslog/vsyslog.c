@@ -48,6 +48,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/streams.h>
 #include <nuttx/syslog/syslog.h>
+#include <nuttx/syslog/ramlog.h>
 
 /****************************************************************************
  * Public Functions
@@ -69,11 +70,28 @@
 int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
 {
   struct lib_syslogstream_s stream;
-  int ret;
-
 #ifdef CONFIG_SYSLOG_TIMESTAMP
   struct timespec ts;
+#endif
+  int ret;
+
+#ifdef CONFIG_RAMLOG_BINARY
+  /* If the RAMLOG is the SYSLOG channel, just save the format string and
+   * the arguments.  The message will be formatted when the RAMLOG is read.
+   * Emergency output is still formatted immediately.
+   */
 
+  if (priority != LOG_EMERG)
+    {
+      ret = ramlog_vsyslog(fmt, ap);
+      if (ret != -ENOSYS)
+        {
+          return ret;
+        }
+    }
+#endif
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
   /* Get the current time.  Since debug output may be generated very early
    * in the start-up sequence, hardware timer support may not yet be
    * available.
@@ -635,7 +635,7 @@ static void usbhost_pollnotify(FAR struct usbhost_state_s *priv)
           if (fds->revents != 0)
             {
               uinfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_post(fds);
             }
         }
     }
@@ -59,6 +59,7 @@
 #include <poll.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 
@@ -732,7 +733,7 @@ static void nrf24l01_worker(FAR void *arg)
           dev->pfd->revents |= POLLIN;  /* Data available for input */
 
           wlinfo("Wake up polled fd\n");
-          nxsem_post(dev->pfd->sem);
+          poll_post(dev->pfd);
         }
 #endif
 
@@ -1401,7 +1402,7 @@ static int nrf24l01_poll(FAR struct file *filep, FAR struct pollfd *fds,
       if (dev->fifo_len > 0)
         {
           dev->pfd->revents |= POLLIN;  /* Data available for input */
-          nxsem_post(dev->pfd->sem);
+          poll_post(dev->pfd);
         }
 
       nxsem_post(&dev->sem_fifo);
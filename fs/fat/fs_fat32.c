@@ -63,6 +63,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/dirent.h>
 
 #include "inode/inode.h"
@@ -272,6 +273,18 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
             {
               goto errout_with_semaphore;
             }
+
+          /* Removing the cluster chain may have moved the directory
+           * sector to another entry of the sector cache.
+           */
+
+          ret = fat_fscacheread(fs, dirinfo.dir.fd_currsector);
+          if (ret < 0)
+            {
+              goto errout_with_semaphore;
+            }
+
+          direntry = &fs->fs_buffer[dirinfo.fd_seq.ds_offset];
         }
 
       /* fall through to finish the file open operations */
@@ -1306,6 +1319,32 @@ static int fat_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       return ret;
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Report the statistics of the mountpoint sector cache */
+
+  if (cmd == FIOC_CACHESTATS)
+    {
+      FAR struct fat_cachestats_s *stats =
+        (FAR struct fat_cachestats_s *)((uintptr_t)arg);
+
+      if (stats == NULL)
+        {
+          ret = -EINVAL;
+        }
+      else
+        {
+          stats->fc_nsectors = FAT_NCACHED;
+          stats->fc_hits     = fs->fs_cachehits;
+          stats->fc_misses   = fs->fs_cachemisses;
+          stats->fc_writes   = fs->fs_cachewrites;
+          ret                = OK;
+        }
+
+      fat_semgive(fs);
+      return ret;
+    }
+#endif
+
   /* ioctl calls are just passed through to the contained block driver */
 
   fat_semgive(fs);
@@ -2199,7 +2238,7 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   if (fs->fs_buffer)
     {
-      fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
+      fat_io_free(FAT_CACHEBUFFER(fs), FAT_NCACHED * fs->fs_hwsectorsize);
     }
 
   nxsem_destroy(&fs->fs_sem);
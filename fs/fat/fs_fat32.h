@@ -863,10 +863,46 @@
 #  define fat_io_free(m,s) kmm_free(m)
 #endif
 
+/****************************************************************************
+ * Mountpoint sector cache
+ *
+ * With CONFIG_FAT_SECTORCACHE, the mountpoint buffers FAT_NCACHED sectors
+ * instead of one.  The sector buffers are allocated as one contiguous
+ * block; fs_buffer is always one of them.  FAT_CACHEBUFFER() is the start
+ * of that block, the address that must be passed to fat_io_free().
+ */
+
+#ifdef CONFIG_FAT_SECTORCACHE
+#  if CONFIG_FAT_SECTORCACHE_FATPIN >= CONFIG_FAT_SECTORCACHE_NSECTORS
+#    error CONFIG_FAT_SECTORCACHE_FATPIN must be less than CONFIG_FAT_SECTORCACHE_NSECTORS
+#  endif
+#  define FAT_NCACHED          CONFIG_FAT_SECTORCACHE_NSECTORS
+#  define FAT_CACHEBUFFER(fs)  ((fs)->fs_cache[0].cs_buffer)
+#else
+#  define FAT_NCACHED          1
+#  define FAT_CACHEBUFFER(fs)  ((fs)->fs_buffer)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_FAT_SECTORCACHE
+/* This structure describes one sector of the mountpoint sector cache.  The
+ * entry that is currently fs_buffer is described by fs_currentsector and
+ * fs_dirty instead; cs_sector and cs_dirty are brought up to date when
+ * another entry is selected.
+ */
+
+struct fat_cachesector_s
+{
+  off_t    cs_sector;              /* The sector held in cs_buffer (-1: none) */
+  uint32_t cs_age;                 /* Value of fs_cacheage when last used */
+  bool     cs_dirty;               /* true: cs_buffer must be written back */
+  uint8_t *cs_buffer;              /* One sector buffer */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a fat32 filesystem.
@@ -901,6 +937,14 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one sector
                                     * from the device */
+#ifdef CONFIG_FAT_SECTORCACHE
+  uint8_t  fs_cachendx;            /* Index of the cache entry that is fs_buffer */
+  uint32_t fs_cacheage;            /* Incremented on each use of a cache entry */
+  uint32_t fs_cachehits;           /* Number of sectors found in the cache */
+  uint32_t fs_cachemisses;         /* Number of sectors read from the device */
+  uint32_t fs_cachewrites;         /* Number of sectors written back */
+  struct fat_cachesector_s fs_cache[CONFIG_FAT_SECTORCACHE_NSECTORS];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -1082,6 +1126,9 @@ EXTERN int    fat_remove(struct fat_mountpt_s *fs, const char *relpath, bool dir
 
 EXTERN int    fat_fscacheflush(struct fat_mountpt_s *fs);
 EXTERN int    fat_fscacheread(struct fat_mountpt_s *fs, off_t sector);
+#ifdef CONFIG_FAT_SECTORCACHE
+EXTERN void   fat_fscacheinitialize(struct fat_mountpt_s *fs);
+#endif
 EXTERN int    fat_ffcacheflush(struct fat_mountpt_s *fs, struct fat_file_s *ff);
 EXTERN int    fat_ffcacheread(struct fat_mountpt_s *fs, struct fat_file_s *ff, off_t sector);
 EXTERN int    fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff);
@@ -275,6 +275,210 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_writesector
+ *
+ * Description:
+ *   Write one sector from the mountpoint sector cache.  If the sector lies
+ *   in the FAT region, the change is made in each FAT copy as well.
+ *
+ ****************************************************************************/
+
+static int fat_writesector(struct fat_mountpt_s *fs, uint8_t *buffer,
+                           off_t sector)
+{
+  int ret;
+
+  /* Write the dirty sector */
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase &&
+      sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      int i;
+
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+#ifdef CONFIG_FAT_SECTORCACHE
+/****************************************************************************
+ * Name: fat_cachepark
+ *
+ * Description:
+ *   Save the state of the cache entry that is currently fs_buffer in the
+ *   entry itself.  Callers may claim a sector for fs_buffer by setting
+ *   fs_currentsector directly; any other copy of that sector in the cache
+ *   is then stale and is discarded here.
+ *
+ ****************************************************************************/
+
+static void fat_cachepark(struct fat_mountpt_s *fs)
+{
+  struct fat_cachesector_s *cs;
+  int i;
+
+  cs            = &fs->fs_cache[fs->fs_cachendx];
+  cs->cs_sector = fs->fs_currentsector;
+  cs->cs_dirty  = fs->fs_dirty;
+
+  if (cs->cs_sector < 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < FAT_NCACHED; i++)
+    {
+      if (i != fs->fs_cachendx && fs->fs_cache[i].cs_sector == cs->cs_sector)
+        {
+          fs->fs_cache[i].cs_sector = -1;
+          fs->fs_cache[i].cs_dirty  = false;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cacheselect
+ *
+ * Description:
+ *   Make a cache entry the current fs_buffer and mark it most recently
+ *   used.  The current entry must have been parked by the caller.
+ *
+ ****************************************************************************/
+
+static void fat_cacheselect(struct fat_mountpt_s *fs, int ndx)
+{
+  struct fat_cachesector_s *cs = &fs->fs_cache[ndx];
+
+  fs->fs_cachendx      = ndx;
+  fs->fs_buffer        = cs->cs_buffer;
+  fs->fs_currentsector = cs->cs_sector;
+  fs->fs_dirty         = cs->cs_dirty;
+  cs->cs_age           = ++fs->fs_cacheage;
+}
+
+/****************************************************************************
+ * Name: fat_cachevictim
+ *
+ * Description:
+ *   Select the cache entry to be replaced:  An unused entry if there is
+ *   one, otherwise the least recently used entry.  Sectors of the FAT are
+ *   passed over while no more than CONFIG_FAT_SECTORCACHE_FATPIN of them
+ *   are cached.
+ *
+ ****************************************************************************/
+
+static int fat_cachevictim(struct fat_mountpt_s *fs)
+{
+  struct fat_cachesector_s *cs;
+  uint32_t oldest;
+  bool pinned;
+  int nfat = 0;
+  int victim;
+  int i;
+
+  for (i = 0; i < FAT_NCACHED; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (cs->cs_sector < 0)
+        {
+          return i;
+        }
+
+      if (cs->cs_sector >= fs->fs_fatbase &&
+          cs->cs_sector < fs->fs_fatbase + fs->fs_nfatsects)
+        {
+          nfat++;
+        }
+    }
+
+  /* If every entry is pinned, fall back to plain LRU */
+
+  pinned = (nfat <= CONFIG_FAT_SECTORCACHE_FATPIN && nfat < FAT_NCACHED);
+  victim = 0;
+  oldest = 0;
+
+  for (i = 0; i < FAT_NCACHED; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (pinned && cs->cs_sector >= fs->fs_fatbase &&
+          cs->cs_sector < fs->fs_fatbase + fs->fs_nfatsects)
+        {
+          continue;
+        }
+
+      /* The age difference is correct even if fs_cacheage wrapped */
+
+      if ((uint32_t)(fs->fs_cacheage - cs->cs_age) >= oldest)
+        {
+          oldest = fs->fs_cacheage - cs->cs_age;
+          victim = i;
+        }
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: fat_cacheinvalidate
+ *
+ * Description:
+ *   Discard the cached copies of sectors that are being written from some
+ *   other buffer.
+ *
+ ****************************************************************************/
+
+static void fat_cacheinvalidate(struct fat_mountpt_s *fs, uint8_t *buffer,
+                                off_t sector, unsigned int nsectors)
+{
+  struct fat_cachesector_s *cs;
+  int i;
+
+  for (i = 0; i < FAT_NCACHED; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (cs->cs_buffer == buffer)
+        {
+          continue;
+        }
+
+      if (i == fs->fs_cachendx)
+        {
+          if (fs->fs_currentsector >= sector &&
+              fs->fs_currentsector < sector + nsectors)
+            {
+              fs->fs_currentsector = -1;
+              fs->fs_dirty         = false;
+            }
+        }
+      else if (cs->cs_sector >= sector && cs->cs_sector < sector + nsectors)
+        {
+          cs->cs_sector = -1;
+          cs->cs_dirty  = false;
+        }
+    }
+}
+#endif /* CONFIG_FAT_SECTORCACHE */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -546,15 +750,22 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   fs->fs_hwsectorsize = geo.geo_sectorsize;
   fs->fs_hwnsectors   = geo.geo_nsectors;
 
-  /* Allocate a buffer to hold one hardware sector */
+  /* Allocate a buffer to hold one hardware sector (or all of the sectors
+   * of the sector cache).
+   */
 
-  fs->fs_buffer = (FAR uint8_t *)fat_io_alloc(fs->fs_hwsectorsize);
+  fs->fs_buffer = (FAR uint8_t *)
+    fat_io_alloc(FAT_NCACHED * fs->fs_hwsectorsize);
   if (!fs->fs_buffer)
     {
       ret = -ENOMEM;
       goto errout;
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  fat_fscacheinitialize(fs);
+#endif
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -682,7 +893,7 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
-  fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
+  fat_io_free(FAT_CACHEBUFFER(fs), FAT_NCACHED * fs->fs_hwsectorsize);
   fs->fs_buffer = 0;
 
 errout:
@@ -787,6 +998,14 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
           ssize_t nSectorsWritten =
               inode->u.i_bops->write(inode, buffer, sector, nsectors);
 
+#ifdef CONFIG_FAT_SECTORCACHE
+          /* Any other copy of these sectors in the sector cache is now
+           * stale.
+           */
+
+          fat_cacheinvalidate(fs, buffer, sector, nsectors);
+#endif
+
           if (nSectorsWritten == nsectors)
             {
               ret = OK;
@@ -1763,16 +1982,77 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fscacheinitialize
+ *
+ * Description:
+ *   Set up the (empty) sector cache of the mountpoint.  fs_buffer holds the
+ *   block of FAT_NCACHED sector buffers allocated when the volume is
+ *   mounted.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_SECTORCACHE
+void fat_fscacheinitialize(struct fat_mountpt_s *fs)
+{
+  uint8_t *buffer = fs->fs_buffer;
+  int i;
+
+  for (i = 0; i < FAT_NCACHED; i++)
+    {
+      fs->fs_cache[i].cs_sector = -1;
+      fs->fs_cache[i].cs_age    = 0;
+      fs->fs_cache[i].cs_dirty  = false;
+      fs->fs_cache[i].cs_buffer = buffer;
+      buffer                   += fs->fs_hwsectorsize;
+    }
+
+  fs->fs_cacheage    = 0;
+  fs->fs_cachehits   = 0;
+  fs->fs_cachemisses = 0;
+  fs->fs_cachewrites = 0;
+
+  fat_cacheselect(fs, 0);
+}
+#endif
+
 /****************************************************************************
  * Name: fat_fscacheflush
  *
  * Description:
- *   Flush any dirty sector if fs_buffer as necessary
+ *   Flush any dirty sector if fs_buffer as necessary.  With
+ *   CONFIG_FAT_SECTORCACHE, all dirty sectors in the cache are written back.
  *
  ****************************************************************************/
 
 int fat_fscacheflush(struct fat_mountpt_s *fs)
 {
+#ifdef CONFIG_FAT_SECTORCACHE
+  struct fat_cachesector_s *cs;
+  int ret = OK;
+  int i;
+
+  fat_cachepark(fs);
+
+  for (i = 0; i < FAT_NCACHED; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (cs->cs_dirty)
+        {
+          ret = fat_writesector(fs, cs->cs_buffer, cs->cs_sector);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          cs->cs_dirty = false;
+          fs->fs_cachewrites++;
+        }
+    }
+
+  fs->fs_dirty = fs->fs_cache[fs->fs_cachendx].cs_dirty;
+  return ret;
+#else
   int ret;
 
   /* Check if the fs_buffer is dirty.  In this case, we will write back the
@@ -1781,40 +2061,19 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
   if (fs->fs_dirty)
     {
-      /* Write the dirty sector */
-
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+      ret = fat_writesector(fs, fs->fs_buffer, fs->fs_currentsector);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
       /* No longer dirty */
 
       fs->fs_dirty = false;
     }
 
   return OK;
+#endif
 }
 
 /****************************************************************************
@@ -1828,6 +2087,61 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
 int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 {
+#ifdef CONFIG_FAT_SECTORCACHE
+  struct fat_cachesector_s *cs;
+  int ret;
+  int i;
+
+  /* Nothing to do if the sector is already in fs_buffer */
+
+  if (fs->fs_currentsector == sector)
+    {
+      fs->fs_cachehits++;
+      return OK;
+    }
+
+  /* Is the sector in some other entry of the cache? */
+
+  fat_cachepark(fs);
+
+  for (i = 0; i < FAT_NCACHED; i++)
+    {
+      if (fs->fs_cache[i].cs_sector == sector)
+        {
+          fat_cacheselect(fs, i);
+          fs->fs_cachehits++;
+          return OK;
+        }
+    }
+
+  /* No.. replace an entry, writing it back first if it is dirty */
+
+  i  = fat_cachevictim(fs);
+  cs = &fs->fs_cache[i];
+
+  if (cs->cs_dirty)
+    {
+      ret = fat_writesector(fs, cs->cs_buffer, cs->cs_sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      cs->cs_dirty = false;
+      fs->fs_cachewrites++;
+    }
+
+  fs->fs_cachemisses++;
+  ret = fat_hwread(fs, cs->cs_buffer, sector, 1);
+  cs->cs_sector = ret < 0 ? -1 : sector;
+
+  /* On a read failure, the current entry stays selected (but may no longer
+   * hold a sector if it was the one replaced).
+   */
+
+  fat_cacheselect(fs, ret < 0 ? fs->fs_cachendx : i);
+  return ret < 0 ? ret : OK;
+#else
   int ret;
 
   /* fs->fs_currentsector holds the current sector that is buffered in
@@ -1861,6 +2175,7 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
     }
 
   return OK;
+#endif
 }
 
 /****************************************************************************
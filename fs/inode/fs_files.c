@@ -105,6 +105,15 @@ static int _files_close(FAR struct file *filep)
 
   if (inode)
     {
+#ifndef CONFIG_DISABLE_POLL
+      /* Remove the file from any epoll instance while it is still open */
+
+      if (filep->f_epolls > 0)
+        {
+          epoll_release(filep);
+        }
+
+#endif
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
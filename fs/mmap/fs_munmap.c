@@ -52,7 +52,11 @@
 #include "inode/inode.h"
 #include "fs_rammap.h"
 
-#ifdef CONFIG_FS_RAMMAP
+#ifdef CONFIG_FS_TMPFS
+#  include "tmpfs/fs_tmpfs.h"
+#endif
+
+#if defined(CONFIG_FS_RAMMAP) || defined(CONFIG_FS_TMPFS)
 
 /****************************************************************************
  * Public Functions
@@ -95,6 +99,10 @@
  *      into RAM.  munmap() is required in this case to free the allocated
  *      memory holding the shared copy of the file.
  *
+ *   3. TMPFS files are mapped in place.  munmap() is required in this case
+ *      to release the mapping's reference on the file's contiguous region
+ *      so that the region can be freed once the file no longer uses it.
+ *
  * Input Parameters:
  *   start   The start address of the mapping to delete.  For this
  *           simplified munmap() implementation, the *must* be the start
@@ -110,13 +118,31 @@
 
 int munmap(FAR void *start, size_t length)
 {
+#ifdef CONFIG_FS_RAMMAP
   FAR struct fs_rammap_s *prev;
   FAR struct fs_rammap_s *curr;
   FAR void *newaddr;
   unsigned int offset;
   int ret;
   int errcode;
+#endif
 
+#ifdef CONFIG_FS_TMPFS
+  /* Is this a region that was mapped in place from a TMPFS file? */
+
+  if (tmpfs_munmap(start) == OK)
+    {
+      return OK;
+    }
+#endif
+
+#ifndef CONFIG_FS_RAMMAP
+  /* No.. Then it is a fixed address in the MCU address space that does not
+   * need to be unmapped.
+   */
+
+  return OK;
+#else
   /* Find a region containing this start and length in the list of regions */
 
   rammap_initialize();
@@ -210,6 +236,7 @@ errout_with_semaphore:
 errout:
   set_errno(errcode);
   return ERROR;
+#endif /* CONFIG_FS_RAMMAP */
 }
 
-#endif /* CONFIG_FS_RAMMAP */
+#endif /* CONFIG_FS_RAMMAP || CONFIG_FS_TMPFS */
@@ -410,6 +410,45 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef CONFIG_MM_CACHE
+  if (totalsize < buflen)
+    {
+      struct mm_cacheinfo_s info;
+      int i;
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Show the small object cache statistics of the user heap, one line
+       * per size class.
+       */
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "             chunk     cached       hits     misses\n");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+      for (i = 0; i < MM_CACHE_NCLASSES && totalsize < buflen; i++)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          (void)mm_cacheinfo(&g_mmheap, i, &info);
+
+          linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                                "Cache: %11lu%11lu%11lu%11lu\n",
+                                (unsigned long)info.size,
+                                (unsigned long)info.cached,
+                                (unsigned long)info.hits,
+                                (unsigned long)info.misses);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -598,8 +598,6 @@ static int romfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   DEBUGASSERT(rm != NULL);
 
-  /* Only one ioctl command is supported */
-
   if (cmd == FIOC_MMAP && rm->rm_xipbase && ppv)
     {
       /* Return the address on the media corresponding to the start of
@@ -610,6 +608,33 @@ static int romfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       return OK;
     }
 
+  if (cmd == FIOC_MEMSEG && rm->rm_xipbase && arg != 0)
+    {
+      FAR struct fioc_memseg_s *seg =
+        (FAR struct fioc_memseg_s *)((uintptr_t)arg);
+
+      /* The whole file is contiguous on the media */
+
+      if (seg->ms_offset < 0)
+        {
+          return -EINVAL;
+        }
+
+      if (seg->ms_offset >= rf->rf_size)
+        {
+          seg->ms_addr   = NULL;
+          seg->ms_length = 0;
+        }
+      else
+        {
+          seg->ms_addr   = rm->rm_xipbase + rf->rf_startoffset +
+                           seg->ms_offset;
+          seg->ms_length = rf->rf_size - seg->ms_offset;
+        }
+
+      return OK;
+    }
+
   ferr("ERROR: Invalid cmd: %d \n", cmd);
   return -ENOTTY;
 }
@@ -1002,6 +1002,12 @@ static int smartfs_sync(FAR struct file *filep)
   smartfs_semtake(fs);
 
   ret = smartfs_sync_internal(fs, sf);
+  if (ret >= 0)
+    {
+      /* Give the block driver a chance to flush its own state, too */
+
+      (void)FS_IOCTL(fs, BIOC_FLUSH, 0);
+    }
 
   smartfs_semgive(fs);
   return ret;
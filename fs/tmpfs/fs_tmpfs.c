@@ -67,10 +67,6 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
-#endif
-
 #define tmpfs_lock_file(tfo) \
            (tmpfs_lock_object((FAR struct tmpfs_object_s *)tfo))
 #define tmpfs_lock_directory(tdo) \
@@ -91,10 +87,22 @@ static void tmpfs_unlock_reentrant(FAR struct tmpfs_sem_s *sem);
 static void tmpfs_unlock(FAR struct tmpfs_s *fs);
 static void tmpfs_lock_object(FAR struct tmpfs_object_s *to);
 static void tmpfs_unlock_object(FAR struct tmpfs_object_s *to);
+static void tmpfs_lock_maps(void);
+static void tmpfs_unlock_maps(void);
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
               unsigned int nentries);
-static int  tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
+static int  tmpfs_grow_pagetable(FAR struct tmpfs_file_s *tfo,
+              size_t npages);
+static FAR uint8_t *tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+              size_t pageno);
+static void tmpfs_shrink_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+static int  tmpfs_map_file(FAR struct tmpfs_file_s *tfo,
+              FAR void **ppv);
+static void tmpfs_release_map(FAR struct tmpfs_map_s *map);
+static int  tmpfs_memseg(FAR struct tmpfs_file_s *tfo,
+              FAR struct fioc_memseg_s *seg);
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -166,6 +174,17 @@ static void tmpfs_stat_common(FAR struct tmpfs_object_s *to,
 static int  tmpfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
               FAR struct stat *buf);
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of all regions created by FIOC_MMAP and the semaphore that
+ * protects the list and the region reference counts.
+ */
+
+static sem_t g_tmpfs_mapsem = SEM_INITIALIZER(1);
+static FAR struct tmpfs_map_s *g_tmpfs_maps;
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -311,6 +330,38 @@ static void tmpfs_unlock_object(FAR struct tmpfs_object_s *to)
   tmpfs_unlock_reentrant(&to->to_exclsem);
 }
 
+/****************************************************************************
+ * Name: tmpfs_lock_maps
+ ****************************************************************************/
+
+static void tmpfs_lock_maps(void)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait(&g_tmpfs_mapsem);
+
+      /* The only case that an error should occur here is if the wait
+       * was awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+/****************************************************************************
+ * Name: tmpfs_unlock_maps
+ ****************************************************************************/
+
+static void tmpfs_unlock_maps(void)
+{
+  nxsem_post(&g_tmpfs_mapsem);
+}
+
 /****************************************************************************
  * Name: tmpfs_realloc_directory
  ****************************************************************************/
@@ -372,74 +423,421 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
 }
 
 /****************************************************************************
- * Name: tmpfs_realloc_file
+ * Name: tmpfs_grow_pagetable
+ *
+ * Description:
+ *   Make sure that the page table of the file has at least 'npages'
+ *   entries.  The table is grown geometrically so that appending to a file
+ *   reallocates the table only occasionally; the file data itself is never
+ *   moved.
+ *
  ****************************************************************************/
 
-static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
-                              size_t newsize)
+static int tmpfs_grow_pagetable(FAR struct tmpfs_file_s *tfo,
+                                size_t npages)
 {
-  FAR struct tmpfs_file_s *oldtfo = *tfo;
-  FAR struct tmpfs_file_s *newtfo;
-  size_t objsize;
-  size_t allocsize;
-  size_t delta;
+  FAR uint8_t **newpages;
+  size_t newsize;
+
+  if (npages <= tfo->tfo_npages)
+    {
+      return OK;
+    }
 
-  /* Check if the current allocation is sufficient */
+  newsize = 2 * tfo->tfo_npages;
+  if (newsize < npages)
+    {
+      newsize = npages;
+    }
+
+  newpages = (FAR uint8_t **)
+    kmm_realloc(tfo->tfo_pages, newsize * sizeof(FAR uint8_t *));
+  if (newpages == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(&newpages[tfo->tfo_npages], 0,
+         (newsize - tfo->tfo_npages) * sizeof(FAR uint8_t *));
+
+  tfo->tfo_alloc += (newsize - tfo->tfo_npages) * sizeof(FAR uint8_t *);
+  tfo->tfo_pages  = newpages;
+  tfo->tfo_npages = newsize;
+  return OK;
+}
 
-  objsize = SIZEOF_TMPFS_FILE(newsize);
+/****************************************************************************
+ * Name: tmpfs_alloc_page
+ *
+ * Description:
+ *   Return the page 'pageno' of the file, allocating a zeroed page if that
+ *   part of the file is currently a hole.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+                                     size_t pageno)
+{
+  FAR uint8_t *page;
+
+  if (pageno < tfo->tfo_npages && tfo->tfo_pages[pageno] != NULL)
+    {
+      return tfo->tfo_pages[pageno];
+    }
+
+  if (tmpfs_grow_pagetable(tfo, pageno + 1) < 0)
+    {
+      return NULL;
+    }
+
+  page = (FAR uint8_t *)kmm_zalloc(TMPFS_PAGESIZE);
+  if (page != NULL)
+    {
+      tfo->tfo_pages[pageno] = page;
+      tfo->tfo_alloc        += TMPFS_PAGESIZE;
+    }
+
+  return page;
+}
+
+/****************************************************************************
+ * Name: tmpfs_shrink_file
+ *
+ * Description:
+ *   Reduce the size of the file to 'newsize', releasing the pages beyond
+ *   the new end of the file.  The part of the last page beyond the new end
+ *   of file is zeroed:  Data beyond the end of the file is always zero so
+ *   that growing the file again never exposes stale data.
+ *
+ ****************************************************************************/
+
+static void tmpfs_shrink_file(FAR struct tmpfs_file_s *tfo, size_t newsize)
+{
+  FAR uint8_t *page;
+  size_t oldsize = tfo->tfo_size;
+  size_t npages;
+  size_t pageno;
+  size_t offset;
+  size_t nzero;
 
-  /* Are we growing or shrinking the object? */
+  DEBUGASSERT(newsize < oldsize);
 
-  if (objsize <= oldtfo->tfo_alloc)
+  if (newsize == 0)
     {
-      /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
+      /* Release everything.  Any mapped region is only freed here if it
+       * is not still mapped.
        */
 
-      if (newsize > 0)
-        {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
-           */
+      tmpfs_free_file(tfo);
 
-          delta = oldtfo->tfo_alloc - objsize;
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
-            {
-              /* Hasn't shrunk enough.. Return doing nothing for now */
+      tfo->tfo_alloc   = sizeof(struct tmpfs_file_s);
+      tfo->tfo_size    = 0;
+      tfo->tfo_npages  = 0;
+      tfo->tfo_nmapped = 0;
+      tfo->tfo_pages   = NULL;
+      tfo->tfo_map     = NULL;
+      return;
+    }
 
-              oldtfo->tfo_size = newsize;
-              return OK;
-            }
+  /* Zero the tail of the new last page */
+
+  pageno = TMPFS_PAGE(newsize);
+  offset = TMPFS_PAGEOFF(newsize);
+
+  if (offset > 0 && pageno < tfo->tfo_npages &&
+      (page = tfo->tfo_pages[pageno]) != NULL)
+    {
+      nzero = TMPFS_PAGESIZE - offset;
+      if (nzero > oldsize - newsize)
+        {
+          nzero = oldsize - newsize;
         }
+
+      memset(&page[offset], 0, nzero);
+      pageno++;
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
+  /* Release (or zero, if they belong to the mapped region) the pages that
+   * are now wholly beyond the end of the file.
    */
 
-  allocsize = objsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+  npages = TMPFS_NPAGES(oldsize);
+  if (npages > tfo->tfo_npages)
+    {
+      npages = tfo->tfo_npages;
+    }
 
-  /* Realloc the file object */
+  for (; pageno < npages; pageno++)
+    {
+      page = tfo->tfo_pages[pageno];
+      if (page == NULL)
+        {
+          continue;
+        }
 
-  newtfo = (FAR struct tmpfs_file_s *)kmm_realloc(oldtfo, allocsize);
-  if (newtfo == NULL)
+      if (pageno < tfo->tfo_nmapped)
+        {
+          memset(page, 0, TMPFS_PAGESIZE);
+        }
+      else
+        {
+          kmm_free(page);
+          tfo->tfo_pages[pageno] = NULL;
+          tfo->tfo_alloc        -= TMPFS_PAGESIZE;
+        }
+    }
+
+  tfo->tfo_size = newsize;
+}
+
+/****************************************************************************
+ * Name: tmpfs_map_file
+ *
+ * Description:
+ *   Return the address of the file data as a single contiguous region.  The
+ *   first time a file is mapped, its pages are gathered into one
+ *   allocation; the file then continues to use that region in place so
+ *   that writes through the file and through the mapping are visible to
+ *   each other.  Each successful call adds a reference to the region that
+ *   is released by munmap(); the region remains valid until both the file
+ *   and all of its mappings have released it.
+ *
+ *   If the file has since grown beyond its mapped region, the region cannot
+ *   be moved without invalidating existing mappings and -EBUSY is returned.
+ *   mmap() will then fall back to the RAM copy if CONFIG_FS_RAMMAP is
+ *   enabled.
+ *
+ ****************************************************************************/
+
+static int tmpfs_map_file(FAR struct tmpfs_file_s *tfo, FAR void **ppv)
+{
+  FAR struct tmpfs_map_s *map;
+  FAR uint8_t *region;
+  FAR uint8_t *page;
+  size_t npages;
+  size_t pageno;
+  int ret;
+
+  npages = TMPFS_NPAGES(tfo->tfo_size);
+  if (npages == 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Is the whole file already in the mapped region? */
+
+  map = tfo->tfo_map;
+  if (map != NULL)
+    {
+      if (npages > tfo->tfo_nmapped)
+        {
+          return -EBUSY;
+        }
+
+      tmpfs_lock_maps();
+      map->tm_refs++;
+      tmpfs_unlock_maps();
+
+      *ppv = map->tm_region;
+      return OK;
+    }
+
+  /* No.. Gather the file pages into one contiguous region */
+
+  ret = tmpfs_grow_pagetable(tfo, npages);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  map = (FAR struct tmpfs_map_s *)kmm_malloc(sizeof(struct tmpfs_map_s));
+  if (map == NULL)
     {
       return -ENOMEM;
     }
 
-  /* Adjust the reference in the parent directory entry */
+  region = (FAR uint8_t *)kmm_malloc(npages * TMPFS_PAGESIZE);
+  if (region == NULL)
+    {
+      kmm_free(map);
+      return -ENOMEM;
+    }
+
+  for (pageno = 0; pageno < npages; pageno++)
+    {
+      page = tfo->tfo_pages[pageno];
+      if (page != NULL)
+        {
+          memcpy(&region[pageno * TMPFS_PAGESIZE], page, TMPFS_PAGESIZE);
+          kmm_free(page);
+        }
+      else
+        {
+          memset(&region[pageno * TMPFS_PAGESIZE], 0, TMPFS_PAGESIZE);
+          tfo->tfo_alloc += TMPFS_PAGESIZE;
+        }
+
+      tfo->tfo_pages[pageno] = &region[pageno * TMPFS_PAGESIZE];
+    }
+
+  /* The region holds one reference for the file and one for this mapping */
+
+  map->tm_region   = region;
+  map->tm_length   = npages * TMPFS_PAGESIZE;
+  map->tm_refs     = 2;
+
+  tmpfs_lock_maps();
+  map->tm_flink    = g_tmpfs_maps;
+  g_tmpfs_maps     = map;
+  tmpfs_unlock_maps();
+
+  tfo->tfo_map     = map;
+  tfo->tfo_nmapped = npages;
+
+  *ppv = region;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_release_map
+ *
+ * Description:
+ *   Release one reference on a mapped region.  The region is removed from
+ *   the list and freed when the last reference is released.  The caller
+ *   must hold g_tmpfs_mapsem.
+ *
+ ****************************************************************************/
+
+static void tmpfs_release_map(FAR struct tmpfs_map_s *map)
+{
+  FAR struct tmpfs_map_s *prev;
+  FAR struct tmpfs_map_s *curr;
+
+  DEBUGASSERT(map != NULL && map->tm_refs > 0);
+
+  if (--map->tm_refs > 0)
+    {
+      return;
+    }
+
+  for (prev = NULL, curr = g_tmpfs_maps;
+       curr != NULL && curr != map;
+       prev = curr, curr = curr->tm_flink);
+
+  DEBUGASSERT(curr != NULL);
+
+  if (prev != NULL)
+    {
+      prev->tm_flink = map->tm_flink;
+    }
+  else
+    {
+      g_tmpfs_maps = map->tm_flink;
+    }
+
+  kmm_free(map->tm_region);
+  kmm_free(map);
+}
+
+/****************************************************************************
+ * Name: tmpfs_memseg
+ *
+ * Description:
+ *   Return the address of the file data at seg->ms_offset and the number
+ *   of bytes that follow it contiguously in memory.  Adjacent pages are
+ *   merged when they happen to be contiguous (as in a mapped region).  The
+ *   caller holds the file lock.
+ *
+ ****************************************************************************/
+
+static int tmpfs_memseg(FAR struct tmpfs_file_s *tfo,
+                        FAR struct fioc_memseg_s *seg)
+{
+  FAR uint8_t *page;
+  FAR uint8_t *next;
+  size_t pageno;
+  size_t offset;
+  size_t length;
+
+  if (seg->ms_offset < 0)
+    {
+      return -EINVAL;
+    }
+
+  seg->ms_addr   = NULL;
+  seg->ms_length = 0;
+
+  if (seg->ms_offset >= tfo->tfo_size)
+    {
+      return OK;
+    }
 
-  DEBUGASSERT(newtfo->tfo_dirent);
-  newtfo->tfo_dirent->tde_object = (FAR struct tmpfs_object_s *)newtfo;
+  /* Holes in the file have no memory behind them */
 
-  /* Return the new address of the reallocated file object */
+  pageno = TMPFS_PAGE(seg->ms_offset);
+  offset = TMPFS_PAGEOFF(seg->ms_offset);
+  page   = pageno < tfo->tfo_npages ? tfo->tfo_pages[pageno] : NULL;
+  if (page == NULL)
+    {
+      return -ENXIO;
+    }
+
+  length = TMPFS_PAGESIZE - offset;
+  for (next = page + TMPFS_PAGESIZE;
+       ++pageno < tfo->tfo_npages && tfo->tfo_pages[pageno] == next;
+       next += TMPFS_PAGESIZE)
+    {
+      length += TMPFS_PAGESIZE;
+    }
 
-  newtfo->tfo_alloc = allocsize;
-  newtfo->tfo_size  = newsize;
-  *tfo              = newtfo;
+  if (length > tfo->tfo_size - seg->ms_offset)
+    {
+      length = tfo->tfo_size - seg->ms_offset;
+    }
+
+  seg->ms_addr   = &page[offset];
+  seg->ms_length = length;
   return OK;
 }
 
+/****************************************************************************
+ * Name: tmpfs_free_file
+ *
+ * Description:
+ *   Release the data pages and the page table of a file.  The file object
+ *   itself is not freed.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo)
+{
+  size_t pageno;
+
+  for (pageno = tfo->tfo_nmapped; pageno < tfo->tfo_npages; pageno++)
+    {
+      if (tfo->tfo_pages[pageno] != NULL)
+        {
+          kmm_free(tfo->tfo_pages[pageno]);
+        }
+    }
+
+  /* Release the file's reference on any mapped region.  The region is not
+   * freed if it is still mapped.
+   */
+
+  if (tfo->tfo_map != NULL)
+    {
+      tmpfs_lock_maps();
+      tmpfs_release_map(tfo->tfo_map);
+      tmpfs_unlock_maps();
+    }
+
+  if (tfo->tfo_pages != NULL)
+    {
+      kmm_free(tfo->tfo_pages);
+    }
+}
+
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
  ****************************************************************************/
@@ -476,6 +874,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
   if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0)
     {
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
+      tmpfs_free_file(tfo);
       kmm_free(tfo);
     }
 
@@ -622,12 +1021,12 @@ static int tmpfs_add_dirent(FAR struct tmpfs_directory_s **tdo,
 static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
 {
   FAR struct tmpfs_file_s *tfo;
-  size_t allocsize;
 
-  /* Create a new zero length file object */
+  /* Create a new zero length file object.  No pages are allocated until
+   * the file is written.
+   */
 
-  allocsize = SIZEOF_TMPFS_FILE(CONFIG_FS_TMPFS_FILE_ALLOCGUARD);
-  tfo = (FAR struct tmpfs_file_s *)kmm_malloc(allocsize);
+  tfo = (FAR struct tmpfs_file_s *)kmm_malloc(sizeof(struct tmpfs_file_s));
   if (tfo == NULL)
     {
       return NULL;
@@ -637,11 +1036,15 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
    * locked with one reference count.
    */
 
-  tfo->tfo_alloc = allocsize;
-  tfo->tfo_type  = TMPFS_REGULAR;
-  tfo->tfo_refs  = 1;
-  tfo->tfo_flags = 0;
-  tfo->tfo_size  = 0;
+  tfo->tfo_alloc   = sizeof(struct tmpfs_file_s);
+  tfo->tfo_type    = TMPFS_REGULAR;
+  tfo->tfo_refs    = 1;
+  tfo->tfo_flags   = 0;
+  tfo->tfo_size    = 0;
+  tfo->tfo_npages  = 0;
+  tfo->tfo_nmapped = 0;
+  tfo->tfo_pages   = NULL;
+  tfo->tfo_map     = NULL;
 
   tfo->tfo_exclsem.ts_holder = getpid();
   tfo->tfo_exclsem.ts_count  = 1;
@@ -1280,6 +1683,11 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
   /* Free the object now */
 
   nxsem_destroy(&to->to_exclsem.ts_sem);
+  if (to->to_type == TMPFS_REGULAR)
+    {
+      tmpfs_free_file((FAR struct tmpfs_file_s *)to);
+    }
+
   kmm_free(to);
   return TMPFS_DELETED;
 }
@@ -1428,11 +1836,7 @@ static int tmpfs_open(FAR struct file *filep, FAR const char *relpath,
 
           if (tfo->tfo_size > 0)
             {
-              ret = tmpfs_realloc_file(&tfo, 0);
-              if (ret < 0)
-                {
-                  goto errout_with_filelock;
-                }
+              tmpfs_shrink_file(tfo, 0);
             }
         }
     }
@@ -1543,6 +1947,7 @@ static int tmpfs_close(FAR struct file *filep)
        * have any other references.
        */
 
+      tmpfs_free_file(tfo);
       kmm_free(tfo);
       return OK;
     }
@@ -1561,9 +1966,14 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
                           size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nread;
   off_t startpos;
   off_t endpos;
+  size_t remaining;
+  size_t pageno;
+  size_t offset;
+  size_t ncopy;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
         filep, buffer, (unsigned long)buflen);
@@ -1583,15 +1993,44 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
   nread    = buflen;
   endpos   = startpos + buflen;
 
-  if (endpos > tfo->tfo_size)
+  if (startpos >= tfo->tfo_size)
+    {
+      nread = 0;
+    }
+  else if (endpos > tfo->tfo_size)
     {
       endpos = tfo->tfo_size;
       nread  = endpos - startpos;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the file pages to the user buffer.  Holes in the file
+   * read as zeros.
+   */
+
+  for (remaining = nread; remaining > 0; remaining -= ncopy)
+    {
+      pageno = TMPFS_PAGE(startpos);
+      offset = TMPFS_PAGEOFF(startpos);
+      ncopy  = TMPFS_PAGESIZE - offset;
+      if (ncopy > remaining)
+        {
+          ncopy = remaining;
+        }
+
+      page = pageno < tfo->tfo_npages ? tfo->tfo_pages[pageno] : NULL;
+      if (page != NULL)
+        {
+          memcpy(buffer, &page[offset], ncopy);
+        }
+      else
+        {
+          memset(buffer, 0, ncopy);
+        }
+
+      buffer   += ncopy;
+      startpos += ncopy;
+    }
 
-  memcpy(buffer, &tfo->tfo_data[startpos], nread);
   filep->f_pos += nread;
 
   /* Release the lock on the file */
@@ -1608,10 +2047,12 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
                            size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nwritten;
   off_t startpos;
-  off_t endpos;
-  int ret;
+  size_t pageno;
+  size_t offset;
+  size_t ncopy;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
         filep, buffer, (unsigned long)buflen);
@@ -1625,38 +2066,49 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 
   tmpfs_lock_file(tfo);
 
-  /* Handle attempts to write beyond the end of the file */
+  /* Copy data from the user buffer to the file pages, allocating pages as
+   * needed.  Only the pages that are written are allocated so writing
+   * beyond the end of the file leaves a hole.
+   */
 
   startpos = filep->f_pos;
-  nwritten = buflen;
-  endpos   = startpos + buflen;
+  nwritten = 0;
 
-  if (endpos > tfo->tfo_size)
+  while (nwritten < buflen)
     {
-      /* Reallocate the file to handle the write past the end of the file. */
+      pageno = TMPFS_PAGE(startpos);
+      offset = TMPFS_PAGEOFF(startpos);
+      ncopy  = TMPFS_PAGESIZE - offset;
+      if (ncopy > buflen - nwritten)
+        {
+          ncopy = buflen - nwritten;
+        }
 
-      ret = tmpfs_realloc_file(&tfo, (size_t)endpos);
-      if (ret < 0)
+      page = tmpfs_alloc_page(tfo, pageno);
+      if (page == NULL)
         {
-          goto errout_with_lock;
+          break;
         }
 
-      filep->f_priv = tfo;
+      memcpy(&page[offset], &buffer[nwritten], ncopy);
+      nwritten += ncopy;
+      startpos += ncopy;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  if (startpos > tfo->tfo_size)
+    {
+      tfo->tfo_size = startpos;
+    }
 
-  memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
-  filep->f_pos += nwritten;
+  filep->f_pos = startpos;
 
   /* Release the lock on the file */
 
   tmpfs_unlock_file(tfo);
-  return nwritten;
 
-errout_with_lock:
-  tmpfs_unlock_file(tfo);
-  return (ssize_t)ret;
+  /* Report a partial write, or -ENOMEM if nothing could be written */
+
+  return nwritten > 0 || buflen == 0 ? nwritten : (ssize_t)-ENOMEM;
 }
 
 /****************************************************************************
@@ -1727,6 +2179,7 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
   FAR struct tmpfs_file_s *tfo;
   FAR void **ppv = (FAR void**)arg;
+  int ret;
 
   finfo("filep: %p cmd: %d arg: %08lx\n", filep, cmd, arg);
   DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
@@ -1737,16 +2190,26 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   DEBUGASSERT(tfo != NULL);
 
-  /* Only one ioctl command is supported */
-
   if (cmd == FIOC_MMAP && ppv != NULL)
     {
-      /* Return the address on the media corresponding to the start of
-       * the file.
+      /* Return the address of the file data in one contiguous region */
+
+      tmpfs_lock_file(tfo);
+      ret = tmpfs_map_file(tfo, ppv);
+      tmpfs_unlock_file(tfo);
+      return ret;
+    }
+
+  if (cmd == FIOC_MEMSEG && arg != 0)
+    {
+      /* Return the address of the file page holding the data at the
+       * requested offset, without taking a reference or copying the file.
        */
 
-      *ppv = (FAR void *)tfo->tfo_data;
-      return OK;
+      tmpfs_lock_file(tfo);
+      ret = tmpfs_memseg(tfo, (FAR struct fioc_memseg_s *)((uintptr_t)arg));
+      tmpfs_unlock_file(tfo);
+      return ret;
     }
 
   ferr("ERROR: Invalid cmd: %d\n", cmd);
@@ -1828,7 +2291,6 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
 {
   FAR struct tmpfs_file_s *tfo;
   size_t oldsize;
-  int ret = OK;
 
   finfo("filep: %p length: %ld\n", filep, (long)length);
   DEBUGASSERT(filep != NULL && length >= 0);
@@ -1846,35 +2308,27 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
    */
 
   oldsize = tfo->tfo_size;
-  if (oldsize != length)
+  if (length < oldsize)
     {
-      /* The size is changing.. up or down.  Reallocate the file memory. */
-
-      ret = tmpfs_realloc_file(&tfo, (size_t)length);
-      if (ret < 0)
-        {
-          goto errout_with_lock;
-        }
-
-      filep->f_priv = tfo;
-
-      /* If the size has increased, then we need to zero the newly added
-       * memory.
+      /* The file is shrinking.  Release the pages beyond the new end of
+       * file.
        */
 
-      if (length > oldsize)
-        {
-          memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
-        }
+      tmpfs_shrink_file(tfo, (size_t)length);
+    }
+  else
+    {
+      /* The file is growing (or not changing).  The extension is a hole
+       * that reads as zeros; no pages are allocated until it is written.
+       */
 
-      ret = OK;
+      tfo->tfo_size = length;
     }
 
   /* Release the lock on the file */
 
-errout_with_lock:
   tmpfs_unlock_file(tfo);
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
@@ -2276,6 +2730,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
+      tmpfs_free_file(tfo);
       kmm_free(tfo);
     }
 
@@ -2671,4 +3126,38 @@ errout_with_fslock:
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tmpfs_munmap
+ *
+ * Description:
+ *   Release the reference that a mapping holds on a region created by
+ *   FIOC_MMAP.  The region is freed if the file no longer uses it and this
+ *   was its last mapping.
+ *
+ ****************************************************************************/
+
+int tmpfs_munmap(FAR void *start)
+{
+  FAR struct tmpfs_map_s *map;
+  int ret = -ENOENT;
+
+  tmpfs_lock_maps();
+
+  /* Find the region that contains this address */
+
+  for (map = g_tmpfs_maps; map != NULL; map = map->tm_flink)
+    {
+      if ((FAR uint8_t *)start >= map->tm_region &&
+          (FAR uint8_t *)start < map->tm_region + map->tm_length)
+        {
+          tmpfs_release_map(map);
+          ret = OK;
+          break;
+        }
+    }
+
+  tmpfs_unlock_maps();
+  return ret;
+}
+
 #endif /* CONFIG_DISABLE_MOUNTPOINT */
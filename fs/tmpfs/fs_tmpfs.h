@@ -58,6 +58,13 @@
 
 #define TFO_FLAG_UNLINKED (1 << 0)  /* Bit 0: File is unlinked */
 
+/* File data is held in pages of CONFIG_FS_TMPFS_PAGESIZE bytes */
+
+#define TMPFS_PAGESIZE    CONFIG_FS_TMPFS_PAGESIZE
+#define TMPFS_PAGE(o)     ((size_t)(o) / TMPFS_PAGESIZE)
+#define TMPFS_PAGEOFF(o)  ((size_t)(o) % TMPFS_PAGESIZE)
+#define TMPFS_NPAGES(n)   (((size_t)(n) + TMPFS_PAGESIZE - 1) / TMPFS_PAGESIZE)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -131,6 +138,20 @@ struct tmpfs_directory_s
 #define SIZEOF_TMPFS_DIRECTORY(n) \
   (sizeof(struct tmpfs_directory_s) + ((n) - 1) * sizeof(struct tmpfs_dirent_s))
 
+/* A contiguous region created to support mmap().  The region is shared by
+ * the file and by each mapping of it.  It holds one reference for the file
+ * and one for each mapping and is freed when the last reference is
+ * released, so it remains valid after the file is truncated or deleted.
+ */
+
+struct tmpfs_map_s
+{
+  FAR struct tmpfs_map_s *tm_flink; /* Supports a singly linked list */
+  FAR uint8_t *tm_region;           /* Start of the contiguous region */
+  size_t   tm_length;               /* Size of the region in bytes */
+  unsigned int tm_refs;             /* Reference count */
+};
+
 /* The form of a regular file memory object
  *
  * NOTE that in this very simplified implementation, there is no per-open
@@ -150,15 +171,22 @@ struct tmpfs_file_s
   uint8_t  tfo_type;     /* See enum tmpfs_objtype_e */
   uint8_t  tfo_refs;     /* Reference count */
 
-  /* Remaining fields are unique to a directory object */
+  /* Remaining fields are unique to a file object.
+   *
+   * The file data is held in a table of pages.  A NULL page is a hole in
+   * the file that reads as zeros.  Pages below tfo_nmapped are part of a
+   * single contiguous region at tfo_map that was created to support mmap();
+   * these pages are not individually freed.
+   */
 
   uint8_t  tfo_flags;    /* See TFO_FLAG_* definitions */
   size_t   tfo_size;     /* Valid file size */
-  uint8_t  tfo_data[1];  /* File data starts here */
+  size_t   tfo_npages;   /* Number of entries in tfo_pages[] */
+  size_t   tfo_nmapped;  /* Number of pages in the mapped region */
+  FAR uint8_t **tfo_pages; /* Table of file pages */
+  FAR struct tmpfs_map_s *tfo_map; /* Region for mmap(), or NULL */
 };
 
-#define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s) + (n) - 1)
-
 /* This structure represents one instance of a TMPFS file system */
 
 struct tmpfs_s
@@ -203,6 +231,25 @@ EXTERN const struct mountpt_operations tmpfs_operations;
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tmpfs_munmap
+ *
+ * Description:
+ *   Release the reference that a mapping holds on a region created by
+ *   FIOC_MMAP.  The region is freed if the file no longer uses it and this
+ *   was its last mapping.
+ *
+ * Input Parameters:
+ *   start - An address within the mapped region.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if the address
+ *   does not lie within a TMPFS mapped region.
+ *
+ ****************************************************************************/
+
+int tmpfs_munmap(FAR void *start);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
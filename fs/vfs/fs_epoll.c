@@ -42,15 +42,509 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <poll.h>
+#include <queue.h>
+#include <semaphore.h>
+#include <assert.h>
 #include <errno.h>
-#include <string.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
 
 #ifndef CONFIG_DISABLE_POLL
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values of the flags field of struct epoll_node_s */
+
+#define EPOLL_NODE_ARMED  (1 << 0) /* The poll is set up on the descriptor */
+#define EPOLL_NODE_READY  (1 << 1) /* In the ready list (or being harvested) */
+
+/* The events that are passed to the poll setup of the descriptor.  POLLERR
+ * and POLLHUP are always reported.
+ */
+
+#define EPOLL_POLLEVENTS  (POLLIN | POLLOUT | POLLERR | POLLHUP)
+
+#define epoll_semgive(eph) nxsem_post(&(eph)->exclsem)
+#define epoll_listgive()   nxsem_post(&g_epoll_listsem)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one descriptor registered with epoll_ctl().  The
+ * poll of the descriptor is set up when it is registered and remains set up
+ * until it is removed or the descriptor is closed.  The driver notification
+ * callback adds the node to the ready list of the epoll instance so that
+ * epoll_wait() only needs to visit the descriptors that have reported
+ * events.
+ *
+ * The poll is set up and torn down through the struct file or struct socket
+ * that the descriptor referred to when it was registered, never through the
+ * descriptor number which may be closed and re-used by then.
+ */
+
+struct epoll_head_s;
+struct epoll_node_s
+{
+  FAR struct epoll_node_s *flink;   /* Supports a singly linked list */
+  FAR struct epoll_head_s *eph;     /* The epoll instance */
+  int                      fd;      /* The registered descriptor or -1 */
+  FAR void                *obj;     /* The struct file or struct socket */
+  uint32_t                 events;  /* Requested events and EPOLL* flags */
+  epoll_data_t             data;    /* Returned with the events */
+  uint8_t                  flags;   /* See EPOLL_NODE_* definitions */
+  struct pollfd            pfd;     /* The poll set up on the descriptor */
+};
+
+/* This structure describes one epoll instance */
+
+struct epoll_head_s
+{
+  FAR struct epoll_head_s *flink;   /* Supports a singly linked list */
+  int                      size;    /* Number of entries in nodes[] */
+  sem_t                    exclsem; /* Serializes epoll_ctl()/epoll_wait() */
+  sem_t                    waitsem; /* Posted when the ready list fills */
+  sq_queue_t               ready;   /* Nodes with pending events */
+  FAR struct epoll_node_s *nodes;   /* The registered descriptors */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All epoll instances.  The list is visited when a registered file or
+ * socket is closed in order to remove it from the instances where it is
+ * registered.  The f_epolls or s_epolls count of a file or socket tells the
+ * close logic whether this is needed.
+ */
+
+static sq_queue_t g_epoll_list;
+static sem_t      g_epoll_listsem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_head
+ *
+ * Description:
+ *   Convert an epoll descriptor to the epoll instance.
+ *
+ ****************************************************************************/
+
+static inline FAR struct epoll_head_s *epoll_head(int epfd)
+{
+  /* REVISIT: This will not work on machines where:
+   * sizeof(struct epoll_head_s *) > sizeof(int)
+   */
+
+  return (FAR struct epoll_head_s *)((intptr_t)epfd);
+}
+
+/****************************************************************************
+ * Name: epoll_semtake
+ *
+ * Description:
+ *   Take the exclusive access semaphore of the epoll instance, ignoring
+ *   signals.
+ *
+ ****************************************************************************/
+
+static void epoll_semtake(FAR struct epoll_head_s *eph)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(&eph->exclsem);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+/****************************************************************************
+ * Name: epoll_listtake
+ *
+ * Description:
+ *   Take the semaphore that protects the list of epoll instances, ignoring
+ *   signals.
+ *
+ ****************************************************************************/
+
+static void epoll_listtake(void)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(&g_epoll_listsem);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+/****************************************************************************
+ * Name: epoll_callback
+ *
+ * Description:
+ *   The poll notification callback of a registered descriptor.  Add the
+ *   node to the ready list, unless it is already there, and wake up the
+ *   waiter.
+ *
+ * Assumptions:
+ *   May be called from interrupt handling logic.
+ *
+ ****************************************************************************/
+
+static void epoll_callback(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node_s *node = (FAR struct epoll_node_s *)fds->arg;
+  FAR struct epoll_head_s *eph = node->eph;
+  irqstate_t flags;
+  int sval;
+
+  flags = enter_critical_section();
+  if ((node->flags & EPOLL_NODE_READY) == 0)
+    {
+      node->flags |= EPOLL_NODE_READY;
+      sq_addlast((FAR sq_entry_t *)node, &eph->ready);
+
+      /* The semaphore is only a wake-up signal:  Do not let the count grow
+       * while nobody is waiting.
+       */
+
+      if (nxsem_getvalue(&eph->waitsem, &sval) < 0 || sval <= 0)
+        {
+          nxsem_post(&eph->waitsem);
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_getobj
+ *
+ * Description:
+ *   Get the struct file or struct socket of an open descriptor.
+ *
+ ****************************************************************************/
+
+static int epoll_getobj(int fd, FAR void **obj)
+{
+  if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS)
+    {
+      FAR struct file *filep;
+      int ret;
+
+      ret = fs_getfilep(fd, &filep);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (filep->f_inode == NULL)
+        {
+          return -EBADF;
+        }
+
+      *obj = filep;
+      return OK;
+    }
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+  if ((unsigned int)fd <
+      (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS))
+    {
+      FAR struct socket *psock = sockfd_socket(fd);
+
+      if (psock == NULL || psock->s_crefs <= 0)
+        {
+          return -EBADF;
+        }
+
+      *obj = psock;
+      return OK;
+    }
+#endif
+
+  return -EBADF;
+}
+
+/****************************************************************************
+ * Name: epoll_register
+ *
+ * Description:
+ *   Count a registration of the descriptor of a node in its struct file or
+ *   struct socket, or remove it from the count.
+ *
+ ****************************************************************************/
+
+static void epoll_register(FAR struct epoll_node_s *node, bool add)
+{
+  FAR uint16_t *nregs;
+  irqstate_t flags;
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+  if ((unsigned int)node->fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      nregs = &((FAR struct socket *)node->obj)->s_epolls;
+    }
+  else
+#endif
+    {
+      nregs = &((FAR struct file *)node->obj)->f_epolls;
+    }
+
+  /* Registrations in different epoll instances may race */
+
+  flags = enter_critical_section();
+  if (add)
+    {
+      DEBUGASSERT(*nregs < UINT16_MAX);
+      (*nregs)++;
+    }
+  else if (*nregs > 0)
+    {
+      (*nregs)--;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_fdsetup
+ *
+ * Description:
+ *   Set up or tear down the poll of the descriptor of a node.
+ *
+ ****************************************************************************/
+
+static int epoll_fdsetup(FAR struct epoll_node_s *node, bool setup)
+{
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+  if ((unsigned int)node->fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return psock_poll((FAR struct socket *)node->obj, &node->pfd, setup);
+    }
+#endif
+
+  return file_poll((FAR struct file *)node->obj, &node->pfd, setup);
+}
+
+/****************************************************************************
+ * Name: epoll_arm
+ *
+ * Description:
+ *   Set up the poll of the descriptor of a node.  If the descriptor is
+ *   already ready, the driver reports it immediately and the node is added
+ *   to the ready list (unless it is marked ready already).
+ *
+ ****************************************************************************/
+
+static int epoll_arm(FAR struct epoll_head_s *eph,
+                     FAR struct epoll_node_s *node)
+{
+  int ret;
+
+  node->pfd.fd      = node->fd;
+  node->pfd.sem     = &eph->waitsem;
+  node->pfd.events  = (node->events & EPOLL_POLLEVENTS) | POLLERR | POLLHUP;
+  node->pfd.revents = 0;
+  node->pfd.priv    = NULL;
+  node->pfd.cb      = epoll_callback;
+  node->pfd.arg     = node;
+
+  ret = epoll_fdsetup(node, true);
+  if (ret >= 0)
+    {
+      node->flags |= EPOLL_NODE_ARMED;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_disarm
+ *
+ * Description:
+ *   Tear down the poll of the descriptor of a node.
+ *
+ ****************************************************************************/
+
+static void epoll_disarm(FAR struct epoll_node_s *node)
+{
+  if ((node->flags & EPOLL_NODE_ARMED) != 0)
+    {
+      (void)epoll_fdsetup(node, false);
+      node->flags &= ~EPOLL_NODE_ARMED;
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove a node from the ready list.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR struct epoll_head_s *eph,
+                          FAR struct epoll_node_s *node)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if ((node->flags & EPOLL_NODE_READY) != 0)
+    {
+      sq_rem((FAR sq_entry_t *)node, &eph->ready);
+      node->flags &= ~EPOLL_NODE_READY;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Find the node of a registered descriptor.  If fd is -1, a free node is
+ *   returned.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_node_s *epoll_find(FAR struct epoll_head_s *eph,
+                                           int fd)
+{
+  int i;
+
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->nodes[i].fd == fd)
+        {
+          return &eph->nodes[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_harvest
+ *
+ * Description:
+ *   Return the events of the nodes in the ready list.  Each node is re-armed
+ *   to obtain the current state of the descriptor, so a node that is no
+ *   longer ready is dropped silently.  Then:
+ *
+ *   - EPOLLONESHOT nodes are disarmed until they are modified.
+ *   - EPOLLET nodes stay armed but leave the ready list until the driver
+ *     reports another event.
+ *   - Level-triggered nodes are put back at the end of the ready list so
+ *     that the next call checks them again.
+ *
+ *   The work done is proportional to the number of ready nodes, not to the
+ *   number of registered descriptors.
+ *
+ * Assumptions:
+ *   The caller holds the exclusive access semaphore.
+ *
+ ****************************************************************************/
+
+static int epoll_harvest(FAR struct epoll_head_s *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node_s *node;
+  sq_queue_t requeue;
+  pollevent_t revents;
+  irqstate_t flags;
+  int nevents = 0;
+
+  sq_init(&requeue);
+  while (nevents < maxevents)
+    {
+      /* The node keeps EPOLL_NODE_READY while it is harvested so that the
+       * callback leaves it alone.
+       */
+
+      flags = enter_critical_section();
+      node  = (FAR struct epoll_node_s *)sq_remfirst(&eph->ready);
+      leave_critical_section(flags);
+
+      if (node == NULL)
+        {
+          break;
+        }
+
+      /* Poll the descriptor again to get its current state */
+
+      epoll_disarm(node);
+      if (epoll_arm(eph, node) < 0)
+        {
+          /* The descriptor is no longer valid.  Report the error once. */
+
+          node->flags &= ~EPOLL_NODE_READY;
+          evs[nevents].events = POLLERR;
+          evs[nevents].data   = node->data;
+          nevents++;
+          continue;
+        }
+
+      flags   = enter_critical_section();
+      revents = node->pfd.revents;
+
+      if (revents == 0)
+        {
+          /* Nothing to report, the descriptor is not ready any longer */
+
+          node->flags &= ~EPOLL_NODE_READY;
+          leave_critical_section(flags);
+          continue;
+        }
+
+      evs[nevents].events = revents;
+      evs[nevents].data   = node->data;
+      nevents++;
+
+      node->pfd.revents = 0;
+      if ((node->events & (EPOLLONESHOT | EPOLLET)) != 0)
+        {
+          node->flags &= ~EPOLL_NODE_READY;
+        }
+      else
+        {
+          sq_addlast((FAR sq_entry_t *)node, &requeue);
+        }
+
+      leave_critical_section(flags);
+
+      if ((node->events & EPOLLONESHOT) != 0)
+        {
+          epoll_disarm(node);
+        }
+    }
+
+  /* Level-triggered nodes go to the end of the ready list */
+
+  flags = enter_critical_section();
+  sq_cat(&requeue, &eph->ready);
+  leave_critical_section(flags);
+
+  return nevents;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -59,24 +553,62 @@
  * Name: epoll_create
  *
  * Description:
+ *   Create an epoll instance.
  *
  * Input Parameters:
+ *   size - The maximum number of descriptors that can be registered
  *
  * Returned Value:
+ *   The epoll descriptor on success; -1 (ERROR) on failure with errno set
+ *   appropriately.
  *
  ****************************************************************************/
 
 int epoll_create(int size)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head));
+  FAR struct epoll_head_s *eph;
+  int i;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  eph = (FAR struct epoll_head_s *)
+    kmm_zalloc(sizeof(struct epoll_head_s) +
+               size * sizeof(struct epoll_node_s));
+  if (eph == NULL)
+    {
+      set_errno(ENOMEM);
+      return ERROR;
+    }
+
+  eph->size  = size;
+  eph->nodes = (FAR struct epoll_node_s *)(eph + 1);
 
-  eph->size = size;
-  eph->occupied = 0;
-  eph->evs = kmm_malloc(sizeof(struct epoll_event) * eph->size);
+  for (i = 0; i < size; i++)
+    {
+      eph->nodes[i].eph = eph;
+      eph->nodes[i].fd  = -1;
+    }
+
+  sq_init(&eph->ready);
+  nxsem_init(&eph->exclsem, 0, 1);
+
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_setprotocol(&eph->waitsem, SEM_PRIO_NONE);
+
+  epoll_listtake();
+  sq_addlast((FAR sq_entry_t *)eph, &g_epoll_list);
+  epoll_listgive();
 
   /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
+   * sizeof(struct epoll_head_s *) > sizeof(int)
    */
 
   return (int)((intptr_t)eph);
@@ -86,22 +618,33 @@ int epoll_create(int size)
  * Name: epoll_close
  *
  * Description:
+ *   Remove all registered descriptors and free the epoll instance.
  *
  * Input Parameters:
- *
- * Returned Value:
+ *   epfd - The epoll descriptor
  *
  ****************************************************************************/
 
 void epoll_close(int epfd)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  int i;
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  epoll_listtake();
+  sq_rem((FAR sq_entry_t *)eph, &g_epoll_list);
+  epoll_listgive();
 
-  kmm_free(eph->evs);
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->nodes[i].fd >= 0)
+        {
+          epoll_disarm(&eph->nodes[i]);
+          epoll_register(&eph->nodes[i], false);
+        }
+    }
+
+  nxsem_destroy(&eph->waitsem);
+  nxsem_destroy(&eph->exclsem);
   kmm_free(eph);
 }
 
@@ -109,130 +652,293 @@ void epoll_close(int epfd)
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a descriptor of the epoll instance.  The poll of
+ *   the descriptor is set up when it is added and remains set up until it
+ *   is removed (or, with EPOLLONESHOT, until an event has been reported).
  *
  * Input Parameters:
+ *   epfd - The epoll descriptor
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The file or socket descriptor
+ *   ev   - The requested events (EPOLLIN, EPOLLOUT, EPOLLET, EPOLLONESHOT)
+ *          and the data to be returned with them.  Not used by
+ *          EPOLL_CTL_DEL.
  *
  * Returned Value:
+ *   Zero (OK) on success; -1 (ERROR) on failure with errno set
+ *   appropriately:
+ *
+ *   EEXIST - The descriptor is already registered (EPOLL_CTL_ADD)
+ *   ENOENT - The descriptor is not registered (EPOLL_CTL_MOD/DEL)
+ *   ENOMEM - The epoll instance is full
+ *   EINVAL - Invalid op or descriptor
+ *
+ *   Errors from the poll setup of the descriptor are returned as well.
  *
  ****************************************************************************/
 
-int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  FAR struct epoll_node_s *node;
+  int ret = OK;
+
+  if (fd < 0 || (op != EPOLL_CTL_DEL && ev == NULL))
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  epoll_semtake(eph);
 
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
-              epfd, eph->occupied, fd, ev->events);
-
-        eph->evs[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->evs[eph->occupied++].data.fd = fd;
-        return 0;
+        finfo("%08x CTL ADD: fd=%d ev=%08x\n", epfd, fd, ev->events);
+
+        if (epoll_find(eph, fd) != NULL)
+          {
+            ret = -EEXIST;
+            break;
+          }
+
+        node = epoll_find(eph, -1);
+        if (node == NULL)
+          {
+            ret = -ENOMEM;
+            break;
+          }
+
+        ret = epoll_getobj(fd, &node->obj);
+        if (ret < 0)
+          {
+            break;
+          }
+
+        node->fd     = fd;
+        node->events = ev->events;
+        node->data   = ev->data;
+        node->flags  = 0;
+
+        ret = epoll_arm(eph, node);
+        if (ret < 0)
+          {
+            epoll_unready(eph, node);
+            node->fd = -1;
+            break;
+          }
+
+        epoll_register(node, true);
+        break;
 
       case EPOLL_CTL_DEL:
-        {
-          int i;
+        finfo("%08x CTL DEL: fd=%d\n", epfd, fd);
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  if (i != eph->occupied-1)
-                    {
-                      memmove(&eph->evs[i], &eph->evs[i + 1],
-                              eph->occupied - i);
-                    }
-
-                  eph->occupied--;
-                  return 0;
-                }
-            }
+        node = epoll_find(eph, fd);
+        if (node == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          return -ENOENT;
-        }
+        epoll_unready(eph, node);
+        epoll_disarm(node);
+        epoll_register(node, false);
+        node->fd = -1;
+        break;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%08x CTL MOD: fd=%d ev=%08x\n", epfd, fd, ev->events);
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+        node = epoll_find(eph, fd);
+        if (node == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  eph->evs[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
-            }
+        /* Re-arm the poll with the new events.  This also re-enables an
+         * EPOLLONESHOT descriptor after its event has been reported.
+         */
 
-          return -ENOENT;
-        }
+        epoll_unready(eph, node);
+        epoll_disarm(node);
+
+        node->events = ev->events;
+        node->data   = ev->data;
+
+        ret = epoll_arm(eph, node);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  epoll_semgive(eph);
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
     }
 
-  return -EINVAL;
+  return OK;
 }
 
 /****************************************************************************
  * Name: epoll_wait
  *
  * Description:
+ *   Wait for events on the descriptors of the epoll instance.  Only the
+ *   descriptors in the ready list are examined.
  *
  * Input Parameters:
+ *   epfd      - The epoll descriptor
+ *   evs       - The location to return the events
+ *   maxevents - The maximum number of events to return
+ *   timeout   - The time to wait in milliseconds.  A negative value means
+ *               to wait forever; zero means to return immediately.
  *
  * Returned Value:
+ *   The number of events returned in evs, zero on a timeout, or -1 (ERROR)
+ *   on failure with errno set appropriately:
+ *
+ *   EINVAL - evs is NULL or maxevents is not positive
+ *   EINTR  - A signal was received while waiting
  *
  ****************************************************************************/
 
 int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
                int timeout)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  clock_t start = 0;
+  clock_t ticks = 0;
+  int ret;
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
-  int counter;
-  int rc;
-  int i;
+  if (evs == NULL || maxevents <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  /* epoll_wait() is a cancellation point */
 
-  rc = poll((FAR struct pollfd *)eph->evs, eph->occupied, timeout);
+  (void)enter_cancellation_point();
 
-  if (rc <= 0)
+  if (timeout > 0)
     {
-      if (rc < 0)
+      /* Round the timeout up to the next full tick as poll() does */
+
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) +
+               (USEC_PER_TICK - 1)) / USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) / MSEC_PER_TICK;
+#endif
+      start = clock_systimer();
+    }
+
+  for (; ; )
+    {
+      epoll_semtake(eph);
+      ret = epoll_harvest(eph, evs, maxevents);
+      epoll_semgive(eph);
+
+      if (ret > 0 || timeout == 0)
         {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+          break;
+        }
 
-          for (i = 0; i < eph->occupied; i++)
+      /* Nothing is ready.  Wait until the callback of a descriptor signals
+       * that the ready list has been filled.
+       */
+
+      if (timeout > 0)
+        {
+          ret = nxsem_tickwait(&eph->waitsem, start, ticks);
+          if (ret == -ETIMEDOUT)
             {
-              ferr("  %02d: fd=%d\n", i, eph->evs[i].data.fd);
+              /* Check the ready list one last time */
+
+              timeout = 0;
+              continue;
             }
         }
+      else
+        {
+          ret = nxsem_wait(&eph->waitsem);
+        }
 
-      return rc;
+      if (ret < 0)
+        {
+          ferr("ERROR: %08x wait failed: %d\n", epfd, ret);
+          break;
+        }
     }
 
-  /* Iterate over non NULL event fds */
+  leave_cancellation_point();
 
-  for (i = 0, counter = 0; i < rc && counter < eph->size; counter++)
+  if (ret < 0)
     {
-      if (eph->evs[counter].revents != 0)
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Remove a file or socket that is being closed from all epoll instances.
+ *   The poll of the descriptor is torn down while the file or socket is
+ *   still open so that the driver drops its references to the epoll node.
+ *   The close logic calls this only if the file or socket has registrations,
+ *   so closing a descriptor that is in no epoll instance costs nothing here.
+ *
+ * Input Parameters:
+ *   obj - The struct file or struct socket that is being closed
+ *
+ * Assumptions:
+ *   Called from the close logic before the driver close method.
+ *
+ ****************************************************************************/
+
+void epoll_release(FAR void *obj)
+{
+  FAR struct epoll_head_s *eph;
+  FAR struct epoll_node_s *node;
+  int i;
+
+  epoll_listtake();
+
+  for (eph = (FAR struct epoll_head_s *)sq_peek(&g_epoll_list);
+       eph != NULL;
+       eph = eph->flink)
+    {
+      epoll_semtake(eph);
+
+      for (i = 0; i < eph->size; i++)
         {
-          evs[i].data.fd = eph->evs[counter].data.fd;
-          evs[i].events  = eph->evs[counter].revents;
-          i += 1;
+          node = &eph->nodes[i];
+          if (node->fd >= 0 && node->obj == obj)
+            {
+              epoll_unready(eph, node);
+              epoll_disarm(node);
+              epoll_register(node, false);
+              node->fd  = -1;
+              node->obj = NULL;
+            }
         }
+
+      epoll_semgive(eph);
     }
 
-  return i;
+  epoll_listgive();
 }
 
 #endif /* CONFIG_DISABLE_POLL */
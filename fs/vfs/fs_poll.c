@@ -147,6 +147,8 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds, sem_t *sem)
       fds[i].sem     = sem;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
+      fds[i].cb      = NULL;
+      fds[i].arg     = NULL;
 
       /* Check for invalid descriptors. "If the value of fd is less than 0,
        * events shall be ignored, and revents shall be set to 0 in that entry
@@ -305,6 +307,34 @@ static inline int poll_teardown(FAR struct pollfd *fds, nfds_t nfds, int *count,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: poll_post
+ *
+ * Description:
+ *   Report the events that have been set in fds->revents to the waiter of
+ *   a poll descriptor:  Either call the notification callback or post the
+ *   semaphore.
+ *
+ * Input Parameters:
+ *   fds - The poll descriptor with the reported events in revents
+ *
+ * Assumptions:
+ *   May be called from interrupt handling logic.
+ *
+ ****************************************************************************/
+
+void poll_post(FAR struct pollfd *fds)
+{
+  if (fds->cb != NULL)
+    {
+      fds->cb(fds);
+    }
+  else if (fds->sem != NULL)
+    {
+      poll_semgive(fds->sem);
+    }
+}
+
 /****************************************************************************
  * Name: file_poll
  *
@@ -360,7 +390,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
               fds->revents |= (fds->events & (POLLIN | POLLOUT));
               if (fds->revents != 0)
                 {
-                  nxsem_post(fds->sem);
+                  poll_post(fds);
                 }
             }
 
@@ -0,0 +1,325 @@
+/****************************************************************************
+ * fs/vfs/fs_readv.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+# include <sys/socket.h>
+#endif
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_readv
+ *
+ * Description:
+ *   Equivalent to the standard readv() function except that is accepts a
+ *   struct file instance instead of a file descriptor.  It is functionally
+ *   equivalent to readv() except that in addition to the differences in
+ *   input parameters:
+ *
+ *  - It does not modify the errno variable,
+ *  - It is not a cancellation point, and
+ *  - It does not handle socket descriptors.
+ *
+ *   If the driver provides a readv method, the whole I/O vector is passed
+ *   to the driver in one call.  Otherwise, the read method is called for
+ *   each element of the vector in turn until all of the buffers have been
+ *   filled or until a read returns less than was requested.
+ *
+ * Input Parameters:
+ *   filep  - Instance of struct file to use with the read
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes read on success (zero indicates an end-of-file
+ *   condition).  On any failure, a negated errno value is returned (see
+ *   comments with read() for a description of the appropriate errno
+ *   values).
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+ssize_t file_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt)
+{
+  FAR struct inode *inode;
+  ssize_t nread;
+  ssize_t ntotal;
+  size_t total;
+  int i;
+
+  /* Was this file opened for read access? */
+
+  if ((filep->f_oflags & O_RDOK) == 0)
+    {
+      return -EBADF;
+    }
+
+  /* Is a driver registered? */
+
+  inode = filep->f_inode;
+  if (!inode || !inode->u.i_ops)
+    {
+      return -EBADF;
+    }
+
+  /* Verify the I/O vector.  The total size must be representable in the
+   * ssize_t return value.
+   */
+
+  if (iov == NULL || iovcnt <= 0 || iovcnt > IOV_MAX)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0, total = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += iov[i].iov_len;
+    }
+
+  /* Does the driver support the readv method?  Note that the mountpoint
+   * operations do not include the readv method.
+   */
+
+  if (!INODE_IS_MOUNTPT(inode) && inode->u.i_ops->readv != NULL)
+    {
+      /* Yes, then let the driver fill the whole vector */
+
+      return inode->u.i_ops->readv(filep, iov, iovcnt);
+    }
+
+  if (inode->u.i_ops->read == NULL)
+    {
+      return -EBADF;
+    }
+
+  /* No.. read into each element of the vector in turn */
+
+  for (i = 0, ntotal = 0; i < iovcnt; i++)
+    {
+      /* Ignore zero-length reads */
+
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nread = inode->u.i_ops->read(filep, iov[i].iov_base, iov[i].iov_len);
+      if (nread < 0)
+        {
+          /* Report the error only if nothing was read */
+
+          return ntotal > 0 ? ntotal : nread;
+        }
+
+      ntotal += nread;
+
+      /* Stop at a short read (or end-of-file).  Another read might block
+       * waiting for data that the caller does not yet need.
+       */
+
+      if ((size_t)nread < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal;
+}
+#endif
+
+/****************************************************************************
+ * Name: nx_readv
+ *
+ * Description:
+ *  nx_readv() reads data from the file (or socket) referenced by the
+ *  descriptor fd and scatters it into the 'iovcnt' buffers described by
+ *  'iov'.  nx_readv() is an internal OS function.  It is functionally
+ *  equivalent to readv() except that:
+ *
+ *  - It does not modify the errno variable, and
+ *  - It is not a cancellation point.
+ *
+ * Input Parameters:
+ *   fd     - file descriptor (or socket descriptor) to read from
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes read on success (zero indicates an end-of-file
+ *   condition).  On any failure, a negated errno value is returned (see
+ *   comments with readv() for a description of the appropriate errno
+ *   values).
+ *
+ ****************************************************************************/
+
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  /* Did we get a valid file descriptor? */
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+#endif
+    {
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+      struct msghdr msg;
+
+      /* readv() on a socket descriptor is equivalent to recvmsg() with no
+       * source address and with flags == 0.
+       */
+
+      if (iovcnt <= 0)
+        {
+          return -EINVAL;
+        }
+
+      msg.msg_name       = NULL;
+      msg.msg_namelen    = 0;
+      msg.msg_iov        = (FAR struct iovec *)iov;
+      msg.msg_iovlen     = iovcnt;
+      msg.msg_control    = NULL;
+      msg.msg_controllen = 0;
+      msg.msg_flags      = 0;
+
+      return nx_recvmsg(fd, &msg, 0);
+#else
+      return -EBADF;
+#endif
+    }
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  else
+    {
+      FAR struct file *filep;
+      ssize_t ret;
+
+      /* The descriptor is in the right range to be a file descriptor..
+       * get the file structure.
+       */
+
+      ret = (ssize_t)fs_getfilep(fd, &filep);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Then let file_readv() do all of the work */
+
+      return file_readv(filep, iov, iovcnt);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: readv
+ *
+ * Description:
+ *   The readv() function is equivalent to read(), except as described below.
+ *   The readv() function places the input data into the 'iovcnt' buffers
+ *   specified by the members of the 'iov' array: iov[0], iov[1], ...,
+ *   iov['iovcnt'-1].  The 'iovcnt' argument is valid if greater than 0 and
+ *   less than or equal to IOV_MAX as defined in limits.h.
+ *
+ *   Each iovec entry specifies the base address and length of an area in
+ *   memory where data should be placed.  The readv() function will always
+ *   fill an area completely before proceeding to the next.
+ *
+ *   TODO: Upon successful completion, readv() will mark for update the
+ *   st_atime field of the file.
+ *
+ * Input Parameters:
+ *   fildes - The open file descriptor for the file to be read
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   Upon successful completion, readv() will return a non-negative integer
+ *   indicating the number of bytes actually read.  Otherwise, the functions
+ *   will return -1 and set errno to indicate the error.  See read() for the
+ *   list of returned errno values.  In addition, the readv() function will
+ *   fail if:
+ *
+ *    EINVAL.
+ *      The sum of the iov_len values in the iov array overflowed an ssize_t
+ *      or The 'iovcnt' argument was less than or equal to 0, or greater than
+ *      IOV_MAX.
+ *
+ ****************************************************************************/
+
+ssize_t readv(int fildes, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* readv() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Let nx_readv() do all of the work */
+
+  ret = nx_readv(fildes, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
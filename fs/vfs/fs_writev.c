@@ -0,0 +1,334 @@
+/****************************************************************************
+ * fs/vfs/fs_writev.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+# include <sys/socket.h>
+#endif
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_writev
+ *
+ * Description:
+ *   Equivalent to the standard writev() function except that is accepts a
+ *   struct file instance instead of a file descriptor.  It is functionally
+ *   equivalent to writev() except that in addition to the differences in
+ *   input parameters:
+ *
+ *  - It does not modify the errno variable,
+ *  - It is not a cancellation point, and
+ *  - It does not handle socket descriptors.
+ *
+ *   If the driver provides a writev method, the whole I/O vector is passed
+ *   to the driver in one call.  Otherwise, the write method is called for
+ *   each element of the vector in turn until all of the data has been
+ *   written or until a write transfers less than was requested.
+ *
+ * Input Parameters:
+ *   filep  - Instance of struct file to use with the write
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *  On success, the number of bytes written are returned (zero indicates
+ *  nothing was written).  On any failure, a negated errno value is returned
+ *  (see comments with writev() for a description of the appropriate errno
+ *  values).
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt)
+{
+  FAR struct inode *inode;
+  ssize_t nwritten;
+  ssize_t ntotal;
+  size_t total;
+  int i;
+
+  /* Was this file opened for write access? */
+
+  if ((filep->f_oflags & O_WROK) == 0)
+    {
+      return -EBADF;
+    }
+
+  /* Is a driver registered? */
+
+  inode = filep->f_inode;
+  if (!inode || !inode->u.i_ops)
+    {
+      return -EBADF;
+    }
+
+  /* Verify the I/O vector.  The total size must be representable in the
+   * ssize_t return value.
+   */
+
+  if (iov == NULL || iovcnt <= 0 || iovcnt > IOV_MAX)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0, total = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += iov[i].iov_len;
+    }
+
+  /* Does the driver support the writev method?  Note that the mountpoint
+   * operations do not include the writev method.
+   */
+
+  if (!INODE_IS_MOUNTPT(inode) && inode->u.i_ops->writev != NULL)
+    {
+      /* Yes, then let the driver write the whole vector */
+
+      return inode->u.i_ops->writev(filep, iov, iovcnt);
+    }
+
+  if (inode->u.i_ops->write == NULL)
+    {
+      return -EBADF;
+    }
+
+  /* No.. write each element of the vector in turn */
+
+  for (i = 0, ntotal = 0; i < iovcnt; i++)
+    {
+      /* Ignore zero-length writes */
+
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nwritten = inode->u.i_ops->write(filep, iov[i].iov_base,
+                                       iov[i].iov_len);
+      if (nwritten < 0)
+        {
+          /* Report the error only if nothing was written */
+
+          return ntotal > 0 ? ntotal : nwritten;
+        }
+
+      ntotal += nwritten;
+
+      /* Stop at a short write.  The remaining data may not follow the data
+       * that was written.
+       */
+
+      if ((size_t)nwritten < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal;
+}
+#endif
+
+/****************************************************************************
+ * Name: nx_writev
+ *
+ * Description:
+ *  nx_writev() gathers data from the 'iovcnt' buffers described by 'iov'
+ *  and writes it to the file (or socket) referenced by the descriptor fd.
+ *  nx_writev() is an internal OS function.  It is functionally equivalent
+ *  to writev() except that:
+ *
+ *  - It does not modify the errno variable, and
+ *  - It is not a cancellation point.
+ *
+ * Input Parameters:
+ *   fd     - file descriptor (or socket descriptor) to write to
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *  On success, the number of bytes written are returned (zero indicates
+ *  nothing was written).  On any failure, a negated errno value is returned
+ *  (see comments with writev() for a description of the appropriate errno
+ *  values).
+ *
+ ****************************************************************************/
+
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  /* Did we get a valid file descriptor? */
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+#endif
+    {
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+      struct msghdr msg;
+
+      /* writev() on a socket descriptor is equivalent to sendmsg() with no
+       * destination address and with flags == 0.
+       */
+
+      if (iovcnt <= 0)
+        {
+          return -EINVAL;
+        }
+
+      msg.msg_name       = NULL;
+      msg.msg_namelen    = 0;
+      msg.msg_iov        = (FAR struct iovec *)iov;
+      msg.msg_iovlen     = iovcnt;
+      msg.msg_control    = NULL;
+      msg.msg_controllen = 0;
+      msg.msg_flags      = 0;
+
+      return nx_sendmsg(fd, &msg, 0);
+#else
+      return -EBADF;
+#endif
+    }
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  else
+    {
+      FAR struct file *filep;
+      ssize_t ret;
+
+      /* The descriptor is in the right range to be a file descriptor..
+       * get the file structure.
+       */
+
+      ret = (ssize_t)fs_getfilep(fd, &filep);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Then let file_writev() do all of the work */
+
+      return file_writev(filep, iov, iovcnt);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: writev
+ *
+ * Description:
+ *   The writev() function is equivalent to write(), except as described
+ *   below. The writev() function will gather output data from the 'iovcnt'
+ *   buffers specified by the members of the 'iov' array: iov[0], iov[1], ...,
+ *   iov[iovcnt-1]. The 'iovcnt' argument is valid if greater than 0 and less
+ *   than or equal to IOV_MAX, as defined in limits.h.
+ *
+ *   Each iovec entry specifies the base address and length of an area in
+ *   memory from which data should be written. The writev() function always
+ *   writes a complete area before proceeding to the next.
+ *
+ *   If 'fildes' refers to a regular file and all of the iov_len members in
+ *   the array pointed to by iov are 0, writev() will return 0 and have no
+ *   other effect. For other file types, the behavior is unspecified.
+ *
+ *   If the sum of the iov_len values is greater than SSIZE_MAX, the
+ *   operation will fail and no data will be transferred.
+ *
+ *   If 'fildes' refers to a socket, the whole vector is sent as with
+ *   sendmsg():  A UDP datagram is built from all of the buffers and a TCP
+ *   send queues all of the buffers in one operation.
+ *
+ * Input Parameters:
+ *   fildes - The open file descriptor for the file to be written
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   Upon successful completion, writev() shall return the number of bytes
+ *   actually written. Otherwise, it shall return a value of -1, the file-
+ *   pointer shall remain unchanged, and errno shall be set to indicate an
+ *   error. See write for the list of returned errno values. In addition,
+ *   the writev() function will fail if:
+ *
+ *    EINVAL.
+ *      The sum of the iov_len values in the iov array overflowed an ssize_t
+ *      or The 'iovcnt' argument was less than or equal to 0, or greater than
+ *      IOV_MAX.
+ *
+ ****************************************************************************/
+
+ssize_t writev(int fildes, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* writev() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Let nx_writev() do all of the work */
+
+  ret = nx_writev(fildes, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -0,0 +1,548 @@
+/****************************************************************************
+ * graphics/vnc/vnc_hextile.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_FEATURES
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  define CONFIG_DEBUG_FEATURES 1
+#  define CONFIG_DEBUG_ERROR    1
+#  define CONFIG_DEBUG_WARN     1
+#  define CONFIG_DEBUG_INFO     1
+#  define CONFIG_DEBUG_GRAPHICS 1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of most frequent colors considered when picking the tile
+ * background.
+ */
+
+#define HEXTILE_NCOLORS 8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state that carries over from one tile to the next */
+
+struct vnc_hextile_s
+{
+  FAR struct vnc_session_s *session;
+  uint32_t bg;                 /* Background of the previous tile */
+  uint32_t fg;                 /* Foreground of the previous tile */
+  bool bgvalid;                /* True: bg may be carried over */
+  bool fgvalid;                /* True: fg may be carried over */
+  bool bigendian;              /* True: Remote expects big-endian pixels */
+  uint8_t bytesperpixel;       /* Size of one remote pixel */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile_colors
+ *
+ * Description:
+ *   Find the most frequent color of the converted tile.
+ *
+ * Input Parameters:
+ *   tile    - The converted tile.
+ *   npixels - The number of pixels in the tile.
+ *   bg      - The location to return the most frequent color.
+ *   fg      - The location to return the second color of a two color tile.
+ *
+ * Returned Value:
+ *   The number of different colors in the tile.  HEXTILE_NCOLORS + 1 is
+ *   returned if there are more than HEXTILE_NCOLORS colors.
+ *
+ ****************************************************************************/
+
+static int vnc_hextile_colors(FAR const uint32_t *tile, unsigned int npixels,
+                              FAR uint32_t *bg, FAR uint32_t *fg)
+{
+  uint32_t colors[HEXTILE_NCOLORS];
+  uint16_t counts[HEXTILE_NCOLORS];
+  uint32_t pixel;
+  unsigned int i;
+  int ncolors = 1;
+  int maxndx  = 0;
+  int ndx;
+  bool many   = false;
+
+  /* Start with the first pixel which gets counted again below */
+
+  colors[0] = tile[0];
+  counts[0] = 0;
+
+  for (i = 0; i < npixels; i++)
+    {
+      pixel = tile[i];
+      for (ndx = 0; ndx < ncolors && colors[ndx] != pixel; ndx++)
+        {
+        }
+
+      if (ndx < ncolors)
+        {
+          counts[ndx]++;
+        }
+      else if (ncolors < HEXTILE_NCOLORS)
+        {
+          colors[ncolors] = pixel;
+          counts[ncolors] = 1;
+          ncolors++;
+        }
+      else
+        {
+          /* Just keep counting the colors that we already have */
+
+          many = true;
+          continue;
+        }
+
+      if (counts[ndx] > counts[maxndx])
+        {
+          maxndx = ndx;
+        }
+    }
+
+  *bg = colors[maxndx];
+  *fg = colors[(ncolors > 1 && maxndx == 0) ? 1 : 0];
+  return many ? HEXTILE_NCOLORS + 1 : ncolors;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_subrects
+ *
+ * Description:
+ *   Cover the pixels of the converted tile that are not the background
+ *   color with single color sub-rectangles.  Each sub-rectangle is grown
+ *   first to the right and then downward from the top-left-most uncovered
+ *   pixel.
+ *
+ * Input Parameters:
+ *   priv    - The Hextile encoder state.
+ *   width, height - The size of the tile.
+ *   bg      - The background color of the tile.
+ *   colored - True: Each sub-rectangle carries its own color.
+ *   maxsub  - Counting stops once this number of sub-rectangles is
+ *             exceeded.
+ *   emit    - True: Send the sub-rectangles; False: Only count them.
+ *
+ * Returned Value:
+ *   The number of sub-rectangles (at most maxsub + 1) or a negated errno
+ *   value if the send failed.
+ *
+ ****************************************************************************/
+
+static int vnc_hextile_subrects(FAR struct vnc_hextile_s *priv,
+                                unsigned int width, unsigned int height,
+                                uint32_t bg, bool colored,
+                                unsigned int maxsub, bool emit)
+{
+  FAR struct vnc_session_s *session = priv->session;
+  FAR const uint32_t *tile = session->tile;
+  FAR uint8_t *dest;
+  uint16_t covered[VNCSERVER_TILESIZE];
+  uint16_t runmask;
+  uint32_t color;
+  unsigned int nsubrects = 0;
+  unsigned int x;
+  unsigned int y;
+  unsigned int x2;
+  unsigned int y2;
+  unsigned int i;
+  int ret;
+
+  memset(covered, 0, sizeof(covered));
+
+  for (y = 0; y < height; y++)
+    {
+      for (x = 0; x < width; x++)
+        {
+          color = tile[y * width + x];
+          if (color == bg || (covered[y] & (1 << x)) != 0)
+            {
+              continue;
+            }
+
+          if (++nsubrects > maxsub)
+            {
+              return nsubrects;
+            }
+
+          /* Grow to the right */
+
+          for (x2 = x + 1;
+               x2 < width && tile[y * width + x2] == color &&
+               (covered[y] & (1 << x2)) == 0;
+               x2++)
+            {
+            }
+
+          /* Then grow downward while the whole run matches */
+
+          runmask = (uint16_t)(((1 << (x2 - x)) - 1) << x);
+          for (y2 = y + 1; y2 < height; y2++)
+            {
+              if ((covered[y2] & runmask) != 0)
+                {
+                  break;
+                }
+
+              for (i = x; i < x2 && tile[y2 * width + i] == color; i++)
+                {
+                }
+
+              if (i < x2)
+                {
+                  break;
+                }
+            }
+
+          for (i = y; i < y2; i++)
+            {
+              covered[i] |= runmask;
+            }
+
+          if (emit)
+            {
+              ret = vnc_tile_reserve(session, priv->bytesperpixel + 2);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              dest = &session->outbuf[session->outlen];
+              if (colored)
+                {
+                  dest = vnc_tile_putpixel(dest, color, priv->bytesperpixel,
+                                           priv->bigendian);
+                }
+
+              *dest++ = (uint8_t)((x << 4) | y);
+              *dest++ = (uint8_t)(((x2 - x - 1) << 4) | (y2 - y - 1));
+
+              session->outlen = dest - session->outbuf;
+            }
+
+          /* Skip over the run that we just covered */
+
+          x = x2 - 1;
+        }
+    }
+
+  return nsubrects;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_tile
+ *
+ * Description:
+ *   Encode the converted tile in session->tile[] using the smallest of the
+ *   Hextile tile formats.
+ *
+ * Input Parameters:
+ *   priv    - The Hextile encoder state.
+ *   width, height - The size of the tile.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on a send failure.
+ *
+ ****************************************************************************/
+
+static int vnc_hextile_tile(FAR struct vnc_hextile_s *priv,
+                            unsigned int width, unsigned int height)
+{
+  FAR struct vnc_session_s *session = priv->session;
+  FAR uint8_t *dest;
+  unsigned int npixels = width * height;
+  unsigned int bpp = priv->bytesperpixel;
+  unsigned int rawsize;
+  unsigned int hdrsize;
+  unsigned int subsize;
+  unsigned int maxsub;
+  unsigned int x;
+  unsigned int y;
+  uint32_t bg;
+  uint32_t fg;
+  uint8_t mask;
+  bool colored;
+  int ncolors;
+  int nsubrects;
+  int ret;
+
+  ncolors = vnc_hextile_colors(session->tile, npixels, &bg, &fg);
+
+  /* Decide which colors must be sent with the tile */
+
+  mask = 0;
+  if (!priv->bgvalid || priv->bg != bg)
+    {
+      mask |= RFB_HEXTILE_BACK;
+    }
+
+  nsubrects = 0;
+  colored   = false;
+
+  if (ncolors > 1)
+    {
+      /* Try sub-rectangles.  Give up as soon as they would take more space
+       * than the raw pixels.
+       */
+
+      colored = (ncolors > 2);
+      if (!colored && (!priv->fgvalid || priv->fg != fg))
+        {
+          mask |= RFB_HEXTILE_FORE;
+        }
+
+      rawsize = npixels * bpp;
+      hdrsize = 2 + ((mask & RFB_HEXTILE_BACK) != 0 ? bpp : 0) +
+                    ((mask & RFB_HEXTILE_FORE) != 0 ? bpp : 0);
+      subsize = colored ? bpp + 2 : 2;
+      maxsub  = rawsize > hdrsize ? (rawsize - hdrsize) / subsize : 0;
+      if (maxsub > 255)
+        {
+          maxsub = 255;
+        }
+
+      nsubrects = vnc_hextile_subrects(priv, width, height, bg, colored,
+                                       maxsub, false);
+      if (nsubrects > maxsub)
+        {
+          /* Send the raw pixels.  Neither color may carry over a raw tile */
+
+          ret = vnc_tile_reserve(session, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          session->outbuf[session->outlen++] = RFB_HEXTILE_RAW;
+
+          for (y = 0; y < height; y++)
+            {
+              ret = vnc_tile_reserve(session, width * bpp);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              dest = &session->outbuf[session->outlen];
+              for (x = 0; x < width; x++)
+                {
+                  dest = vnc_tile_putpixel(dest,
+                                           session->tile[y * width + x],
+                                           bpp, priv->bigendian);
+                }
+
+              session->outlen = dest - session->outbuf;
+            }
+
+          priv->bgvalid = false;
+          priv->fgvalid = false;
+          return OK;
+        }
+
+      mask |= RFB_HEXTILE_ANY;
+      if (colored)
+        {
+          mask |= RFB_HEXTILE_COLORED;
+        }
+    }
+
+  /* Send the sub-encoding mask and the colors */
+
+  ret = vnc_tile_reserve(session, 2 + 2 * bpp);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  dest    = &session->outbuf[session->outlen];
+  *dest++ = mask;
+
+  if ((mask & RFB_HEXTILE_BACK) != 0)
+    {
+      dest = vnc_tile_putpixel(dest, bg, bpp, priv->bigendian);
+    }
+
+  if ((mask & RFB_HEXTILE_FORE) != 0)
+    {
+      dest = vnc_tile_putpixel(dest, fg, bpp, priv->bigendian);
+    }
+
+  if ((mask & RFB_HEXTILE_ANY) != 0)
+    {
+      *dest++ = (uint8_t)nsubrects;
+    }
+
+  session->outlen = dest - session->outbuf;
+
+  priv->bg      = bg;
+  priv->bgvalid = true;
+
+  if (colored)
+    {
+      priv->fgvalid = false;
+    }
+  else if ((mask & RFB_HEXTILE_FORE) != 0)
+    {
+      priv->fg      = fg;
+      priv->fgvalid = true;
+    }
+
+  /* Then the sub-rectangles */
+
+  if (nsubrects > 0)
+    {
+      ret = vnc_hextile_subrects(priv, width, height, bg, colored,
+                                 nsubrects, true);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if the client does not support Hextile encoding.
+ *   Otherwise, a positive value is returned on success or a negated errno
+ *   value is returned on failure that indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect)
+{
+  struct vnc_hextile_s priv;
+  nxgl_coord_t width;
+  nxgl_coord_t height;
+  nxgl_coord_t x;
+  nxgl_coord_t y;
+  uint8_t colorfmt;
+  int ret;
+
+  /* Check if the client supports the Hextile encoding */
+
+  if (!session->hextile)
+    {
+      return 0;
+    }
+
+  /* Set up characteristics of the client pixel format to use on this
+   * update.  These can change at any time if a SetPixelFormat is
+   * received asynchronously, the update is finished in the format that it
+   * was started with.
+   */
+
+  memset(&priv, 0, sizeof(struct vnc_hextile_s));
+  priv.session       = session;
+  priv.bigendian     = session->bigendian;
+  priv.bytesperpixel = (session->bpp + 7) >> 3;
+  colorfmt           = session->colorfmt;
+
+  vnc_tile_header(session, rect, RFB_ENCODING_HEXTILE);
+
+  /* Encode each tile, left-to-right and top-to-bottom */
+
+  for (y = rect->pt1.y; y <= rect->pt2.y; y += VNCSERVER_TILESIZE)
+    {
+      height = MIN(rect->pt2.y - y + 1, VNCSERVER_TILESIZE);
+
+      for (x = rect->pt1.x; x <= rect->pt2.x; x += VNCSERVER_TILESIZE)
+        {
+          width = MIN(rect->pt2.x - x + 1, VNCSERVER_TILESIZE);
+
+          ret = vnc_tile_convert(session, colorfmt, x, y, width, height);
+          if (ret >= 0)
+            {
+              ret = vnc_hextile_tile(&priv, width, height);
+            }
+
+          if (ret < 0)
+            {
+              session->outlen = 0;
+              return ret;
+            }
+        }
+    }
+
+  ret = vnc_tile_flush(session);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  updinfo("Sent {(%d, %d),(%d, %d)}\n",
+          rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
+  return 1;
+}
@@ -259,7 +259,7 @@ static size_t vnc_copy32(FAR struct vnc_session_s *session,
       srcleft = (FAR lfb_color_t *)((uintptr_t)srcleft + RFB_STRIDE);
     }
 
-  return (size_t)((uintptr_t)srcleft - (uintptr_t)update->rect[0].data);
+  return (size_t)((uintptr_t)dest - (uintptr_t)update->rect[0].data);
 }
 
 /****************************************************************************
@@ -297,6 +297,17 @@ int vnc_receiver(FAR struct vnc_session_s *session)
                   rect.pt2.x = rect.pt1.x + rfb_getbe16(update->width);
                   rect.pt2.y = rect.pt1.y + rfb_getbe16(update->height);
 
+#ifdef CONFIG_VNCSERVER_TILECACHE
+                  /* A non-incremental request asks for the whole region,
+                   * changed or not.
+                   */
+
+                  if (update->incremental == 0)
+                    {
+                      session->tilereset = true;
+                    }
+
+#endif
                   ret = vnc_update_rectangle(session, &rect, false);
                   if (ret < 0)
                     {
@@ -465,7 +476,9 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
 
   /* Assume that there are no common encodings (other than RAW) */
 
-  session->rre = false;
+  session->rre     = false;
+  session->hextile = false;
+  session->trle    = false;
 
   /* Loop for each client supported encoding */
 
@@ -482,6 +495,18 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
         {
           session->rre = true;
         }
+#ifdef CONFIG_VNCSERVER_HEXTILE
+      else if (encoding == RFB_ENCODING_HEXTILE)
+        {
+          session->hextile = true;
+        }
+#endif
+#ifdef CONFIG_VNCSERVER_TRLE
+      else if (encoding == RFB_ENCODING_TRLE)
+        {
+          session->trle = true;
+        }
+#endif
     }
 
   session->change = true;
@@ -129,6 +129,12 @@ static void vnc_reset_session(FAR struct vnc_session_s *session,
       sq_addlast((FAR sq_entry_t *)&session->updpool[i], &session->updfree);
     }
 
+#ifdef CONFIG_VNCSERVER_TILECACHE
+  /* The new client has none of the tiles */
+
+  session->tilereset = true;
+#endif
+
   /* Set the INITIALIZED state */
 
   nxsem_reset(&session->freesem, CONFIG_VNCSERVER_NUPDATES);
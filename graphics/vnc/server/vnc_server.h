@@ -166,6 +166,19 @@
 #define RFB_STRIDE          (RFB_BYTESPERPIXEL * CONFIG_VNCSERVER_SCREENWIDTH)
 #define RFB_SIZE            (RFB_STRIDE * CONFIG_VNCSERVER_SCREENHEIGHT)
 
+/* The Hextile and TRLE encodings and the tile cache work on tiles of
+ * 16x16 pixels.  Tiles of the tile cache are aligned to the local
+ * framebuffer.
+ */
+
+#if defined(CONFIG_VNCSERVER_HEXTILE) || defined(CONFIG_VNCSERVER_TRLE)
+#  define VNCSERVER_HAVE_TILES 1
+#endif
+
+#define VNCSERVER_TILESIZE  16
+#define VNCSERVER_NTILESX   ((CONFIG_VNCSERVER_SCREENWIDTH + 15) >> 4)
+#define VNCSERVER_NTILESY   ((CONFIG_VNCSERVER_SCREENHEIGHT + 15) >> 4)
+
 /* RFB Port Number */
 
 #define RFB_PORT_BASE       5900
@@ -249,8 +262,11 @@ struct vnc_session_s
   uint8_t display;             /* Display number (for debug) */
   volatile uint8_t colorfmt;   /* Remote color format (See include/nuttx/fb.h) */
   volatile uint8_t bpp;        /* Remote bits per pixel */
+  volatile uint8_t depth;      /* Remote color depth */
   volatile bool bigendian;     /* True: Remote expect data in big-endian format */
   volatile bool rre;           /* True: Remote supports RRE encoding */
+  volatile bool hextile;       /* True: Remote supports Hextile encoding */
+  volatile bool trle;          /* True: Remote supports TRLE encoding */
   FAR uint8_t *fb;             /* Allocated local frame buffer */
 
   /* VNC client input support */
@@ -271,6 +287,26 @@ struct vnc_session_s
   sem_t freesem;
   sem_t queuesem;
 
+#ifdef CONFIG_VNCSERVER_TILECACHE
+  /* Hash of each tile of the local framebuffer as last sent.  Zero means
+   * unknown.  tileskip counts the updates that skipped a tile because its
+   * hash was unchanged.  rowhash holds the new hashes of one tile row until
+   * the tiles have been sent.
+   */
+
+  volatile bool tilereset;     /* True: Forget all tile hashes */
+  uint32_t tilehash[VNCSERVER_NTILESX * VNCSERVER_NTILESY];
+  uint8_t tileskip[VNCSERVER_NTILESX * VNCSERVER_NTILESY];
+  uint32_t rowhash[VNCSERVER_NTILESX];
+#endif
+
+#ifdef VNCSERVER_HAVE_TILES
+  /* The tile being encoded, converted to the remote color format */
+
+  uint32_t tile[VNCSERVER_TILESIZE * VNCSERVER_TILESIZE];
+  uint16_t outlen;             /* Bytes of a streamed update in outbuf */
+#endif
+
   /* I/O buffers for misc network send/receive */
 
   uint8_t inbuf[CONFIG_VNCSERVER_INBUFFER_SIZE];
@@ -518,6 +554,162 @@ int vnc_rre(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
 
 int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
 
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if the client does not support Hextile encoding.
+ *   Otherwise, a positive value is returned on success or a negated errno
+ *   value is returned on failure that indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: vnc_trle
+ *
+ * Description:
+ *  Send the framebuffer update using the TRLE encoding.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if the client does not support TRLE encoding.
+ *   Otherwise, a positive value is returned on success or a negated errno
+ *   value is returned on failure that indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TRLE
+int vnc_trle(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: vnc_tile_convert
+ *
+ * Description:
+ *  Convert one tile of the local framebuffer to the remote color format,
+ *  leaving the remote pixel values in session->tile[].  Each tile is
+ *  converted only once and the converted values are then used both to
+ *  select the sub-encoding and to send the tile.
+ *
+ * Input Parameters:
+ *   session  - An instance of the session structure.
+ *   colorfmt - The remote color format to convert to.
+ *   x, y     - The position of the tile in the local framebuffer.
+ *   width, height - The size of the tile (at most VNCSERVER_TILESIZE).
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the color format is not supported.
+ *
+ ****************************************************************************/
+
+#ifdef VNCSERVER_HAVE_TILES
+int vnc_tile_convert(FAR struct vnc_session_s *session, uint8_t colorfmt,
+                     nxgl_coord_t x, nxgl_coord_t y,
+                     nxgl_coord_t width, nxgl_coord_t height);
+#endif
+
+/****************************************************************************
+ * Name: vnc_tile_header
+ *
+ * Description:
+ *  Start a streamed FramebufferUpdate message with one rectangle.  The
+ *  message is built in session->outbuf which is sent whenever it fills up.
+ *
+ * Input Parameters:
+ *   session  - An instance of the session structure.
+ *   rect     - Describes the rectangle in the local framebuffer.
+ *   encoding - The encoding of the rectangle.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef VNCSERVER_HAVE_TILES
+void vnc_tile_header(FAR struct vnc_session_s *session,
+                     FAR const struct nxgl_rect_s *rect, int32_t encoding);
+#endif
+
+/****************************************************************************
+ * Name: vnc_tile_reserve
+ *
+ * Description:
+ *  Make sure that there is space for 'size' more bytes in the streamed
+ *  update, sending the buffered part of the update if necessary.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   size    - The number of bytes needed.  This must not exceed 64.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value is returned if the send
+ *   failed.  On success, the data may be written at
+ *   &session->outbuf[session->outlen] and session->outlen must then be
+ *   advanced by the number of bytes actually written.
+ *
+ ****************************************************************************/
+
+#ifdef VNCSERVER_HAVE_TILES
+int vnc_tile_reserve(FAR struct vnc_session_s *session, size_t size);
+#endif
+
+/****************************************************************************
+ * Name: vnc_tile_putpixel
+ *
+ * Description:
+ *  Store the 'nbytes' least significant bytes of a remote pixel value in
+ *  the byte order expected by the remote client.
+ *
+ * Input Parameters:
+ *   dest      - The location to store the pixel.
+ *   pixel     - The pixel value in the remote color format.
+ *   nbytes    - The number of bytes to store (1-4).
+ *   bigendian - True: The remote client expects big-endian pixels.
+ *
+ * Returned Value:
+ *   The location following the stored pixel.
+ *
+ ****************************************************************************/
+
+#ifdef VNCSERVER_HAVE_TILES
+FAR uint8_t *vnc_tile_putpixel(FAR uint8_t *dest, uint32_t pixel,
+                               unsigned int nbytes, bool bigendian);
+#endif
+
+/****************************************************************************
+ * Name: vnc_tile_flush
+ *
+ * Description:
+ *  Send the buffered part of a streamed update.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value is returned if the send
+ *   failed.
+ *
+ ****************************************************************************/
+
+#ifdef VNCSERVER_HAVE_TILES
+int vnc_tile_flush(FAR struct vnc_session_s *session);
+#endif
+
 /****************************************************************************
  * Name: vnc_key_map
  *
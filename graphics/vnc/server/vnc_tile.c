@@ -0,0 +1,324 @@
+/****************************************************************************
+ * graphics/vnc/vnc_tile.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_FEATURES
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  define CONFIG_DEBUG_FEATURES 1
+#  define CONFIG_DEBUG_ERROR    1
+#  define CONFIG_DEBUG_WARN     1
+#  define CONFIG_DEBUG_INFO     1
+#  define CONFIG_DEBUG_GRAPHICS 1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_tile_convert
+ *
+ * Description:
+ *  Convert one tile of the local framebuffer to the remote color format,
+ *  leaving the remote pixel values in session->tile[].  Each tile is
+ *  converted only once and the converted values are then used both to
+ *  select the sub-encoding and to send the tile.
+ *
+ * Input Parameters:
+ *   session  - An instance of the session structure.
+ *   colorfmt - The remote color format to convert to.
+ *   x, y     - The position of the tile in the local framebuffer.
+ *   width, height - The size of the tile (at most VNCSERVER_TILESIZE).
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the color format is not supported.
+ *
+ ****************************************************************************/
+
+int vnc_tile_convert(FAR struct vnc_session_s *session, uint8_t colorfmt,
+                     nxgl_coord_t x, nxgl_coord_t y,
+                     nxgl_coord_t width, nxgl_coord_t height)
+{
+  FAR const lfb_color_t *srcleft;
+  FAR const lfb_color_t *src;
+  FAR uint32_t *dest;
+  nxgl_coord_t col;
+  nxgl_coord_t row;
+
+  union
+  {
+    vnc_convert8_t bpp8;
+    vnc_convert16_t bpp16;
+    vnc_convert32_t bpp32;
+  } convert;
+
+  DEBUGASSERT(width <= VNCSERVER_TILESIZE && height <= VNCSERVER_TILESIZE);
+
+  srcleft = (FAR const lfb_color_t *)
+    (session->fb + RFB_STRIDE * y + RFB_BYTESPERPIXEL * x);
+  dest    = session->tile;
+
+  /* Select the conversion once for the whole tile */
+
+  switch (colorfmt)
+    {
+      case FB_FMT_RGB8_222:
+      case FB_FMT_RGB8_332:
+        convert.bpp8 = (colorfmt == FB_FMT_RGB8_222) ?
+                       vnc_convert_rgb8_222 : vnc_convert_rgb8_332;
+
+        for (row = 0; row < height; row++)
+          {
+            src = srcleft;
+            for (col = 0; col < width; col++)
+              {
+                *dest++ = convert.bpp8(*src++);
+              }
+
+            srcleft = (FAR const lfb_color_t *)
+              ((uintptr_t)srcleft + RFB_STRIDE);
+          }
+        break;
+
+      case FB_FMT_RGB16_555:
+      case FB_FMT_RGB16_565:
+        convert.bpp16 = (colorfmt == FB_FMT_RGB16_555) ?
+                        vnc_convert_rgb16_555 : vnc_convert_rgb16_565;
+
+        for (row = 0; row < height; row++)
+          {
+            src = srcleft;
+            for (col = 0; col < width; col++)
+              {
+                *dest++ = convert.bpp16(*src++);
+              }
+
+            srcleft = (FAR const lfb_color_t *)
+              ((uintptr_t)srcleft + RFB_STRIDE);
+          }
+        break;
+
+      case FB_FMT_RGB32:
+        convert.bpp32 = vnc_convert_rgb32_888;
+
+        for (row = 0; row < height; row++)
+          {
+            src = srcleft;
+            for (col = 0; col < width; col++)
+              {
+                *dest++ = convert.bpp32(*src++);
+              }
+
+            srcleft = (FAR const lfb_color_t *)
+              ((uintptr_t)srcleft + RFB_STRIDE);
+          }
+        break;
+
+      default:
+        gerr("ERROR: Unrecognized color format: %d\n", colorfmt);
+        return -EINVAL;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: vnc_tile_header
+ *
+ * Description:
+ *  Start a streamed FramebufferUpdate message with one rectangle.  The
+ *  message is built in session->outbuf which is sent whenever it fills up.
+ *
+ * Input Parameters:
+ *   session  - An instance of the session structure.
+ *   rect     - Describes the rectangle in the local framebuffer.
+ *   encoding - The encoding of the rectangle.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void vnc_tile_header(FAR struct vnc_session_s *session,
+                     FAR const struct nxgl_rect_s *rect, int32_t encoding)
+{
+  FAR struct rfb_framebufferupdate_s *update;
+
+  update          = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
+  update->msgtype = RFB_FBUPDATE_MSG;
+  update->padding = 0;
+  rfb_putbe16(update->nrect, 1);
+
+  rfb_putbe16(update->rect[0].xpos,   rect->pt1.x);
+  rfb_putbe16(update->rect[0].ypos,   rect->pt1.y);
+  rfb_putbe16(update->rect[0].width,  rect->pt2.x - rect->pt1.x + 1);
+  rfb_putbe16(update->rect[0].height, rect->pt2.y - rect->pt1.y + 1);
+  rfb_putbe32(update->rect[0].encoding, (uint32_t)encoding);
+
+  session->outlen = SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0));
+}
+
+/****************************************************************************
+ * Name: vnc_tile_reserve
+ *
+ * Description:
+ *  Make sure that there is space for 'size' more bytes in the streamed
+ *  update, sending the buffered part of the update if necessary.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   size    - The number of bytes needed.  This must not exceed 64.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value is returned if the send
+ *   failed.  On success, the data may be written at
+ *   &session->outbuf[session->outlen] and session->outlen must then be
+ *   advanced by the number of bytes actually written.
+ *
+ ****************************************************************************/
+
+int vnc_tile_reserve(FAR struct vnc_session_s *session, size_t size)
+{
+  DEBUGASSERT(size <= 64 && size <= VNCSERVER_UPDATE_BUFSIZE);
+
+  if (session->outlen + size > VNCSERVER_UPDATE_BUFSIZE)
+    {
+      return vnc_tile_flush(session);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: vnc_tile_putpixel
+ *
+ * Description:
+ *  Store the 'nbytes' least significant bytes of a remote pixel value in
+ *  the byte order expected by the remote client.
+ *
+ * Input Parameters:
+ *   dest      - The location to store the pixel.
+ *   pixel     - The pixel value in the remote color format.
+ *   nbytes    - The number of bytes to store (1-4).
+ *   bigendian - True: The remote client expects big-endian pixels.
+ *
+ * Returned Value:
+ *   The location following the stored pixel.
+ *
+ ****************************************************************************/
+
+FAR uint8_t *vnc_tile_putpixel(FAR uint8_t *dest, uint32_t pixel,
+                               unsigned int nbytes, bool bigendian)
+{
+  unsigned int i;
+
+  if (bigendian)
+    {
+      for (i = nbytes; i > 0; i--)
+        {
+          *dest++ = (uint8_t)(pixel >> (8 * (i - 1)));
+        }
+    }
+  else
+    {
+      for (i = 0; i < nbytes; i++)
+        {
+          *dest++ = (uint8_t)pixel;
+          pixel >>= 8;
+        }
+    }
+
+  return dest;
+}
+
+/****************************************************************************
+ * Name: vnc_tile_flush
+ *
+ * Description:
+ *  Send the buffered part of a streamed update.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value is returned if the send
+ *   failed.
+ *
+ ****************************************************************************/
+
+int vnc_tile_flush(FAR struct vnc_session_s *session)
+{
+  FAR const uint8_t *src = session->outbuf;
+  size_t size = session->outlen;
+  ssize_t nsent;
+
+  /* Send until all of the bytes are out.  This may loop for the case where
+   * TCP write buffering is enabled and there are a limited number of IOBs
+   * available.
+   */
+
+  session->outlen = 0;
+  while (size > 0)
+    {
+      nsent = psock_send(&session->connect, src, size, 0);
+      if (nsent < 0)
+        {
+          gerr("ERROR: Send FrameBufferUpdate failed: %d\n", (int)nsent);
+          return (int)nsent;
+        }
+
+      DEBUGASSERT(nsent <= size);
+      src  += nsent;
+      size -= nsent;
+    }
+
+  return OK;
+}
@@ -0,0 +1,527 @@
+/****************************************************************************
+ * graphics/vnc/vnc_trle.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_FEATURES
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  define CONFIG_DEBUG_FEATURES 1
+#  define CONFIG_DEBUG_ERROR    1
+#  define CONFIG_DEBUG_WARN     1
+#  define CONFIG_DEBUG_INFO     1
+#  define CONFIG_DEBUG_GRAPHICS 1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The protocol permits palettes of up to 127 colors.  Larger palettes are
+ * rarely smaller than plain RLE and would cost a lot of stack.
+ */
+
+#define TRLE_MAXPALETTE 32
+
+/* The largest palette that can be sent as packed indices */
+
+#define TRLE_MAXPACKED  16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct vnc_trle_s
+{
+  FAR struct vnc_session_s *session;
+  bool bigendian;              /* True: Remote expects big-endian pixels */
+  uint8_t cbpp;                /* Size of one remote CPIXEL */
+  uint8_t npalette;            /* Number of palette colors, 0 if too many */
+  uint32_t palette[TRLE_MAXPALETTE];
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_trle_index
+ *
+ * Description:
+ *   Return the palette index of a color, adding the color to the palette
+ *   if it is not there yet.
+ *
+ * Input Parameters:
+ *   priv  - The TRLE encoder state.
+ *   pixel - The remote pixel value.
+ *
+ * Returned Value:
+ *   The palette index or a negative value if the palette is full.
+ *
+ ****************************************************************************/
+
+static int vnc_trle_index(FAR struct vnc_trle_s *priv, uint32_t pixel)
+{
+  int ndx;
+
+  for (ndx = 0; ndx < priv->npalette; ndx++)
+    {
+      if (priv->palette[ndx] == pixel)
+        {
+          return ndx;
+        }
+    }
+
+  if (priv->npalette >= TRLE_MAXPALETTE)
+    {
+      return -1;
+    }
+
+  priv->palette[ndx] = pixel;
+  priv->npalette++;
+  return ndx;
+}
+
+/****************************************************************************
+ * Name: vnc_trle_putcpixel
+ *
+ * Description:
+ *   Add one CPIXEL to the streamed update.
+ *
+ ****************************************************************************/
+
+static int vnc_trle_putcpixel(FAR struct vnc_trle_s *priv, uint32_t pixel)
+{
+  FAR struct vnc_session_s *session = priv->session;
+  FAR uint8_t *dest;
+  int ret;
+
+  ret = vnc_tile_reserve(session, priv->cbpp);
+  if (ret >= 0)
+    {
+      dest = vnc_tile_putpixel(&session->outbuf[session->outlen], pixel,
+                               priv->cbpp, priv->bigendian);
+      session->outlen = dest - session->outbuf;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: vnc_trle_putrun
+ *
+ * Description:
+ *   Add one run to the streamed update:  The run value (CPIXEL or palette
+ *   index) followed by the run length, unless the run is a single pixel of
+ *   a palette RLE tile.
+ *
+ ****************************************************************************/
+
+static int vnc_trle_putrun(FAR struct vnc_trle_s *priv, uint32_t pixel,
+                           unsigned int runlen, bool palette)
+{
+  FAR struct vnc_session_s *session = priv->session;
+  FAR uint8_t *dest;
+  int ret;
+
+  ret = vnc_tile_reserve(session, priv->cbpp + 2);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  dest = &session->outbuf[session->outlen];
+  if (palette)
+    {
+      /* A run of one pixel is just the index */
+
+      *dest++ = (uint8_t)(vnc_trle_index(priv, pixel) |
+                          (runlen > 1 ? 0x80 : 0));
+      if (runlen == 1)
+        {
+          session->outlen = dest - session->outbuf;
+          return OK;
+        }
+    }
+  else
+    {
+      dest = vnc_tile_putpixel(dest, pixel, priv->cbpp, priv->bigendian);
+    }
+
+  /* The length minus one as a sequence of 255 bytes and a final byte less
+   * than 255.  Tiles have at most 256 pixels.
+   */
+
+  for (runlen--; runlen >= 255; runlen -= 255)
+    {
+      *dest++ = 255;
+    }
+
+  *dest++ = (uint8_t)runlen;
+
+  session->outlen = dest - session->outbuf;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: vnc_trle_tile
+ *
+ * Description:
+ *   Encode the converted tile in session->tile[] using the smallest of the
+ *   TRLE sub-encodings.
+ *
+ * Input Parameters:
+ *   priv    - The TRLE encoder state.
+ *   width, height - The size of the tile.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on a send failure.
+ *
+ ****************************************************************************/
+
+static int vnc_trle_tile(FAR struct vnc_trle_s *priv,
+                         unsigned int width, unsigned int height)
+{
+  FAR struct vnc_session_s *session = priv->session;
+  FAR const uint32_t *tile = session->tile;
+  FAR uint8_t *dest;
+  unsigned int npixels = width * height;
+  unsigned int cbpp = priv->cbpp;
+  unsigned int rawsize;
+  unsigned int rlesize;
+  unsigned int palrlesize;
+  unsigned int packedsize;
+  unsigned int bestsize;
+  unsigned int runlen;
+  unsigned int npalette;
+  unsigned int bits;
+  unsigned int x;
+  unsigned int y;
+  unsigned int i;
+  uint8_t subencoding;
+  uint8_t byte;
+  int shift;
+  int ret;
+
+  /* Build the palette and measure the run-length encodings in one pass */
+
+  priv->npalette = 0;
+  rlesize        = 0;
+  palrlesize     = 0;
+
+  for (i = 0; i < npixels; i += runlen)
+    {
+      for (runlen = 1;
+           i + runlen < npixels && tile[i + runlen] == tile[i];
+           runlen++)
+        {
+        }
+
+      if (priv->npalette <= TRLE_MAXPALETTE &&
+          vnc_trle_index(priv, tile[i]) < 0)
+        {
+          priv->npalette = TRLE_MAXPALETTE + 1;
+        }
+
+      rlesize    += cbpp + (runlen - 1) / 255 + 1;
+      palrlesize += runlen == 1 ? 1 : (runlen - 1) / 255 + 2;
+    }
+
+  npalette = priv->npalette;
+  if (npalette > TRLE_MAXPALETTE)
+    {
+      npalette = 0;
+    }
+
+  /* A single color tile */
+
+  if (npalette == 1)
+    {
+      ret = vnc_tile_reserve(session, 1 + cbpp);
+      if (ret >= 0)
+        {
+          dest    = &session->outbuf[session->outlen];
+          *dest++ = RFB_SUBENCODING_SOLID;
+          dest    = vnc_tile_putpixel(dest, tile[0], cbpp, priv->bigendian);
+          session->outlen = dest - session->outbuf;
+        }
+
+      return ret;
+    }
+
+  /* Pick the smallest of the other sub-encodings */
+
+  rawsize     = npixels * cbpp;
+  bestsize    = rawsize;
+  subencoding = RFB_SUBENCODING_RAW;
+  bits        = 0;
+
+  if (rlesize < bestsize)
+    {
+      bestsize    = rlesize;
+      subencoding = RFB_SUBENCODING_RLE;
+    }
+
+  if (npalette > 1)
+    {
+      palrlesize += npalette * cbpp;
+      if (palrlesize < bestsize)
+        {
+          bestsize    = palrlesize;
+          subencoding = RFB_SUBENCODING_RLE + npalette;
+        }
+
+      if (npalette <= TRLE_MAXPACKED)
+        {
+          bits       = npalette == 2 ? 1 : npalette <= 4 ? 2 : 4;
+          packedsize = npalette * cbpp + height * ((width * bits + 7) >> 3);
+          if (packedsize < bestsize)
+            {
+              subencoding = npalette;
+            }
+        }
+    }
+
+  ret = vnc_tile_reserve(session, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  session->outbuf[session->outlen++] = subencoding;
+
+  /* The palette, if any */
+
+  if (subencoding != RFB_SUBENCODING_RAW &&
+      subencoding != RFB_SUBENCODING_RLE)
+    {
+      for (i = 0; i < npalette; i++)
+        {
+          ret = vnc_trle_putcpixel(priv, priv->palette[i]);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  if (subencoding == RFB_SUBENCODING_RAW)
+    {
+      for (y = 0; y < height; y++)
+        {
+          ret = vnc_tile_reserve(session, width * cbpp);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          dest = &session->outbuf[session->outlen];
+          for (x = 0; x < width; x++)
+            {
+              dest = vnc_tile_putpixel(dest, tile[y * width + x], cbpp,
+                                       priv->bigendian);
+            }
+
+          session->outlen = dest - session->outbuf;
+        }
+    }
+  else if (subencoding >= RFB_SUBENCODING_RLE)
+    {
+      /* Plain or palette RLE.  Runs continue from the end of one row to the
+       * start of the next.
+       */
+
+      for (i = 0; i < npixels; i += runlen)
+        {
+          for (runlen = 1;
+               i + runlen < npixels && tile[i + runlen] == tile[i];
+               runlen++)
+            {
+            }
+
+          ret = vnc_trle_putrun(priv, tile[i], runlen,
+                                subencoding != RFB_SUBENCODING_RLE);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+  else
+    {
+      /* Packed palette:  Each row starts on a byte boundary and the
+       * leftmost pixel is in the most significant bits.
+       */
+
+      for (y = 0; y < height; y++)
+        {
+          ret = vnc_tile_reserve(session, (width * bits + 7) >> 3);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          dest  = &session->outbuf[session->outlen];
+          byte  = 0;
+          shift = 8;
+
+          for (x = 0; x < width; x++)
+            {
+              shift -= bits;
+              byte  |= vnc_trle_index(priv, tile[y * width + x]) << shift;
+              if (shift == 0)
+                {
+                  *dest++ = byte;
+                  byte    = 0;
+                  shift   = 8;
+                }
+            }
+
+          if (shift < 8)
+            {
+              *dest++ = byte;
+            }
+
+          session->outlen = dest - session->outbuf;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_trle
+ *
+ * Description:
+ *  Send the framebuffer update using the TRLE encoding.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if the client does not support TRLE encoding.
+ *   Otherwise, a positive value is returned on success or a negated errno
+ *   value is returned on failure that indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+int vnc_trle(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
+{
+  struct vnc_trle_s priv;
+  nxgl_coord_t width;
+  nxgl_coord_t height;
+  nxgl_coord_t x;
+  nxgl_coord_t y;
+  uint8_t colorfmt;
+  int ret;
+
+  /* Check if the client supports the TRLE encoding */
+
+  if (!session->trle)
+    {
+      return 0;
+    }
+
+  /* Set up characteristics of the client pixel format to use on this
+   * update.  The update is finished in the format that it was started
+   * with.  32-bit pixels with a depth of no more than 24 bits are sent as
+   * 3 byte CPIXELs.
+   */
+
+  priv.session   = session;
+  priv.bigendian = session->bigendian;
+  priv.cbpp      = (session->bpp + 7) >> 3;
+  colorfmt       = session->colorfmt;
+
+  if (priv.cbpp == 4 && session->depth <= 24)
+    {
+      priv.cbpp = 3;
+    }
+
+  vnc_tile_header(session, rect, RFB_ENCODING_TRLE);
+
+  /* Encode each tile, left-to-right and top-to-bottom */
+
+  for (y = rect->pt1.y; y <= rect->pt2.y; y += VNCSERVER_TILESIZE)
+    {
+      height = MIN(rect->pt2.y - y + 1, VNCSERVER_TILESIZE);
+
+      for (x = rect->pt1.x; x <= rect->pt2.x; x += VNCSERVER_TILESIZE)
+        {
+          width = MIN(rect->pt2.x - x + 1, VNCSERVER_TILESIZE);
+
+          ret = vnc_tile_convert(session, colorfmt, x, y, width, height);
+          if (ret >= 0)
+            {
+              ret = vnc_trle_tile(&priv, width, height);
+            }
+
+          if (ret < 0)
+            {
+              session->outlen = 0;
+              return ret;
+            }
+        }
+    }
+
+  ret = vnc_tile_flush(session);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  updinfo("Sent {(%d, %d),(%d, %d)}\n",
+          rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
+  return 1;
+}
@@ -381,6 +381,282 @@ static void vnc_add_queue(FAR struct vnc_session_s *session,
   sched_unlock();
 }
 
+/****************************************************************************
+ * Name: vnc_area
+ *
+ * Description:
+ *   Return the number of pixels in a rectangle.
+ *
+ ****************************************************************************/
+
+static inline uint32_t vnc_area(FAR const struct nxgl_rect_s *rect)
+{
+  return (uint32_t)(rect->pt2.x - rect->pt1.x + 1) *
+         (uint32_t)(rect->pt2.y - rect->pt1.y + 1);
+}
+
+/****************************************************************************
+ * Name: vnc_merge_update
+ *
+ * Description:
+ *   Try to absorb a new update rectangle into one that is already queued.
+ *   The queued rectangle is replaced with the bounding rectangle of the two
+ *   if that is no larger than the two rectangles together.  This is always
+ *   the case if the queued rectangle already contains the new one.  The
+ *   merge never increases the number of pixels to be sent, but it saves an
+ *   update structure and the overhead of a FramebufferUpdate message.
+ *
+ *   The scheduler must be locked by the caller.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The new (clipped) update rectangle.
+ *
+ * Returned Value:
+ *   True is returned if the rectangle was merged and must not be queued.
+ *
+ ****************************************************************************/
+
+static bool vnc_merge_update(FAR struct vnc_session_s *session,
+                             FAR const struct nxgl_rect_s *rect)
+{
+  FAR struct vnc_fbupdate_s *curr;
+  struct nxgl_rect_s bounds;
+
+  for (curr = (FAR struct vnc_fbupdate_s *)session->updqueue.head;
+       curr != NULL;
+       curr = curr->flink)
+    {
+      nxgl_rectunion(&bounds, &curr->rect, rect);
+      if (vnc_area(&bounds) <= vnc_area(&curr->rect) + vnc_area(rect))
+        {
+          updinfo("Merged {(%d, %d),(%d, %d)} -> {(%d, %d),(%d, %d)}\n",
+                  rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y,
+                  bounds.pt1.x, bounds.pt1.y, bounds.pt2.x, bounds.pt2.y);
+
+          nxgl_rectcopy(&curr->rect, &bounds);
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: vnc_send_rect
+ *
+ * Description:
+ *   Send one rectangle of the local framebuffer to the client using the
+ *   best encoding supported by the client.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The rectangle to be sent.
+ *
+ * Returned Value:
+ *   Zero or a positive value on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int vnc_send_rect(FAR struct vnc_session_s *session,
+                         FAR struct nxgl_rect_s *rect)
+{
+  int ret;
+
+  /* Attempt to use RRE encoding (single color rectangles only) */
+
+  ret = vnc_rre(session, rect);
+
+#ifdef CONFIG_VNCSERVER_TRLE
+  /* Then TRLE encoding */
+
+  if (ret == 0)
+    {
+      ret = vnc_trle(session, rect);
+    }
+#endif
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  /* Then Hextile encoding */
+
+  if (ret == 0)
+    {
+      ret = vnc_hextile(session, rect);
+    }
+#endif
+
+  if (ret == 0)
+    {
+      /* Perform the framebuffer update using the default RAW encoding */
+
+      ret = vnc_raw(session, rect);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: vnc_hash_tile
+ *
+ * Description:
+ *   Return a (FNV-1a) hash of the content of one tile of the local
+ *   framebuffer.  Zero is never returned.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   tx, ty  - The tile column and row.
+ *
+ * Returned Value:
+ *   The non-zero hash value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILECACHE
+static uint32_t vnc_hash_tile(FAR struct vnc_session_s *session,
+                              unsigned int tx, unsigned int ty)
+{
+  FAR const lfb_color_t *srcleft;
+  FAR const lfb_color_t *src;
+  unsigned int x = tx * VNCSERVER_TILESIZE;
+  unsigned int y = ty * VNCSERVER_TILESIZE;
+  unsigned int width;
+  unsigned int height;
+  unsigned int col;
+  unsigned int row;
+  uint32_t hash = 2166136261ul;
+
+  width  = MIN(VNCSERVER_TILESIZE, CONFIG_VNCSERVER_SCREENWIDTH - x);
+  height = MIN(VNCSERVER_TILESIZE, CONFIG_VNCSERVER_SCREENHEIGHT - y);
+
+  srcleft = (FAR const lfb_color_t *)
+    (session->fb + RFB_STRIDE * y + RFB_BYTESPERPIXEL * x);
+
+  for (row = 0; row < height; row++)
+    {
+      src = srcleft;
+      for (col = 0; col < width; col++)
+        {
+          hash = (hash ^ *src++) * 16777619ul;
+        }
+
+      srcleft = (FAR const lfb_color_t *)((uintptr_t)srcleft + RFB_STRIDE);
+    }
+
+  return hash != 0 ? hash : 1;
+}
+#endif
+
+/****************************************************************************
+ * Name: vnc_send_changed
+ *
+ * Description:
+ *   Send only the tiles of an update rectangle whose content changed since
+ *   they were last sent.  The rectangle is expanded to whole tiles so that
+ *   the hash of each tile always describes what the client has.  Adjacent
+ *   changed tiles in a tile row are sent as one rectangle.  A tile is also
+ *   sent if it was skipped CONFIG_VNCSERVER_TILECACHE_REFRESH times, in case
+ *   a change was hidden by a hash collision.  The hashes are updated only
+ *   after the tiles were sent.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The update rectangle.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILECACHE
+static int vnc_send_changed(FAR struct vnc_session_s *session,
+                            FAR const struct nxgl_rect_s *rect)
+{
+  FAR uint32_t *tilehash;
+  FAR uint8_t *tileskip;
+  struct nxgl_rect_s run;
+  unsigned int tx1 = rect->pt1.x / VNCSERVER_TILESIZE;
+  unsigned int tx2 = rect->pt2.x / VNCSERVER_TILESIZE;
+  unsigned int ty1 = rect->pt1.y / VNCSERVER_TILESIZE;
+  unsigned int ty2 = rect->pt2.y / VNCSERVER_TILESIZE;
+  unsigned int tx;
+  unsigned int ty;
+  unsigned int start;
+  uint32_t hash;
+  bool inrun;
+  int ret;
+
+  /* Forget what the client has if it asked for a full update */
+
+  if (session->tilereset)
+    {
+      session->tilereset = false;
+      memset(session->tilehash, 0, sizeof(session->tilehash));
+      memset(session->tileskip, 0, sizeof(session->tileskip));
+    }
+
+  for (ty = ty1; ty <= ty2; ty++)
+    {
+      run.pt1.y = ty * VNCSERVER_TILESIZE;
+      run.pt2.y = MIN(run.pt1.y + VNCSERVER_TILESIZE,
+                      CONFIG_VNCSERVER_SCREENHEIGHT) - 1;
+
+      tilehash  = &session->tilehash[ty * VNCSERVER_NTILESX];
+      tileskip  = &session->tileskip[ty * VNCSERVER_NTILESX];
+      inrun     = false;
+      start     = tx1;
+
+      /* The pass with tx == tx2 + 1 ends the last run of the row */
+
+      for (tx = tx1; tx <= tx2 + 1; tx++)
+        {
+          if (tx <= tx2)
+            {
+              hash = vnc_hash_tile(session, tx, ty);
+              if (hash != tilehash[tx] ||
+                  tileskip[tx] >= CONFIG_VNCSERVER_TILECACHE_REFRESH)
+                {
+                  session->rowhash[tx] = hash;
+                  if (!inrun)
+                    {
+                      inrun = true;
+                      start = tx;
+                    }
+
+                  continue;
+                }
+
+              tileskip[tx]++;
+            }
+
+          if (inrun)
+            {
+              run.pt1.x = start * VNCSERVER_TILESIZE;
+              run.pt2.x = MIN(tx * VNCSERVER_TILESIZE,
+                              CONFIG_VNCSERVER_SCREENWIDTH) - 1;
+
+              ret = vnc_send_rect(session, &run);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              /* The client now has the content of these tiles */
+
+              for (; start < tx; start++)
+                {
+                  tilehash[start] = session->rowhash[start];
+                  tileskip[start] = 0;
+                }
+
+              inrun = false;
+            }
+        }
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: vnc_updater
  *
@@ -424,15 +700,15 @@ static FAR void *vnc_updater(FAR void *arg)
               srcrect->rect.pt1.x, srcrect->rect.pt1.y,
               srcrect->rect.pt2.x, srcrect->rect.pt2.y);
 
-      /* Attempt to use RRE encoding */
-
-      ret = vnc_rre(session, &srcrect->rect);
-      if (ret == 0)
-        {
-          /* Perform the framebuffer update using the default RAW encoding */
+      /* Send the rectangle or, with the tile cache, only the parts of it
+       * that actually changed.
+       */
 
-          ret = vnc_raw(session, &srcrect->rect);
-        }
+#ifdef CONFIG_VNCSERVER_TILECACHE
+      ret = vnc_send_changed(session, &srcrect->rect);
+#else
+      ret = vnc_send_rect(session, &srcrect->rect);
+#endif
 
       /* Release the update structure */
 
@@ -637,6 +913,14 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
                */
 
               session->change |= change;
+
+              /* Try to merge the update with one that is already queued */
+
+              if (vnc_merge_update(session, &intersection))
+                {
+                  sched_unlock();
+                  return OK;
+                }
             }
 
           /* Allocate an update structure... waiting if necessary */
@@ -110,6 +110,13 @@
 #define F_SETOWN    13 /* Set pid that will receive SIGIO and SIGURG signals for fd */
 #define F_SETSIG    14 /* Set the signal to be sent */
 
+/* splice() and tee() flags (linux) */
+
+#define SPLICE_F_MOVE     (1 << 0) /* Move pages instead of copying (ignored) */
+#define SPLICE_F_NONBLOCK (1 << 1) /* Do not block on pipe I/O */
+#define SPLICE_F_MORE     (1 << 2) /* More data will be coming (ignored) */
+#define SPLICE_F_GIFT     (1 << 3) /* Unused by splice() and tee() */
+
 /* For posix fcntl() and lockf() */
 
 #define F_RDLCK     0  /* Take out a read lease */
@@ -173,6 +180,14 @@ extern "C"
 int open(const char *path, int oflag, ...);
 int fcntl(int fd, int cmd, ...);
 
+/* Linux-like pipe interfaces */
+
+#if defined(CONFIG_PIPES) && defined(CONFIG_DEV_PIPE_SPLICE)
+ssize_t splice(int fd_in, FAR off_t *off_in, int fd_out, FAR off_t *off_out,
+               size_t len, unsigned int flags);
+ssize_t tee(int fd_in, int fd_out, size_t len, unsigned int flags);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -113,6 +113,10 @@ struct elf_loadinfo_s
   Elf32_Ehdr        ehdr;        /* Buffered ELF file header */
   FAR Elf32_Shdr    *shdr;       /* Buffered ELF section headers */
   uint8_t           *iobuffer;   /* File I/O buffer */
+#ifdef CONFIG_ELF_SYMTAB_CACHE
+  FAR Elf32_Sym     *symcache;   /* Symbol table cached while binding */
+  FAR char          *strcache;   /* String table cached while binding */
+#endif
 
   /* Constructors and destructors */
 
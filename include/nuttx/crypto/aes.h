@@ -42,13 +42,21 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <sys/types.h>
 #include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+#define AES_BLOCK_SIZE     16
+
 #define AES128_KEY_SIZE    16
+#define AES192_KEY_SIZE    24
+#define AES256_KEY_SIZE    32
+
+#define AES_MAXNR          14  /* Number of rounds for AES-256 */
 
 /****************************************************************************
  * Public Types
@@ -56,7 +64,13 @@
 
 struct aes_state_s
 {
+#ifdef CONFIG_CRYPTO_SW_AES_TTABLE
+  uint32_t ek[4 * (AES_MAXNR + 1)];  /* Encryption round keys */
+  uint32_t dk[4 * (AES_MAXNR + 1)];  /* Decryption round keys */
+  int nr;                            /* Number of rounds */
+#else
   uint8_t expanded_key[176];
+#endif
 };
 
 /****************************************************************************
@@ -118,14 +132,13 @@ void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key);
  *
  * Input Parameters:
  *  state  an AES context that can be used for AES operations
- *  key    a pointer to a 16-byte buffer holding the AES-128 key
- *  len    length of the key, must be 16
- *
- * TODO: Support other key lengths of 24 (AES-192) and 32 (AES-256)
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key:  16 (AES-128) or, with
+ *         CONFIG_CRYPTO_SW_AES_TTABLE, 24 (AES-192) or 32 (AES-256)
  *
  * Returned Value:
  *   0 if OK
- *   -EINVAL if len is not 16
+ *   -EINVAL if the key length is not supported
  *
  ****************************************************************************/
 
@@ -164,6 +177,107 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
                   int nblk);
 
+/****************************************************************************
+ * Name: aes_cbc_encrypt
+ *
+ * Description:
+ *   Encrypt 'nblk' 16-byte blocks in CBC mode.  On return, 'iv' holds the
+ *   last cipher text block so that a long message may be encrypted with
+ *   several calls.  'in' and 'out' may be the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_cbc_encrypt(FAR const struct aes_state_s *state, FAR uint8_t *iv,
+                     FAR const uint8_t *in, FAR uint8_t *out, size_t nblk);
+
+/****************************************************************************
+ * Name: aes_cbc_decrypt
+ *
+ * Description:
+ *   Decrypt 'nblk' 16-byte blocks in CBC mode.  On return, 'iv' holds the
+ *   last cipher text block.  'in' and 'out' may be the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_cbc_decrypt(FAR const struct aes_state_s *state, FAR uint8_t *iv,
+                     FAR const uint8_t *in, FAR uint8_t *out, size_t nblk);
+
+/****************************************************************************
+ * Name: aes_ctr_crypt
+ *
+ * Description:
+ *   Encrypt or decrypt 'len' bytes in CTR mode.  'ctr' is the 16-byte
+ *   initial counter block; it is incremented as a 128-bit big-endian
+ *   integer for each block.  On return it holds the next unused counter so
+ *   that a long message may be processed with several calls, all but the
+ *   last of which must be a multiple of 16 bytes.  'in' and 'out' may be
+ *   the same buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_ctr_crypt(FAR const struct aes_state_s *state, FAR uint8_t *ctr,
+                   FAR const uint8_t *in, FAR uint8_t *out, size_t len);
+
+/****************************************************************************
+ * Name: aes_gcm_encrypt
+ *
+ * Description:
+ *   Encrypt 'len' bytes and authenticate them together with 'aadlen' bytes
+ *   of additional data in GCM mode (NIST SP 800-38D).
+ *
+ * Input Parameters:
+ *   state  - An AES context initialized by aes_setupkey()
+ *   iv     - The initialization vector; 12 bytes is recommended
+ *   ivlen  - The size of the IV
+ *   aad    - Additional authenticated data (may be NULL if aadlen is 0)
+ *   aadlen - The size of the additional data
+ *   in     - The plain text
+ *   out    - The cipher text
+ *   len    - The size of the plain text
+ *   tag    - The location to return the authentication tag
+ *   taglen - The size of the tag, 4 to 16 bytes
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if the IV or tag size is invalid
+ *
+ ****************************************************************************/
+
+int aes_gcm_encrypt(FAR const struct aes_state_s *state,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR uint8_t *tag, size_t taglen);
+
+/****************************************************************************
+ * Name: aes_gcm_decrypt
+ *
+ * Description:
+ *   Verify and decrypt 'len' bytes in GCM mode.  Nothing is written to
+ *   'out' if the authentication tag does not match.
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if the IV or tag size is invalid
+ *   -EBADMSG if the authentication tag does not match
+ *
+ ****************************************************************************/
+
+int aes_gcm_decrypt(FAR const struct aes_state_s *state,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR const uint8_t *tag, size_t taglen);
+
 #ifdef  __cplusplus
 }
 #endif /* __cplusplus */
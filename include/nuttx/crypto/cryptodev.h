@@ -53,7 +53,8 @@
 #define CRYPTO_AES_ECB          1
 #define CRYPTO_AES_CBC          2
 #define CRYPTO_AES_CTR          3
-#define CRYPTO_ALGORITHM_MAX    1
+#define CRYPTO_AES_GCM          4 /* Requires CONFIG_CRYPTO_SW_AES */
+#define CRYPTO_ALGORITHM_MAX    4
 
 #define CRYPTO_FLAG_HARDWARE    0x01000000 /* hardware accelerated */
 #define CRYPTO_FLAG_SOFTWARE    0x02000000 /* software implementation */
@@ -65,6 +66,8 @@
 #define CIOCGSESSION            101
 #define CIOCFSESSION            102
 #define CIOCCRYPT               103
+#define CIOCCRYPTM              104 /* struct crypt_mop */
+#define CIOCAUTHCRYPT           105 /* struct crypt_auth_op */
 
 typedef char* caddr_t;
 
@@ -92,4 +95,36 @@ struct crypt_op
   caddr_t iv;
 };
 
+/* A batch of operations.  The operations are performed in order and may
+ * use different sessions.  If one fails, the ioctl returns its error and
+ * 'count' is set to the number of operations that completed.
+ */
+
+struct crypt_mop
+{
+  unsigned count;              /* Number of operations in reqs[] */
+  FAR struct crypt_op *reqs;
+};
+
+/* An authenticated encryption (AEAD) operation, i.e. AES-GCM.  For
+ * COP_ENCRYPT the tag is returned in 'tag'; for COP_DECRYPT the tag in
+ * 'tag' is verified and the ioctl fails with EBADMSG (without writing
+ * 'dst') if it does not match.
+ */
+
+struct crypt_auth_op
+{
+  uint32_t ses;
+  uint16_t op;                 /* i.e. COP_ENCRYPT */
+  uint16_t flags;
+  unsigned len;                /* Length of src and dst */
+  unsigned auth_len;           /* Length of the additional data */
+  caddr_t auth_src;            /* Additional authenticated data */
+  caddr_t src, dst;
+  caddr_t tag;                 /* Authentication tag */
+  unsigned tag_len;
+  caddr_t iv;
+  unsigned iv_len;
+};
+
 #endif /* __INCLUDE_NUTTX_CRYPTO_CRYPTODEV_H */
@@ -43,8 +43,29 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_BCH_CACHE
+/* Statistics of the sector cache of a BCH device.  These are returned by
+ * the BIOC_CACHESTATS ioctl command.
+ */
+
+struct bch_cachestats_s
+{
+  uint32_t nsectors;     /* Number of sectors in the cache */
+  uint32_t hits;         /* Number of sectors found in the cache */
+  uint32_t misses;       /* Number of sectors that had to be read */
+  uint32_t rasectors;    /* Number of additional sectors read ahead */
+  uint32_t writes;       /* Number of write requests to the block driver */
+  uint32_t wsectors;     /* Number of sectors written back */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
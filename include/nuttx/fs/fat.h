@@ -65,6 +65,20 @@
 
 typedef uint8_t fat_attrib_t;
 
+#ifdef CONFIG_FAT_SECTORCACHE
+/* Statistics of the sector cache of a mountpoint.  These are returned by
+ * the FIOC_CACHESTATS ioctl command on any file of the volume.
+ */
+
+struct fat_cachestats_s
+{
+  uint32_t fc_nsectors;  /* Number of sectors in the cache */
+  uint32_t fc_hits;      /* Number of sectors found in the cache */
+  uint32_t fc_misses;    /* Number of sectors read from the media */
+  uint32_t fc_writes;    /* Number of dirty sectors written back */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -214,6 +214,7 @@ struct inode;
 struct stat;
 struct statfs;
 struct pollfd;
+struct iovec;
 struct fs_dirent_s;
 struct mtd_dev_s;
 
@@ -246,6 +247,16 @@ struct file_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   int     (*unlink)(FAR struct inode *inode);
 #endif
+
+  /* Optional scatter/gather methods.  If these are not provided, readv()
+   * and writev() will call the read and write methods once for each
+   * element of the I/O vector.
+   */
+
+  ssize_t (*readv)(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt);
+  ssize_t (*writev)(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt);
 };
 
 /* This structure provides information about the state of a block driver */
@@ -421,6 +432,9 @@ struct file
   off_t             f_pos;      /* File position */
   FAR struct inode *f_inode;    /* Driver or file system interface */
   void             *f_priv;     /* Per file driver private data */
+#ifndef CONFIG_DISABLE_POLL
+  uint16_t          f_epolls;   /* Number of epoll registrations */
+#endif
 };
 
 /* This defines a list of files indexed by the file descriptor */
@@ -1133,6 +1147,45 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes);
 
 ssize_t nx_write(int fd, FAR const void *buf, size_t nbytes);
 
+/****************************************************************************
+ * Name: file_readv and file_writev
+ *
+ * Description:
+ *   Equivalent to the standard readv() and writev() functions except that
+ *   they accept a struct file instance instead of a file descriptor, they
+ *   do not modify the errno variable and they are not cancellation points.
+ *   The driver's readv or writev method is used if it provides one.
+ *
+ * Returned Value:
+ *   The number of bytes transferred on success; a negated errno value on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+ssize_t file_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt);
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt);
+#endif
+
+/****************************************************************************
+ * Name: nx_readv and nx_writev
+ *
+ * Description:
+ *   nx_readv() and nx_writev() are internal OS interfaces.  They are
+ *   functionally equivalent to readv() and writev() except that they do
+ *   not modify the errno variable and they are not cancellation points.
+ *
+ * Returned Value:
+ *   The number of bytes transferred on success; a negated errno value on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt);
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt);
+
 /****************************************************************************
  * Name: file_pread
  *
@@ -1345,6 +1398,46 @@ int file_fstat(FAR struct file *filep, FAR struct stat *buf);
 int fdesc_poll(int fd, FAR struct pollfd *fds, bool setup);
 #endif
 
+/****************************************************************************
+ * Name: poll_post
+ *
+ * Description:
+ *   Report the events that have been set in fds->revents to the waiter of
+ *   a poll descriptor.  Drivers must use this function rather than posting
+ *   fds->sem directly:  The waiter may have provided a notification
+ *   callback in place of the semaphore.
+ *
+ * Input Parameters:
+ *   fds - The poll descriptor with the reported events in revents
+ *
+ * Assumptions:
+ *   May be called from interrupt handling logic.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+void poll_post(FAR struct pollfd *fds);
+#endif
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Remove a file or socket that is being closed from all epoll instances.
+ *   The close logic calls this before the driver close method so that the
+ *   driver drops its references to the epoll registrations.  It need only
+ *   be called if the f_epolls or s_epolls count of the file or socket is
+ *   non-zero.
+ *
+ * Input Parameters:
+ *   obj - The struct file or struct socket that is being closed
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0 && !defined(CONFIG_DISABLE_POLL)
+void epoll_release(FAR void *obj);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -43,6 +43,8 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -93,6 +95,7 @@
 #define _MAC802154BASE  (0x2600) /* 802.15.4 MAC ioctl commands */
 #define _PWRBASE        (0x2700) /* Power-related ioctl commands */
 #define _FBIOCBASE      (0x2800) /* Frame buffer character driver ioctl commands */
+#define _NOTEBASE       (0x2900) /* Scheduler note driver ioctl commands */
 
 /* boardctl() commands share the same number space */
 
@@ -167,6 +170,20 @@
                                            * OUT: Instance number is returned on
                                            *      success.
                                            */
+#define FIOC_CACHESTATS _FIOC(0x000b)     /* IN:  Pointer to the file system specific
+                                           *      cache statistics structure (struct
+                                           *      fat_cachestats_s for FAT)
+                                           * OUT: Statistics of the sector cache
+                                           */
+#define FIOC_MEMSEG     _FIOC(0x000c)     /* IN:  Pointer to struct fioc_memseg_s
+                                           *      with ms_offset set
+                                           * OUT: If the file data at ms_offset is
+                                           *      directly accessible, its address
+                                           *      and the number of contiguous
+                                           *      bytes there.  No reference is
+                                           *      taken: the data is valid only
+                                           *      until the file is truncated.
+                                           */
 
 /* NuttX file system ioctl definitions **************************************/
 
@@ -261,6 +278,12 @@
                                            * IN:  None
                                            * OUT: None (ioctl return value provides
                                            *      success/failure indication). */
+#define BIOC_CACHESTATS _BIOC(0x000e)     /* Used only by BCH to return the
+                                           * statistics of its sector cache.
+                                           * IN:  Pointer to writable instance
+                                           *      of struct bch_cachestats_s.
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -470,6 +493,11 @@
 #define _FBIOCVALID(c)   (_IOC_TYPE(c)==_FBIOCBASE)
 #define _FBIOC(nr)       _IOC(_FBIOCBASE,nr)
 
+/* Scheduler note driver ***************************************************/
+
+#define _NOTEIOCVALID(c) (_IOC_TYPE(c)==_NOTEBASE)
+#define _NOTEIOC(nr)     _IOC(_NOTEBASE,nr)
+
 /* boardctl() command definitions *******************************************/
 
 #define _BOARDIOCVALID(c) (_IOC_TYPE(c)==_BOARDBASE)
@@ -479,6 +507,16 @@
  * Public Type Definitions
  ****************************************************************************/
 
+/* Used with the FIOC_MEMSEG ioctl command */
+
+struct fioc_memseg_s
+{
+  off_t    ms_offset;           /* IN:  File offset of the first byte */
+  FAR const void *ms_addr;      /* OUT: Address of the byte at ms_offset */
+  size_t   ms_length;           /* OUT: Number of contiguous bytes at ms_addr
+                                 *      (zero at or beyond the end of file) */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
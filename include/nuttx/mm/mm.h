@@ -161,6 +161,27 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* Two-level segregated fit (TLSF) free lists.  Free chunks are kept in
+ * MM_TLSF_FLCOUNT first level power-of-two ranges, each split into
+ * MM_TLSF_SLCOUNT linear second level lists.  Chunks smaller than
+ * MM_TLSF_SMALL are kept in first level 0, one list per granule.  All
+ * chunks of MM_MAX_CHUNK bytes or more share the last list.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  ifndef CONFIG_MM_TLSF_SLBITS
+#    define CONFIG_MM_TLSF_SLBITS 4
+#  endif
+
+#  if CONFIG_MM_TLSF_SLBITS < 1 || CONFIG_MM_TLSF_SLBITS > 5
+#    error CONFIG_MM_TLSF_SLBITS must be in the range 1 through 5
+#  endif
+
+#  define MM_TLSF_SLCOUNT  (1 << CONFIG_MM_TLSF_SLBITS)
+#  define MM_TLSF_SMALL    (1 << (MM_MIN_SHIFT + CONFIG_MM_TLSF_SLBITS))
+#  define MM_TLSF_FLCOUNT  (MM_MAX_SHIFT - MM_MIN_SHIFT - CONFIG_MM_TLSF_SLBITS + 2)
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -177,6 +198,48 @@
 #define MM_IS_ALLOCATED(n) \
   ((int)((struct mm_allocnode_s*)(n)->preceding) < 0))
 
+/* Small object cache.  Chunks up to CONFIG_MM_CACHE_MAXSIZE bytes (including
+ * the chunk header) are grouped into size classes of one granule each.
+ * Each CPU has its own set of size class lists.
+ */
+
+#ifdef CONFIG_MM_CACHE
+#  ifndef CONFIG_MM_CACHE_MAXSIZE
+#    define CONFIG_MM_CACHE_MAXSIZE 128
+#  endif
+
+#  ifndef CONFIG_MM_CACHE_DEPTH
+#    define CONFIG_MM_CACHE_DEPTH 16
+#  endif
+
+#  ifndef CONFIG_MM_CACHE_BATCH
+#    define CONFIG_MM_CACHE_BATCH 8
+#  endif
+
+#  if CONFIG_MM_CACHE_BATCH > CONFIG_MM_CACHE_DEPTH
+#    error CONFIG_MM_CACHE_BATCH must not exceed CONFIG_MM_CACHE_DEPTH
+#  endif
+
+#  define MM_CACHE_NCLASSES   (CONFIG_MM_CACHE_MAXSIZE >> MM_MIN_SHIFT)
+#  if MM_CACHE_NCLASSES < 1
+#    error CONFIG_MM_CACHE_MAXSIZE is smaller than the minimum chunk size
+#  endif
+
+#  ifdef CONFIG_SMP
+#    define MM_CACHE_NCPUS    CONFIG_SMP_NCPUS
+#  else
+#    define MM_CACHE_NCPUS    1
+#  endif
+
+/* Map a chunk size (including SIZEOF_MM_ALLOCNODE) to its size class and
+ * back.
+ */
+
+#  define MM_CACHEABLE(s)     ((s) <= (MM_CACHE_NCLASSES << MM_MIN_SHIFT))
+#  define MM_CACHE_CLASS(s)   (((s) >> MM_MIN_SHIFT) - 1)
+#  define MM_CACHE_SIZE(c)    (((c) + 1) << MM_MIN_SHIFT)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -231,6 +294,38 @@ struct mm_freenode_s
 #define CHECK_FREENODE_SIZE \
   DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
 
+#ifdef CONFIG_MM_CACHE
+/* This describes a chunk held in the small object cache.  The chunk remains
+ * marked as allocated in the heap; the link is kept in the user portion of
+ * the chunk.
+ */
+
+struct mm_cachenode_s
+{
+  FAR struct mm_cachenode_s *flink;  /* Supports a singly linked list */
+};
+
+/* This describes one size class of the cache of one CPU */
+
+struct mm_cacheclass_s
+{
+  FAR struct mm_cachenode_s *mc_head; /* List of cached chunks */
+  uint16_t mc_count;                  /* Number of chunks in the list */
+  uint32_t mc_hits;                   /* Allocations satisfied by the cache */
+  uint32_t mc_misses;                 /* Allocations that went to the heap */
+};
+
+/* This is the information returned by mm_cacheinfo() for one size class */
+
+struct mm_cacheinfo_s
+{
+  size_t   size;                      /* Chunk size of the class */
+  size_t   cached;                    /* Number of chunks in all CPU caches */
+  uint32_t hits;                      /* Total cache hits */
+  uint32_t misses;                    /* Total cache misses */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -256,12 +351,32 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_TLSF
+  /* Free nodes are maintained in segregated, doubly linked lists.  A bit
+   * is set in the first level bitmap for each first level range that has
+   * a non-empty list and in the second level bitmap for each non-empty
+   * list of that range.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_TLSF_FLCOUNT];
+  FAR struct mm_freenode_s *mm_freelist[MM_TLSF_FLCOUNT][MM_TLSF_SLCOUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
+
+#ifdef CONFIG_MM_CACHE
+  /* Per-CPU small object cache.  Each CPU accesses only its own lists and
+   * does so with local interrupts disabled.
+   */
+
+  struct mm_cacheclass_s mm_cache[MM_CACHE_NCPUS][MM_CACHE_NCLASSES];
+#endif
 };
 
 /****************************************************************************
@@ -377,6 +492,7 @@ FAR void *kmm_malloc(size_t size);
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
 
 /* Functions contained in kmm_free.c ****************************************/
 
@@ -508,14 +624,42 @@ int kmm_mallinfo(struct mallinfo *info);
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
                     FAR struct mm_allocnode_s *node, size_t size);
 
-/* Functions contained in mm_addfreechunk.c *********************************/
+/* Functions contained in mm_addfreechunk.c or mm_tlsf.c *******************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c or mm_tlsf.c *******************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c or mm_tlsf.c ******************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
+#ifndef CONFIG_MM_TLSF
 int mm_size2ndx(size_t size);
+#endif
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_CACHE
+void mm_cacheinitialize(FAR struct mm_heap_s *heap);
+FAR void *mm_cachealloc(FAR struct mm_heap_s *heap, size_t size);
+void mm_cacherefill(FAR struct mm_heap_s *heap, size_t size,
+                    FAR struct mm_cachenode_s *chain, int nchunks);
+int mm_cacheroom(FAR struct mm_heap_s *heap, size_t size);
+FAR struct mm_cachenode_s *mm_cachefree(FAR struct mm_heap_s *heap,
+                                        FAR void *mem, size_t size);
+FAR struct mm_cachenode_s *mm_cacheflush(FAR struct mm_heap_s *heap);
+size_t mm_cachedbytes(FAR struct mm_heap_s *heap);
+int mm_cacheinfo(FAR struct mm_heap_s *heap, int sizeclass,
+                 FAR struct mm_cacheinfo_s *info);
+#endif
 
 #undef EXTERN
 #ifdef __cplusplus
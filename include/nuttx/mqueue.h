@@ -108,6 +108,8 @@ struct mqueue_inode_s
   int16_t nmsgs;              /* Number of message in the queue */
   int16_t nwaitnotfull;       /* Number tasks waiting for not full */
   int16_t nwaitnotempty;      /* Number tasks waiting for not empty */
+  dq_queue_t waitnotfull;     /* Tasks waiting for not full */
+  dq_queue_t waitnotempty;    /* Tasks waiting for not empty */
 #if CONFIG_MQ_MAXMSGSIZE < 256
   uint8_t maxmsgsize;         /* Max size of message in message queue */
 #else
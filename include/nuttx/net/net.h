@@ -130,7 +130,7 @@ enum net_lltype_e
 
 /* This defines a bitmap big enough for one bit for each socket option */
 
-typedef uint16_t sockopt_t;
+typedef uint32_t sockopt_t;
 
 /* This defines the storage size of a timeout value.  This effects only
  * range of supported timeout values.  With an LSB in seciseconds, the
@@ -151,6 +151,7 @@ typedef uint8_t sockcaps_t;
 struct file;    /* Forward reference */
 struct socket;  /* Forward reference */
 struct pollfd;  /* Forward reference */
+struct msghdr;  /* Forward reference */
 
 struct sock_intf_s
 {
@@ -177,6 +178,8 @@ struct sock_intf_s
   CODE ssize_t    (*si_sendto)(FAR struct socket *psock, FAR const void *buf,
                     size_t len, int flags, FAR const struct sockaddr *to,
                     socklen_t tolen);
+  CODE ssize_t    (*si_sendmsg)(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
 #ifdef CONFIG_NET_SENDFILE
   CODE ssize_t    (*si_sendfile)(FAR struct socket *psock,
                     FAR struct file *infile, FAR off_t *offset,
@@ -204,6 +207,9 @@ struct socket
   uint8_t       s_domain;    /* IP domain: PF_INET, PF_INET6, or PF_PACKET */
   uint8_t       s_type;      /* Protocol type: Only SOCK_STREAM or SOCK_DGRAM */
   uint8_t       s_flags;     /* See _SF_* definitions */
+#ifndef CONFIG_DISABLE_POLL
+  uint16_t      s_epolls;    /* Number of epoll registrations */
+#endif
 
   /* Socket options */
 
@@ -967,6 +973,57 @@ ssize_t nx_recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
 
 #define nx_recv(psock,buf,len,flags) nx_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_sendmsg and nx_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() and nx_sendmsg() send the data gathered from the I/O
+ *   vector of 'msg' as a single message:  One datagram on a datagram socket
+ *   or one contiguous write on a stream socket.  These are internal OS
+ *   interfaces.  They are functionally equivalent to sendmsg() except that:
+ *
+ *   - They are not cancellation points, and
+ *   - They do not modify the errno variable.
+ *
+ *   psock_sendmsg() also accepts the internal socket structure rather than
+ *   a socket descriptor.
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (See comments with sendto() for a list
+ *   of the appropriate errno value).
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+ssize_t nx_sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmsg and nx_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() and nx_recvmsg() receive a message from a socket and
+ *   scatter it into the I/O vector of 'msg'.  These are internal OS
+ *   interfaces.  They are functionally equivalent to recvmsg() except that:
+ *
+ *   - They are not cancellation points, and
+ *   - They do not modify the errno variable.
+ *
+ *   psock_recvmsg() also accepts the internal socket structure rather than
+ *   a socket descriptor.
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  Otherwise, on
+ *   any failure, a negated errno value is returned (see comments with
+ *   recvfrom() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+ssize_t nx_recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
+
 /****************************************************************************
  * Name: psock_getsockopt
  *
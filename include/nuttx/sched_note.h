@@ -47,6 +47,7 @@
 #include <stdbool.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/fs/ioctl.h>
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION
 
@@ -66,6 +67,12 @@
 #  define CONFIG_SCHED_NOTE_BUFSIZE 2048
 #endif
 
+/* IOCTL commands supported by the /dev/note driver */
+
+#define NOTEIOC_GETDROPPED  _NOTEIOC(0x0001)  /* Get the number of dropped notes
+                                               * IN:  FAR unsigned long *
+                                               * OUT: The count */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -311,6 +318,8 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
  * Description:
  *   Remove the next note from the tail of the circular buffer.  The note
  *   is also removed from the circular buffer to make room for futher notes.
+ *   In SMP configurations, each CPU has its own circular buffer and the
+ *   oldest note of all of the buffers is returned.
  *
  * Input Parameters:
  *   buffer - Location to return the next note
@@ -348,6 +357,26 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen);
 ssize_t sched_note_size(void);
 #endif
 
+/****************************************************************************
+ * Name: sched_note_dropped
+ *
+ * Description:
+ *   Return the number of notes that were dropped because the circular
+ *   buffer was full.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The total number of dropped notes since boot.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
+    defined(CONFIG_SCHED_NOTE_GET)
+unsigned long sched_note_dropped(void);
+#endif
+
 /****************************************************************************
  * Name: note_register
  *
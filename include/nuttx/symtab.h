@@ -42,6 +42,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -62,6 +64,9 @@
  *    adding or removing entries from the symbol table (realloc might be
  *    used for that purpose if needed).  The intention is to support only
  *    fixed size arrays completely defined at compilation or link time.
+ *
+ * A hashed symbol table (see symtab_findhashedbyname()) may contain unused
+ * entries with a NULL sym_name and a NULL sym_value.
  */
 
 struct symtab_s
@@ -118,6 +123,36 @@ FAR const struct symtab_s *
 symtab_findorderedbyname(FAR const struct symtab_s *symtab,
                          FAR const char *name, int nsyms);
 
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Return the hash of a symbol name as used to place the symbols in a
+ *   hashed symbol table.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hash(FAR const char *name);
+
+/****************************************************************************
+ * Name: symtab_findhashedbyname
+ *
+ * Description:
+ *   Find the symbol in the symbol table with the matching name.
+ *   This version assumes that the table is a hashed symbol table as
+ *   generated by 'mksymtab -h'.  nsyms is the size of the table, which is
+ *   a power of two.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_findhashedbyname(FAR const struct symtab_s *symtab,
+                        FAR const char *name, int nsyms);
+
 /****************************************************************************
  * Name: symtab_findbyvalue
  *
@@ -141,7 +176,8 @@ symtab_findbyvalue(FAR const struct symtab_s *symtab,
  * Name: symtab_sortbyname
  *
  * Description:
- *   Sort the symbol table by name.
+ *   Sort the symbol table by name.  This must not be used on a hashed
+ *   symbol table.
  *
  * Returned Value:
  *   None.
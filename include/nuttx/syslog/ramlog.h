@@ -54,6 +54,9 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <stdarg.h>
+
 #include <nuttx/syslog/syslog.h>
 
 #ifdef CONFIG_RAMLOG
@@ -77,6 +80,12 @@
  *   used to generate debug output from interrupt level handlers.
  * CONFIG_RAMLOG_NPOLLWAITERS - The number of threads than can be waiting
  *   for this driver on poll().  Default: 4
+ * CONFIG_RAMLOG_BINARY - Save SYSLOG messages in the RAM log as binary
+ *   records (format string address, time stamp and raw arguments).  The
+ *   messages are formatted only when the RAM log is read.
+ * CONFIG_RAMLOG_BINARY_RECSIZE - The maximum size of one binary record.
+ * CONFIG_RAMLOG_BINARY_LINESIZE - The maximum size of one formatted
+ *   message.
  *
  * If CONFIG_RAMLOG_CONSOLE or CONFIG_RAMLOG_SYSLOG is selected, then the
  * following may also be provided:
@@ -100,6 +109,18 @@
 #  define CONFIG_RAMLOG_BUFSIZE 1024
 #endif
 
+#ifndef CONFIG_RAMLOG_SYSLOG
+#  undef CONFIG_RAMLOG_BINARY
+#endif
+
+#ifndef CONFIG_RAMLOG_BINARY_RECSIZE
+#  define CONFIG_RAMLOG_BINARY_RECSIZE 64
+#endif
+
+#ifndef CONFIG_RAMLOG_BINARY_LINESIZE
+#  define CONFIG_RAMLOG_BINARY_LINESIZE 128
+#endif
+
 /* When used as a console or syslogging device, the RAM log will pre-pend
  * line-feeds with carriage returns.
  */
@@ -190,6 +211,21 @@ int ramlog_syslog_channel(void);
 int ramlog_putc(int ch);
 #endif
 
+/****************************************************************************
+ * Name: ramlog_vsyslog
+ *
+ * Description:
+ *   Save a SYSLOG message in the RAM log as a binary record without
+ *   formatting it.  The format string must persist until the message is
+ *   read from the RAM log.  -ENOSYS is returned if the RAM log is not the
+ *   current SYSLOG channel.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_BINARY
+int ramlog_vsyslog(FAR const char *fmt, FAR va_list *ap);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
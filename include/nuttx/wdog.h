@@ -144,6 +144,10 @@ struct wdog_s
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
+#ifdef CONFIG_WDOG_WHEEL
+  FAR struct wdog_s **pprev;     /* Link that points to this watchdog */
+  uint32_t           expire;     /* Expiration time in timing wheel ticks */
+#endif
 };
 
 /* Watchdog 'handle' */
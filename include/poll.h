@@ -110,6 +110,14 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+/* The type of the optional notification callback of a poll descriptor.  If
+ * it is provided, the callback is invoked (perhaps from interrupt level)
+ * instead of posting the semaphore when events are reported.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the Nuttx variant of the standard pollfd structure. */
 
 struct pollfd
@@ -133,6 +141,8 @@ struct pollfd
   pollevent_t  events;  /* The input event flags */
   pollevent_t  revents; /* The output event flags */
   FAR void    *priv;    /* For use by drivers */
+  pollcb_t     cb;      /* Notification callback (NULL: post sem) */
+  FAR void    *arg;     /* For use by the notification callback */
 };
 
 /****************************************************************************
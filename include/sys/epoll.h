@@ -40,6 +40,9 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
+#include <stdint.h>
 #include <poll.h>
 
 /****************************************************************************
@@ -76,25 +79,33 @@ enum EPOLL_EVENTS
 #define EPOLLHUP EPOLLHUP
   };
 
-typedef union poll_data
+/* Input flags of epoll_ctl() that are not poll events.  These do not fit
+ * in an enumeration value.
+ *
+ *   EPOLLONESHOT - Disable the descriptor after one event has been
+ *                  reported.  It must be re-armed with EPOLL_CTL_MOD.
+ *   EPOLLET      - Edge triggered:  Report the descriptor only when a new
+ *                  event has been signaled by the driver, not for as long
+ *                  as the descriptor remains ready.
+ */
+
+#define EPOLLONESHOT (1u << 30)
+#define EPOLLET      (1u << 31)
+
+typedef union epoll_data
 {
+  FAR void    *ptr;
   int          fd;       /* The descriptor being polled */
+  uint32_t     u32;
+#ifdef CONFIG_HAVE_LONG_LONG
+  uint64_t     u64;
+#endif
 } epoll_data_t;
 
 struct epoll_event
 {
-  epoll_data_t data;
-  FAR sem_t   *sem;      /* Pointer to semaphore used to post output event */
-  pollevent_t  events;   /* The input event flags */
-  pollevent_t  revents;  /* The output event flags */
-  FAR void    *priv;     /* For use by drivers */
-};
-
-struct epoll_head
-{
-  int size;
-  int occupied;
-  FAR struct epoll_event *evs;
+  uint32_t     events;   /* The input event flags / the output events */
+  epoll_data_t data;     /* Returned unmodified by epoll_wait() */
 };
 
 /****************************************************************************
@@ -102,8 +113,9 @@ struct epoll_head
  ****************************************************************************/
 
 int epoll_create(int size);
-int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev);
-int epoll_wait(int epfd, struct epoll_event *evs, int maxevents, int timeout);
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev);
+int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
+               int timeout);
 
 void epoll_close(int epfd);
 
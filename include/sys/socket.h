@@ -197,6 +197,11 @@
 #define SO_TYPE         15 /* Reports the socket type (get only).
                             * return: int
                             */
+#define SO_REUSEPORT    16 /* Allow several sockets to bind to the same
+                            * local address and port (get/set)
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* Protocol-level socket operations. */
 
@@ -211,7 +216,7 @@
 
 /* Protocol-level socket options may begin with this value */
 
-#define __SO_PROTOCOL  16
+#define __SO_PROTOCOL  17
 
 /* Values for the 'how' argument of shutdown() */
 
@@ -72,7 +72,7 @@ struct iovec
  *   memory where data should be placed.  The readv() function will always
  *   fill an area completely before proceeding to the next.
  *
- *   TODO: pon successful completion, readv() will mark for update the
+ *   TODO: Upon successful completion, readv() will mark for update the
  *   st_atime field of the file.
  *
  * Input Parameters:
@@ -90,7 +90,7 @@ struct iovec
  *    EINVAL.
  *      The sum of the iov_len values in the iov array overflowed an ssize_t
  *      or The 'iovcnt' argument was less than or equal to 0, or greater than
- *      IOV_MAX (Not implemented).
+ *      IOV_MAX.
  *
  ****************************************************************************/
 
@@ -114,7 +114,7 @@ ssize_t readv(int fildes, FAR const struct iovec *iov, int iovcnt);
  *   the array pointed to by iov are 0, writev() will return 0 and have no
  *   other effect. For other file types, the behavior is unspecified.
  *
- *   TODO: If the sum of the iov_len values is greater than SSIZE_MAX, the
+ *   If the sum of the iov_len values is greater than SSIZE_MAX, the
  *   operation will fail and no data will be transferred.
  *
  * Input Parameters:
@@ -132,7 +132,7 @@ ssize_t readv(int fildes, FAR const struct iovec *iov, int iovcnt);
  *    EINVAL.
  *      The sum of the iov_len values in the iov array overflowed an ssize_t
  *      or The 'iovcnt' argument was less than or equal to 0, or greater than
- *      IOV_MAX (Not implemented).
+ *      IOV_MAX.
  *
  ****************************************************************************/
 
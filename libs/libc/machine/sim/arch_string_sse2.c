@@ -0,0 +1,286 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_string_sse2.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of one SSE2 register in bytes */
+
+#define SSE_SIZE         16
+#define SSE_MASK         (SSE_SIZE - 1)
+
+/* An unaligned 16-byte load is safe if it does not cross into the next
+ * page.  The host page size is a multiple of 4KiB.
+ */
+
+#define SSE_PAGESIZE     4096
+#define SSE_PAGESAFE(p)  (((uintptr_t)(p) & (SSE_PAGESIZE - 1)) <= \
+                          (SSE_PAGESIZE - SSE_SIZE))
+
+/* Return a bit mask with one bit set for each byte in the vector 'v' whose
+ * most significant bit is set, i.e. for each byte of a comparison result
+ * that is true.
+ */
+
+#define SSE_MOVEMASK(v)  ((unsigned int)__builtin_ia32_pmovmskb128(v))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The SSE2 registers are accessed using the GCC vector extensions so that
+ * no host intrinsics header is needed.  sse_vec_t must be 16-byte aligned
+ * in memory; sse_uvec_t may be unaligned.
+ */
+
+typedef char sse_vec_t __attribute__((vector_size(SSE_SIZE), may_alias));
+typedef char sse_uvec_t __attribute__((vector_size(SSE_SIZE), aligned(1),
+                                       may_alias));
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memcpy
+ ****************************************************************************/
+
+FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
+{
+  FAR char *pout = (FAR char *)dest;
+  FAR const char *pin = (FAR const char *)src;
+  sse_uvec_t last;
+  size_t nalign;
+
+  if (n < SSE_SIZE)
+    {
+      while (n-- > 0) *pout++ = *pin++;
+      return dest;
+    }
+
+  /* The last 16 bytes are copied with one unaligned store at the end */
+
+  last = *(FAR const sse_uvec_t *)(pin + n - SSE_SIZE);
+
+  /* Copy the first 16 bytes unaligned, then continue from the first 16-byte
+   * aligned destination address.
+   */
+
+  *(FAR sse_uvec_t *)pout = *(FAR const sse_uvec_t *)pin;
+
+  nalign = SSE_SIZE - ((uintptr_t)pout & SSE_MASK);
+  pout  += nalign;
+  pin   += nalign;
+  n     -= nalign;
+
+  while (n > SSE_SIZE)
+    {
+      *(FAR sse_vec_t *)pout = *(FAR const sse_uvec_t *)pin;
+      pout += SSE_SIZE;
+      pin  += SSE_SIZE;
+      n    -= SSE_SIZE;
+    }
+
+  *(FAR sse_uvec_t *)(pout + n - SSE_SIZE) = last;
+  return dest;
+}
+
+/****************************************************************************
+ * Name: memset
+ ****************************************************************************/
+
+FAR void *memset(FAR void *s, int c, size_t n)
+{
+  FAR char *p = (FAR char *)s;
+  sse_vec_t v = (sse_vec_t){ 0 } + (char)c;
+  size_t nalign;
+
+  if (n < SSE_SIZE)
+    {
+      while (n-- > 0) *p++ = (char)c;
+      return s;
+    }
+
+  /* Set the first 16 bytes unaligned, then continue from the first 16-byte
+   * aligned address.  The last 16 bytes are set with one unaligned store.
+   */
+
+  *(FAR sse_uvec_t *)p = v;
+
+  nalign = SSE_SIZE - ((uintptr_t)p & SSE_MASK);
+  p     += nalign;
+  n     -= nalign;
+
+  while (n > SSE_SIZE)
+    {
+      *(FAR sse_vec_t *)p = v;
+      p += SSE_SIZE;
+      n -= SSE_SIZE;
+    }
+
+  *(FAR sse_uvec_t *)(p + n - SSE_SIZE) = v;
+  return s;
+}
+
+/****************************************************************************
+ * Name: memcmp
+ ****************************************************************************/
+
+int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
+{
+  FAR const unsigned char *p1 = (FAR const unsigned char *)s1;
+  FAR const unsigned char *p2 = (FAR const unsigned char *)s2;
+  unsigned int mask;
+  unsigned int i;
+
+  while (n >= SSE_SIZE)
+    {
+      mask = SSE_MOVEMASK(*(FAR const sse_uvec_t *)p1 ==
+                          *(FAR const sse_uvec_t *)p2) ^ 0xffff;
+      if (mask != 0)
+        {
+          i = __builtin_ctz(mask);
+          return p1[i] - p2[i];
+        }
+
+      p1 += SSE_SIZE;
+      p2 += SSE_SIZE;
+      n  -= SSE_SIZE;
+    }
+
+  for (; n > 0; n--, p1++, p2++)
+    {
+      if (*p1 != *p2)
+        {
+          return *p1 - *p2;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: strlen
+ ****************************************************************************/
+
+size_t strlen(FAR const char *s)
+{
+  FAR const sse_vec_t *p;
+  sse_vec_t zero = { 0 };
+  unsigned int offset;
+  unsigned int mask;
+
+  /* Start with the aligned 16 bytes that contain the beginning of the
+   * string and ignore any NULs before the beginning.  An aligned load never
+   * crosses a page boundary.
+   */
+
+  offset = (uintptr_t)s & SSE_MASK;
+  p      = (FAR const sse_vec_t *)(s - offset);
+  mask   = SSE_MOVEMASK(*p == zero) >> offset;
+
+  if (mask != 0)
+    {
+      return __builtin_ctz(mask);
+    }
+
+  for (; ; )
+    {
+      p++;
+      mask = SSE_MOVEMASK(*p == zero);
+      if (mask != 0)
+        {
+          return (FAR const char *)p - s + __builtin_ctz(mask);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: strcmp
+ ****************************************************************************/
+
+int strcmp(FAR const char *cs, FAR const char *ct)
+{
+  FAR const unsigned char *p1 = (FAR const unsigned char *)cs;
+  FAR const unsigned char *p2 = (FAR const unsigned char *)ct;
+  sse_uvec_t zero = { 0 };
+  sse_uvec_t v1;
+  sse_uvec_t v2;
+  unsigned int mask;
+  unsigned int i;
+
+  for (; ; )
+    {
+      /* Compare 16 bytes at a time unless that could read beyond the end of
+       * the page that contains the terminating NUL.
+       */
+
+      if (SSE_PAGESAFE(p1) && SSE_PAGESAFE(p2))
+        {
+          v1   = *(FAR const sse_uvec_t *)p1;
+          v2   = *(FAR const sse_uvec_t *)p2;
+          mask = SSE_MOVEMASK((v1 != v2) | (v1 == zero));
+          if (mask != 0)
+            {
+              i = __builtin_ctz(mask);
+              return p1[i] - p2[i];
+            }
+
+          p1 += SSE_SIZE;
+          p2 += SSE_SIZE;
+        }
+      else
+        {
+          if (*p1 != *p2 || *p1 == '\0')
+            {
+              return *p1 - *p2;
+            }
+
+          p1++;
+          p2++;
+        }
+    }
+}
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -62,9 +65,36 @@
 FAR void *memchr(FAR const void *s, int c, size_t n)
 {
   FAR const unsigned char *p = (FAR const unsigned char *)s;
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  uintptr_t pattern;
+#endif
 
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Check bytes until 'p' is word aligned */
+
+      for (; n > 0 && !LIB_ALIGNED(p); p++, n--)
+        {
+          if (*p == (unsigned char)c)
+            {
+              return (FAR void *)p;
+            }
+        }
+
+      /* Then skip over the words that do not contain 'c'.  A byte that
+       * matches 'c' is zero after the XOR with the repeated pattern.
+       */
+
+      pattern = LIB_REPEAT(c);
+      while (n >= LIB_WORDSIZE &&
+             !LIB_HASZERO(*(FAR const uintptr_t *)p ^ pattern))
+        {
+          p += LIB_WORDSIZE;
+          n -= LIB_WORDSIZE;
+        }
+#endif
+
       while (n--)
         {
           if (*p == (unsigned char)c)
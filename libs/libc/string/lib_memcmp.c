@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +54,33 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* If both buffers have the same alignment, skip over the equal words */
+
+  if ((((uintptr_t)p1 ^ (uintptr_t)p2) & LIB_WORDMASK) == 0)
+    {
+      while (n > 0 && !LIB_ALIGNED(p1) && *p1 == *p2)
+        {
+          p1++;
+          p2++;
+          n--;
+        }
+
+      if (LIB_ALIGNED(p1))
+        {
+          while (n >= LIB_WORDSIZE &&
+                 *(FAR const uintptr_t *)p1 == *(FAR const uintptr_t *)p2)
+            {
+              p1 += LIB_WORDSIZE;
+              p2 += LIB_WORDSIZE;
+              n  -= LIB_WORDSIZE;
+            }
+        }
+    }
+#endif
+
+  /* Compare the remaining bytes */
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -54,6 +57,68 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR uintptr_t *wout;
+  FAR const uintptr_t *win;
+  uintptr_t prev;
+  uintptr_t next;
+  unsigned int shift;
+
+  if (n >= 2 * LIB_WORDSIZE)
+    {
+      /* Copy bytes until the destination is word aligned */
+
+      while (!LIB_ALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout = (FAR uintptr_t *)pout;
+      if (LIB_ALIGNED(pin))
+        {
+          /* The source is aligned too.  Just copy words. */
+
+          win = (FAR const uintptr_t *)pin;
+          while (n >= LIB_WORDSIZE)
+            {
+              *wout++ = *win++;
+              n      -= LIB_WORDSIZE;
+            }
+
+          pin = (FAR unsigned char *)win;
+        }
+      else
+        {
+          /* The source is not aligned.  Read aligned source words and merge
+           * each pair of adjacent words into one destination word.
+           */
+
+          shift = 8 * ((uintptr_t)pin & LIB_WORDMASK);
+          win   = (FAR const uintptr_t *)((uintptr_t)pin & ~LIB_WORDMASK);
+          prev  = *win++;
+
+          while (n >= LIB_WORDSIZE)
+            {
+              next    = *win++;
+#ifdef CONFIG_ENDIAN_BIG
+              *wout++ = (prev << shift) | (next >> (8 * LIB_WORDSIZE - shift));
+#else
+              *wout++ = (prev >> shift) | (next << (8 * LIB_WORDSIZE - shift));
+#endif
+              prev    = next;
+              pin    += LIB_WORDSIZE;
+              n      -= LIB_WORDSIZE;
+            }
+        }
+
+      pout = (FAR unsigned char *)wout;
+    }
+#endif
+
+  /* Copy the remaining bytes */
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,6 +52,42 @@
 int strcmp(FAR const char *cs, FAR const char *ct)
 {
   register signed char result;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *w1;
+  FAR const uintptr_t *w2;
+
+  /* If both strings have the same alignment, skip over the equal words
+   * that do not contain the terminating NUL.
+   */
+
+  if ((((uintptr_t)cs ^ (uintptr_t)ct) & LIB_WORDMASK) == 0)
+    {
+      while (!LIB_ALIGNED(cs) && *cs == *ct && *cs != '\0')
+        {
+          cs++;
+          ct++;
+        }
+
+      if (LIB_ALIGNED(cs))
+        {
+          w1 = (FAR const uintptr_t *)cs;
+          w2 = (FAR const uintptr_t *)ct;
+
+          while (*w1 == *w2 && !LIB_HASZERO(*w1))
+            {
+              w1++;
+              w2++;
+            }
+
+          cs = (FAR const char *)w1;
+          ct = (FAR const char *)w2;
+        }
+    }
+#endif
+
+  /* Compare the remaining bytes */
+
   for (; ; )
     {
       if ((result = *cs - *ct++) != 0 || !*cs++)
@@ -0,0 +1,80 @@
+/****************************************************************************
+ * libs/libc/string/lib_string.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRING_H
+#define __LIBS_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The word-at-a-time string functions operate on naturally aligned machine
+ * words of type uintptr_t.  An aligned word never crosses a page or
+ * protection boundary so the functions may safely read a whole word that
+ * contains the terminating NUL or the last byte of an object.
+ */
+
+#define LIB_WORDSIZE      sizeof(uintptr_t)
+#define LIB_WORDMASK      (LIB_WORDSIZE - 1)
+#define LIB_ALIGNED(p)    (((uintptr_t)(p) & LIB_WORDMASK) == 0)
+
+/* LIB_ONES is 0x0101..01 and LIB_HIGHS is 0x8080..80 */
+
+#define LIB_ONES          ((uintptr_t)-1 / 0xff)
+#define LIB_HIGHS         (LIB_ONES << 7)
+
+/* Replicate the byte 'c' in each byte of a word */
+
+#define LIB_REPEAT(c)     (LIB_ONES * (uint8_t)(c))
+
+/* Non-zero if any byte in the word 'w' is zero.  The result may have false
+ * positives only in bytes following the first zero byte, so it is exact
+ * about whether the word contains a zero byte.
+ */
+
+#define LIB_HASZERO(w)    (((w) - LIB_ONES) & ~(w) & LIB_HIGHS)
+
+#endif /* CONFIG_LIBC_STRING_OPTSPEED */
+#endif /* __LIBS_LIBC_STRING_LIB_STRING_H */
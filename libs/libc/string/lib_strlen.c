@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -48,8 +51,28 @@
 #ifndef CONFIG_LIBC_ARCH_STRLEN
 size_t strlen(const char *s)
 {
-  const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+  const char *sc = s;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *w;
+
+  /* Check bytes until 'sc' is word aligned, then skip over the words that
+   * do not contain the terminating NUL.
+   */
+
+  for (; !LIB_ALIGNED(sc); ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  for (w = (FAR const uintptr_t *)sc; !LIB_HASZERO(*w); w++);
+  sc = (FAR const char *)w;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
@@ -71,7 +71,7 @@ symtab_findbyname(FAR const struct symtab_s *symtab,
   DEBUGASSERT(symtab != NULL && name != NULL);
   for (; nsyms > 0; symtab++, nsyms--)
     {
-      if (strcmp(name, symtab->sym_name) == 0)
+      if (symtab->sym_name != NULL && strcmp(name, symtab->sym_name) == 0)
         {
           return symtab;
         }
@@ -74,9 +74,11 @@ symtab_findbyvalue(FAR const struct symtab_s *symtab,
   DEBUGASSERT(symtab != NULL);
   for (; nsyms > 0; symtab++, nsyms--)
     {
-      /* Look for symbols of lesser or equal value (probably address) to value */
+      /* Look for symbols of lesser or equal value (probably address) to value.
+       * Unused entries in a hashed symbol table have a NULL value.
+       */
 
-      if (symtab->sym_value <= value)
+      if (symtab->sym_value != NULL && symtab->sym_value <= value)
         {
           /* Found one.  Is it the largest we have found so far? */
 
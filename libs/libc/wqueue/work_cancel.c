@@ -77,6 +77,7 @@
 
 static int work_qcancel(FAR struct usr_wqueue_s *wqueue, FAR struct work_s *work)
 {
+  FAR dq_queue_t *list;
   int ret = -ENOENT;
 
   DEBUGASSERT(work != NULL);
@@ -94,16 +95,17 @@ static int work_qcancel(FAR struct usr_wqueue_s *wqueue, FAR struct work_s *work
     {
       /* A little test of the integrity of the work queue */
 
+      list = WORK_LIST(wqueue, work);
       DEBUGASSERT(work->dq.flink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.tail);
+                  (FAR dq_entry_t *)work == list->tail);
       DEBUGASSERT(work->dq.blink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.head);
+                  (FAR dq_entry_t *)work == list->head);
 
       /* Remove the entry from the work queue and make sure that it is
        * marked as available (i.e., the worker field is nullified).
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      dq_rem((FAR dq_entry_t *)work, list);
       work->worker = NULL;
       ret = OK;
     }
@@ -56,6 +56,21 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_remaining
+ *
+ * Description:
+ *   Return the number of clock ticks until delayed work is due (zero if the
+ *   work is already due).
+ *
+ ****************************************************************************/
+
+static clock_t work_remaining(FAR struct work_s *work, clock_t now)
+{
+  clock_t elapsed = now - work->qtime;
+  return elapsed >= work->delay ? 0 : work->delay - elapsed;
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -89,6 +104,8 @@ static int work_qqueue(FAR struct usr_wqueue_s *wqueue,
                        FAR struct work_s *work, worker_t worker,
                        FAR void *arg, clock_t delay)
 {
+  FAR struct work_s *next;
+
   DEBUGASSERT(work != NULL);
 
   /* Get exclusive access to the work queue */
@@ -103,7 +120,7 @@ static int work_qqueue(FAR struct usr_wqueue_s *wqueue,
        * end of the work queue.
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      dq_rem((FAR dq_entry_t *)work, WORK_LIST(wqueue, work));
     }
 
   /* Initialize the work structure */
@@ -116,8 +133,40 @@ static int work_qqueue(FAR struct usr_wqueue_s *wqueue,
 
   work->qtime  = clock(); /* Time work queued */
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
-  kill(wqueue->pid, SIGWORK);   /* Wake up the worker thread */
+  if (delay == 0)
+    {
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+      kill(wqueue->pid, SIGWORK);   /* Wake up the worker thread */
+    }
+  else
+    {
+      /* Insert the delayed work after all delayed work that expires at the
+       * same time or earlier.
+       */
+
+      for (next = (FAR struct work_s *)wqueue->delayed.head;
+           next != NULL && work_remaining(next, work->qtime) <= delay;
+           next = (FAR struct work_s *)next->dq.flink);
+
+      if (next != NULL)
+        {
+          dq_addbefore((FAR dq_entry_t *)next, (FAR dq_entry_t *)work,
+                       &wqueue->delayed);
+        }
+      else
+        {
+          dq_addlast((FAR dq_entry_t *)work, &wqueue->delayed);
+        }
+
+      /* The worker thread only needs to be awakened if this is now the
+       * first delayed work to expire.
+       */
+
+      if (wqueue->delayed.head == (FAR dq_entry_t *)work)
+        {
+          kill(wqueue->pid, SIGWORK);
+        }
+    }
 
   work_unlock();
   return OK;
@@ -76,10 +76,6 @@
 #  define WORK_DELAY_MAX UINT32_MAX
 #endif
 
-#ifndef MIN
-#  define MIN(a,b) ((a) < (b) ? (a) : (b))
-#endif
-
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -123,23 +119,20 @@ pthread_mutex_t g_usrmutex;
 
 void work_process(FAR struct usr_wqueue_s *wqueue)
 {
-  volatile FAR struct work_s *work;
+  FAR struct work_s *work;
   sigset_t sigset;
   sigset_t oldset;
   worker_t  worker;
   FAR void *arg;
   clock_t elapsed;
-  clock_t remaining;
-  clock_t stick;
-  clock_t ctick;
   clock_t next;
+  clock_t now;
   int ret;
 
   /* Then process queued work.  Lock the work queue while we process items
    * in the work list.
    */
 
-  next = WORK_DELAY_MAX;
   ret = work_lock();
   if (ret < 0)
     {
@@ -153,114 +146,75 @@ void work_process(FAR struct usr_wqueue_s *wqueue)
   sigemptyset(&sigset);
   sigaddset(&sigset, SIGWORK);
 
-  /* Get the time that we started this polling cycle in clock ticks. */
-
-  stick = clock();
-
-  /* And check each entry in the work queue.  Since we have locked the
-   * work queue we know:  (1) we will not be suspended unless we do
-   * so ourselves, and (2) there will be no changes to the work queue
-   */
-
-  work = (FAR struct work_s *)wqueue->q.head;
-  while (work)
+  for (; ; )
     {
-      /* Is this work ready?  It is ready if there is no delay or if
-       * the delay has elapsed. qtime is the time that the work was added
-       * to the work queue.  It will always be greater than or equal to
-       * zero.  Therefore a delay of zero will always execute immediately.
+      /* Move all delayed work that has expired to the list of work that is
+       * ready to be performed.  The delayed work is in order of expiration
+       * so we are finished at the first work that is not yet due.
        */
 
-      ctick   = clock();
-      elapsed = ctick - work->qtime;
-      if (elapsed >= work->delay)
+      now = clock();
+      while ((work = (FAR struct work_s *)wqueue->delayed.head) != NULL &&
+             now - work->qtime >= work->delay)
         {
-          /* Remove the ready-to-execute work from the list */
-
-          (void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
-
-          /* Extract the work description from the entry (in case the work
-           * instance by the re-used after it has been de-queued).
-           */
-
-          worker = work->worker;
-
-          /* Check for a race condition where the work may be nullified
-           * before it is removed from the queue.
-           */
-
-          if (worker != NULL)
-            {
-              /* Extract the work argument (before unlocking the work queue) */
+          dq_rem((FAR dq_entry_t *)work, &wqueue->delayed);
+          work->delay = 0;
+          dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+        }
 
-              arg = work->arg;
+      /* Take the next work that is ready to be performed */
 
-              /* Mark the work as no longer being queued */
+      work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+      if (work == NULL)
+        {
+          break;
+        }
 
-              work->worker = NULL;
+      /* Extract the work description from the entry (in case the work
+       * instance by the re-used after it has been de-queued).
+       */
 
-              /* Do the work.  Unlock the work queue while the work is being
-               * performed... we don't have any idea how long this will take!
-               */
+      worker = work->worker;
 
-              work_unlock();
-              worker(arg);
+      /* Check for a race condition where the work may be nullified
+       * before it is removed from the queue.
+       */
 
-              /* Now, unfortunately, since we unlocked the work queue we don't
-               * know the state of the work list and we will have to start
-               * back at the head of the list.
-               */
+      if (worker != NULL)
+        {
+          /* Extract the work argument (before unlocking the work queue) */
 
-              ret = work_lock();
-              if (ret < 0)
-                {
-                  /* Break out earlier if we were awakened by a signal */
+          arg = work->arg;
 
-                  return;
-                }
+          /* Mark the work as no longer being queued */
 
-              work = (FAR struct work_s *)wqueue->q.head;
-            }
-          else
-            {
-              /* Canceled.. Just move to the next work in the list with
-               * the work queue still locked.
-               */
+          work->worker = NULL;
 
-              work = (FAR struct work_s *)work->dq.flink;
-            }
-        }
-      else /* elapsed < work->delay */
-        {
-          /* This one is not ready.
-           *
-           * NOTE that elapsed is relative to the current time,
-           * not the time of beginning of this queue processing pass.
-           * So it may need an adjustment.
+          /* Do the work.  Unlock the work queue while the work is being
+           * performed... we don't have any idea how long this will take!
            */
 
-          elapsed += (ctick - stick);
-          if (elapsed > work->delay)
-            {
-              /* The delay has expired while we are processing */
-
-              elapsed = work->delay;
-            }
+          work_unlock();
+          worker(arg);
 
-          /* Will it be ready before the next scheduled wakeup interval? */
-
-          remaining = work->delay - elapsed;
-          if (remaining < next)
+          ret = work_lock();
+          if (ret < 0)
             {
-              /* Yes.. Then schedule to wake up when the work is ready */
+              /* Break out earlier if we were awakened by a signal */
 
-              next = remaining;
+              return;
             }
+        }
+    }
 
-          /* Then try the next in the list. */
+  /* Sleep until the first delayed work is due (if there is any) */
 
-          work = (FAR struct work_s *)work->dq.flink;
-        }
+  next = WORK_DELAY_MAX;
+  work = (FAR struct work_s *)wqueue->delayed.head;
+  if (work != NULL)
+    {
+      elapsed = now - work->qtime;
+      next    = elapsed >= work->delay ? 0 : work->delay - elapsed;
     }
 
   /* Unlock the work queue before waiting.  In order to assure that we do
@@ -285,12 +239,12 @@ void work_process(FAR struct usr_wqueue_s *wqueue)
 
       /* Wait awhile to check the work list.  We will wait here until
        * either the time elapses or until we are awakened by a signal.
-       * Interrupts will be re-enabled while we wait.
+       * The delay is in clock ticks.
        */
 
-      sec          = next / 1000000;
+      sec          = next / TICK_PER_SEC;
       rqtp.tv_sec  = sec;
-      rqtp.tv_nsec = (next - (sec * 1000000)) * 1000;
+      rqtp.tv_nsec = (next - (sec * TICK_PER_SEC)) * NSEC_PER_TICK;
 
       sigtimedwait(&sigset, NULL, &rqtp);
     }
@@ -53,16 +53,27 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The list that holds queued work.  The delay of delayed work is set to
+ * zero when the work expires and is moved to the 'q' list.
+ */
+
+#define WORK_LIST(wq,w) ((w)->delay != 0 ? &(wq)->delayed : &(wq)->q)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
-/* This structure defines the state of one user-modework queue. */
+/* This structure defines the state of one user-modework queue.  Work that
+ * is ready to be performed is kept in the FIFO 'q';  delayed work is kept
+ * in 'delayed' in order of expiration.  The worker thread sleeps until the
+ * work at the head of 'delayed' is due or until it is signalled.
+ */
 
 struct usr_wqueue_s
 {
-  struct dq_queue_s q;      /* The queue of pending work */
-  pid_t             pid;    /* The task ID of the worker thread(s) */
+  struct dq_queue_s q;       /* The queue of work ready to be performed */
+  struct dq_queue_s delayed; /* Delayed work in order of expiration */
+  pid_t             pid;     /* The task ID of the worker thread(s) */
 };
 
 /****************************************************************************
@@ -0,0 +1,388 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_CACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cacheclass
+ *
+ * Description:
+ *   Return the size class list of the current CPU for the chunk size.
+ *
+ * Assumptions:
+ *   Local interrupts are disabled so that the caller cannot migrate to
+ *   another CPU or be preempted by another user of the same list.  The
+ *   lists are private to each CPU so no spinlock is needed.
+ *
+ ****************************************************************************/
+
+static inline FAR struct mm_cacheclass_s *
+mm_cacheclass(FAR struct mm_heap_s *heap, size_t size)
+{
+  return &heap->mm_cache[up_cpu_index()][MM_CACHE_CLASS(size)];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cacheinitialize
+ *
+ * Description:
+ *   Initialize the (empty) small object cache of the heap.
+ *
+ ****************************************************************************/
+
+void mm_cacheinitialize(FAR struct mm_heap_s *heap)
+{
+  memset(heap->mm_cache, 0, sizeof(heap->mm_cache));
+}
+
+/****************************************************************************
+ * Name: mm_cachealloc
+ *
+ * Description:
+ *   Try to take a chunk of the given size from the cache of the current
+ *   CPU.  This neither takes the heap semaphore nor searches the free list.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   size - The chunk size, including SIZEOF_MM_ALLOCNODE
+ *
+ * Returned Value:
+ *   The user memory of the chunk or NULL if the size is not cached or if
+ *   the cache is empty.  In the latter case a miss is recorded and the
+ *   caller is expected to allocate from the heap and call
+ *   mm_cacherefill().
+ *
+ ****************************************************************************/
+
+FAR void *mm_cachealloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_cacheclass_s *mc;
+  FAR struct mm_cachenode_s *node;
+  irqstate_t flags;
+
+  if (!MM_CACHEABLE(size))
+    {
+      return NULL;
+    }
+
+  flags = up_irq_save();
+  mc    = mm_cacheclass(heap, size);
+  node  = mc->mc_head;
+
+  if (node != NULL)
+    {
+      mc->mc_head = node->flink;
+      mc->mc_count--;
+      mc->mc_hits++;
+    }
+  else
+    {
+      mc->mc_misses++;
+    }
+
+  up_irq_restore(flags);
+  return node;
+}
+
+/****************************************************************************
+ * Name: mm_cacheroom
+ *
+ * Description:
+ *   Return the number of chunks that should be allocated from the heap to
+ *   refill the cache of the current CPU after a miss.  At most
+ *   CONFIG_MM_CACHE_BATCH - 1 chunks are requested (the caller allocates
+ *   one more for itself) and never more than will fit in
+ *   CONFIG_MM_CACHE_DEPTH.
+ *
+ ****************************************************************************/
+
+int mm_cacheroom(FAR struct mm_heap_s *heap, size_t size)
+{
+  irqstate_t flags;
+  int room;
+
+  if (!MM_CACHEABLE(size))
+    {
+      return 0;
+    }
+
+  flags = up_irq_save();
+  room  = CONFIG_MM_CACHE_DEPTH - mm_cacheclass(heap, size)->mc_count;
+  up_irq_restore(flags);
+
+  if (room > CONFIG_MM_CACHE_BATCH - 1)
+    {
+      room = CONFIG_MM_CACHE_BATCH - 1;
+    }
+
+  return room < 0 ? 0 : room;
+}
+
+/****************************************************************************
+ * Name: mm_cacherefill
+ *
+ * Description:
+ *   Add a chain of chunks of the same size to the cache of the current CPU.
+ *   The chain was allocated from the heap in one batch by the caller.
+ *
+ * Input Parameters:
+ *   heap    - The selected heap
+ *   size    - The chunk size, including SIZEOF_MM_ALLOCNODE
+ *   chain   - The first chunk of the chain (user memory address)
+ *   nchunks - The number of chunks in the chain
+ *
+ ****************************************************************************/
+
+void mm_cacherefill(FAR struct mm_heap_s *heap, size_t size,
+                    FAR struct mm_cachenode_s *chain, int nchunks)
+{
+  FAR struct mm_cacheclass_s *mc;
+  FAR struct mm_cachenode_s *tail;
+  irqstate_t flags;
+
+  if (chain == NULL)
+    {
+      return;
+    }
+
+  for (tail = chain; tail->flink != NULL; tail = tail->flink);
+
+  flags        = up_irq_save();
+  mc           = mm_cacheclass(heap, size);
+  tail->flink  = mc->mc_head;
+  mc->mc_head  = chain;
+  mc->mc_count += nchunks;
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mm_cachefree
+ *
+ * Description:
+ *   Return an allocated chunk to the cache of the current CPU.  If the size
+ *   class overflows CONFIG_MM_CACHE_DEPTH, a batch of CONFIG_MM_CACHE_BATCH
+ *   chunks is removed from the cache and returned to the caller which must
+ *   then release them to the heap.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   mem  - The user memory of the chunk
+ *   size - The chunk size, including SIZEOF_MM_ALLOCNODE
+ *
+ * Returned Value:
+ *   A NULL terminated chain of chunks to be returned to the heap, or NULL
+ *   if there are none.
+ *
+ ****************************************************************************/
+
+FAR struct mm_cachenode_s *mm_cachefree(FAR struct mm_heap_s *heap,
+                                        FAR void *mem, size_t size)
+{
+  FAR struct mm_cacheclass_s *mc;
+  FAR struct mm_cachenode_s *node = (FAR struct mm_cachenode_s *)mem;
+  FAR struct mm_cachenode_s *drain = NULL;
+  irqstate_t flags;
+
+  DEBUGASSERT(MM_CACHEABLE(size));
+
+  flags = up_irq_save();
+  mc    = mm_cacheclass(heap, size);
+
+  node->flink = mc->mc_head;
+  mc->mc_head = node;
+  mc->mc_count++;
+
+  if (mc->mc_count > CONFIG_MM_CACHE_DEPTH)
+    {
+      FAR struct mm_cachenode_s *tail;
+      int keep;
+      int i;
+
+      /* Keep the most recently freed chunks, which are the most likely to
+       * still be in the CPU data cache, and drain the older chunks at the
+       * end of the list.
+       */
+
+      keep = mc->mc_count - CONFIG_MM_CACHE_BATCH;
+      for (tail = mc->mc_head, i = 1; i < keep; i++)
+        {
+          tail = tail->flink;
+        }
+
+      drain        = tail->flink;
+      tail->flink  = NULL;
+      mc->mc_count = keep;
+    }
+
+  up_irq_restore(flags);
+  return drain;
+}
+
+/****************************************************************************
+ * Name: mm_cacheflush
+ *
+ * Description:
+ *   Empty all size classes of the cache of the current CPU.  This is used
+ *   when the heap is exhausted so that memory held in the cache can be
+ *   coalesced again.
+ *
+ * Returned Value:
+ *   A NULL terminated chain of chunks (of mixed sizes) to be returned to
+ *   the heap, or NULL if the cache was empty.
+ *
+ ****************************************************************************/
+
+FAR struct mm_cachenode_s *mm_cacheflush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_cacheclass_s *mc;
+  FAR struct mm_cachenode_s *chain = NULL;
+  FAR struct mm_cachenode_s *node;
+  irqstate_t flags;
+  int i;
+
+  flags = up_irq_save();
+  for (i = 0; i < MM_CACHE_NCLASSES; i++)
+    {
+      mc = &heap->mm_cache[up_cpu_index()][i];
+      while ((node = mc->mc_head) != NULL)
+        {
+          mc->mc_head = node->flink;
+          node->flink = chain;
+          chain       = node;
+        }
+
+      mc->mc_count = 0;
+    }
+
+  up_irq_restore(flags);
+  return chain;
+}
+
+/****************************************************************************
+ * Name: mm_cachedbytes
+ *
+ * Description:
+ *   Return the total size of the chunks held in the caches of all CPUs.
+ *   The caches of other CPUs are sampled without synchronization so the
+ *   result is approximate while other CPUs are allocating.
+ *
+ ****************************************************************************/
+
+size_t mm_cachedbytes(FAR struct mm_heap_s *heap)
+{
+  size_t cached = 0;
+  int cpu;
+  int i;
+
+  for (cpu = 0; cpu < MM_CACHE_NCPUS; cpu++)
+    {
+      for (i = 0; i < MM_CACHE_NCLASSES; i++)
+        {
+          cached += (size_t)heap->mm_cache[cpu][i].mc_count *
+                    MM_CACHE_SIZE(i);
+        }
+    }
+
+  return cached;
+}
+
+/****************************************************************************
+ * Name: mm_cacheinfo
+ *
+ * Description:
+ *   Return the statistics of one size class, summed over all CPUs.
+ *
+ * Input Parameters:
+ *   heap      - The selected heap
+ *   sizeclass - The size class, 0 through MM_CACHE_NCLASSES-1
+ *   info      - The location to return the statistics
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the size class is out of range.
+ *
+ ****************************************************************************/
+
+int mm_cacheinfo(FAR struct mm_heap_s *heap, int sizeclass,
+                 FAR struct mm_cacheinfo_s *info)
+{
+  FAR struct mm_cacheclass_s *mc;
+  int cpu;
+
+  DEBUGASSERT(info != NULL);
+
+  if (sizeclass < 0 || sizeclass >= MM_CACHE_NCLASSES)
+    {
+      return -EINVAL;
+    }
+
+  memset(info, 0, sizeof(struct mm_cacheinfo_s));
+  info->size = MM_CACHE_SIZE(sizeclass);
+
+  for (cpu = 0; cpu < MM_CACHE_NCPUS; cpu++)
+    {
+      mc = &heap->mm_cache[cpu][sizeclass];
+
+      info->cached += mc->mc_count;
+      info->hits   += mc->mc_hits;
+      info->misses += mc->mc_misses;
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_MM_CACHE */
@@ -1,7 +1,7 @@
 /****************************************************************************
- * libc/net/lib_sendmsg.c
+ * mm/mm_heap/mm_delfreechunk.c
  *
- *   Copyright (C) 2007, 2008, 2012, 2018 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -39,51 +39,33 @@
 
 #include <nuttx/config.h>
 
-#ifdef CONFIG_NET
+#include <assert.h>
 
-#include <sys/types.h>
-#include <sys/socket.h>
-#include <errno.h>
+#include <nuttx/mm/mm.h>
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Function: sendmsg
+ * Name: mm_delfreechunk
  *
  * Description:
- *   The sendmsg() call is identical to sendto() with a NULL from parameter.
- *
- * Parameters:
- *   sockfd   Socket descriptor of socket
- *   buf      Buffer to send data
- *   len      Length of buffer
- *   flags    Receive flags
- *
- * Returned Value:
- *  (see sendto)
- *
- * Assumptions:
+ *   Remove a free chunk from the node list.  It is assumed that the caller
+ *   holds the mm semaphore
  *
  ****************************************************************************/
 
-ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags)
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 {
-  FAR void *buf           = msg->msg_iov->iov_base;
-  FAR struct sockaddr *to = msg->msg_name;
-  socklen_t tolen         = msg->msg_namelen;
-  size_t len              = msg->msg_iov->iov_len;
+  /* Remove the node.  There must be a predecessor, but there may not be
+   * a successor node.
+   */
 
-  if (msg->msg_iovlen == 1)
+  DEBUGASSERT(node->blink);
+  node->blink->flink = node->flink;
+  if (node->flink)
     {
-      return sendto(sockfd, buf, len, flags, to, tolen);
-    }
-  else
-    {
-      set_errno(ENOTSUP);
-      return ERROR;
+      node->flink->blink = node->blink;
     }
 }
-
-#endif /* CONFIG_NET */
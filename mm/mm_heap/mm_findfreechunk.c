@@ -1,7 +1,7 @@
 /****************************************************************************
- * libc/net/lib_recvmsg.c
+ * mm/mm_heap/mm_findfreechunk.c
  *
- *   Copyright (C) 2007, 2008, 2012, 2008 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -39,51 +39,56 @@
 
 #include <nuttx/config.h>
 
-#ifdef CONFIG_NET
-
-#include <sys/types.h>
-#include <sys/socket.h>
-#include <errno.h>
+#include <nuttx/mm/mm.h>
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Function: recvmsg
+ * Name: mm_findfreechunk
  *
  * Description:
- *   The recvmsg() call is identical to recvfrom() with a NULL from parameter.
- *
- * Parameters:
- *   sockfd   Socket descriptor of socket
- *   buf      Buffer to receive data
- *   len      Length of buffer
- *   flags    Receive flags
- *
- * Returned Value:
- *  (see recvfrom)
- *
- * Assumptions:
+ *   Find the smallest free chunk that is at least 'size' bytes in size.
+ *   The chunk is not removed from the node list.  It is assumed that the
+ *   caller holds the mm semaphore
  *
  ****************************************************************************/
 
-ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
 {
-  FAR void *buf             = msg->msg_iov->iov_base;
-  FAR struct sockaddr *from = msg->msg_name;
-  FAR socklen_t *fromlen    = (FAR socklen_t *)&msg->msg_namelen;
-  size_t len                = msg->msg_iov->iov_len;
+  FAR struct mm_freenode_s *node;
+  int ndx;
+
+  /* Get the location in the node list to start the search. Special case
+   * really big allocations
+   */
 
-  if (msg->msg_iovlen == 1)
+  if (size >= MM_MAX_CHUNK)
     {
-      return recvfrom(sockfd, buf, len, flags, from, fromlen);
+      ndx = MM_NNODES-1;
     }
   else
     {
-      set_errno(ENOTSUP);
-      return ERROR;
+      /* Convert the request size into a nodelist index */
+
+      ndx = mm_size2ndx(size);
     }
-}
 
-#endif /* CONFIG_NET */
+  /* Search for a large enough chunk in the list of nodes. This list is
+   * ordered by size, but will have occasional zero sized nodes as we visit
+   * other mm_nodelist[] entries.
+   */
+
+  for (node = heap->mm_nodelist[ndx].flink;
+       node && node->size < size;
+       node = node->flink);
+
+  /* If we found a node with non-zero size, then this is one to use. Since
+   * the list is ordered, we know that is must be best fitting chunk
+   * available.
+   */
+
+  return node;
+}
@@ -64,6 +64,9 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
   int    ordblks  = 0;  /* Number of non-inuse chunks */
   size_t uordblks = 0;  /* Total allocated space */
   size_t fordblks = 0;  /* Total non-inuse space */
+#ifdef CONFIG_MM_CACHE
+  size_t cached;        /* Total space in the small object caches */
+#endif
 #if CONFIG_MM_REGIONS > 1
   int region;
 #else
@@ -121,6 +124,16 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 
   DEBUGASSERT(uordblks + fordblks == heap->mm_heapsize);
 
+#ifdef CONFIG_MM_CACHE
+  /* Chunks held in the small object caches are allocated as far as the
+   * heap is concerned, but they are available to the user.
+   */
+
+  cached    = mm_cachedbytes(heap);
+  uordblks -= cached;
+  fordblks += cached;
+#endif
+
   info->arena    = heap->mm_heapsize;
   info->ordblks  = ordblks;
   info->mxordblk = mxordblk;
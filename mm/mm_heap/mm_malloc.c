@@ -55,90 +55,41 @@
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_allocchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
+ *  Find the smallest free chunk that satisfies the request and take the
+ *  memory from it, returning the remainder (if any) to the free list.
  *
- *  8-byte alignment of the allocated data is assured.
+ * Assumptions:
+ *   The caller holds the MM semaphore.  alignsize includes
+ *   SIZEOF_MM_ALLOCNODE and is a multiple of the granule size.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+static FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
   void *ret = NULL;
-  int ndx;
-
-  /* Ignore zero-length allocations */
-
-  if (size < 1)
-    {
-      return NULL;
-    }
-
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
-   */
 
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
-
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  mm_takesemaphore(heap);
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
-
-  if (alignsize >= MM_MAX_CHUNK)
-    {
-      ndx = MM_NNODES-1;
-    }
-  else
-    {
-      /* Convert the request size into a nodelist index */
-
-      ndx = mm_size2ndx(alignsize);
-    }
-
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
-
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink);
-
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that is must be best fitting chunk
-   * available.
+  /* Find the best fitting free chunk.  How long this takes depends on how
+   * the free chunks are organized (see mm_findfreechunk.c and mm_tlsf.c).
    */
 
+  node = mm_findfreechunk(heap, alignsize);
   if (node)
     {
       FAR struct mm_freenode_s *remainder;
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -183,7 +134,111 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = (void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
     }
 
-  mm_givesemaphore(heap);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  size_t alignsize;
+  void *ret = NULL;
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
+
+#ifdef CONFIG_MM_CACHE
+  /* Small requests are first tried in the cache of the current CPU.  That
+   * needs neither the MM semaphore nor a search of the node list.
+   */
+
+  ret = mm_cachealloc(heap, alignsize);
+  if (ret == NULL)
+#endif
+    {
+      /* We need to hold the MM semaphore while we muck with the nodelist. */
+
+      mm_takesemaphore(heap);
+      ret = mm_allocchunk(heap, alignsize);
+
+#ifdef CONFIG_MM_CACHE
+      if (ret == NULL)
+        {
+          FAR struct mm_cachenode_s *chain;
+
+          /* The chunks held in the cache of this CPU cannot be coalesced
+           * with their neighbors.  Return them to the heap and try again.
+           */
+
+          chain = mm_cacheflush(heap);
+          if (chain != NULL)
+            {
+              while (chain != NULL)
+                {
+                  FAR struct mm_cachenode_s *next = chain->flink;
+                  mm_freechunk(heap, chain);
+                  chain = next;
+                }
+
+              ret = mm_allocchunk(heap, alignsize);
+            }
+        }
+      else
+        {
+          FAR struct mm_cachenode_s *chain = NULL;
+          FAR struct mm_cachenode_s *chunk;
+          int nchunks;
+          int room;
+
+          /* This was a cache miss.  While we hold the heap, allocate a
+           * batch of chunks of the same size to refill the cache so that
+           * the following requests of this size hit.
+           */
+
+          room = mm_cacheroom(heap, alignsize);
+          for (nchunks = 0; nchunks < room; nchunks++)
+            {
+              chunk = (FAR struct mm_cachenode_s *)
+                mm_allocchunk(heap, alignsize);
+              if (chunk == NULL)
+                {
+                  break;
+                }
+
+              chunk->flink = chain;
+              chain        = chunk;
+            }
+
+          mm_cacherefill(heap, alignsize, chain, nchunks);
+        }
+#endif
+
+      mm_givesemaphore(heap);
+    }
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
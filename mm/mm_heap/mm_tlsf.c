@@ -0,0 +1,260 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_TLSF
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsfmapping
+ *
+ * Description:
+ *   Map a chunk size to the first and second level indices of the free
+ *   list that holds chunks of that size.
+ *
+ ****************************************************************************/
+
+static void mm_tlsfmapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  int msb;
+
+  if (size < MM_TLSF_SMALL)
+    {
+      /* Small chunks:  One list for each multiple of the granule size */
+
+      *fl = 0;
+      *sl = (int)(size >> MM_MIN_SHIFT);
+    }
+  else if (size < MM_MAX_CHUNK)
+    {
+      /* The first level is given by the most significant bit of the size,
+       * the second level by the CONFIG_MM_TLSF_SLBITS bits below it.
+       */
+
+      msb = fls((int)size) - 1;
+      *fl = msb - (MM_MIN_SHIFT + CONFIG_MM_TLSF_SLBITS) + 1;
+      *sl = (int)(size >> (msb - CONFIG_MM_TLSF_SLBITS)) - MM_TLSF_SLCOUNT;
+    }
+  else
+    {
+      /* Really big chunks all go into the last list */
+
+      *fl = MM_TLSF_FLCOUNT - 1;
+      *sl = MM_TLSF_SLCOUNT - 1;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of its segregated free list.  It is
+ *   assumed that the caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *next;
+  int fl;
+  int sl;
+
+  mm_tlsfmapping(node->size, &fl, &sl);
+
+  next        = heap->mm_freelist[fl][sl];
+  node->blink = NULL;
+  node->flink = next;
+
+  if (next)
+    {
+      next->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_flbitmap        |= (uint32_t)1 << fl;
+  heap->mm_slbitmap[fl]    |= (uint32_t)1 << sl;
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its segregated free list.  It is assumed that
+ *   the caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+  int fl;
+  int sl;
+
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+    }
+  else
+    {
+      /* This is the head of the list.  Clear the bitmaps if the list is
+       * now empty.
+       */
+
+      mm_tlsfmapping(node->size, &fl, &sl);
+      DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+
+      heap->mm_freelist[fl][sl] = node->flink;
+      if (node->flink == NULL)
+        {
+          heap->mm_slbitmap[fl] &= ~((uint32_t)1 << sl);
+          if (heap->mm_slbitmap[fl] == 0)
+            {
+              heap->mm_flbitmap &= ~((uint32_t)1 << fl);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk that is at least 'size' bytes in size.  The request
+ *   is rounded up to the next list boundary so that any chunk in the
+ *   selected list is large enough; the search is then just two bitmap
+ *   lookups.  Only requests of MM_MAX_CHUNK bytes or more, and requests
+ *   that would otherwise fail, require a walk of a list.  The chunk is not
+ *   removed from its list.  It is assumed that the caller holds the mm
+ *   semaphore
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  uint32_t map;
+  int fl;
+  int sl;
+
+  /* Round up to the next list boundary.  Small chunk lists hold exactly
+   * one size so no rounding is needed for them.
+   */
+
+  if (size >= MM_TLSF_SMALL && size < MM_MAX_CHUNK)
+    {
+      size_t round = ((size_t)1 << (fls((int)size) - 1 -
+                                    CONFIG_MM_TLSF_SLBITS)) - 1;
+      mm_tlsfmapping(size + round, &fl, &sl);
+    }
+  else
+    {
+      mm_tlsfmapping(size, &fl, &sl);
+    }
+
+  /* Look for a non-empty list in this first level range at or above the
+   * second level index.
+   */
+
+  map = heap->mm_slbitmap[fl] & ~(((uint32_t)1 << sl) - 1);
+  if (map == 0)
+    {
+      /* None.. look for the next non-empty first level range */
+
+      map = 0;
+      if (fl + 1 < MM_TLSF_FLCOUNT)
+        {
+          map = heap->mm_flbitmap & ~(((uint32_t)1 << (fl + 1)) - 1);
+        }
+
+      if (map == 0)
+        {
+          /* There is no list that is guaranteed to satisfy the request.
+           * Before failing, check the list that holds chunks of the
+           * requested size:  It may still contain one that is large
+           * enough.  This only happens when the heap is nearly exhausted.
+           */
+
+          mm_tlsfmapping(size, &fl, &sl);
+          for (node = heap->mm_freelist[fl][sl];
+               node && node->size < size;
+               node = node->flink);
+
+          return node;
+        }
+
+      fl  = ffs((int)map) - 1;
+      map = heap->mm_slbitmap[fl];
+    }
+
+  sl   = ffs((int)map) - 1;
+  node = heap->mm_freelist[fl][sl];
+  DEBUGASSERT(node != NULL);
+
+  /* The last list holds all of the really big chunks, in no order */
+
+  if (fl == MM_TLSF_FLCOUNT - 1 && sl == MM_TLSF_SLCOUNT - 1)
+    {
+      while (node && node->size < size)
+        {
+          node = node->flink;
+        }
+    }
+
+  return node;
+}
+
+#endif /* CONFIG_MM_TLSF */
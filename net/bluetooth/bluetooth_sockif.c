@@ -109,6 +109,7 @@ const struct sock_intf_s g_bluetooth_sockif =
 #endif
   bluetooth_send,        /* si_send */
   bluetooth_sendto,      /* si_sendto */
+  NULL,                  /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                   /* si_sendfile */
 #endif
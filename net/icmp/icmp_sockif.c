@@ -102,6 +102,7 @@ const struct sock_intf_s g_icmp_sockif =
 #endif
   icmp_send,        /* si_send */
   icmp_sendto,      /* si_sendto */
+  NULL,             /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,             /* si_sendfile */
 #endif
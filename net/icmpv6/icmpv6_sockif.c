@@ -102,6 +102,7 @@ const struct sock_intf_s g_icmpv6_sockif =
 #endif
   icmpv6_send,        /* si_send */
   icmpv6_sendto,      /* si_sendto */
+  NULL,               /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,               /* si_sendfile */
 #endif
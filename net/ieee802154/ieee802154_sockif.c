@@ -107,6 +107,7 @@ const struct sock_intf_s g_ieee802154_sockif =
 #endif
   ieee802154_send,        /* si_send */
   ieee802154_sendto,      /* si_sendto */
+  NULL,                   /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                   /* si_sendfile */
 #endif
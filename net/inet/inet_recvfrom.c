@@ -51,6 +51,7 @@
 
 #include <arch/irq.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/cancelpt.h>
@@ -70,6 +71,7 @@
 #include "socket/socket.h"
 #include "usrsock/usrsock.h"
 #include "inet/inet.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -303,12 +305,18 @@ static inline void inet_udp_newdata(FAR struct net_driver_s *dev,
  *
  * Input Parameters:
  *   pstate   recvfrom state structure
+ *   iob      The UDP datagram, already removed from the read-ahead queue
+ *            (inet_udp_readahead only)
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   The network is locked.
+ *   The network need not be locked.  inet_tcp_readahead takes the
+ *   connection's receiver lock, which the device path never takes, and
+ *   modifies the read-ahead queue only in a critical section.  Data is
+ *   copied to the user buffer outside of the critical section.  The UDP
+ *   datagram is owned by the caller and is freed by inet_udp_readahead.
  *
  ****************************************************************************/
 
@@ -317,15 +325,27 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
 {
   FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)pstate->ir_sock->s_conn;
   FAR struct iob_s *iob;
+  irqstate_t flags;
   int recvlen;
 
   /* Check there is any TCP data already buffered in a read-ahead
-   * buffer.
+   * buffer.  Other receivers of the connection wait on rdlock while the
+   * data is copied.  The device path only appends to the queue, so the
+   * I/O buffer chain at the head does not change while it is copied.
    */
 
-  while ((iob = iob_peek_queue(&conn->readahead)) != NULL &&
-          pstate->ir_buflen > 0)
+  net_connlock(&conn->rdlock);
+  while (pstate->ir_buflen > 0)
     {
+      flags = enter_critical_section();
+      iob   = iob_peek_queue(&conn->readahead);
+      leave_critical_section(flags);
+
+      if (iob == NULL)
+        {
+          break;
+        }
+
       DEBUGASSERT(iob->io_pktlen > 0);
 
       /* Transfer that buffered data from the I/O buffer chain into
@@ -353,7 +373,10 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
            * buffer queue.
            */
 
-          tmp = iob_remove_queue(&conn->readahead);
+          flags = enter_critical_section();
+          tmp   = iob_remove_queue(&conn->readahead);
+          leave_critical_section(flags);
+
           DEBUGASSERT(tmp == iob);
           UNUSED(tmp);
 
@@ -368,97 +391,82 @@ static inline void inet_tcp_readahead(struct inet_recvfrom_s *pstate)
            * buffer queue).
            */
 
+          flags = enter_critical_section();
           (void)iob_trimhead_queue(&conn->readahead, recvlen);
+          leave_critical_section(flags);
         }
     }
+
+  net_connunlock(&conn->rdlock);
 }
 #endif /* NET_TCP_HAVE_STACK && CONFIG_NET_TCP_READAHEAD */
 
 #if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_READAHEAD)
-
-static inline void inet_udp_readahead(struct inet_recvfrom_s *pstate)
+static inline void inet_udp_readahead(struct inet_recvfrom_s *pstate,
+                                      FAR struct iob_s *iob)
 {
-  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)pstate->ir_sock->s_conn;
-  FAR struct iob_s *iob;
+  uint8_t src_addr_size;
   int recvlen;
 
-  /* Check there is any UDP datagram already buffered in a read-ahead
-   * buffer.
-   */
+  DEBUGASSERT(iob->io_pktlen > 0);
 
   pstate->ir_recvlen = -1;
 
-  if ((iob = iob_peek_queue(&conn->readahead)) != NULL)
-    {
-      FAR struct iob_s *tmp;
-      uint8_t src_addr_size;
-
-      DEBUGASSERT(iob->io_pktlen > 0);
-
-      /* Transfer that buffered data from the I/O buffer chain into
-       * the user buffer.
-       */
+  /* Transfer that buffered data from the I/O buffer chain into the user
+   * buffer.
+   */
 
-      recvlen = iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0);
-      if (recvlen != sizeof(uint8_t))
-        {
-          goto out;
-        }
+  recvlen = iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0);
+  if (recvlen != sizeof(uint8_t))
+    {
+      goto out;
+    }
 
-      if (0
+  if (0
 #ifdef CONFIG_NET_IPv6
-          || src_addr_size == sizeof(struct sockaddr_in6)
+      || src_addr_size == sizeof(struct sockaddr_in6)
 #endif
 #ifdef CONFIG_NET_IPv4
-          || src_addr_size == sizeof(struct sockaddr_in)
+      || src_addr_size == sizeof(struct sockaddr_in)
 #endif
-        )
+    )
+    {
+      if (pstate->ir_from)
         {
-          if (pstate->ir_from)
-            {
-              socklen_t len = *pstate->ir_fromlen;
-              len = (socklen_t)src_addr_size > len ? len : (socklen_t)src_addr_size;
+          socklen_t len = *pstate->ir_fromlen;
+          len = (socklen_t)src_addr_size > len ? len : (socklen_t)src_addr_size;
 
-              recvlen = iob_copyout((FAR uint8_t *)pstate->ir_from, iob,
-                                    len, sizeof(uint8_t));
-              if (recvlen != len)
-                {
-                  goto out;
-                }
+          recvlen = iob_copyout((FAR uint8_t *)pstate->ir_from, iob,
+                                len, sizeof(uint8_t));
+          if (recvlen != len)
+            {
+              goto out;
             }
         }
+    }
 
-      if (pstate->ir_buflen > 0)
-        {
-          recvlen = iob_copyout(pstate->ir_buffer, iob, pstate->ir_buflen,
-                                src_addr_size + sizeof(uint8_t));
+  if (pstate->ir_buflen > 0)
+    {
+      recvlen = iob_copyout(pstate->ir_buffer, iob, pstate->ir_buflen,
+                            src_addr_size + sizeof(uint8_t));
 
-          ninfo("Received %d bytes (of %d)\n", recvlen, iob->io_pktlen);
+      ninfo("Received %d bytes (of %d)\n", recvlen, iob->io_pktlen);
 
-          /* Update the accumulated size of the data read */
+      /* Update the accumulated size of the data read */
 
-          pstate->ir_recvlen  = recvlen;
-          pstate->ir_buffer  += recvlen;
-          pstate->ir_buflen  -= recvlen;
-        }
-      else
-        {
-          pstate->ir_recvlen = 0;
-        }
+      pstate->ir_recvlen  = recvlen;
+      pstate->ir_buffer  += recvlen;
+      pstate->ir_buflen  -= recvlen;
+    }
+  else
+    {
+      pstate->ir_recvlen = 0;
+    }
 
 out:
-      /* Remove the I/O buffer chain from the head of the read-ahead
-       * buffer queue.
-       */
-
-      tmp = iob_remove_queue(&conn->readahead);
-      DEBUGASSERT(tmp == iob);
-      UNUSED(tmp);
-
-      /* And free the I/O buffer chain */
+  /* And free the I/O buffer chain */
 
-      (void)iob_free_chain(iob);
-    }
+  (void)iob_free_chain(iob);
 }
 #endif
 
@@ -1193,22 +1201,77 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 {
   FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
   FAR struct net_driver_s *dev;
+#ifdef CONFIG_NET_UDP_READAHEAD
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+#endif
   struct inet_recvfrom_s state;
   int ret;
 
   /* Perform the UDP recvfrom() operation */
 
-  /* Initialize the state structure.  This is done with the network locked
-   * because we don't want anything to happen until we are ready.
+  inet_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
+
+#ifdef CONFIG_NET_UDP_READAHEAD
+  /* Check if there is any UDP datagram already buffered in a read-ahead
+   * buffer.  The read-ahead queue is only modified in a critical section,
+   * so a datagram that is already buffered is received without the network
+   * locked at all.  Once it has been removed from the read-ahead queue the
+   * datagram belongs to us.
+   */
+
+  state.ir_recvlen = -1;
+
+  flags = enter_critical_section();
+  iob   = iob_remove_queue(&conn->readahead);
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      inet_udp_readahead(&state, iob);
+
+      if (state.ir_recvlen > 0 || _SS_ISNONBLOCK(psock->s_flags))
+        {
+          ret = state.ir_recvlen < 0 ? -EAGAIN : state.ir_recvlen;
+          inet_recvfrom_uninitialize(&state);
+          return ret;
+        }
+    }
+#endif
+
+  /* Lock the network because we don't want anything to happen until we are
+   * ready.
    */
 
   net_lock();
-  inet_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
 
 #ifdef CONFIG_NET_UDP_READAHEAD
-  /* Copy the read-ahead data from the packet */
+  /* A datagram may have been buffered before the network was locked.  The
+   * copy into the user buffer is still done without the network locked.
+   * The network only needs to be locked again if we must wait for a new
+   * datagram.
+   */
+
+  state.ir_recvlen = -1;
+
+  flags = enter_critical_section();
+  iob   = iob_remove_queue(&conn->readahead);
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      net_unlock();
+      inet_udp_readahead(&state, iob);
 
-  inet_udp_readahead(&state);
+      if (state.ir_recvlen > 0 || _SS_ISNONBLOCK(psock->s_flags))
+        {
+          ret = state.ir_recvlen < 0 ? -EAGAIN : state.ir_recvlen;
+          inet_recvfrom_uninitialize(&state);
+          return ret;
+        }
+
+      net_lock();
+    }
 
   /* The default return value is the number of bytes that we just copied
    * into the user buffer.  We will return this if the socket has become
@@ -1305,6 +1368,8 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
+ *   flags  Receive flags.  MSG_DONTWAIT makes this one receive
+ *          non-blocking.
  *   from   INET address of source (may be NULL)
  *
  * Returned Value:
@@ -1317,19 +1382,44 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
 #ifdef NET_TCP_HAVE_STACK
 static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                                 FAR struct sockaddr *from, FAR socklen_t *fromlen)
+                                 int flags, FAR struct sockaddr *from,
+                                 FAR socklen_t *fromlen)
 {
   struct inet_recvfrom_s state;
   int               ret;
 
-  /* Initialize the state structure.  This is done with the network locked
-   * because we don't want anything to happen until we are ready.
+  inet_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
+
+#ifdef CONFIG_NET_TCP_READAHEAD
+  /* Take any TCP data already buffered in a read-ahead buffer.  The
+   * read-ahead queue has its own lock, so if the buffered data satisfies
+   * the request, it is received without the network locked at all.  The
+   * conditions are the same as those of the return below.
+   */
+
+  inet_tcp_readahead(&state);
+  if (state.ir_recvlen > 0)
+    {
+#if CONFIG_NET_TCP_RECVDELAY > 0
+      if (state.ir_buflen == 0 || _SS_ISNONBLOCK(psock->s_flags) ||
+          (flags & MSG_DONTWAIT) != 0)
+#endif
+        {
+          ret = state.ir_recvlen;
+          inet_recvfrom_uninitialize(&state);
+          return (ssize_t)ret;
+        }
+    }
+#endif
+
+  /* Lock the network because we don't want anything to happen until we are
+   * ready.
    */
 
   net_lock();
-  inet_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
 
-  /* Handle any any TCP data already buffered in a read-ahead buffer.  NOTE
+  /* Handle any any TCP data already buffered in a read-ahead buffer
+   * (again, some may have arrived before the network was locked).  NOTE
    * that there may be read-ahead data to be retrieved even after the
    * socket has been disconnected.
    */
@@ -1386,12 +1476,17 @@ static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
   /* In general, this implementation will not support non-blocking socket
    * operations... except in a few cases:  Here for TCP receive with read-ahead
    * enabled.  If this socket is configured as non-blocking then return EAGAIN
-   * if no data was obtained from the read-ahead buffers.
+   * if no data was obtained from the read-ahead buffers.  MSG_DONTWAIT does
+   * the same for one receive.  Without read-ahead, nothing can be received
+   * without waiting.
    */
 
   else
 #ifdef CONFIG_NET_TCP_READAHEAD
-  if (_SS_ISNONBLOCK(psock->s_flags))
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
+#else
+  if ((flags & MSG_DONTWAIT) != 0)
+#endif
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -1411,7 +1506,6 @@ static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
    */
 
   else
-#endif
 
   /* We get here when we we decide that we need to setup the wait for incoming
    * TCP/IP data.  Just a few more conditions to check:
@@ -1557,7 +1651,7 @@ ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     case SOCK_STREAM:
       {
 #ifdef NET_TCP_HAVE_STACK
-        ret = inet_tcp_recvfrom(psock, buf, len, from, fromlen);
+        ret = inet_tcp_recvfrom(psock, buf, len, flags, from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
@@ -88,6 +88,8 @@ static ssize_t    inet_send(FAR struct socket *psock, FAR const void *buf,
 static ssize_t    inet_sendto(FAR struct socket *psock, FAR const void *buf,
                     size_t len, int flags, FAR const struct sockaddr *to,
                     socklen_t tolen);
+static ssize_t    inet_sendmsg(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
 #ifdef CONFIG_NET_SENDFILE
 static ssize_t    inet_sendfile(FAR struct socket *psock, FAR struct file *infile,
                     FAR off_t *offset, size_t count);
@@ -113,6 +115,7 @@ static const struct sock_intf_s g_inet_sockif =
 #endif
   inet_send,        /* si_send */
   inet_sendto,      /* si_sendto */
+  inet_sendmsg,     /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   inet_sendfile,    /* si_sendfile */
 #endif
@@ -445,6 +448,21 @@ static int inet_bind(FAR struct socket *psock,
       case SOCK_DGRAM:
         {
 #ifdef NET_UDP_HAVE_STACK
+#ifdef CONFIG_NET_UDP_REUSEPORT
+          FAR struct udp_conn_s *conn = psock->s_conn;
+
+          /* SO_REUSEPORT must be set before the socket is bound */
+
+          if (_SO_GETOPT(psock->s_options, SO_REUSEPORT))
+            {
+              conn->flags |= _UDP_FLAG_REUSEPORT;
+            }
+          else
+            {
+              conn->flags &= ~_UDP_FLAG_REUSEPORT;
+            }
+#endif
+
           /* Bind a UDP/IP datagram socket */
 
           ret = udp_bind(psock->s_conn, addr);
@@ -1258,6 +1276,41 @@ static ssize_t inet_sendto(FAR struct socket *psock, FAR const void *buf,
   return nsent;
 }
 
+/****************************************************************************
+ * Name: inet_sendmsg
+ *
+ * Description:
+ *   Implements the sendmsg() operation for the case of the AF_INET and
+ *   AF_INET6 sockets.  Only a TCP send through the write buffers can accept
+ *   the I/O vector directly; in all other cases -ENOSYS is returned and the
+ *   caller must gather the data into a single buffer.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      Message to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error, a negated
+ *   errno value is returned (see sendmsg() for the list of appropriate error
+ *   values.
+ *
+ ****************************************************************************/
+
+static ssize_t inet_sendmsg(FAR struct socket *psock,
+                            FAR struct msghdr *msg, int flags)
+{
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_WRITE_BUFFERS) && \
+   !defined(CONFIG_NET_6LOWPAN)
+  if (psock->s_type == SOCK_STREAM && msg->msg_name == NULL)
+    {
+      return psock_tcp_sendv(psock, msg->msg_iov, msg->msg_iovlen);
+    }
+#endif
+
+  return -ENOSYS;
+}
+
 /****************************************************************************
  * Name: inet_sendfile
  *
@@ -53,6 +53,25 @@
 
 #ifdef HAVE_LOCAL_POLL
 
+/****************************************************************************
+ * Name: local_shadow_notify
+ *
+ * Description:
+ *   Forward the events reported on one of the shadow pollfds of a stream
+ *   socket to the pollfd of the socket (passed as the callback argument).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_shadow_notify(FAR struct pollfd *shadowfds)
+{
+  FAR struct pollfd *fds = (FAR struct pollfd *)shadowfds->arg;
+
+  fds->revents |= shadowfds->revents;
+  poll_post(fds);
+}
+#endif
+
 /****************************************************************************
  * Name: local_accept_pollsetup
  ****************************************************************************/
@@ -152,7 +171,7 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_post(fds);
             }
         }
     }
@@ -223,12 +242,20 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
               return -ENOMEM;
             }
 
+          /* Events on the shadow pollfds are forwarded to fds as they are
+           * reported so that a notification callback of fds sees them.
+           */
+
           shadowfds[0].fd     = 0; /* Does not matter */
           shadowfds[0].sem    = fds->sem;
+          shadowfds[0].cb     = local_shadow_notify;
+          shadowfds[0].arg    = fds;
           shadowfds[0].events = fds->events & ~POLLOUT;
 
           shadowfds[1].fd     = 1; /* Does not matter */
           shadowfds[1].sem    = fds->sem;
+          shadowfds[1].cb     = local_shadow_notify;
+          shadowfds[1].arg    = fds;
           shadowfds[1].events = fds->events & ~POLLIN;
 
           /* Setup poll for both shadow pollfds. */
@@ -295,7 +322,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_post(fds);
   return OK;
 }
 
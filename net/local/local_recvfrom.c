@@ -167,8 +167,17 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 
   if (conn->u.peer.lc_remaining == 0)
     {
-      /* No.. Sync to the start of the next packet in the stream and get
-       * the size of the next packet.
+      /* No.. Syncing to the next packet may block.  With MSG_DONTWAIT,
+       * only the remainder of the current packet may be received.
+       */
+
+      if ((flags & MSG_DONTWAIT) != 0)
+        {
+          return -EAGAIN;
+        }
+
+      /* Sync to the start of the next packet in the stream and get the
+       * size of the next packet.
        */
 
       ret = local_sync(&conn->lc_infile);
@@ -110,6 +110,7 @@ const struct sock_intf_s g_local_sockif =
 #endif
   local_send,        /* si_send */
   local_sendto,      /* si_sendto */
+  NULL,              /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,              /* si_sendfile */
 #endif
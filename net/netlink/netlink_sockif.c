@@ -104,6 +104,7 @@ const struct sock_intf_s g_netlink_sockif =
 #endif
   netlink_send,         /* si_send */
   netlink_sendto,       /* si_sendto */
+  NULL,                 /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                 /* si_sendfile */
 #endif
@@ -107,6 +107,7 @@ const struct sock_intf_s g_pkt_sockif =
 #endif
   pkt_send,        /* si_send */
   pkt_sendto,      /* si_sendto */
+  NULL,            /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,            /* si_sendfile */
 #endif
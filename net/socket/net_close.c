@@ -47,6 +47,7 @@
 #include <debug.h>
 #include <assert.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
@@ -85,6 +86,15 @@ int psock_close(FAR struct socket *psock)
       return -EBADF;
     }
 
+#if CONFIG_NFILE_DESCRIPTORS > 0 && !defined(CONFIG_DISABLE_POLL)
+  /* Remove the socket from any epoll instance while it is still open */
+
+  if (psock->s_epolls > 0)
+    {
+      epoll_release(psock);
+    }
+
+#endif
   /* We perform the close operation only if this is the last count on
    * the socket. (actually, I think the socket crefs only takes the values
    * 0 and 1 right now).
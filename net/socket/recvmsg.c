@@ -0,0 +1,333 @@
+/****************************************************************************
+ * net/socket/recvmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives one message from a socket and scatters it into
+ *   the I/O vector of 'msg'.  A message that fits in a single buffer is
+ *   received in place.  Stream data is received in place into each buffer
+ *   in turn.  A datagram is received into one temporary buffer so that the
+ *   whole datagram is consumed by a single receive.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Buffers to receive the message and its source address
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly
+ *   shutdown, zero is returned.  Otherwise, on any failure, a negated errno
+ *   value is returned (see comments with recvfrom() for a list of
+ *   appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  FAR struct sockaddr *from;
+  FAR socklen_t *pfromlen;
+  FAR struct iovec *iov;
+  FAR uint8_t *buffer;
+  FAR uint8_t *src;
+  socklen_t fromlen;
+  size_t remaining;
+  size_t ncopy;
+  size_t total;
+  ssize_t nrecvd;
+  ssize_t ret;
+  int nbufs;
+  int iovcnt;
+  int last;
+  int i;
+
+  /* Verify that the psock corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  /* Verify the I/O vector.  The total size must be representable in the
+   * ssize_t return value.
+   */
+
+  if (msg == NULL || msg->msg_iov == NULL || msg->msg_iovlen == 0 ||
+      msg->msg_iovlen > IOV_MAX)
+    {
+      return -EINVAL;
+    }
+
+  iov    = msg->msg_iov;
+  iovcnt = (int)msg->msg_iovlen;
+
+  for (i = 0, total = 0, nbufs = 0, last = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      if (iov[i].iov_len > 0)
+        {
+          total += iov[i].iov_len;
+          last   = i;
+          nbufs++;
+        }
+    }
+
+  /* Return the source address only if the caller provided a buffer for it */
+
+  if (msg->msg_name != NULL)
+    {
+      from     = (FAR struct sockaddr *)msg->msg_name;
+      fromlen  = (socklen_t)msg->msg_namelen;
+      pfromlen = &fromlen;
+    }
+  else
+    {
+      from     = NULL;
+      pfromlen = NULL;
+    }
+
+  msg->msg_flags = 0;
+
+  /* If there is no more than one non-empty buffer, receive into it in
+   * place.
+   */
+
+  if (nbufs <= 1)
+    {
+      ret = psock_recvfrom(psock, iov[last].iov_base, iov[last].iov_len,
+                           flags, from, pfromlen);
+    }
+  else if (psock->s_type == SOCK_STREAM)
+    {
+      /* A stream has no message boundaries, so receive into each buffer in
+       * place.  Only the first receive may wait for data.  The next buffer
+       * is used only if the previous one was filled and more data can be
+       * received without waiting.
+       */
+
+      for (i = 0, nrecvd = 0, ret = 0; i <= last; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          if (nrecvd == 0)
+            {
+              ret = psock_recvfrom(psock, iov[i].iov_base, iov[i].iov_len,
+                                   flags, from, pfromlen);
+            }
+          else
+            {
+              ret = psock_recvfrom(psock, iov[i].iov_base, iov[i].iov_len,
+                                   flags | MSG_DONTWAIT, NULL, NULL);
+            }
+
+          if (ret <= 0)
+            {
+              break;
+            }
+
+          nrecvd += ret;
+          if ((size_t)ret < iov[i].iov_len)
+            {
+              break;
+            }
+        }
+
+      /* An error after some data was received is reported by the next
+       * receive.
+       */
+
+      if (nrecvd > 0)
+        {
+          ret = nrecvd;
+        }
+    }
+  else
+    {
+      /* Otherwise, receive the datagram into one buffer and scatter it */
+
+      buffer = (FAR uint8_t *)kmm_malloc(total);
+      if (buffer == NULL)
+        {
+          nerr("ERROR: Failed to allocate %lu byte buffer\n",
+               (unsigned long)total);
+          return -ENOMEM;
+        }
+
+      ret = psock_recvfrom(psock, buffer, total, flags, from, pfromlen);
+
+      for (i = 0, src = buffer, remaining = ret > 0 ? ret : 0;
+           remaining > 0;
+           i++)
+        {
+          ncopy = iov[i].iov_len;
+          if (ncopy > remaining)
+            {
+              ncopy = remaining;
+            }
+
+          memcpy(iov[i].iov_base, src, ncopy);
+          src       += ncopy;
+          remaining -= ncopy;
+        }
+
+      kmm_free(buffer);
+    }
+
+  /* Return the actual size of the source address */
+
+  if (ret >= 0 && from != NULL)
+    {
+      msg->msg_namelen = fromlen;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nx_recvmsg
+ *
+ * Description:
+ *   nx_recvmsg() receives one message from a socket and scatters it into
+ *   the I/O vector of 'msg'.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmsg() except that:
+ *
+ *   - It is not a cancellation point, and
+ *   - It does not modify the errno variable.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - Buffers to receive the message and its source address
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly
+ *   shutdown, zero is returned.  Otherwise, on any failure, a negated errno
+ *   value is returned (see comments with recvfrom() for a list of
+ *   appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t nx_recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Then let psock_recvmsg() do all of the work */
+
+  return psock_recvmsg(psock, msg, flags);
+}
+
+/****************************************************************************
+ * Name: recvmsg
+ *
+ * Description:
+ *   The recvmsg() call is identical to recvfrom() except that the received
+ *   data is scattered into the 'msg_iovlen' buffers of the I/O vector
+ *   'msg_iov'.  If 'msg_name' is not NULL, the source address is returned
+ *   there and 'msg_namelen' is updated.  Ancillary data is not supported.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - Buffers to receive the message and its source address
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On error, -1
+ *   is returned, and errno is set appropriately (see recvfrom()).
+ *
+ ****************************************************************************/
+
+ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  ssize_t ret;
+
+  /* recvmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Let nx_recvmsg() and psock_recvmsg() do all of the work */
+
+  ret = nx_recvmsg(sockfd, msg, flags);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -0,0 +1,290 @@
+/****************************************************************************
+ * net/socket/sendmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends the data gathered from the I/O vector of 'msg' as
+ *   a single message.  If the address family provides a sendmsg method,
+ *   the I/O vector is passed to it directly.  Otherwise, stream data is
+ *   sent in place from each buffer in turn with psock_sendto().  Datagram
+ *   data is gathered into one temporary buffer so that it still results in
+ *   one datagram.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Message to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (see comments with sendto() for a list
+ *   of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  FAR const struct sockaddr *to;
+  FAR struct iovec *iov;
+  FAR uint8_t *buffer;
+  FAR uint8_t *dest;
+  socklen_t tolen;
+  size_t total;
+  ssize_t nsent;
+  ssize_t ret;
+  int nbufs;
+  int iovcnt;
+  int last;
+  int i;
+
+  /* Verify that the psock corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  /* Verify the I/O vector.  The total size must be representable in the
+   * ssize_t return value.
+   */
+
+  if (msg == NULL || msg->msg_iov == NULL || msg->msg_iovlen == 0 ||
+      msg->msg_iovlen > IOV_MAX)
+    {
+      return -EINVAL;
+    }
+
+  iov    = msg->msg_iov;
+  iovcnt = (int)msg->msg_iovlen;
+  to     = (FAR const struct sockaddr *)msg->msg_name;
+  tolen  = msg->msg_name != NULL ? (socklen_t)msg->msg_namelen : 0;
+
+  for (i = 0, total = 0, nbufs = 0, last = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      if (iov[i].iov_len > 0)
+        {
+          total += iov[i].iov_len;
+          last   = i;
+          nbufs++;
+        }
+    }
+
+  /* Let the address family send the I/O vector directly if it can */
+
+  if (psock->s_sockif != NULL && psock->s_sockif->si_sendmsg != NULL)
+    {
+      ret = psock->s_sockif->si_sendmsg(psock, msg, flags);
+      if (ret != -ENOSYS)
+        {
+          return ret;
+        }
+    }
+
+  /* If there is no more than one non-empty buffer, send it in place */
+
+  if (nbufs <= 1)
+    {
+      return psock_sendto(psock, iov[last].iov_base, iov[last].iov_len,
+                          flags, to, tolen);
+    }
+
+  /* A stream has no message boundaries, so send from each buffer in place.
+   * Stop at the first buffer that is not sent completely.
+   */
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      for (i = 0, nsent = 0; i <= last; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          ret = psock_sendto(psock, iov[i].iov_base, iov[i].iov_len, flags,
+                             to, tolen);
+          if (ret < 0)
+            {
+              /* An error after some data was sent is reported by the next
+               * send.
+               */
+
+              return nsent > 0 ? nsent : ret;
+            }
+
+          nsent += ret;
+          if ((size_t)ret < iov[i].iov_len)
+            {
+              break;
+            }
+        }
+
+      return nsent;
+    }
+
+  /* Otherwise, gather the datagram into one buffer */
+
+  buffer = (FAR uint8_t *)kmm_malloc(total);
+  if (buffer == NULL)
+    {
+      nerr("ERROR: Failed to allocate %lu byte buffer\n",
+           (unsigned long)total);
+      return -ENOMEM;
+    }
+
+  for (i = 0, dest = buffer; i < iovcnt; i++)
+    {
+      memcpy(dest, iov[i].iov_base, iov[i].iov_len);
+      dest += iov[i].iov_len;
+    }
+
+  ret = psock_sendto(psock, buffer, total, flags, to, tolen);
+
+  kmm_free(buffer);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nx_sendmsg
+ *
+ * Description:
+ *   nx_sendmsg() sends the data gathered from the I/O vector of 'msg' as a
+ *   single message.  This is an internal OS interface.  It is functionally
+ *   equivalent to sendmsg() except that:
+ *
+ *   - It is not a cancellation point, and
+ *   - It does not modify the errno variable.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of the socket
+ *   msg    - Message to send
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (see comments with sendto() for a list
+ *   of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t nx_sendmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* And let psock_sendmsg do all of the work */
+
+  return psock_sendmsg(psock, msg, flags);
+}
+
+/****************************************************************************
+ * Name: sendmsg
+ *
+ * Description:
+ *   The sendmsg() call is identical to sendto() except that the data to be
+ *   sent is gathered from the 'msg_iovlen' buffers of the I/O vector
+ *   'msg_iov'.  The destination address, if any, is given by 'msg_name'
+ *   and 'msg_namelen'.  Ancillary data is not supported and is ignored.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of the socket
+ *   msg    - Message to send
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On error, -1 is
+ *   returned, and errno is set appropriately (see sendto()).
+ *
+ ****************************************************************************/
+
+ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  ssize_t ret;
+
+  /* sendmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Let psock_sendmsg() do all of the work */
+
+  ret = nx_sendmsg(sockfd, msg, flags);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -44,6 +44,7 @@
 
 #include <sys/types.h>
 #include <queue.h>
+#include <semaphore.h>
 
 #include <nuttx/clock.h>
 #include <nuttx/mm/iob.h>
@@ -88,10 +89,10 @@
 #  define TCP_WBNRTX(wrb)            ((wrb)->wb_nrtx)
 #  define TCP_WBIOB(wrb)             ((wrb)->wb_iob)
 #  define TCP_WBCOPYOUT(wrb,dest,n)  (iob_copyout(dest,(wrb)->wb_iob,(n),0))
-#  define TCP_WBCOPYIN(wrb,src,n) \
-     (iob_copyin((wrb)->wb_iob,src,(n),0,false))
-#  define TCP_WBTRYCOPYIN(wrb,src,n) \
-     (iob_trycopyin((wrb)->wb_iob,src,(n),0,false))
+#  define TCP_WBCOPYIN(wrb,src,n,off) \
+     (iob_copyin((wrb)->wb_iob,src,(n),(off),false))
+#  define TCP_WBTRYCOPYIN(wrb,src,n,off) \
+     (iob_trycopyin((wrb)->wb_iob,src,(n),(off),false))
 
 #  define TCP_WBTRIM(wrb,n) \
      do { (wrb)->wb_iob = iob_trimhead((wrb)->wb_iob,(n)); } while (0)
@@ -104,6 +105,15 @@
 #  endif
 #endif
 
+#ifdef CONFIG_NET_TCP_HASH
+/* Hash a local port number (in network byte order) into a bucket of the
+ * port-keyed hash tables.
+ */
+
+#  define TCP_PORT_HASH(p) \
+     ((unsigned int)((p) ^ ((p) >> 8)) % CONFIG_NET_TCP_HASHSIZE)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -160,14 +170,36 @@ struct tcp_conn_s
 
   FAR struct net_driver_s *dev;
 
+#ifdef CONFIG_NET_TCP_HASH
+  /* Hash table linkage
+   *
+   *   hnext - The next active connection in the same bucket of the
+   *           connection (local port, remote port, remote address) hash.
+   *   pnext - The next connection in the same bucket of the local port
+   *           hash.  All allocated connections with a non-zero lport are
+   *           in this table.
+   *   lnext - The next listener in the same bucket of the listener hash.
+   */
+
+  FAR struct tcp_conn_s *hnext;
+  FAR struct tcp_conn_s *pnext;
+  FAR struct tcp_conn_s *lnext;
+#endif
+
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Read-ahead buffering.
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
-   *               where the TCP/IP read-ahead data is retained.
+   *               where the TCP/IP read-ahead data is retained.  It is
+   *               modified only in a critical section so that recvfrom()
+   *               can consume data without the network lock.
+   *   rdlock    - Serializes the receivers of the connection while one of
+   *               them copies data out of readahead.  The device path never
+   *               takes it.  Taken after net_lock() when both are needed.
    */
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
+  sem_t rdlock;                   /* Receivers' lock of readahead */
 #endif
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -1295,6 +1327,36 @@ struct socket;
 ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len);
 
+/****************************************************************************
+ * Name: psock_tcp_sendv
+ *
+ * Description:
+ *   Send the data gathered from the 'iovcnt' buffers described by 'iov' on
+ *   a connected TCP socket.  psock_tcp_sendv() is equivalent to
+ *   psock_tcp_send() on the concatenation of the buffers:  The data is
+ *   copied into a single write buffer and the network is locked once, so
+ *   the data is sent in as few segments as possible.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iov      Array of buffer descriptors
+ *   iovcnt   Number of elements in iov[]
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error, a
+ *   negated errno value is returned (see psock_tcp_send()).
+ *
+ * Assumptions:
+ *   Available only if CONFIG_NET_TCP_WRITE_BUFFERS is selected.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+struct iovec;
+ssize_t psock_tcp_sendv(FAR struct socket *psock,
+                        FAR const struct iovec *iov, int iovcnt);
+#endif
+
 /****************************************************************************
  * Name: tcp_setsockopt
  *
@@ -1432,7 +1494,8 @@ void tcp_wrbuffer_initialize(void);
  *   None
  *
  * Assumptions:
- *   Called from user logic with the network locked.
+ *   Called from user logic.  The network may or may not be locked; if it
+ *   is, it will be momentarily unlocked while waiting for a buffer.
  *
  ****************************************************************************/
 
@@ -1454,7 +1517,7 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void);
  *   None
  *
  * Assumptions:
- *   Called from user logic with the network locked.
+ *   Called from user logic.
  *
  ****************************************************************************/
 
@@ -1470,7 +1533,7 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void);
  *   buffered data.
  *
  * Assumptions:
- *   Called from network stack logic with the network stack locked
+ *   May be called with or without the network stack locked
  *
  ****************************************************************************/
 
@@ -43,6 +43,7 @@
 #include <string.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
@@ -246,6 +247,7 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t buflen)
 {
   FAR struct iob_s *iob;
+  irqstate_t flags;
   int ret;
 
   /* Try to allocate on I/O buffer to start the chain without waiting (and
@@ -275,10 +277,14 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
     }
 
   /* Add the new I/O buffer chain to the tail of the read-ahead queue (again
-   * without waiting).
+   * without waiting).  recvfrom() consumes the queue without the network
+   * locked, so the queue is only modified in a critical section.
    */
 
+  flags = enter_critical_section();
   ret = iob_tryadd_queue(iob, &conn->readahead);
+  leave_critical_section(flags);
+
   if (ret < 0)
     {
       nerr("ERROR: Failed to queue the I/O buffer chain: %d\n", ret);
@@ -55,6 +55,7 @@
 #include <arch/irq.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -92,10 +93,199 @@ static dq_queue_t g_active_tcp_connections;
 
 static uint16_t g_last_tcp_port;
 
+#ifdef CONFIG_NET_TCP_HASH
+/* Active connections hashed by local port, remote port and remote address */
+
+static FAR struct tcp_conn_s *g_tcp_conn_hash[CONFIG_NET_TCP_HASHSIZE];
+
+/* Allocated connections with a local port, hashed by the local port */
+
+static FAR struct tcp_conn_s *g_tcp_port_hash[CONFIG_NET_TCP_HASHSIZE];
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HASH
+static void tcp_hash_insert(FAR struct tcp_conn_s *conn);
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn);
+static void tcp_port_insert(FAR struct tcp_conn_s *conn);
+static void tcp_port_remove(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_hash_insert(conn)
+#  define tcp_hash_remove(conn)
+#  define tcp_port_insert(conn)
+#  define tcp_port_remove(conn)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hashkey
+ *
+ * Description:
+ *   Fold the local port, the remote port (both in network byte order) and
+ *   a 32-bit digest of the remote address into a connection hash bucket.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HASH
+static inline unsigned int tcp_hashkey(uint16_t lport, uint16_t rport,
+                                       uint32_t raddr)
+{
+  uint32_t hash = raddr ^ ((uint32_t)lport << 16) ^ rport;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return hash % CONFIG_NET_TCP_HASHSIZE;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_ipv6_digest
+ *
+ * Description:
+ *   Reduce an IPv6 address to 32-bits for tcp_hashkey().
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_HASH) && defined(CONFIG_NET_IPv6)
+static inline uint32_t tcp_ipv6_digest(const net_ipv6addr_t ipaddr)
+{
+  uint32_t digest = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      digest ^= ((uint32_t)ipaddr[i] << 16) | ipaddr[i + 1];
+    }
+
+  return digest;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_connhash
+ *
+ * Description:
+ *   Return the connection hash bucket of an active connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HASH
+static unsigned int tcp_connhash(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_hashkey(conn->lport, conn->rport,
+                         (uint32_t)conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_hashkey(conn->lport, conn->rport,
+                         tcp_ipv6_digest(conn->u.ipv6.raddr));
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_hash_insert and tcp_hash_remove
+ *
+ * Description:
+ *   Add or remove a connection to/from the connection hash.  This must be
+ *   done whenever a connection is added to or removed from the list of
+ *   active connections.  The port numbers and the remote address of the
+ *   connection may not change while it is in the hash.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HASH
+static void tcp_hash_insert(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **bucket = &g_tcp_conn_hash[tcp_connhash(conn)];
+
+  conn->hnext = *bucket;
+  *bucket     = conn;
+}
+
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **prev;
+
+  for (prev = &g_tcp_conn_hash[tcp_connhash(conn)];
+       *prev != NULL;
+       prev = &(*prev)->hnext)
+    {
+      if (*prev == conn)
+        {
+          *prev       = conn->hnext;
+          conn->hnext = NULL;
+          break;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_port_insert and tcp_port_remove
+ *
+ * Description:
+ *   Add or remove a connection to/from the local port hash.  A connection
+ *   is in the local port hash while it is allocated and has a non-zero
+ *   local port number so the local port must be removed before lport is
+ *   changed and re-inserted afterward.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HASH
+static void tcp_port_insert(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **bucket;
+
+  if (conn->lport != 0)
+    {
+      bucket      = &g_tcp_port_hash[TCP_PORT_HASH(conn->lport)];
+      conn->pnext = *bucket;
+      *bucket     = conn;
+    }
+}
+
+static void tcp_port_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **prev;
+
+  for (prev = &g_tcp_port_hash[TCP_PORT_HASH(conn->lport)];
+       *prev != NULL;
+       prev = &(*prev)->pnext)
+    {
+      if (*prev == conn)
+        {
+          *prev       = conn->pnext;
+          conn->pnext = NULL;
+          break;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -113,14 +303,21 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
                                                        uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
-  int i;
 
+#ifdef CONFIG_NET_TCP_HASH
+  /* Only the connections in the local port hash bucket can use this port */
+
+  for (conn = g_tcp_port_hash[TCP_PORT_HASH(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+#else
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+  for (conn = g_tcp_connections;
+       conn < &g_tcp_connections[CONFIG_NET_TCP_CONNS];
+       conn++)
+#endif
     {
-      conn = &g_tcp_connections[i];
-
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
        */
@@ -164,14 +361,21 @@ static inline FAR struct tcp_conn_s *
 tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
-  int i;
 
+#ifdef CONFIG_NET_TCP_HASH
+  /* Only the connections in the local port hash bucket can use this port */
+
+  for (conn = g_tcp_port_hash[TCP_PORT_HASH(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+#else
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+  for (conn = g_tcp_connections;
+       conn < &g_tcp_connections[CONFIG_NET_TCP_CONNS];
+       conn++)
+#endif
     {
-      conn = &g_tcp_connections[i];
-
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
        */
@@ -327,10 +531,18 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#ifdef CONFIG_NET_TCP_HASH
+  /* Only the connections in the hash bucket can match */
+
+  conn = g_tcp_conn_hash[tcp_hashkey(tcp->destport, tcp->srcport,
+                                     (uint32_t)srcipaddr)];
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -366,7 +578,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -394,10 +610,18 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#ifdef CONFIG_NET_TCP_HASH
+  /* Only the connections in the hash bucket can match */
+
+  conn = g_tcp_conn_hash[tcp_hashkey(tcp->destport, tcp->srcport,
+                                     tcp_ipv6_digest(*srcipaddr))];
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -433,7 +657,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -479,6 +707,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
+  tcp_port_remove(conn);
   conn->lport = htons(port);
   net_ipv4addr_copy(conn->u.ipv4.laddr, addr->sin_addr.s_addr);
 
@@ -500,6 +729,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
       return ret;
     }
 
+  tcp_port_insert(conn);
   net_unlock();
   return OK;
 }
@@ -546,6 +776,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
+  tcp_port_remove(conn);
   conn->lport = htons(port);
   net_ipv6addr_copy(conn->u.ipv6.laddr, addr->sin6_addr.in6_u.u6_addr16);
 
@@ -567,6 +798,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
       return ret;
     }
 
+  tcp_port_insert(conn);
   net_unlock();
   return OK;
 }
@@ -714,6 +946,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
     {
       memset(conn, 0, sizeof(struct tcp_conn_s));
       conn->tcpstateflags = TCP_ALLOCATED;
+#ifdef CONFIG_NET_TCP_READAHEAD
+      nxsem_init(&conn->rdlock, 0, 1);
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       conn->domain        = domain;
 #endif
@@ -772,8 +1007,13 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+      tcp_hash_remove(conn);
     }
 
+  /* Release the local port number */
+
+  tcp_port_remove(conn);
+
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Release any read-ahead buffers attached to the connection */
 
@@ -1035,6 +1275,8 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+      tcp_port_insert(conn);
+      tcp_hash_insert(conn);
     }
 
   return conn;
@@ -1246,7 +1488,10 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->rto        = TCP_RTO;
   conn->sa         = 0;
   conn->sv         = 16;   /* Initial value of the RTT variance. */
+
+  tcp_port_remove(conn);
   conn->lport      = htons((uint16_t)port);
+  tcp_port_insert(conn);
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
   conn->isn        = 0;
@@ -1270,6 +1515,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+  tcp_hash_insert(conn);
   ret = OK;
 
 errout_with_lock:
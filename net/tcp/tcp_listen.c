@@ -58,9 +58,19 @@
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_HASH
+/* The tcp_listenhash table holds all currently listening connections,
+ * hashed by the local port number and linked through lnext.
+ * tcp_nlisteners is the number of listeners in the table.
+ */
+
+static FAR struct tcp_conn_s *tcp_listenhash[CONFIG_NET_TCP_HASHSIZE];
+static int tcp_nlisteners;
+#else
 /* The tcp_listenports list all currently listening ports. */
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -83,17 +93,30 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno, uint8_t domain)
 FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 #endif
 {
+  FAR struct tcp_conn_s *conn;
+#ifndef CONFIG_NET_TCP_HASH
   int ndx;
+#endif
+
+#ifdef CONFIG_NET_TCP_HASH
+  /* Examine each listener in the hash bucket of the port */
 
+  for (conn = tcp_listenhash[TCP_PORT_HASH(portno)];
+       conn != NULL;
+       conn = conn->lnext)
+#else
   /* Examine each connection structure in each slot of the listener list */
 
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+#endif
     {
       /* Is this slot assigned?  If so, does the connection have the same
        * local port number?
        */
 
-      FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+#ifndef CONFIG_NET_TCP_HASH
+      conn = tcp_listenports[ndx];
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       if (conn && conn->lport == portno && conn->domain == domain)
 #else
@@ -130,10 +153,20 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 void tcp_listen_initialize(void)
 {
   int ndx;
+
+#ifdef CONFIG_NET_TCP_HASH
+  for (ndx = 0; ndx < CONFIG_NET_TCP_HASHSIZE; ndx++)
+    {
+      tcp_listenhash[ndx] = NULL;
+    }
+
+  tcp_nlisteners = 0;
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       tcp_listenports[ndx] = NULL;
     }
+#endif
 }
 
 /****************************************************************************
@@ -149,10 +182,29 @@ void tcp_listen_initialize(void)
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_HASH
+  FAR struct tcp_conn_s **prev;
+#else
   int ndx;
+#endif
   int ret = -EINVAL;
 
   net_lock();
+#ifdef CONFIG_NET_TCP_HASH
+  for (prev = &tcp_listenhash[TCP_PORT_HASH(conn->lport)];
+       *prev != NULL;
+       prev = &(*prev)->lnext)
+    {
+      if (*prev == conn)
+        {
+          *prev       = conn->lnext;
+          conn->lnext = NULL;
+          tcp_nlisteners--;
+          ret = OK;
+          break;
+        }
+    }
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       if (tcp_listenports[ndx] == conn)
@@ -162,6 +214,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
           break;
         }
     }
+#endif
 
   net_unlock();
   return ret;
@@ -180,7 +233,11 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_HASH
+  FAR struct tcp_conn_s **bucket;
+#else
   int ndx;
+#endif
   int ret;
 
   /* This must be done with network locked because the listener table
@@ -209,6 +266,20 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
       ret = -ENOBUFS; /* Assume failure */
 
+#ifdef CONFIG_NET_TCP_HASH
+      /* Add the connection to the hash bucket of its port unless the
+       * maximum number of listeners has been reached.
+       */
+
+      if (tcp_nlisteners < CONFIG_NET_MAX_LISTENPORTS)
+        {
+          bucket      = &tcp_listenhash[TCP_PORT_HASH(conn->lport)];
+          conn->lnext = *bucket;
+          *bucket     = conn;
+          tcp_nlisteners++;
+          ret = OK;
+        }
+#else
       /* Search all slots until an available slot is found */
 
       for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
@@ -224,6 +295,7 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               break;
             }
         }
+#endif
     }
 
   net_unlock();
@@ -44,6 +44,7 @@
 #include <poll.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/mm/iob.h>
@@ -152,7 +153,7 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           info->cb->event   = NULL;
 
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_post(info->fds);
         }
     }
 
@@ -208,7 +209,7 @@ static inline void tcp_iob_work(FAR void *arg)
            */
 
           fds->revents |= (POLLERR | POLLHUP);
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
     }
 
@@ -226,7 +227,7 @@ static inline void tcp_iob_work(FAR void *arg)
           /* Yes.. then signal the poll logic */
 
           fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_post(fds);
         }
       else
         {
@@ -449,7 +450,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_post(fds);
     }
 
 #if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
@@ -52,6 +52,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -1013,11 +1014,43 @@ static inline void send_txnotify(FAR struct socket *psock,
 
 ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len)
+{
+  struct iovec iov;
+
+  iov.iov_base = (FAR void *)buf;
+  iov.iov_len  = len;
+
+  return psock_tcp_sendv(psock, &iov, 1);
+}
+
+/****************************************************************************
+ * Name: psock_tcp_sendv
+ *
+ * Description:
+ *   Send the data gathered from the 'iovcnt' buffers described by 'iov' on
+ *   a connected TCP socket.  All of the data is copied into one write
+ *   buffer which is queued with a single acquisition of the network lock.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iov      Array of buffer descriptors
+ *   iovcnt   Number of elements in iov[]
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error, a
+ *   negated errno value is returned (see psock_tcp_send()).
+ *
+ ****************************************************************************/
+
+ssize_t psock_tcp_sendv(FAR struct socket *psock,
+                        FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
   ssize_t    result = 0;
+  size_t     len;
   int        ret = OK;
+  int        i;
 
   if (psock == NULL || psock->s_crefs <= 0)
     {
@@ -1071,9 +1104,12 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
-  /* Dump the incoming buffer */
+  /* Get the total size of the data to be sent */
 
-  BUF_DUMP("psock_tcp_send", buf, len);
+  for (i = 0, len = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
 
   /* Set the socket state to sending */
 
@@ -1081,11 +1117,13 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   if (len > 0)
     {
-      /* Allocate a write buffer.  Careful, the network will be momentarily
-       * unlocked here.
+      /* Allocate a write buffer and copy the user data into it before
+       * locking the network.  The write buffer is not visible to the
+       * network until it is added to the write queue so the possibly long
+       * copy, and any wait for free I/O buffers, does not hold off the
+       * network or other sockets.
        */
 
-      net_lock();
       if (_SS_ISNONBLOCK(psock->s_flags))
         {
           wrb = tcp_wrbuffer_tryalloc();
@@ -1101,11 +1139,78 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
           nerr("ERROR: Failed to allocate write buffer\n");
           ret = _SS_ISNONBLOCK(psock->s_flags) ? -EAGAIN : -ENOMEM;
-          goto errout_with_lock;
+          goto errout;
+        }
+
+      /* Initialize the write buffer */
+
+      TCP_WBSEQNO(wrb) = (unsigned)-1;
+      TCP_WBNRTX(wrb)  = 0;
+
+      /* Copy the user data into the write buffer.  We cannot wait for
+       * buffer space if the socket was opened non-blocking.  Each part of
+       * the user data is appended to the same I/O buffer chain so that the
+       * data is sent as one stream of segments.
+       */
+
+      for (i = 0; i < iovcnt; i++)
+        {
+          if (iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          /* Dump the incoming buffer */
+
+          BUF_DUMP("psock_tcp_sendv", iov[i].iov_base, iov[i].iov_len);
+
+          if (_SS_ISNONBLOCK(psock->s_flags))
+            {
+              result = TCP_WBTRYCOPYIN(wrb, (FAR uint8_t *)iov[i].iov_base,
+                                       iov[i].iov_len, TCP_WBPKTLEN(wrb));
+            }
+          else
+            {
+              result = TCP_WBCOPYIN(wrb, (FAR uint8_t *)iov[i].iov_base,
+                                    iov[i].iov_len, TCP_WBPKTLEN(wrb));
+            }
+
+          if (result < 0)
+            {
+              break;
+            }
         }
 
+      /* The return value from TCP_WBTRYCOPYIN is -ENOMEM if less than the
+       * entire data chunk could be allocated.  If at least a part of the
+       * data was copied, we return that number and let the caller deal
+       * with sending the remaining data.
+       */
+
+      if (result < 0)
+        {
+          if (TCP_WBPKTLEN(wrb) > 0)
+            {
+              ninfo("INFO: Allocated part of the requested data\n");
+            }
+          else
+            {
+              nerr("ERROR: Failed to add data to the I/O buffer chain\n");
+              ret = _SS_ISNONBLOCK(psock->s_flags) ? -EWOULDBLOCK :
+                                                     (int)result;
+              goto errout_with_wrb;
+            }
+        }
+
+      result = TCP_WBPKTLEN(wrb);
+
+      /* Dump I/O buffer chain */
+
+      TCP_WBDUMP("I/O buffer chain", wrb, TCP_WBPKTLEN(wrb), 0);
+
       /* Allocate resources to receive a callback */
 
+      net_lock();
       if (psock->s_sndcb == NULL)
         {
           psock->s_sndcb = tcp_callback_alloc(conn);
@@ -1119,7 +1224,7 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
           nerr("ERROR: Failed to allocate callback\n");
           ret = _SS_ISNONBLOCK(psock->s_flags) ? -EAGAIN : -ENOMEM;
-          goto errout_with_wrb;
+          goto errout_with_lock;
         }
 
       /* Set up the callback in the connection */
@@ -1129,54 +1234,6 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       psock->s_sndcb->priv  = (FAR void *)psock;
       psock->s_sndcb->event = psock_send_eventhandler;
 
-      /* Initialize the write buffer */
-
-      TCP_WBSEQNO(wrb) = (unsigned)-1;
-      TCP_WBNRTX(wrb)  = 0;
-
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
-       */
-
-      if (_SS_ISNONBLOCK(psock->s_flags))
-        {
-          /* The return value from TCP_WBTRYCOPYIN is either OK or
-           * -ENOMEM if less than the entire data chunk could be allocated.
-           * If -ENOMEM is returned, check if at least a part of the data
-           * chunk was allocated. If more than zero bytes were sent
-           * we return that number and let the caller deal with sending the
-           * remaining data.
-           */
-
-          result = TCP_WBTRYCOPYIN(wrb, (FAR uint8_t *)buf, len);
-          if (result == -ENOMEM)
-            {
-              if (TCP_WBPKTLEN(wrb) > 0)
-                {
-                  ninfo("INFO: Allocated part of the requested data\n");
-                  result = TCP_WBPKTLEN(wrb);
-                }
-              else
-                {
-                  nerr("ERROR: Failed to add data to the I/O buffer chain\n");
-                  ret = -EWOULDBLOCK;
-                  goto errout_with_wrb;
-                }
-            }
-          else
-            {
-              result = len;
-            }
-        }
-      else
-        {
-          result = TCP_WBCOPYIN(wrb, (FAR uint8_t *)buf, len);
-        }
-
-      /* Dump I/O buffer chain */
-
-      TCP_WBDUMP("I/O buffer chain", wrb, TCP_WBPKTLEN(wrb), 0);
-
       /* psock_send_eventhandler() will send data in FIFO order from the
        * conn->write_q
        */
@@ -1215,12 +1272,12 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   return result;
 
-errout_with_wrb:
-  tcp_wrbuffer_release(wrb);
-
 errout_with_lock:
   net_unlock();
 
+errout_with_wrb:
+  tcp_wrbuffer_release(wrb);
+
 errout:
   return ret;
 }
@@ -44,6 +44,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/ioctl.h>
 
 #include <fcntl.h>
 #include <stdint.h>
@@ -99,6 +100,9 @@ struct sendfile_s
   FAR struct devif_callback_s *snd_datacb; /* Data callback */
   FAR struct devif_callback_s *snd_ackcb;  /* ACK callback */
   FAR struct file   *snd_file;    /* File structure of the input file */
+#ifdef CONFIG_NET_SENDFILE_MMAP
+  bool               snd_memseg;  /* File data is directly accessible */
+#endif
   sem_t              snd_sem;     /* Used to wake up the waiting thread */
   off_t              snd_foffset; /* Input file offset */
   size_t             snd_flen;    /* File length */
@@ -179,7 +183,7 @@ static uint16_t ack_eventhandler(FAR struct net_driver_s *dev,
       if (IFF_IS_IPv6(dev->d_flags))
 #endif
         {
-          DEBUGASSERT(pstate->snd_sock == PF_INET6);
+          DEBUGASSERT(pstate->snd_sock->s_domain == PF_INET6);
           tcp = TCPIPv6BUF;
         }
 #endif /* CONFIG_NET_IPv6 */
@@ -189,7 +193,7 @@ static uint16_t ack_eventhandler(FAR struct net_driver_s *dev,
       else
 #endif
         {
-          DEBUGASSERT(pstate->snd_sock == PF_INET);
+          DEBUGASSERT(pstate->snd_sock->s_domain == PF_INET);
           tcp = TCPIPv4BUF;
         }
 #endif /* CONFIG_NET_IPv4 */
@@ -318,9 +322,114 @@ static inline bool sendfile_addrcheck(FAR struct tcp_conn_s *conn)
 }
 
 #else /* CONFIG_NET_ETHERNET */
-#  sendfile_addrcheck(r) (true)
+#  define sendfile_addrcheck(r) (true)
 #endif /* CONFIG_NET_ETHERNET */
 
+/****************************************************************************
+ * Name: sendfile_memseg
+ *
+ * Description:
+ *   Check if the file data is directly accessible in memory with
+ *   FIOC_MEMSEG.  If so, the count is clipped to the end of the file.  No
+ *   reference is taken on the file data and nothing is copied.
+ *
+ * Input Parameters:
+ *   infile - The input file
+ *   offset - The file offset of the first byte to send
+ *   count  - The number of bytes to send.  Updated on return.
+ *
+ * Returned Value:
+ *   True if the file data can be copied with sendfile_memcopy().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_MMAP
+static bool sendfile_memseg(FAR struct file *infile, off_t offset,
+                            FAR size_t *count)
+{
+  struct fioc_memseg_s seg;
+  struct stat buf;
+  int ret;
+
+  seg.ms_offset = offset;
+  ret = file_ioctl(infile, FIOC_MEMSEG, (unsigned long)((uintptr_t)&seg));
+  if (ret < 0 && ret != -ENXIO)
+    {
+      return false;
+    }
+
+  ret = file_fstat(infile, &buf);
+  if (ret < 0)
+    {
+      return false;
+    }
+
+  if (offset >= buf.st_size)
+    {
+      *count = 0;
+    }
+  else if (*count > buf.st_size - offset)
+    {
+      *count = buf.st_size - offset;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: sendfile_memcopy
+ *
+ * Description:
+ *   Copy file data into the packet buffer directly from the memory that
+ *   holds it, one contiguous segment at a time.
+ *
+ * Input Parameters:
+ *   infile - The input file
+ *   offset - The file offset of the first byte to copy
+ *   dest   - The packet buffer
+ *   len    - The number of bytes to copy
+ *
+ * Returned Value:
+ *   The number of bytes copied or a negated errno value if some of the
+ *   data is not directly accessible.
+ *
+ ****************************************************************************/
+
+static ssize_t sendfile_memcopy(FAR struct file *infile, off_t offset,
+                                FAR uint8_t *dest, size_t len)
+{
+  struct fioc_memseg_s seg;
+  size_t ncopied;
+  size_t ncopy;
+  int ret;
+
+  for (ncopied = 0; ncopied < len; ncopied += ncopy)
+    {
+      seg.ms_offset = offset + ncopied;
+      ret = file_ioctl(infile, FIOC_MEMSEG,
+                       (unsigned long)((uintptr_t)&seg));
+      if (ret < 0)
+        {
+          return ret;
+        }
+      else if (seg.ms_length == 0)
+        {
+          return -EIO;
+        }
+
+      ncopy = len - ncopied;
+      if (ncopy > seg.ms_length)
+        {
+          ncopy = seg.ms_length;
+        }
+
+      memcpy(&dest[ncopied], seg.ms_addr, ncopy);
+    }
+
+  return ncopied;
+}
+#endif
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -418,21 +527,40 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
-          if (ret < 0)
+#ifdef CONFIG_NET_SENDFILE_MMAP
+          /* Copy the data directly from the file's memory if we can.  If
+           * not (for example, a hole in a TMPFS file), read it instead.
+           */
+
+          ret = -ENOTTY;
+          if (pstate->snd_memseg)
             {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
+              ret = sendfile_memcopy(pstate->snd_file,
+                                     pstate->snd_foffset + pstate->snd_sent,
+                                     dev->d_appdata, sndlen);
             }
 
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
           if (ret < 0)
+#endif
             {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
+              ret = file_seek(pstate->snd_file,
+                              pstate->snd_foffset + pstate->snd_sent,
+                              SEEK_SET);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to lseek: %d\n", ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
+
+              ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to read from input file: %d\n",
+                       (int)ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
             }
 
           dev->d_sndlen = sndlen;
@@ -585,6 +713,9 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+#ifdef CONFIG_NET_SENDFILE_MMAP
+  bool memseg;
+#endif
   int ret;
 
   /* If this is an un-connected socket, then return ENOTCONN */
@@ -631,6 +762,16 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
+#ifdef CONFIG_NET_SENDFILE_MMAP
+  /* If the file data is in memory, then we can send it from there */
+
+  memseg = sendfile_memseg(infile, offset ? *offset : 0, &count);
+  if (memseg && count == 0)
+    {
+      return 0;
+    }
+#endif
+
   /* Set the socket state to sending */
 
   psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_SEND);
@@ -654,6 +795,9 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_foffset = offset ? *offset : 0; /* Input file offset */
   state.snd_flen    = count;                /* Number of bytes to send */
   state.snd_file    = infile;               /* File to read from */
+#ifdef CONFIG_NET_SENDFILE_MMAP
+  state.snd_memseg  = memseg;               /* Copy from file memory */
+#endif
 
   /* Allocate resources to receive a callback */
 
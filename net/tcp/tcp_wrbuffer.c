@@ -54,6 +54,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
@@ -75,7 +76,11 @@ struct wrbuffer_s
 
   sem_t sem;
 
-  /* This is the list of available write buffers */
+  /* This is the list of available write buffers.  Write buffers are
+   * allocated by user logic without the network locked and released from
+   * the network event handlers so the list is modified only within a
+   * critical section.
+   */
 
   sq_queue_t freebuffers;
 
@@ -92,6 +97,33 @@ struct wrbuffer_s
 
 static struct wrbuffer_s g_wrbuffer;
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_wrbuffer_remfirst
+ *
+ * Description:
+ *   Remove a write buffer structure, reserved by taking the semaphore, from
+ *   the free list and initialize it.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_wrbuffer_s *tcp_wrbuffer_remfirst(void)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  wrb   = (FAR struct tcp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
+  leave_critical_section(flags);
+
+  DEBUGASSERT(wrb);
+  memset(wrb, 0, sizeof(struct tcp_wrbuffer_s));
+  return wrb;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -133,7 +165,8 @@ void tcp_wrbuffer_initialize(void)
  *   None
  *
  * Assumptions:
- *   Called from user logic with the network locked.
+ *   Called from user logic.  The network may or may not be locked; if it
+ *   is, it will be momentarily unlocked while waiting for a buffer.
  *
  ****************************************************************************/
 
@@ -155,9 +188,7 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void)
    * for us in the free list.
    */
 
-  wrb = (FAR struct tcp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
-  DEBUGASSERT(wrb);
-  memset(wrb, 0, sizeof(struct tcp_wrbuffer_s));
+  wrb = tcp_wrbuffer_remfirst();
 
   /* Now get the first I/O buffer for the write buffer structure */
 
@@ -190,8 +221,7 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void)
  *   None
  *
  * Assumptions:
- *   Called from user logic with the network locked. Will return if no buffer
- *   is available.
+ *   Called from user logic.  Will return if no buffer is available.
  *
  ****************************************************************************/
 
@@ -220,9 +250,7 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void)
    * for us in the free list.
    */
 
-  wrb = (FAR struct tcp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
-  DEBUGASSERT(wrb);
-  memset(wrb, 0, sizeof(struct tcp_wrbuffer_s));
+  wrb = tcp_wrbuffer_remfirst();
 
   /* Now get the first I/O buffer for the write buffer structure */
 
@@ -246,12 +274,14 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void)
  *   buffered data.
  *
  * Assumptions:
- *   This function must be called with the network locked.
+ *   None.  This function may be called with or without the network locked.
  *
  ****************************************************************************/
 
 void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb)
 {
+  irqstate_t flags;
+
   DEBUGASSERT(wrb != NULL);
 
   /* To avoid deadlocks, we must following this ordering:  Release the I/O
@@ -265,7 +295,10 @@ void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb)
 
   /* Then free the write buffer structure */
 
+  flags = enter_critical_section();
   sq_addlast(&wrb->wb_node, &g_wrbuffer.freebuffers);
+  leave_critical_section(flags);
+
   nxsem_post(&g_wrbuffer.sem);
 }
 
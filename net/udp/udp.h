@@ -93,8 +93,19 @@
 /* Definitions for the UDP connection struct flag field */
 
 #define _UDP_FLAG_CONNECTMODE (1 << 0) /* Bit 0:  UDP connection-mode */
+#define _UDP_FLAG_REUSEPORT   (1 << 1) /* Bit 1:  Bound with SO_REUSEPORT */
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
+#define _UDP_ISREUSEPORT(f)   (((f) & _UDP_FLAG_REUSEPORT) != 0)
+
+#ifdef CONFIG_NET_UDP_HASH
+/* Hash a local port number (in network byte order) into a bucket of the
+ * local port hash table.
+ */
+
+#  define UDP_PORT_HASH(p) \
+     ((unsigned int)((p) ^ ((p) >> 8)) % CONFIG_NET_UDP_HASHSIZE)
+#endif
 
 /****************************************************************************
  * Public Type Definitions
@@ -121,11 +132,21 @@ struct udp_conn_s
                            * Unbound: 0, Bound: 1-MAX_IFINDEX */
 #endif
 
+#ifdef CONFIG_NET_UDP_HASH
+  /* The next connection in the same bucket of the local port hash.  All
+   * allocated connections with a non-zero lport are in the hash.
+   */
+
+  FAR struct udp_conn_s *pnext;
+#endif
+
 #ifdef CONFIG_NET_UDP_READAHEAD
   /* Read-ahead buffering.
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
-   *               where the UDP/IP read-ahead data is retained.
+   *               where the UDP/IP read-ahead data is retained.  It is
+   *               modified only in a critical section so that recvfrom()
+   *               can take a datagram without the network lock.
    */
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
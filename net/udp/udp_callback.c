@@ -44,6 +44,7 @@
 #include <string.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/netstats.h>
@@ -80,6 +81,7 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev, FAR struct udp_con
                                 FAR uint8_t *buffer, uint16_t buflen)
 {
   FAR struct iob_s *iob;
+  irqstate_t flags;
   int ret;
 #ifdef CONFIG_NET_IPv6
   FAR struct sockaddr_in6 src_addr6;
@@ -214,9 +216,15 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev, FAR struct udp_con
         }
     }
 
-  /* Add the new I/O buffer chain to the tail of the read-ahead queue */
+  /* Add the new I/O buffer chain to the tail of the read-ahead queue.
+   * recvfrom() takes datagrams from the queue without the network locked,
+   * so the queue is only modified in a critical section.
+   */
 
+  flags = enter_critical_section();
   ret = iob_tryadd_queue(iob, &conn->readahead);
+  leave_critical_section(flags);
+
   if (ret < 0)
     {
       nerr("ERROR: Failed to queue the I/O buffer chain: %d\n", ret);
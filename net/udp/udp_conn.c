@@ -45,6 +45,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_UDP)
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -73,6 +74,18 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_REUSEPORT
+/* Tests if a connection will accept the UDP datagram in the device buffer */
+
+typedef CODE bool (*udp_match_t)(FAR struct net_driver_s *dev,
+                                 FAR struct udp_hdr_s *udp,
+                                 FAR struct udp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,6 +107,24 @@ static dq_queue_t g_active_udp_connections;
 
 static uint16_t g_last_udp_port;
 
+#ifdef CONFIG_NET_UDP_HASH
+/* Allocated connections with a local port, hashed by the local port */
+
+static FAR struct udp_conn_s *g_udp_port_hash[CONFIG_NET_UDP_HASHSIZE];
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_HASH
+static void udp_port_insert(FAR struct udp_conn_s *conn);
+static void udp_port_remove(FAR struct udp_conn_s *conn);
+#else
+#  define udp_port_insert(conn)
+#  define udp_port_remove(conn)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -126,11 +157,178 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: udp_port_insert and udp_port_remove
+ *
+ * Description:
+ *   Add or remove a connection to/from the local port hash.  A connection
+ *   is in the local port hash while it is allocated and has a non-zero
+ *   local port number so the connection must be removed before lport is
+ *   changed and re-inserted afterward.  Connections are added at the end of
+ *   the hash chain so that the chain, like the list of active connections,
+ *   is searched in the order in which the ports were bound.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_HASH
+static void udp_port_insert(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **next;
+
+  if (conn->lport != 0)
+    {
+      for (next = &g_udp_port_hash[UDP_PORT_HASH(conn->lport)];
+           *next != NULL;
+           next = &(*next)->pnext);
+
+      conn->pnext = NULL;
+      *next       = conn;
+    }
+}
+
+static void udp_port_remove(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **prev;
+
+  for (prev = &g_udp_port_hash[UDP_PORT_HASH(conn->lport)];
+       *prev != NULL;
+       prev = &(*prev)->pnext)
+    {
+      if (*prev == conn)
+        {
+          *prev       = conn->pnext;
+          conn->pnext = NULL;
+          break;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_portlist and udp_portnext
+ *
+ * Description:
+ *   Traverse the connections that may be bound to a local port:  Only the
+ *   connections in the same bucket of the local port hash or, without the
+ *   hash, all of the active connections.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static inline FAR struct udp_conn_s *udp_portlist(uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_HASH
+  return g_udp_port_hash[UDP_PORT_HASH(portno)];
+#else
+  return (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
+}
+
+#ifdef CONFIG_NET_UDP_HASH
+#  define udp_portnext(conn) ((conn)->pnext)
+#else
+#  define udp_portnext(conn) ((FAR struct udp_conn_s *)(conn)->node.flink)
+#endif
+
+/****************************************************************************
+ * Name: udp_ipv6_digest
+ *
+ * Description:
+ *   Reduce an IPv6 address to 32-bits for udp_reuseport_select().
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_REUSEPORT) && defined(CONFIG_NET_IPv6)
+static inline uint32_t udp_ipv6_digest(const net_ipv6addr_t ipaddr)
+{
+  uint32_t digest = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      digest ^= ((uint32_t)ipaddr[i] << 16) | ipaddr[i + 1];
+    }
+
+  return digest;
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   Several connections with SO_REUSEPORT may accept the datagram.  Select
+ *   one of them using a hash of the source address and port of the
+ *   datagram so that all datagrams from one peer go to the same socket.
+ *
+ * Input Parameters:
+ *   dev     - The device with the UDP datagram
+ *   udp     - The UDP header of the datagram
+ *   first   - The first connection that accepts the datagram
+ *   match   - The IPv4 or IPv6 match function
+ *   srcaddr - A 32-bit digest of the source IP address of the datagram
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_REUSEPORT
+static FAR struct udp_conn_s *
+  udp_reuseport_select(FAR struct net_driver_s *dev,
+                       FAR struct udp_hdr_s *udp,
+                       FAR struct udp_conn_s *first, udp_match_t match,
+                       uint32_t srcaddr)
+{
+  FAR struct udp_conn_s *conn;
+  uint32_t hash;
+  int nconns = 0;
+  int select;
+
+  /* Count the connections that share the port and accept the datagram */
+
+  for (conn = first; conn != NULL; conn = udp_portnext(conn))
+    {
+      if (_UDP_ISREUSEPORT(conn->flags) && match(dev, udp, conn))
+        {
+          nconns++;
+        }
+    }
+
+  /* Mix the source address and port so that consecutive addresses or
+   * ports do not all map to the same socket.
+   */
+
+  hash    = srcaddr ^ udp->srcport;
+  hash   ^= hash >> 16;
+  hash   *= 0x45d9f3b;
+  hash   ^= hash >> 16;
+  select  = (int)(hash % (uint32_t)nconns);
+
+  for (conn = first; conn != NULL; conn = udp_portnext(conn))
+    {
+      if (_UDP_ISREUSEPORT(conn->flags) && match(dev, udp, conn) &&
+          select-- == 0)
+        {
+          break;
+        }
+    }
+
+  return conn;
+}
+#endif
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
  * Description:
- *   Find the UDP connection that uses this local port number.
+ *   Find the UDP connection that uses this local port number.  If
+ *   reuseport is true, connections bound with SO_REUSEPORT are ignored.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -139,16 +337,24 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             FAR union ip_binding_u *ipaddr,
-                                            uint16_t portno)
+                                            uint16_t portno, bool reuseport)
 {
   FAR struct udp_conn_s *conn;
-  int i;
 
-  /* Now search each connection structure. */
+  /* Now search each connection structure that may use this port. */
 
-  for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
+  for (conn = udp_portlist(portno);
+       conn != NULL;
+       conn = udp_portnext(conn))
     {
-      conn = &g_udp_connections[i];
+#ifdef CONFIG_NET_UDP_REUSEPORT
+      /* The port may be shared by sockets that all set SO_REUSEPORT */
+
+      if (reuseport && _UDP_ISREUSEPORT(conn->flags))
+        {
+          continue;
+        }
+#endif
 
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -232,7 +438,7 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
           g_last_udp_port = 4096;
         }
     }
-  while (udp_find_conn(domain, u, htons(g_last_udp_port)) != NULL);
+  while (udp_find_conn(domain, u, htons(g_last_udp_port), false) != NULL);
 
   /* Initialize and return the connection structure, bind it to the
    * port number
@@ -245,11 +451,11 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
 }
 
 /****************************************************************************
- * Name: udp_ipv4_active
+ * Name: udp_ipv4_match
  *
  * Description:
- *   Find a connection structure that is the appropriate connection to be
- *   used within the provided UDP header
+ *   Check if a connection should accept the UDP datagram in the device
+ *   buffer.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -257,137 +463,124 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
-static inline FAR struct udp_conn_s *
-  udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+static bool udp_ipv4_match(FAR struct net_driver_s *dev,
+                           FAR struct udp_hdr_s *udp,
+                           FAR struct udp_conn_s *conn)
 {
 #ifdef CONFIG_NET_BROADCAST
   static const in_addr_t bcast = INADDR_BROADCAST;
 #endif
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
-  FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
-  while (conn)
-    {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *   - The local port number is checked against the destination port
-       *     number in the received packet.
-       *   - If multiple network interfaces are supported, then the local
-       *     IP address is available and we will insist that the
-       *     destination IP matches the bound address (or the destination
-       *     IP address is a broadcast address). If a socket is bound to
-       *     INADDRY_ANY (laddr), then it should receive all packets
-       *     directed to the port.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *   - The remote port number is checked if the connection is bound
-       *     to a remote port.
-       *   - Finally, if the connection is bound to a remote IP address,
-       *     the source IP address of the packet is checked. Broadcast
-       *     addresses are also accepted.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVIST: SO_BROADCAST flag is currently ignored.
-       */
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *   - The local port number is checked against the destination port
+   *     number in the received packet.
+   *   - If multiple network interfaces are supported, then the local
+   *     IP address is available and we will insist that the
+   *     destination IP matches the bound address (or the destination
+   *     IP address is a broadcast address). If a socket is bound to
+   *     INADDRY_ANY (laddr), then it should receive all packets
+   *     directed to the port.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *   - The remote port number is checked if the connection is bound
+   *     to a remote port.
+   *   - Finally, if the connection is bound to a remote IP address,
+   *     the source IP address of the packet is checked. Broadcast
+   *     addresses are also accepted.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVIST: SO_BROADCAST flag is currently ignored.
+   */
 
-      /* Check that there is a local port number and this is matches
-       * the port number in the destination address.
-       */
+  /* Check that there is a local port number and this is matches
+   * the port number in the destination address.
+   */
 
-      if (conn->lport != 0 && udp->destport == conn->lport &&
+  if (conn->lport != 0 && udp->destport == conn->lport &&
 
-          /* Local port accepts any address on this port or there
-           * is an exact match in destipaddr and the bound local
-           * address.  This catches the receipt of a broadcast when
-           * the socket is bound to INADDR_ANY.
-           */
+      /* Local port accepts any address on this port or there
+       * is an exact match in destipaddr and the bound local
+       * address.  This catches the receipt of a broadcast when
+       * the socket is bound to INADDR_ANY.
+       */
 
-          (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
-           net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+      (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
+       net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+    {
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
+       */
+
+      if (_UDP_ISCONNECTMODE(conn->flags))
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
-
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+          if ((conn->rport == 0 || udp->srcport == conn->rport) &&
 
-              /* If (1) not connected to a remote address, or (2) a
-               * broadcast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+          /* If (1) not connected to a remote address, or (2) a
+           * broadcast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
+           */
 
-                  (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
+              (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
 #ifdef CONFIG_NET_BROADCAST
-                   net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
+               net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
 #endif
-                   net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr)))
-                {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
-
-                  break;
-                }
-            }
-          else
+               net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr)))
             {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
+              /* Matching connection found */
 
-              break;
+              return true;
             }
         }
+      else
+        {
+          /* This UDP socket is not connected.  We need to match only
+           * the destination address with the bound socket address.
+           */
 
-      /* Look at the next active connection */
-
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+          return true;
+        }
     }
 
-  return conn;
+  return false;
 }
-#endif /* CONFIG_NET_IPv4 */
 
 /****************************************************************************
- * Name: udp_ipv6_active
+ * Name: udp_ipv4_active
  *
  * Description:
  *   Find a connection structure that is the appropriate connection to be
@@ -398,126 +591,195 @@ static inline FAR struct udp_conn_s *
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_IPv6
 static inline FAR struct udp_conn_s *
-  udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+  udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
 {
-  FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
-  while (conn != NULL)
+  for (conn = udp_portlist(udp->destport);
+       conn != NULL;
+       conn = udp_portnext(conn))
     {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *    - The local port number is checked against the destination port
-       *      number in the received packet.
-       *    - If multiple network interfaces are supported, then the local
-       *      IP address is available and we will insist that the
-       *      destination IP matches the bound address. If a socket is bound
-       *      to INADDR6_ANY (laddr), then it should receive all packets
-       *      directed to the port. REVISIT: Should also depend on SO_BROADCAST.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *    - The remote port number is checked if the connection is bound
-       *      to a remote port.
-       *    - Finally, if the connection is bound to a remote IP address,
-       *      the source IP address of the packet is checked.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVIST: SO_BROADCAST flag is currently ignored.
-       */
+      if (udp_ipv4_match(dev, udp, conn))
+        {
+#ifdef CONFIG_NET_UDP_REUSEPORT
+          if (_UDP_ISREUSEPORT(conn->flags))
+            {
+              FAR struct ipv4_hdr_s *ip = IPv4BUF;
 
-      /* Check that there is a local port number and this is matches
-       * the port number in the destination address.
-       */
+              conn = udp_reuseport_select(dev, udp, conn, udp_ipv4_match,
+                                          net_ip4addr_conv32(ip->srcipaddr));
+            }
+#endif
 
-      if ((conn->lport != 0 && udp->destport == conn->lport &&
+          break;
+        }
+    }
 
-          /* Check if the local port accepts any address on this port or
-           * that there is an exact match between the destipaddr and the
-           * bound local address.  This catches the case of the all nodes
-           * multicast when the socket is bound to the IPv6 unspecified
-           * address.
-           */
+  return conn;
+}
+#endif /* CONFIG_NET_IPv4 */
 
-          (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
-           net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+/****************************************************************************
+ * Name: udp_ipv6_match
+ *
+ * Description:
+ *   Check if a connection should accept the UDP datagram in the device
+ *   buffer.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static bool udp_ipv6_match(FAR struct net_driver_s *dev,
+                           FAR struct udp_hdr_s *udp,
+                           FAR struct udp_conn_s *conn)
+{
+  FAR struct ipv6_hdr_s *ip = IPv6BUF;
+
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *    - The local port number is checked against the destination port
+   *      number in the received packet.
+   *    - If multiple network interfaces are supported, then the local
+   *      IP address is available and we will insist that the
+   *      destination IP matches the bound address. If a socket is bound
+   *      to INADDR6_ANY (laddr), then it should receive all packets
+   *      directed to the port. REVISIT: Should also depend on SO_BROADCAST.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *    - The remote port number is checked if the connection is bound
+   *      to a remote port.
+   *    - Finally, if the connection is bound to a remote IP address,
+   *      the source IP address of the packet is checked.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVIST: SO_BROADCAST flag is currently ignored.
+   */
+
+  /* Check that there is a local port number and this is matches
+   * the port number in the destination address.
+   */
+
+  if ((conn->lport != 0 && udp->destport == conn->lport &&
+
+      /* Check if the local port accepts any address on this port or
+       * that there is an exact match between the destipaddr and the
+       * bound local address.  This catches the case of the all nodes
+       * multicast when the socket is bound to the IPv6 unspecified
+       * address.
+       */
+
+      (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
+       net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+    {
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
+       */
+
+      if (_UDP_ISCONNECTMODE(conn->flags))
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
-
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+          if ((conn->rport == 0 || udp->srcport == conn->rport) &&
 
-              /* If (1) not connected to a remote address, or (2) a all-
-               * nodes multicast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+          /* If (1) not connected to a remote address, or (2) a all-
+           * nodes multicast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
+           */
 
-                  (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
+              (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
 #ifdef CONFIG_NET_BROADCAST
-                   net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
+               net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
 #endif
-                   net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr)))
-                {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
-
-                  break;
-                }
-            }
-          else
+               net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr)))
             {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
+              /* Matching connection found */
 
-              break;
+              return true;
             }
         }
+      else
+        {
+          /* This UDP socket is not connected.  We need to match only
+           * the destination address with the bound socket address.
+           */
+
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: udp_ipv6_active
+ *
+ * Description:
+ *   Find a connection structure that is the appropriate connection to be
+ *   used within the provided UDP header
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline FAR struct udp_conn_s *
+  udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_hdr_s *udp)
+{
+  FAR struct udp_conn_s *conn;
+
+  for (conn = udp_portlist(udp->destport);
+       conn != NULL;
+       conn = udp_portnext(conn))
+    {
+      if (udp_ipv6_match(dev, udp, conn))
+        {
+#ifdef CONFIG_NET_UDP_REUSEPORT
+          if (_UDP_ISREUSEPORT(conn->flags))
+            {
+              FAR struct ipv6_hdr_s *ip = IPv6BUF;
 
-      /* Look at the next active connection */
+              conn = udp_reuseport_select(dev, udp, conn, udp_ipv6_match,
+                                          udp_ipv6_digest(ip->srcipaddr));
+            }
+#endif
 
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+          break;
+        }
     }
 
   return conn;
@@ -622,7 +884,9 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   DEBUGASSERT(conn->crefs == 0);
 
+  net_lock();
   _udp_semtake(&g_free_sem);
+  udp_port_remove(conn);
   conn->lport = 0;
 
   /* Remove the connection from the active list */
@@ -648,6 +912,7 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   dq_addlast(&conn->node, &g_free_udp_connections);
   _udp_semgive(&g_free_sem);
+  net_unlock();
 }
 
 /****************************************************************************
@@ -766,38 +1031,42 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     }
 #endif /* CONFIG_NET_IPv6 */
 
+  /* Interrupts must be disabled while access the UDP connection list */
+
+  net_lock();
+
   /* Is the user requesting to bind to any port? */
 
   if (portno == 0)
     {
       /* Yes.. Select any unused local port number */
 
+      udp_port_remove(conn);
       conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_port_insert(conn);
       ret         = OK;
     }
-  else
-    {
-      /* Interrupts must be disabled while access the UDP connection list */
 
-      net_lock();
-
-      /* Is any other UDP connection already bound to this address and port? */
-
-      if (udp_find_conn(conn->domain, &conn->u, portno) == NULL)
-        {
-          /* No.. then bind the socket to the port */
+  /* Is any other UDP connection already bound to this address and port?
+   * Sockets that set SO_REUSEPORT may share the port with each other.
+   */
 
-          conn->lport = portno;
-          ret         = OK;
-        }
-      else
-        {
-          ret         = -EADDRINUSE;
-        }
+  else if (udp_find_conn(conn->domain, &conn->u, portno,
+                         _UDP_ISREUSEPORT(conn->flags)) == NULL)
+    {
+      /* No.. then bind the socket to the port */
 
-      net_unlock();
+      udp_port_remove(conn);
+      conn->lport = portno;
+      udp_port_insert(conn);
+      ret         = OK;
+    }
+  else
+    {
+      ret         = -EADDRINUSE;
     }
 
+  net_unlock();
   return ret;
 }
 
@@ -840,7 +1109,10 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
+      net_lock();
       conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_port_insert(conn);
+      net_unlock();
     }
 
   /* Is there a remote port (rport)? */
@@ -51,6 +51,7 @@
 #include <arch/irq.h>
 
 #include <sys/socket.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/usrsock.h>
@@ -144,7 +145,7 @@ static uint16_t poll_event(FAR struct net_driver_s *dev, FAR void *pvconn,
   if (eventset)
     {
       info->fds->revents |= eventset;
-      nxsem_post(info->fds->sem);
+      poll_post(info->fds);
     }
 
   return flags;
@@ -289,7 +290,7 @@ static int usrsock_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_post(fds);
     }
 
 errout_unlock:
@@ -203,7 +203,7 @@ static int do_recvfrom_request(FAR struct usrsock_conn_s *conn, size_t buflen,
  *   psock    A pointer to a NuttX-specific, internal socket structure
  *   buf      Buffer to receive data
  *   len      Length of buffer
- *   flags    Receive flags (ignored)
+ *   flags    Receive flags (only MSG_DONTWAIT is supported)
  *   from     Address of source (may be NULL)
  *   fromlen  The length of the address structure
  *
@@ -323,7 +323,8 @@ ssize_t usrsock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 
       if (!(conn->flags & USRSOCK_EVENT_RECVFROM_AVAIL))
         {
-          if (_SS_ISNONBLOCK(psock->s_flags))
+          if (_SS_ISNONBLOCK(psock->s_flags) ||
+              (flags & MSG_DONTWAIT) != 0)
             {
               /* Nothing to receive from daemon side. */
 
@@ -84,6 +84,7 @@ const struct sock_intf_s g_usrsock_sockif =
 #endif
   usrsock_sockif_send,        /* si_send */
   usrsock_sendto,             /* si_sendto */
+  NULL,                       /* si_sendmsg */
 #ifdef CONFIG_NET_SENDFILE
   NULL,                       /* si_sendfile */
 #endif
@@ -41,6 +41,7 @@
 #ifdef CONFIG_NET
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -57,6 +58,93 @@
 #define IPv4BUF   ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF   ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The checksum is accumulated in native byte order from the widest aligned
+ * words available.  The carries out of bit 15 are collected in the upper
+ * bits of the accumulator and folded back in only once at the end:  A
+ * uint16_t length limits the number of additions so that the accumulator
+ * cannot overflow.
+ */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+typedef uint64_t chksum_acc_t;
+typedef uint32_t chksum_word_t;
+#else
+typedef uint32_t chksum_acc_t;
+typedef uint16_t chksum_word_t;
+#endif
+
+#ifdef CONFIG_NET_CHKSUM_SIMD
+/* Sixteen bytes handled as four 32-bit lanes.  The loads need only 32-bit
+ * alignment.
+ */
+
+typedef uint32_t chksum_vec_t
+  __attribute__((vector_size(16), aligned(4), may_alias));
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum_byte
+ *
+ * Description:
+ *   Return a single byte as the native 16-bit word that it would form at
+ *   offset 0 (hi == false) or offset 1 (hi == true) of the word.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+static inline uint16_t chksum_byte(uint8_t byte, bool hi)
+{
+#ifdef CONFIG_ENDIAN_BIG
+  return hi ? byte : (uint16_t)byte << 8;
+#else
+  return hi ? (uint16_t)byte << 8 : byte;
+#endif
+}
+
+/****************************************************************************
+ * Name: chksum_simd
+ *
+ * Description:
+ *   Sum the 16-byte blocks of the buffer using the host vector unit.
+ *   Returns the number of bytes consumed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CHKSUM_SIMD
+static uint16_t chksum_simd(FAR const uint8_t *data, uint16_t len,
+                            FAR chksum_acc_t *acc)
+{
+  FAR const chksum_vec_t *vp = (FAR const chksum_vec_t *)data;
+  chksum_vec_t vsum = { 0, 0, 0, 0 };
+  uint16_t nblocks  = len >> 4;
+  uint16_t i;
+
+  /* Each lane collects the two 16-bit words of each of its 32-bit words.
+   * At most 4095 blocks fit in a uint16_t length, so no lane can exceed
+   * 4095 * 2 * 0xffff.
+   */
+
+  for (i = 0; i < nblocks; i++)
+    {
+      chksum_vec_t v = vp[i];
+
+      vsum += (v & 0xffff) + (v >> 16);
+    }
+
+  *acc += (chksum_acc_t)vsum[0] + vsum[1] + vsum[2] + vsum[3];
+  return nblocks << 4;
+}
+#endif
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -82,35 +170,105 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const chksum_word_t *wp;
+  chksum_acc_t acc = 0;
+  uint16_t result;
+  bool odd;
+
+  /* If the buffer begins at an odd address, sum the first byte as the
+   * second byte of an aligned word.  All following bytes are then summed
+   * one position off as well; rotating the final sum by eight bits
+   * corrects for that.
+   */
+
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd && len > 0)
+    {
+      acc += chksum_byte(*data, true);
+      data++;
+      len--;
+    }
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  /* Align to the word size */
 
-  while (dataptr < last_byte)
+  while (((uintptr_t)data & (sizeof(chksum_word_t) - 1)) != 0 && len >= 2)
     {
-      /* At least two more bytes */
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+#ifdef CONFIG_NET_CHKSUM_SIMD
+  if (((uintptr_t)data & 3) == 0)
+    {
+      uint16_t nbytes = chksum_simd(data, len, &acc);
+
+      data += nbytes;
+      len  -= nbytes;
+    }
+#endif
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  /* Sum whole words, four at a time */
 
-      dataptr += 2;
+  wp = (FAR const chksum_word_t *)data;
+  while (len >= 4 * sizeof(chksum_word_t))
+    {
+      acc += (chksum_acc_t)wp[0] + wp[1];
+      acc += (chksum_acc_t)wp[2] + wp[3];
+      wp  += 4;
+      len -= 4 * sizeof(chksum_word_t);
     }
 
-  if (dataptr == last_byte)
+  while (len >= sizeof(chksum_word_t))
+    {
+      acc += *wp++;
+      len -= sizeof(chksum_word_t);
+    }
+
+  /* Then the remaining 16-bit words and a final odd byte */
+
+  data = (FAR const uint8_t *)wp;
+  while (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+      acc += chksum_byte(*data, false);
+    }
+
+  /* Fold the carries back into 16 bits */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+#endif
+  acc    = (acc & 0xffff) + (acc >> 16);
+  acc    = (acc & 0xffff) + (acc >> 16);
+  result = (uint16_t)acc;
+
+  /* Convert the native sum to host order (the sum of big-endian words),
+   * including the correction for an odd start address.
+   */
+
+#ifdef CONFIG_ENDIAN_BIG
+  if (odd)
+#else
+  if (!odd)
+#endif
+    {
+      result = (uint16_t)((result << 8) | (result >> 8));
+    }
+
+  /* Add the partial sum from a previous call */
+
+  sum += result;
+  if (sum < result)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      sum++; /* carry */
     }
 
   /* Return sum in host byte order. */
@@ -132,12 +132,13 @@ void net_lockinitialize(void)
 
 void net_lock(void)
 {
-#ifdef CONFIG_SMP
-  irqstate_t flags = enter_critical_section();
-#endif
   pid_t me = getpid();
 
-  /* Does this thread already hold the semaphore? */
+  /* Does this thread already hold the semaphore?  No critical section is
+   * needed here, even in the SMP case:  g_holder and g_count are only
+   * modified by the thread that holds the semaphore so g_holder can only
+   * be equal to our PID if we set it ourselves.
+   */
 
   if (g_holder == me)
     {
@@ -156,10 +157,6 @@ void net_lock(void)
       g_holder = me;
       g_count  = 1;
     }
-
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
 }
 
 /****************************************************************************
@@ -178,9 +175,6 @@ void net_lock(void)
 
 void net_unlock(void)
 {
-#ifdef CONFIG_SMP
-  irqstate_t flags = enter_critical_section();
-#endif
   DEBUGASSERT(g_holder == getpid() && g_count > 0);
 
   /* If the count would go to zero, then release the semaphore */
@@ -199,10 +193,6 @@ void net_unlock(void)
 
       g_count--;
     }
-
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
 }
 
 /****************************************************************************
@@ -263,6 +253,40 @@ void net_restorelock(unsigned int count)
   g_count  = count;
 }
 
+/****************************************************************************
+ * Name: net_connlock
+ *
+ * Description:
+ *   Take a per-connection lock, waiting indefinitely.  See
+ *   net/utils/utils.h for the lock order.
+ *
+ ****************************************************************************/
+
+void net_connlock(FAR sem_t *lock)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(lock);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+/****************************************************************************
+ * Name: net_connunlock
+ *
+ * Description:
+ *   Release a per-connection lock.
+ *
+ ****************************************************************************/
+
+void net_connunlock(FAR sem_t *lock)
+{
+  (void)nxsem_post(lock);
+}
+
 /****************************************************************************
  * Name: net_timedwait
  *
@@ -107,6 +107,28 @@ int net_breaklock(FAR unsigned int *count);
 
 void net_restorelock(unsigned int count);
 
+/****************************************************************************
+ * Name: net_connlock and net_connunlock
+ *
+ * Description:
+ *   Take or release a per-connection receiver lock.  The lock serializes
+ *   the receivers of one connection while they consume data that is
+ *   already in its read-ahead buffers, without taking the network lock.
+ *   The device path never takes this lock:  It appends to the read-ahead
+ *   queue in a critical section and receivers remove from it the same way.
+ *
+ *   The lock order is net_lock() first, then the per-connection lock.  The
+ *   network lock must never be taken while a per-connection lock is held.
+ *   Sending and all device I/O are still serialized by the network lock.
+ *
+ * Input Parameters:
+ *   lock - The lock of the connection
+ *
+ ****************************************************************************/
+
+void net_connlock(FAR sem_t *lock);
+void net_connunlock(FAR sem_t *lock);
+
 /****************************************************************************
  * Name: net_dsec2timeval
  *
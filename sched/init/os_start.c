@@ -39,6 +39,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
@@ -47,6 +48,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/compiler.h>
 #include <nuttx/sched.h>
+#include <nuttx/mqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 #include <nuttx/lib/lib.h>
@@ -161,30 +163,33 @@ FAR struct tcb_s *g_running_tasks[1];
 
 volatile dq_queue_t g_pendingtasks;
 
-/* This is the list of all tasks that are blocked waiting for a semaphore */
-
-volatile dq_queue_t g_waitingforsemaphore;
-
-#ifndef CONFIG_DISABLE_SIGNALS
-/* This is the list of all tasks that are blocked waiting for a signal */
+#ifdef CONFIG_SCHED_PRIOINDEX
+/* These are the priority indices of the g_readytorun, g_pendingtasks, and
+ * g_assignedtasks[] lists.
+ */
 
-volatile dq_queue_t g_waitingforsignal;
+struct prioindex_s g_readytorunindex;
+struct prioindex_s g_pendingindex;
+#ifdef CONFIG_SMP
+struct prioindex_s g_assignedindex[CONFIG_SMP_NCPUS];
+#endif
 #endif
 
-#ifndef CONFIG_DISABLE_MQUEUE
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-empty.
+/* This is the list of all tasks that are blocked waiting for a semaphore.
+ * With CONFIG_SEM_WAITLISTS, the waiting tasks are spread over several
+ * lists by the address of the semaphore (see SEM_WAITLIST()).
  */
 
-volatile dq_queue_t g_waitingformqnotempty;
+#ifdef CONFIG_SEM_WAITLISTS
+volatile dq_queue_t g_waitingforsemaphore[CONFIG_SEM_NWAITLISTS];
+#else
+volatile dq_queue_t g_waitingforsemaphore;
 #endif
 
-#ifndef CONFIG_DISABLE_MQUEUE
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-full.
- */
+#ifndef CONFIG_DISABLE_SIGNALS
+/* This is the list of all tasks that are blocked waiting for a signal */
 
-volatile dq_queue_t g_waitingformqnotfull;
+volatile dq_queue_t g_waitingforsignal;
 #endif
 
 #ifdef CONFIG_PAGING
@@ -248,7 +253,10 @@ struct pidhash_s g_pidhash[CONFIG_MAX_TASKS];
  * enumeration type (tstate_t) and provides a pointer to the associated
  * static task list (if there is one) as well as a a set of attribute flags
  * indicating properties of the list, for example, if the list is an
- * ordered list or not.
+ * ordered list or not.  For the TLIST_ATTR_OFFSET states, the pointer is
+ * really the offset of the list in the object that the task waits for.
+ * For the TLIST_ATTR_HASHED state, it is the array of lists that
+ * SEM_WAITLIST() selects from.
  */
 
 const struct tasklist_s g_tasklisttable[NUM_TASK_STATES] =
@@ -289,8 +297,13 @@ const struct tasklist_s g_tasklisttable[NUM_TASK_STATES] =
     0
   },
   {                                              /* TSTATE_WAIT_SEM */
+#ifdef CONFIG_SEM_WAITLISTS
+    g_waitingforsemaphore,
+    TLIST_ATTR_PRIORITIZED | TLIST_ATTR_HASHED
+#else
     &g_waitingforsemaphore,
     TLIST_ATTR_PRIORITIZED
+#endif
   }
 #ifndef CONFIG_DISABLE_SIGNALS
   ,
@@ -302,12 +315,14 @@ const struct tasklist_s g_tasklisttable[NUM_TASK_STATES] =
 #ifndef CONFIG_DISABLE_MQUEUE
   ,
   {                                              /* TSTATE_WAIT_MQNOTEMPTY */
-    &g_waitingformqnotempty,
-    TLIST_ATTR_PRIORITIZED
+    (FAR volatile dq_queue_t *)
+      offsetof(struct mqueue_inode_s, waitnotempty),
+    TLIST_ATTR_PRIORITIZED | TLIST_ATTR_OFFSET
   },
   {                                              /* TSTATE_WAIT_MQNOTFULL */
-    &g_waitingformqnotfull,
-    TLIST_ATTR_PRIORITIZED
+    (FAR volatile dq_queue_t *)
+      offsetof(struct mqueue_inode_s, waitnotfull),
+    TLIST_ATTR_PRIORITIZED | TLIST_ATTR_OFFSET
   }
 #endif
 #ifdef CONFIG_PAGING
@@ -411,14 +426,17 @@ void os_start(void)
 
   dq_init(&g_readytorun);
   dq_init(&g_pendingtasks);
+#ifdef CONFIG_SEM_WAITLISTS
+  for (i = 0; i < CONFIG_SEM_NWAITLISTS; i++)
+    {
+      dq_init(&g_waitingforsemaphore[i]);
+    }
+#else
   dq_init(&g_waitingforsemaphore);
+#endif
 #ifndef CONFIG_DISABLE_SIGNALS
   dq_init(&g_waitingforsignal);
 #endif
-#ifndef CONFIG_DISABLE_MQUEUE
-  dq_init(&g_waitingformqnotfull);
-  dq_init(&g_waitingformqnotempty);
-#endif
 #ifdef CONFIG_PAGING
   dq_init(&g_waitingforfill);
 #endif
@@ -551,11 +569,12 @@ void os_start(void)
        */
 
 #ifdef CONFIG_SMP
-      tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING, cpu);
+      tasklist = TLIST_HEAD(&g_idletcb[cpu].cmn, cpu);
 #else
-      tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
+      tasklist = TLIST_HEAD(&g_idletcb[cpu].cmn);
 #endif
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[cpu], tasklist);
+      sched_prioindex_add(&g_idletcb[cpu].cmn, tasklist);
 
       /* Mark the idle task as the running task */
 
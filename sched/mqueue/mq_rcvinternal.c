@@ -291,16 +291,14 @@ ssize_t nxmq_do_receive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
   msgq = mqdes->msgq;
   if (msgq->nwaitnotfull > 0)
     {
-      /* Find the highest priority task that is waiting for
-       * this queue to be not-full in g_waitingformqnotfull list.
-       * This must be performed in a critical section because
-       * messages can be sent from interrupt handlers.
+      /* The highest priority task that is waiting for this queue to be
+       * not-full is at the head of the queue's waitnotfull list.  This
+       * must be performed in a critical section because messages can be
+       * sent from interrupt handlers.
        */
 
       flags = enter_critical_section();
-      for (btcb = (FAR struct tcb_s *)g_waitingformqnotfull.head;
-           btcb && btcb->msgwaitq != msgq;
-           btcb = btcb->flink);
+      btcb = (FAR struct tcb_s *)msgq->waitnotfull.head;
 
       /* If one was found, unblock it.  NOTE:  There is a race
        * condition here:  the queue might be full again by the
@@ -309,7 +307,6 @@ ssize_t nxmq_do_receive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 
       DEBUGASSERT(btcb != NULL);
 
-      btcb->msgwaitq = NULL;
       msgq->nwaitnotfull--;
       up_unblock_task(btcb);
 
@@ -95,4 +95,6 @@ void nxmq_recover(FAR struct tcb_s *tcb)
       DEBUGASSERT(tcb->msgwaitq && tcb->msgwaitq->nwaitnotfull > 0);
       tcb->msgwaitq->nwaitnotfull--;
     }
+
+  tcb->msgwaitq = NULL;
 }
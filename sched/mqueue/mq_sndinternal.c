@@ -423,21 +423,18 @@ int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
   flags = enter_critical_section();
   if (msgq->nwaitnotempty > 0)
     {
-      /* Find the highest priority task that is waiting for
-       * this queue to be non-empty in g_waitingformqnotempty
-       * list. sched_lock() should give us sufficent protection since
+      /* The highest priority task that is waiting for this queue to be
+       * non-empty is at the head of the queue's waitnotempty list.
+       * sched_lock() should give us sufficent protection since
        * interrupts should never cause a change in this list
        */
 
-      for (btcb = (FAR struct tcb_s *)g_waitingformqnotempty.head;
-           btcb && btcb->msgwaitq != msgq;
-           btcb = btcb->flink);
+      btcb = (FAR struct tcb_s *)msgq->waitnotempty.head;
 
       /* If one was found, unblock it */
 
       DEBUGASSERT(btcb);
 
-      btcb->msgwaitq = NULL;
       msgq->nwaitnotempty--;
       up_unblock_task(btcb);
     }
@@ -97,8 +97,6 @@ void nxmq_wait_irq(FAR struct tcb_s *wtcb, int errcode)
       msgq = wtcb->msgwaitq;
       DEBUGASSERT(msgq);
 
-      wtcb->msgwaitq = NULL;
-
       /* Decrement the count of waiters and cancel the wait */
 
       if (wtcb->task_state == TSTATE_WAIT_MQNOTEMPTY)
@@ -116,7 +114,9 @@ void nxmq_wait_irq(FAR struct tcb_s *wtcb, int errcode)
 
       wtcb->pterrno = errcode;
 
-      /* Restart the task. */
+      /* Restart the task.  This removes the task from the message queue's
+       * wait list and clears msgwaitq.
+       */
 
       up_unblock_task(wtcb);
     }
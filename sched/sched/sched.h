@@ -101,22 +101,66 @@
 #define TLIST_ATTR_PRIORITIZED   (1 << 0) /* Bit 0: List is prioritized */
 #define TLIST_ATTR_INDEXED       (1 << 1) /* Bit 1: List is indexed by CPU */
 #define TLIST_ATTR_RUNNABLE      (1 << 2) /* Bit 2: List includes running tasks */
+#define TLIST_ATTR_OFFSET        (1 << 3) /* Bit 3: List is in the wait object */
+#define TLIST_ATTR_HASHED        (1 << 4) /* Bit 4: List is selected by waitsem */
 
 #define __TLIST_ATTR(s)          g_tasklisttable[s].attr
 #define TLIST_ISPRIORITIZED(s)   ((__TLIST_ATTR(s) & TLIST_ATTR_PRIORITIZED) != 0)
 #define TLIST_ISINDEXED(s)       ((__TLIST_ATTR(s) & TLIST_ATTR_INDEXED) != 0)
 #define TLIST_ISRUNNABLE(s)      ((__TLIST_ATTR(s) & TLIST_ATTR_RUNNABLE) != 0)
+#define TLIST_ISOFFSET(s)        ((__TLIST_ATTR(s) & TLIST_ATTR_OFFSET) != 0)
+#define TLIST_ISHASHED(s)        ((__TLIST_ATTR(s) & TLIST_ATTR_HASHED) != 0)
 
-#define __TLIST_HEAD(s)          (FAR dq_queue_t *)g_tasklisttable[s].list
-#define __TLIST_HEADINDEXED(s,c) (&(__TLIST_HEAD(s))[c])
+/* Tasks waiting for a message queue are kept in a list in the message
+ * queue itself.  For these states, the 'list' field of g_tasklisttable[]
+ * holds the offset of the list in tcb->msgwaitq.
+ */
+
+#ifndef CONFIG_DISABLE_MQUEUE
+#  define __TLIST_OBJHEAD(t) \
+  ((FAR dq_queue_t *)((FAR uint8_t *)(t)->msgwaitq + \
+                      (uintptr_t)g_tasklisttable[(t)->task_state].list))
+#else
+#  define __TLIST_OBJHEAD(t)     ((FAR dq_queue_t *)NULL)
+#endif
+
+/* Tasks waiting for a semaphore are kept in one of the
+ * g_waitingforsemaphore[] lists, selected by the address of the semaphore.
+ */
+
+#ifdef CONFIG_SEM_WAITLISTS
+#  define SEM_WAITLIST(s) \
+  ((FAR dq_queue_t *)&g_waitingforsemaphore[ \
+     (((uintptr_t)(s) >> 3) ^ ((uintptr_t)(s) >> 9)) % \
+     CONFIG_SEM_NWAITLISTS])
+#else
+#  define SEM_WAITLIST(s)        ((FAR dq_queue_t *)&g_waitingforsemaphore)
+#endif
+
+#define __TLIST_HEAD(t) \
+  (TLIST_ISOFFSET((t)->task_state) ? __TLIST_OBJHEAD(t) : \
+   TLIST_ISHASHED((t)->task_state) ? SEM_WAITLIST((t)->waitsem) : \
+   (FAR dq_queue_t *)g_tasklisttable[(t)->task_state].list)
+#define __TLIST_HEADINDEXED(t,c) (&(__TLIST_HEAD(t))[c])
+
+/* The task list that holds the TCB 't' in its current state */
 
 #ifdef CONFIG_SMP
-#  define TLIST_HEAD(s,c) \
-  ((TLIST_ISINDEXED(s)) ? __TLIST_HEADINDEXED(s,c) : __TLIST_HEAD(s))
-#  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
+#  define TLIST_HEAD(t,c) \
+  ((TLIST_ISINDEXED((t)->task_state)) ? \
+   __TLIST_HEADINDEXED(t,c) : __TLIST_HEAD(t))
+#  define TLIST_BLOCKED(t)       __TLIST_HEAD(t)
 #else
-#  define TLIST_HEAD(s)          __TLIST_HEAD(s)
-#  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
+#  define TLIST_HEAD(t)          __TLIST_HEAD(t)
+#  define TLIST_BLOCKED(t)       __TLIST_HEAD(t)
+#endif
+
+/* Size of the priority bitmaps of a struct prioindex_s:  One bit for each
+ * priority level in PRIOINDEX_NWORDS 32-bit words.
+ */
+
+#ifdef CONFIG_SCHED_PRIOINDEX
+#  define PRIOINDEX_NWORDS       ((SCHED_PRIORITY_MAX + 32) >> 5)
 #endif
 
 /****************************************************************************
@@ -153,6 +197,24 @@ struct tasklist_s
   uint8_t attr;                   /* List attribute flags */
 };
 
+#ifdef CONFIG_SCHED_PRIOINDEX
+/* This structure indexes one of the runnable, prioritized task lists
+ * (g_readytorun, g_pendingtasks, and g_assignedtasks[]).  The list itself
+ * is unchanged:  It is still ordered by descending priority and tasks of
+ * the same priority are in FIFO order.  The index holds the last TCB of
+ * each priority level in the list and a bitmap of the priority levels that
+ * are present so that the insertion point of a TCB can be found without
+ * walking the list.
+ */
+
+struct prioindex_s
+{
+  uint32_t summary;                       /* Bit n set: bitmap[n] != 0 */
+  uint32_t bitmap[PRIOINDEX_NWORDS];      /* Bit p set: tail[p] != NULL */
+  FAR struct tcb_s *tail[SCHED_PRIORITY_MAX + 1]; /* Last TCB of priority p */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -165,6 +227,11 @@ struct tasklist_s
  * prioritized so that common list handling logic can be used (only the
  * g_readytorun, the g_pendingtasks, and the g_waitingforsemaphore lists
  * need to be prioritized).
+ *
+ * Tasks waiting for a message queue are not in any of these lists but in a
+ * prioritized list in the message queue (waitnotempty and waitnotfull).
+ * Waking the highest priority waiter is then independent of the number of
+ * tasks blocked on other message queues.
  */
 
 /* This is the list of all tasks that are ready to run.  This is a
@@ -229,30 +296,33 @@ extern FAR struct tcb_s *g_running_tasks[1];
 
 extern volatile dq_queue_t g_pendingtasks;
 
-/* This is the list of all tasks that are blocked waiting for a semaphore */
-
-extern volatile dq_queue_t g_waitingforsemaphore;
-
-/* This is the list of all tasks that are blocked waiting for a signal */
+#ifdef CONFIG_SCHED_PRIOINDEX
+/* These are the priority indices of the g_readytorun, g_pendingtasks, and
+ * g_assignedtasks[] lists.
+ */
 
-#ifndef CONFIG_DISABLE_SIGNALS
-extern volatile dq_queue_t g_waitingforsignal;
+extern struct prioindex_s g_readytorunindex;
+extern struct prioindex_s g_pendingindex;
+#ifdef CONFIG_SMP
+extern struct prioindex_s g_assignedindex[CONFIG_SMP_NCPUS];
+#endif
 #endif
 
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-empty.
+/* This is the list of all tasks that are blocked waiting for a semaphore.
+ * With CONFIG_SEM_WAITLISTS, these are CONFIG_SEM_NWAITLISTS lists and
+ * SEM_WAITLIST() selects the list of a semaphore.
  */
 
-#ifndef CONFIG_DISABLE_MQUEUE
-extern volatile dq_queue_t g_waitingformqnotempty;
+#ifdef CONFIG_SEM_WAITLISTS
+extern volatile dq_queue_t g_waitingforsemaphore[CONFIG_SEM_NWAITLISTS];
+#else
+extern volatile dq_queue_t g_waitingforsemaphore;
 #endif
 
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-full.
- */
+/* This is the list of all tasks that are blocked waiting for a signal */
 
-#ifndef CONFIG_DISABLE_MQUEUE
-extern volatile dq_queue_t g_waitingformqnotfull;
+#ifndef CONFIG_DISABLE_SIGNALS
+extern volatile dq_queue_t g_waitingforsignal;
 #endif
 
 /* This is the list of all tasks that are blocking waiting for a page fill */
@@ -415,6 +485,25 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
                             uint8_t task_state);
 bool sched_mergepending(void);
 void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
+
+/* Priority index of the runnable task lists.  sched_prioindex_add() must be
+ * called after a TCB is added to a prioritized list other than by
+ * sched_addprioritized() and sched_prioindex_remove() must be called before
+ * a TCB is removed from a prioritized list.  Both do nothing if the list is
+ * not indexed.
+ */
+
+#ifdef CONFIG_SCHED_PRIOINDEX
+FAR struct prioindex_s *sched_prioindex(FAR dq_queue_t *list);
+FAR struct tcb_s *sched_prioindex_next(FAR struct prioindex_s *index,
+                                       FAR dq_queue_t *list,
+                                       uint8_t sched_priority);
+void sched_prioindex_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void sched_prioindex_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+#else
+#  define sched_prioindex_add(tcb,list)
+#  define sched_prioindex_remove(tcb,list)
+#endif
 void sched_removeblocked(FAR struct tcb_s *btcb);
 int  nxsched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
 
@@ -84,7 +84,7 @@
  *
  ****************************************************************************/
 
-#ifndef CONFIG_SMP
+#if !defined(CONFIG_SMP) && !defined(CONFIG_SCHED_PRIOINDEX)
 bool sched_mergepending(void)
 {
   FAR struct tcb_s *ptcb;
@@ -164,7 +164,69 @@ bool sched_mergepending(void)
 
   return ret;
 }
-#endif /* !CONFIG_SMP */
+#endif /* !CONFIG_SMP && !CONFIG_SCHED_PRIOINDEX */
+
+/****************************************************************************
+ * Name: sched_mergepending
+ *
+ * Description:
+ *   This function merges the prioritized g_pendingtasks list into the
+ *   prioritized ready-to-run task list.  This version moves the pending
+ *   tasks one at a time so that the priority indices of both lists remain
+ *   valid; each move takes constant time.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   true if the head of the ready-to-run task list has changed indicating
+ *     a context switch is needed.
+ *
+ * Assumptions:
+ * - The caller has established a critical section before
+ *   calling this function (calling sched_lock() first is NOT
+ *   a good idea -- use enter_critical_section()).
+ * - The caller handles the condition that occurs if the
+ *   the head of the ready-to-run list is changed.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_SMP) && defined(CONFIG_SCHED_PRIOINDEX)
+bool sched_mergepending(void)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  FAR struct tcb_s *ptcb;
+  bool ret = false;
+
+  /* Process every TCB in the g_pendingtasks list, highest priority first.
+   * Each goes after any ready-to-run task of the same priority.
+   */
+
+  while ((ptcb = (FAR struct tcb_s *)g_pendingtasks.head) != NULL)
+    {
+      sched_prioindex_remove(ptcb, (FAR dq_queue_t *)&g_pendingtasks);
+      dq_rem((FAR dq_entry_t *)ptcb, (FAR dq_queue_t *)&g_pendingtasks);
+
+      ptcb->task_state = TSTATE_TASK_READYTORUN;
+      if (sched_addprioritized(ptcb, (FAR dq_queue_t *)&g_readytorun))
+        {
+          ret = true;
+        }
+    }
+
+  /* If a pending task was added at the head of the ready-to-run list, it is
+   * now the running task.
+   */
+
+  if (ret)
+    {
+      rtcb->task_state = TSTATE_TASK_READYTORUN;
+      this_task()->task_state = TSTATE_TASK_RUNNING;
+    }
+
+  return ret;
+}
+#endif /* !CONFIG_SMP && CONFIG_SCHED_PRIOINDEX */
 
 /****************************************************************************
  * Name: sched_mergepending
@@ -238,6 +300,7 @@ bool sched_mergepending(void)
         {
           /* Remove the task from the pending task list */
 
+          sched_prioindex_remove(ptcb, (FAR dq_queue_t *)&g_pendingtasks);
           tcb = (FAR struct tcb_s *)dq_remfirst((FAR dq_queue_t *)&g_pendingtasks);
 
           /* Add the pending task to the correct ready-to-run list. */
@@ -91,6 +91,26 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
 
   DEBUGASSERT(list1 != NULL && list2 != NULL);
 
+#ifdef CONFIG_SCHED_PRIOINDEX
+  /* If either list is indexed, move the TCBs one at a time so that the
+   * priority indices remain valid.  Each move takes constant time.
+   */
+
+  if (sched_prioindex(list1) != NULL || sched_prioindex(list2) != NULL)
+    {
+      while ((tmp = (FAR struct tcb_s *)dq_peek(list1)) != NULL)
+        {
+          sched_prioindex_remove(tmp, list1);
+          dq_rem((FAR dq_entry_t *)tmp, list1);
+
+          tmp->task_state = task_state;
+          (void)sched_addprioritized(tmp, list2);
+        }
+
+      goto ret_with_lock;
+    }
+#endif
+
   /* Get a private copy of list1, clearing list1.  We do this early so that
    * we can be assured that the list is stationary before we start any
    * operations on it.
@@ -57,14 +57,34 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_SMP
+#  define NOTE_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define NOTE_NCPUS 1
+#endif
+
+/* Memory barriers are needed only between CPUs */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* Each CPU has its own circular buffer.  Only that CPU adds notes to it
+ * (with local interrupts disabled) and so only that CPU changes ni_head;
+ * only the reader changes ni_tail.  No lock is needed between them.
+ * Without CONFIG_SCHED_NOTE_GET there is no reader and the CPU moves
+ * ni_tail itself when it overwrites the oldest notes.
+ */
+
 struct note_info_s
 {
   volatile unsigned int ni_head;
   volatile unsigned int ni_tail;
+  volatile unsigned long ni_dropped;  /* Notes lost because the buffer was full */
   uint8_t ni_buffer[CONFIG_SCHED_NOTE_BUFSIZE];
 };
 
@@ -92,11 +112,7 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen);
  * Private Data
  ****************************************************************************/
 
-static struct note_info_s g_note_info;
-
-#ifdef CONFIG_SMP
-static volatile spinlock_t g_note_lock;
-#endif
+static struct note_info_s g_note_info[NOTE_NCPUS];
 
 /****************************************************************************
  * Private Functions
@@ -206,21 +222,20 @@ void note_spincommon(FAR struct tcb_s *tcb, FAR volatile spinlock_t *spinlock,
  * Name: note_length
  *
  * Description:
- *   Length of data currently in circular buffer.
+ *   Length of data currently in a circular buffer.
  *
  * Input Parameters:
- *   None
+ *   ni - The circular buffer
  *
  * Returned Value:
- *   Length of data currently in circular buffer.
+ *   Length of data currently in the circular buffer.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS)
-static unsigned int note_length(void)
+static unsigned int note_length(FAR struct note_info_s *ni)
 {
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
+  unsigned int head = ni->ni_head;
+  unsigned int tail = ni->ni_tail;
 
   if (tail > head)
     {
@@ -229,70 +244,138 @@ static unsigned int note_length(void)
 
   return head - tail;
 }
+
+/****************************************************************************
+ * Name: note_copyin and note_copyout
+ *
+ * Description:
+ *   Copy data into or out of a circular buffer at the given index,
+ *   handling wraparound.
+ *
+ ****************************************************************************/
+
+static void note_copyin(FAR struct note_info_s *ni, unsigned int ndx,
+                        FAR const uint8_t *data, unsigned int len)
+{
+  unsigned int first = CONFIG_SCHED_NOTE_BUFSIZE - ndx;
+
+  if (first >= len)
+    {
+      memcpy(&ni->ni_buffer[ndx], data, len);
+    }
+  else
+    {
+      memcpy(&ni->ni_buffer[ndx], data, first);
+      memcpy(ni->ni_buffer, data + first, len - first);
+    }
+}
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static void note_copyout(FAR struct note_info_s *ni, unsigned int ndx,
+                         FAR uint8_t *data, unsigned int len)
+{
+  unsigned int first = CONFIG_SCHED_NOTE_BUFSIZE - ndx;
+
+  if (first >= len)
+    {
+      memcpy(data, &ni->ni_buffer[ndx], len);
+    }
+  else
+    {
+      memcpy(data, &ni->ni_buffer[ndx], first);
+      memcpy(data + first, ni->ni_buffer, len - first);
+    }
+}
 #endif
 
 /****************************************************************************
- * Name: note_remove
+ * Name: note_oldest
  *
  * Description:
- *   Remove the variable length note from the tail of the circular buffer
+ *   Find the circular buffer holding the oldest note.  The per-CPU buffers
+ *   are each in time order so this merges them by comparing the timestamps
+ *   of the notes at their tails.
  *
  * Input Parameters:
- *   None
+ *   common - Location to return the common part of the oldest note
  *
  * Returned Value:
- *   None
+ *   The circular buffer holding the oldest note or NULL if all of the
+ *   buffers are empty.
  *
  * Assumptions:
- *   We are within a critical section.
+ *   The caller excludes other readers.
  *
  ****************************************************************************/
 
-static void note_remove(void)
+#ifdef CONFIG_SCHED_NOTE_GET
+static FAR struct note_info_s *note_oldest(FAR struct note_common_s *common)
 {
-  FAR struct note_common_s *note;
-  unsigned int tail;
-  unsigned int length;
+  FAR struct note_info_s *oldest = NULL;
+  struct note_common_s note;
+  uint32_t oldtime = 0;
+  uint32_t systime;
+  int cpu;
 
-  /* Get the tail index of the circular buffer */
+  for (cpu = 0; cpu < NOTE_NCPUS; cpu++)
+    {
+      FAR struct note_info_s *ni = &g_note_info[cpu];
 
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+      if (note_length(ni) == 0)
+        {
+          continue;
+        }
 
-  /* Get the length of the note at the tail index */
+      /* Do not look at the note before the head index that published it */
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+      SP_DMB();
+      note_copyout(ni, ni->ni_tail, (FAR uint8_t *)&note,
+                   sizeof(struct note_common_s));
 
-  /* Increment the tail index to remove the entire note from the circular
-   * buffer.
-   */
+      systime = (uint32_t)note.nc_systime[0]        |
+                (uint32_t)note.nc_systime[1] << 8   |
+                (uint32_t)note.nc_systime[2] << 16  |
+                (uint32_t)note.nc_systime[3] << 24;
+
+      if (oldest == NULL || (int32_t)(systime - oldtime) < 0)
+        {
+          oldest  = ni;
+          oldtime = systime;
+          memcpy(common, &note, sizeof(struct note_common_s));
+        }
+    }
 
-  g_note_info.ni_tail = note_next(tail, length);
+  return oldest;
 }
+#endif
 
 /****************************************************************************
  * Name: note_add
  *
  * Description:
- *   Add the variable length note to the head of the circular buffer
+ *   Add the variable length note to the head of the circular buffer of
+ *   this CPU.  If there is not room for the note:
+ *
+ *   - With CONFIG_SCHED_NOTE_GET, the note is dropped and counted rather
+ *     than overwriting older notes that a reader may be copying.
+ *   - Otherwise there is no reader and this CPU owns the tail as well.  The
+ *     oldest notes are overwritten so that the buffer always holds the most
+ *     recent history.
  *
  * Input Parameters:
- *   None
+ *   note    - The note to add
+ *   notelen - The length of the note
  *
  * Returned Value:
  *   None
  *
- * Assumptions:
- *   We are within a critical section.
- *
  ****************************************************************************/
 
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
+  FAR struct note_info_s *ni;
   unsigned int head;
-  unsigned int next;
+  irqstate_t flags;
 
 #ifdef CONFIG_SMP
   /* Ignore notes that are not in the set of monitored CPUs */
@@ -305,46 +388,42 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
     }
 #endif
 
-#ifdef CONFIG_SMP
-  irqstate_t flags = up_irq_save();
-  spin_lock_wo_note(&g_note_lock);
-#endif
-
-  /* Get the index to the head of the circular buffer */
+  /* Disabling local interrupts keeps us on this CPU and makes us the only
+   * writer of its buffer.
+   */
 
   DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
-  head = g_note_info.ni_head;
 
-  /* Loop until all bytes have been transferred to the circular buffer */
+  flags = up_irq_save();
+  ni    = &g_note_info[this_cpu()];
+  head  = ni->ni_head;
 
-  while (notelen > 0)
+#ifdef CONFIG_SCHED_NOTE_GET
+  if (notelen > CONFIG_SCHED_NOTE_BUFSIZE - 1 - note_length(ni))
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
-
-      next = note_next(head, 1);
-      if (next == g_note_info.ni_tail)
-        {
-          /* Yes, then remove the note at the tail index */
-
-          note_remove();
-        }
-
-      /* Save the next byte at the head index */
-
-      g_note_info.ni_buffer[head] = *note++;
+      ni->ni_dropped++;
+      up_irq_restore(flags);
+      return;
+    }
+#else
+  /* Remove the oldest notes until there is room.  The first byte of each
+   * note is its length (nc_length).
+   */
 
-      head = next;
-      notelen--;
+  while (notelen > CONFIG_SCHED_NOTE_BUFSIZE - 1 - note_length(ni))
+    {
+      ni->ni_tail = note_next(ni->ni_tail, ni->ni_buffer[ni->ni_tail]);
+      ni->ni_dropped++;
     }
+#endif
 
-  g_note_info.ni_head = head;
+  note_copyin(ni, head, note, notelen);
 
-#ifdef CONFIG_SMP
-  spin_unlock_wo_note(&g_note_lock);
+  /* Make the note visible before publishing the new head index */
+
+  SP_DMB();
+  ni->ni_head = note_next(head, notelen);
   up_irq_restore(flags);
-#endif
 }
 
 /****************************************************************************
@@ -609,66 +688,48 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
+  FAR struct note_info_s *ni;
+  struct note_common_s note;
   irqstate_t flags;
-  unsigned int remaining;
   unsigned int tail;
   ssize_t notelen;
-  size_t circlen;
 
   DEBUGASSERT(buffer != NULL);
   flags = enter_critical_section();
 
-  /* Verify that the circular buffer is not empty */
+  /* Find the buffer holding the oldest note, if any */
 
-  circlen = note_length();
-  if (circlen <= 0)
+  ni = note_oldest(&note);
+  if (ni == NULL)
     {
       notelen = 0;
       goto errout_with_csection;
     }
 
-  /* Get the index to the tail of the circular buffer */
-
-  tail    = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
-
   /* Get the length of the note at the tail index */
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  tail    = ni->ni_tail;
+  notelen = note.nc_length;
+  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE &&
+              notelen <= note_length(ni));
 
-  /* Is the user buffer large enough to hold the note? */
+  /* Is the user buffer large enough to hold the note?  If not, remove the
+   * large note so that we do not get constipated and return an error.
+   */
 
   if (buflen < notelen)
     {
-      /* Remove the large note so that we do not get constipated. */
-
-      note_remove();
-
-      /* and return an error */
-
       notelen = -EFBIG;
-      goto errout_with_csection;
     }
-
-  /* Loop until the note has been transferred to the user buffer */
-
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
+  else
     {
-      /* Copy the next byte at the tail index */
-
-      *buffer++ = g_note_info.ni_buffer[tail];
-
-      /* Adjust indices and counts */
-
-      tail = note_next(tail, 1);
-      remaining--;
+      note_copyout(ni, tail, buffer, notelen);
     }
 
-  g_note_info.ni_tail = tail;
+  /* Finish copying the note before releasing its space to the writer */
+
+  SP_DMB();
+  ni->ni_tail = note_next(tail, note.nc_length);
 
 errout_with_csection:
   leave_critical_section(flags);
@@ -694,37 +755,45 @@ errout_with_csection:
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
-  FAR struct note_common_s *note;
+  struct note_common_s note;
   irqstate_t flags;
-  unsigned int tail;
   ssize_t notelen;
-  size_t circlen;
-
-  flags = enter_critical_section();
-
-  /* Verify that the circular buffer is not empty */
 
-  circlen = note_length();
-  if (circlen <= 0)
-    {
-      notelen = 0;
-      goto errout_with_csection;
-    }
+  flags   = enter_critical_section();
+  notelen = note_oldest(&note) != NULL ? note.nc_length : 0;
+  leave_critical_section(flags);
 
-  /* Get the index to the tail of the circular buffer */
+  return notelen;
+}
+#endif
 
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+/****************************************************************************
+ * Name: sched_note_dropped
+ *
+ * Description:
+ *   Return the number of notes that were dropped because the circular
+ *   buffer of their CPU was full.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The total number of dropped notes since boot.
+ *
+ ****************************************************************************/
 
-  /* Get the length of the note at the tail index */
+#ifdef CONFIG_SCHED_NOTE_GET
+unsigned long sched_note_dropped(void)
+{
+  unsigned long dropped = 0;
+  int cpu;
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  for (cpu = 0; cpu < NOTE_NCPUS; cpu++)
+    {
+      dropped += g_note_info[cpu].ni_dropped;
+    }
 
-errout_with_csection:
-  leave_critical_section(flags);
-  return notelen;
+  return dropped;
 }
 #endif
 
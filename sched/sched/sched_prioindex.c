@@ -0,0 +1,242 @@
+/****************************************************************************
+ * sched/sched/sched_prioindex.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex
+ *
+ * Description:
+ *   Return the priority index associated with a task list.
+ *
+ * Input Parameters:
+ *   list - Points to a task list
+ *
+ * Returned Value:
+ *   The priority index of the list or NULL if the list is not indexed.
+ *
+ ****************************************************************************/
+
+FAR struct prioindex_s *sched_prioindex(FAR dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorunindex;
+    }
+  else if (list == (FAR dq_queue_t *)&g_pendingtasks)
+    {
+      return &g_pendingindex;
+    }
+#ifdef CONFIG_SMP
+  else if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+           list <  (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedindex[list - (FAR dq_queue_t *)g_assignedtasks];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_next
+ *
+ * Description:
+ *   Find the position in an indexed task list at which a TCB with priority
+ *   'sched_priority' must be inserted.  That is just after the last TCB of
+ *   the lowest priority level that is greater than or equal to
+ *   'sched_priority'.  The search examines at most two bitmap words.
+ *
+ * Input Parameters:
+ *   index - The priority index of 'list'
+ *   list - Points to the indexed task list
+ *   sched_priority - The priority of the TCB to be inserted
+ *
+ * Returned Value:
+ *   The TCB that the new TCB must be inserted before or NULL if the new
+ *   TCB goes at the end of the list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_prioindex_next(FAR struct prioindex_s *index,
+                                       FAR dq_queue_t *list,
+                                       uint8_t sched_priority)
+{
+  uint32_t bits;
+  unsigned int word;
+  unsigned int prio;
+
+  /* Are there any TCBs of this priority or of a (slightly) higher priority
+   * in the same bitmap word?
+   */
+
+  word = sched_priority >> 5;
+  bits = index->bitmap[word] & (0xffffffff << (sched_priority & 31));
+  if (bits == 0)
+    {
+      /* No.. find the next non-empty bitmap word */
+
+      bits = index->summary & ~((2ul << word) - 1);
+      if (bits == 0)
+        {
+          /* All TCBs in the list have a lower priority.  The new TCB goes
+           * at the head of the list.
+           */
+
+          return (FAR struct tcb_s *)list->head;
+        }
+
+      word = ffsl((long)bits) - 1;
+      bits = index->bitmap[word];
+    }
+
+  prio = (word << 5) + ffsl((long)bits) - 1;
+  DEBUGASSERT(index->tail[prio] != NULL);
+  return index->tail[prio]->flink;
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_add
+ *
+ * Description:
+ *   Update the priority index of a task list after 'tcb' was added to the
+ *   list.  Nothing is done if the list is not indexed.
+ *
+ * Input Parameters:
+ *   tcb - The TCB that was added to the list.
+ *   list - Points to the task list
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct prioindex_s *index = sched_prioindex(list);
+  FAR struct tcb_s *next;
+  uint8_t prio;
+
+  if (index != NULL)
+    {
+      /* The TCB is the new last TCB of its priority level unless it was
+       * added before another TCB of the same priority.
+       */
+
+      prio = tcb->sched_priority;
+      next = tcb->flink;
+
+      if (next == NULL || next->sched_priority != prio)
+        {
+          index->tail[prio]          = tcb;
+          index->bitmap[prio >> 5]  |= (uint32_t)1 << (prio & 31);
+          index->summary            |= (uint32_t)1 << (prio >> 5);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_remove
+ *
+ * Description:
+ *   Update the priority index of a task list before 'tcb' is removed from
+ *   the list.  Nothing is done if the list is not indexed.
+ *
+ * Input Parameters:
+ *   tcb - The TCB that is about to be removed from the list.
+ *   list - Points to the task list
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct prioindex_s *index = sched_prioindex(list);
+  FAR struct tcb_s *prev;
+  uint8_t prio;
+
+  if (index != NULL)
+    {
+      prio = tcb->sched_priority;
+      if (index->tail[prio] == tcb)
+        {
+          /* The TCB is the last TCB of its priority level.  The previous
+           * TCB becomes the last one if it has the same priority;
+           * otherwise the priority level is now empty.
+           */
+
+          prev = tcb->blink;
+          if (prev != NULL && prev->sched_priority == prio)
+            {
+              index->tail[prio] = prev;
+            }
+          else
+            {
+              index->tail[prio]          = NULL;
+              index->bitmap[prio >> 5]  &= ~((uint32_t)1 << (prio & 31));
+              if (index->bitmap[prio >> 5] == 0)
+                {
+                  index->summary &= ~((uint32_t)1 << (prio >> 5));
+                }
+            }
+        }
+    }
+}
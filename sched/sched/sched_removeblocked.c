@@ -80,7 +80,23 @@ void sched_removeblocked(FAR struct tcb_s *btcb)
    * with this state
    */
 
-  dq_rem((FAR dq_entry_t *)btcb, TLIST_BLOCKED(task_state));
+  dq_rem((FAR dq_entry_t *)btcb, TLIST_BLOCKED(btcb));
+
+  /* The wait list was selected by the object that the task waits for.
+   * Now that the task is out of the list, the wait is over.
+   */
+
+  if (task_state == TSTATE_WAIT_SEM)
+    {
+      btcb->waitsem = NULL;
+    }
+#ifndef CONFIG_DISABLE_MQUEUE
+  else if (task_state == TSTATE_WAIT_MQNOTEMPTY ||
+           task_state == TSTATE_WAIT_MQNOTFULL)
+    {
+      btcb->msgwaitq = NULL;
+    }
+#endif
 
   /* Make sure the TCB's state corresponds to not being in
    * any list
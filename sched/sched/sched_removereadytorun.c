@@ -101,6 +101,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+  sched_prioindex_remove(rtcb, (FAR dq_queue_t *)&g_readytorun);
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
@@ -148,7 +149,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
    */
 
   cpu      = rtcb->cpu;
-  tasklist = TLIST_HEAD(rtcb->task_state, cpu);
+  tasklist = TLIST_HEAD(rtcb, cpu);
 
   /* Check if the TCB to be removed is at the head of a ready-to-run list.
    * For the case of SMP, there are two lists involved:  (1) the
@@ -198,6 +199,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
+      sched_prioindex_remove(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
@@ -237,10 +239,13 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
            * list and add to the head of the g_assignedtasks[cpu] list.
            */
 
+          sched_prioindex_remove((FAR struct tcb_s *)g_readytorun.head,
+                                 (FAR dq_queue_t *)&g_readytorun);
           tmptcb = (FAR struct tcb_s *)
             dq_remfirst((FAR dq_queue_t *)&g_readytorun);
 
           dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
+          sched_prioindex_add(tmptcb, tasklist);
 
           tmptcb->cpu = cpu;
           nxttcb = tmptcb;
@@ -328,6 +333,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
+      sched_prioindex_remove(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
     }
 
@@ -164,9 +164,25 @@ static inline void sched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifdef CONFIG_SCHED_PRIOINDEX
+      /* The task remains at the head of its list but it moves to a
+       * different priority level in the list's priority index.
+       */
+
+#ifdef CONFIG_SMP
+      FAR dq_queue_t *tasklist = TLIST_HEAD(tcb, tcb->cpu);
+#else
+      FAR dq_queue_t *tasklist = TLIST_HEAD(tcb);
+#endif
+
+      sched_prioindex_remove(tcb, tasklist);
+      tcb->sched_priority = (uint8_t)sched_priority;
+      sched_prioindex_add(tcb, tasklist);
+#else
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+#endif
     }
 }
 
@@ -284,11 +300,12 @@ static inline void sched_blocked_setpriority(FAR struct tcb_s *tcb,
 
   /* CASE 3a. The task resides in a prioritized list. */
 
-  tasklist = TLIST_BLOCKED(task_state);
+  tasklist = TLIST_BLOCKED(tcb);
   if (TLIST_ISPRIORITIZED(task_state))
     {
       /* Remove the TCB from the prioritized task list */
 
+      sched_prioindex_remove(tcb, tasklist);
       dq_rem((FAR dq_entry_t *)tcb, tasklist);
 
       /* Change the task priority */
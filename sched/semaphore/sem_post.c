@@ -142,10 +142,11 @@ int nxsem_post(FAR sem_t *sem)
           /* Check if there are any tasks in the waiting for semaphore
            * task list that are waiting for this semaphore. This is a
            * prioritized list so the first one we encounter is the one
-           * that we want.
+           * that we want.  With CONFIG_SEM_WAITLISTS, the list only holds
+           * the waiters of semaphores that hash to the same list.
            */
 
-          for (stcb = (FAR struct tcb_s *)g_waitingforsemaphore.head;
+          for (stcb = (FAR struct tcb_s *)SEM_WAITLIST(sem)->head;
                (stcb && stcb->waitsem != sem);
                stcb = stcb->flink);
 
@@ -157,11 +158,10 @@ int nxsem_post(FAR sem_t *sem)
 
               nxsem_addholder_tcb(stcb, sem);
 
-              /* It is, let the task take the semaphore */
-
-              stcb->waitsem = NULL;
-
-              /* Restart the waiting task. */
+              /* It is, let the task take the semaphore and restart the
+               * waiting task.  Removing the task from the wait list also
+               * clears waitsem.
+               */
 
               up_unblock_task(stcb);
             }
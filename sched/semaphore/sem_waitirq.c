@@ -111,15 +111,13 @@ void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode)
 
       sem->semcount++;
 
-      /* Indicate that the semaphore wait is over. */
-
-      wtcb->waitsem = NULL;
-
       /* Mark the errno value for the thread. */
 
       wtcb->pterrno = errcode;
 
-      /* Restart the task. */
+      /* Restart the task.  This removes the task from the wait list and
+       * clears waitsem.
+       */
 
       up_unblock_task(wtcb);
     }
@@ -135,6 +135,17 @@ int task_restart(pid_t pid)
   cpu = sched_cpu_pause(&tcb->cmn);
 #endif /* CONFIG_SMP */
 
+  /* Find the list that the TCB is in.  This must be done before the
+   * recovery which forgets the semaphore or message queue that the task is
+   * waiting for (and the list is selected by it).
+   */
+
+#ifdef CONFIG_SMP
+  tasklist = TLIST_HEAD(&tcb->cmn, tcb->cmn.cpu);
+#else
+  tasklist = TLIST_HEAD(&tcb->cmn);
+#endif
+
   /* Try to recover from any bad states */
 
   task_recover((FAR struct tcb_s *)tcb);
@@ -149,12 +160,7 @@ int task_restart(pid_t pid)
    * should no longer be accessible to the system
    */
 
-#ifdef CONFIG_SMP
-  tasklist = TLIST_HEAD(tcb->cmn.task_state, tcb->cmn.cpu);
-#else
-  tasklist = TLIST_HEAD(tcb->cmn.task_state);
-#endif
-
+  sched_prioindex_remove(&tcb->cmn, tasklist);
   dq_rem((FAR dq_entry_t *)tcb, tasklist);
   tcb->cmn.task_state = TSTATE_TASK_INVALID;
 
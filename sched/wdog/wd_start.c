@@ -91,6 +91,60 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_execute
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog, no longer active.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline void wd_execute(FAR struct wdog_s *wdog)
+{
+  up_setpicbase(wdog->picbase);
+  switch (wdog->argc)
+    {
+      default:
+        DEBUGPANIC();
+        break;
+
+      case 0:
+        (*((wdentry0_t)(wdog->func)))(0);
+        break;
+
+#if CONFIG_MAX_WDOGPARMS > 0
+      case 1:
+        (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 1
+      case 2:
+        (*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 2
+      case 3:
+        (*((wdentry3_t)(wdog->func)))(3,
+                        wdog->parm[0], wdog->parm[1],
+                        wdog->parm[2]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 3
+      case 4:
+        (*((wdentry4_t)(wdog->func)))(4,
+                        wdog->parm[0], wdog->parm[1],
+                        wdog->parm[2], wdog->parm[3]);
+        break;
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -106,6 +160,7 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  *
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_WHEEL
 static inline void wd_expiration(void)
 {
   FAR struct wdog_s *wdog;
@@ -140,46 +195,11 @@ static inline void wd_expiration(void)
 
           /* Execute the watchdog function */
 
-          up_setpicbase(wdog->picbase);
-          switch (wdog->argc)
-            {
-              default:
-                DEBUGPANIC();
-                break;
-
-              case 0:
-                (*((wdentry0_t)(wdog->func)))(0);
-                break;
-
-#if CONFIG_MAX_WDOGPARMS > 0
-              case 1:
-                (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 1
-              case 2:
-                (*((wdentry2_t)(wdog->func)))(2,
-                                wdog->parm[0], wdog->parm[1]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 2
-              case 3:
-                (*((wdentry3_t)(wdog->func)))(3,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 3
-              case 4:
-                (*((wdentry4_t)(wdog->func)))(4,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2], wdog->parm[3]);
-                break;
-#endif
-            }
+          wd_execute(wdog);
         }
     }
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -222,10 +242,12 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 {
   va_list ap;
+#ifndef CONFIG_WDOG_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   int32_t now;
+#endif
   irqstate_t flags;
   int i;
 
@@ -288,6 +310,20 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
   (void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_WHEEL
+#ifdef CONFIG_SCHED_TICKLESS
+  if (wd_wheel_empty())
+    {
+      /* Update clock tickbase */
+
+      g_wdtickbase = clock_systimer();
+    }
+#endif
+
+  /* File the watchdog in the timing wheel.  The lag is not used. */
+
+  wd_wheel_insert(wdog, delay);
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -379,6 +415,8 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
         }
     }
 
+#endif
+
   /* Put the lag into the watchdog structure and mark it as active. */
 
   wdog->lag = delay;
@@ -430,7 +468,12 @@ unsigned int wd_timer(int ticks)
   irqstate_t flags;
 #endif
   unsigned int ret;
+#ifdef CONFIG_WDOG_WHEEL
+  unsigned int remaining;
+  unsigned int last;
+#else
   int decr;
+#endif
 
 #ifdef CONFIG_SMP
   /* We are in an interrupt handler as, as a consequence, interrupts are
@@ -445,6 +488,30 @@ unsigned int wd_timer(int ticks)
   flags = enter_critical_section();
 #endif
 
+#ifdef CONFIG_WDOG_WHEEL
+  /* Advance the timing wheel, executing the watchdogs that expire on the
+   * way.  The tickbase follows the wheel so that wd_start() and
+   * wd_gettime() called from a watchdog function see the right time.
+   */
+
+  remaining = ticks > 0 ? ticks : 0;
+  last      = remaining;
+
+  while ((wdog = wd_wheel_expire(&remaining)) != NULL)
+    {
+      g_wdtickbase += last - remaining;
+      last          = remaining;
+
+      WDOG_CLRACTIVE(wdog);
+      wd_execute(wdog);
+    }
+
+  g_wdtickbase += last;
+
+  /* Return the delay until the wheel next needs attention */
+
+  ret = wd_wheel_nextdelay();
+#else
   /* Check if there are any active watchdogs to process */
 
   while (g_wdactivelist.head != NULL && ticks > 0)
@@ -484,6 +551,7 @@ unsigned int wd_timer(int ticks)
 
   ret = g_wdactivelist.head ?
           ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+#endif
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
@@ -497,6 +565,10 @@ unsigned int wd_timer(int ticks)
 #else
 void wd_timer(void)
 {
+#ifdef CONFIG_WDOG_WHEEL
+  FAR struct wdog_s *wdog;
+  unsigned int ticks;
+#endif
 #ifdef CONFIG_SMP
   irqstate_t flags;
 
@@ -512,6 +584,18 @@ void wd_timer(void)
   flags = enter_critical_section();
 #endif
 
+#ifdef CONFIG_WDOG_WHEEL
+  /* Advance the timing wheel by one tick and execute the watchdogs that
+   * expire.
+   */
+
+  ticks = 1;
+  while ((wdog = wd_wheel_expire(&ticks)) != NULL)
+    {
+      WDOG_CLRACTIVE(wdog);
+      wd_execute(wdog);
+    }
+#else
   /* Check if there are any active watchdogs to process */
 
   if (g_wdactivelist.head)
@@ -524,6 +608,7 @@ void wd_timer(void)
 
       wd_expiration();
     }
+#endif
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
@@ -0,0 +1,457 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The wheel has WHEEL_LEVELS levels of WHEEL_SLOTS slots.  A slot on level
+ * N spans 2**(N*WHEEL_BITS) ticks so the whole wheel covers
+ * 2**(WHEEL_LEVELS*WHEEL_BITS) ticks.  Watchdogs further in the future are
+ * kept in the last slot of the top level and are re-filed each time that
+ * slot cascades.
+ */
+
+#define WHEEL_BITS         6
+#define WHEEL_SLOTS        (1 << WHEEL_BITS)
+#define WHEEL_MASK         (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS       4
+#define WHEEL_NSLOTS       (WHEEL_LEVELS * WHEEL_SLOTS)
+#define WHEEL_RANGE        (1ul << (WHEEL_LEVELS * WHEEL_BITS))
+
+#define WHEEL_SHIFT(l)     ((l) * WHEEL_BITS)
+#define WHEEL_INDEX(t,l)   (((t) >> WHEEL_SHIFT(l)) & WHEEL_MASK)
+#define WHEEL_SLOT(l,i)    (((l) << WHEEL_BITS) | (i))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct wd_wheel_s
+{
+  uint32_t now;                                /* Current time in ticks */
+  unsigned int nactive;                        /* Number of watchdogs */
+  uint32_t map[WHEEL_NSLOTS / 32];             /* Non-empty slots */
+  FAR struct wdog_s *slot[WHEEL_NSLOTS];       /* Slot list heads */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_link
+ *
+ * Description:
+ *   File the watchdog in the slot that covers its expiration time relative
+ *   to the current time of the wheel.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_link(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s **head;
+  uint32_t delta = wdog->expire - g_wdwheel.now;
+  unsigned int level;
+  unsigned int index;
+
+  if (delta >= WHEEL_RANGE)
+    {
+      /* Beyond the range of the wheel.  Park it in the slot that will
+       * cascade last.
+       */
+
+      level = WHEEL_LEVELS - 1;
+      index = (WHEEL_INDEX(g_wdwheel.now, level) + WHEEL_MASK) & WHEEL_MASK;
+    }
+  else
+    {
+      for (level = 0;
+           level < WHEEL_LEVELS - 1 &&
+           delta >= (1ul << WHEEL_SHIFT(level + 1));
+           level++);
+
+      index = WHEEL_INDEX(wdog->expire, level);
+    }
+
+  index       = WHEEL_SLOT(level, index);
+  head        = &g_wdwheel.slot[index];
+
+  wdog->next  = *head;
+  wdog->pprev = head;
+  if (*head != NULL)
+    {
+      (*head)->pprev = &wdog->next;
+    }
+
+  *head = wdog;
+  g_wdwheel.map[index >> 5] |= (uint32_t)1 << (index & 31);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_unlink
+ *
+ * Description:
+ *   Remove the watchdog from its slot.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_unlink(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s **pprev = wdog->pprev;
+  unsigned int index;
+
+  *pprev = wdog->next;
+  if (wdog->next != NULL)
+    {
+      wdog->next->pprev = pprev;
+    }
+  else if (*pprev == NULL && pprev >= &g_wdwheel.slot[0] &&
+           pprev < &g_wdwheel.slot[WHEEL_NSLOTS])
+    {
+      /* That was the only watchdog in the slot */
+
+      index = pprev - &g_wdwheel.slot[0];
+      g_wdwheel.map[index >> 5] &= ~((uint32_t)1 << (index & 31));
+    }
+
+  wdog->next  = NULL;
+  wdog->pprev = NULL;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Re-file the watchdogs of the higher level slots that come due at the
+ *   current time of the wheel into the lower levels.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(void)
+{
+  FAR struct wdog_s *wdog;
+  FAR struct wdog_s *next;
+  unsigned int level;
+  unsigned int index;
+
+  for (level = WHEEL_LEVELS - 1; level > 0; level--)
+    {
+      if ((g_wdwheel.now & ((1ul << WHEEL_SHIFT(level)) - 1)) != 0)
+        {
+          continue;
+        }
+
+      index = WHEEL_SLOT(level, WHEEL_INDEX(g_wdwheel.now, level));
+      wdog  = g_wdwheel.slot[index];
+      if (wdog == NULL)
+        {
+          continue;
+        }
+
+      g_wdwheel.slot[index] = NULL;
+      g_wdwheel.map[index >> 5] &= ~((uint32_t)1 << (index & 31));
+
+      for (; wdog != NULL; wdog = next)
+        {
+          next = wdog->next;
+          wd_wheel_link(wdog);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_nextslot
+ *
+ * Description:
+ *   Return the distance, in slots, from the current slot of a level to the
+ *   next non-empty slot of that level (WHEEL_SLOTS if only the current
+ *   slot is in use) or zero if the level is empty.
+ *
+ ****************************************************************************/
+
+static unsigned int wd_wheel_nextslot(unsigned int level)
+{
+  unsigned int base = WHEEL_SLOT(level, 0);
+  unsigned int curr = WHEEL_INDEX(g_wdwheel.now, level);
+  unsigned int index;
+  unsigned int dist;
+  unsigned int i;
+
+  for (i = 0; i < WHEEL_SLOTS / 32; i++)
+    {
+      if (g_wdwheel.map[(base >> 5) + i] != 0)
+        {
+          break;
+        }
+    }
+
+  if (i >= WHEEL_SLOTS / 32)
+    {
+      return 0;
+    }
+
+  for (dist = 1; dist <= WHEEL_SLOTS; dist++)
+    {
+      index = base + ((curr + dist) & WHEEL_MASK);
+      if ((g_wdwheel.map[index >> 5] & ((uint32_t)1 << (index & 31))) != 0)
+        {
+          break;
+        }
+    }
+
+  return dist;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the (empty) timing wheel.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+  memset(&g_wdwheel, 0, sizeof(struct wd_wheel_s));
+}
+
+/****************************************************************************
+ * Name: wd_wheel_empty
+ *
+ * Description:
+ *   Return true if there are no active watchdogs in the timing wheel.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_empty(void)
+{
+  return g_wdwheel.nactive == 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog to the timing wheel to expire 'delay' ticks from the
+ *   current time of the wheel.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog, int32_t delay)
+{
+  DEBUGASSERT(delay > 0);
+
+  wdog->expire = g_wdwheel.now + (uint32_t)delay;
+  wd_wheel_link(wdog);
+  g_wdwheel.nactive++;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  DEBUGASSERT(wdog->pprev != NULL && g_wdwheel.nactive > 0);
+
+  wd_wheel_unlink(wdog);
+  g_wdwheel.nactive--;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of ticks from the current time of the wheel until
+ *   the watchdog expires.
+ *
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog)
+{
+  return (int)(wdog->expire - g_wdwheel.now);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expire
+ *
+ * Description:
+ *   Advance the timing wheel by up to '*ticks' ticks and return the next
+ *   watchdog that expires on the way.  The watchdog is removed from the
+ *   wheel, '*ticks' is reduced by the number of ticks consumed and the
+ *   caller should call again, with the same '*ticks', after executing it.
+ *   Runs of empty slots are skipped with the occupancy bitmaps rather than
+ *   one tick at a time.
+ *
+ * Input Parameters:
+ *   ticks - The number of ticks by which to advance the wheel.
+ *
+ * Returned Value:
+ *   The next expired watchdog or NULL if no further watchdog expires
+ *   within '*ticks' ticks (in which case '*ticks' is now zero).
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expire(FAR unsigned int *ticks)
+{
+  FAR struct wdog_s *wdog;
+  uint32_t step;
+
+  for (; ; )
+    {
+      /* Anything in the current level 0 slot expires now */
+
+      wdog = g_wdwheel.slot[WHEEL_INDEX(g_wdwheel.now, 0)];
+      if (wdog != NULL)
+        {
+          DEBUGASSERT(wdog->expire == g_wdwheel.now);
+
+          wd_wheel_remove(wdog);
+          return wdog;
+        }
+
+      if (*ticks == 0)
+        {
+          return NULL;
+        }
+
+      /* Move to the next time at which something happens in the wheel
+       * (or as far as we were asked to go).
+       */
+
+      step = *ticks;
+      if (step > 1 && g_wdwheel.nactive > 0)
+        {
+          step = wd_wheel_nextdelay();
+          if (step == 0 || step > *ticks)
+            {
+              step = *ticks;
+            }
+        }
+
+      g_wdwheel.now += step;
+      *ticks        -= step;
+
+      if (g_wdwheel.nactive > 0)
+        {
+          wd_wheel_cascade();
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_nextdelay
+ *
+ * Description:
+ *   Return the number of ticks until the wheel next needs attention:  The
+ *   next expiration or the next cascade of a non-empty slot.  The latter
+ *   may come before any watchdog actually expires.  Zero is returned if
+ *   the wheel is empty.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_nextdelay(void)
+{
+  uint32_t delay = 0;
+  uint32_t next;
+  unsigned int level;
+  unsigned int dist;
+
+  if (g_wdwheel.nactive == 0)
+    {
+      return 0;
+    }
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      dist = wd_wheel_nextslot(level);
+      if (dist > 0)
+        {
+          next = ((g_wdwheel.now >> WHEEL_SHIFT(level)) + dist) <<
+                 WHEEL_SHIFT(level);
+          next -= g_wdwheel.now;
+
+          if (delay == 0 || next < delay)
+            {
+              delay = next;
+            }
+        }
+    }
+
+  return delay;
+}
+
+#endif /* CONFIG_WDOG_WHEEL */
@@ -93,7 +93,9 @@ extern sq_queue_t g_wdfreelist;
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_WHEEL
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -188,6 +190,26 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_*
+ *
+ * Description:
+ *   Management of the hierarchical timing wheel that holds the active
+ *   watchdogs when CONFIG_WDOG_WHEEL is selected.  See wd_wheel.c.  All
+ *   of these must be called from within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_WHEEL
+void wd_wheel_initialize(void);
+bool wd_wheel_empty(void);
+void wd_wheel_insert(FAR struct wdog_s *wdog, int32_t delay);
+void wd_wheel_remove(FAR struct wdog_s *wdog);
+int wd_wheel_remaining(FAR struct wdog_s *wdog);
+FAR struct wdog_s *wd_wheel_expire(FAR unsigned int *ticks);
+unsigned int wd_wheel_nextdelay(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
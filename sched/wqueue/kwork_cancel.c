@@ -45,6 +45,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
@@ -79,6 +80,7 @@
 static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
                         FAR struct work_s *work)
 {
+  FAR dq_queue_t *list;
   irqstate_t flags;
   int ret = -ENOENT;
 
@@ -94,18 +96,29 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
     {
       /* A little test of the integrity of the work queue */
 
+      list = WORK_LIST(wqueue, work);
       DEBUGASSERT(work->dq.flink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.tail);
+                  (FAR dq_entry_t *)work == list->tail);
       DEBUGASSERT(work->dq.blink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.head);
+                  (FAR dq_entry_t *)work == list->head);
 
       /* Remove the entry from the work queue and make sure that it is
        * marked as available (i.e., the worker field is nullified).
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      dq_rem((FAR dq_entry_t *)work, list);
       work->worker = NULL;
       ret = OK;
+
+      /* Stop the work queue timer if there is no more delayed work.  If
+       * other delayed work remains, the timer may expire early but will
+       * then just be restarted.
+       */
+
+      if (list == &wqueue->delayed && dq_empty(list))
+        {
+          (void)wd_cancel(&wqueue->timer);
+        }
     }
 
   leave_critical_section(flags);
@@ -50,6 +50,7 @@
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 
 #include "wqueue/wqueue.h"
 
@@ -61,7 +62,16 @@
 
 /* The state of the kernel mode, high priority work queue(s). */
 
-struct hp_wqueue_s g_hpwork;
+/* The delayed work timer is initialized statically:  Delayed work may be
+ * queued (and the timer started) before the worker threads are started.
+ */
+
+struct hp_wqueue_s g_hpwork =
+{
+  { NULL, NULL },     /* q */
+  { NULL, NULL },     /* delayed */
+  WDOG_INITIAILIZER   /* timer */
+};
 
 /****************************************************************************
  * Private Functions
@@ -148,8 +158,9 @@ static int work_hpthread(int argc, char *argv[])
 #endif
 
           /* Then process queued work.  work_process will not return until: (1)
-           * there is no further work in the work queue, and (2) signal is
-           * triggered, or delayed work expires.
+           * there is no further work ready in the work queue, and (2) the
+           * worker is signalled because new work is ready (or delayed work
+           * has expired).
            */
 
           work_process((FAR struct kwork_wqueue_s *)&g_hpwork, 0);
@@ -50,6 +50,7 @@
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 
 #include "wqueue/wqueue.h"
 
@@ -61,7 +62,16 @@
 
 /* The state of the kernel mode, low priority work queue(s). */
 
-struct lp_wqueue_s g_lpwork;
+/* The delayed work timer is initialized statically:  Delayed work may be
+ * queued (and the timer started) before the worker threads are started.
+ */
+
+struct lp_wqueue_s g_lpwork =
+{
+  { NULL, NULL },     /* q */
+  { NULL, NULL },     /* delayed */
+  WDOG_INITIAILIZER   /* timer */
+};
 
 /****************************************************************************
  * Private Functions
@@ -144,8 +154,9 @@ static int work_lpthread(int argc, char *argv[])
           sched_garbage_collection();
 
           /* Then process queued work.  work_process will not return until:
-           * (1) there is no further work in the work queue, and (2) signal is
-           * triggered, or delayed work expires.
+           * (1) there is no further work ready in the work queue, and (2) the
+           * worker is signalled because new work is ready (or delayed work
+           * has expired).
            */
 
           work_process((FAR struct kwork_wqueue_s *)&g_lpwork, 0);
@@ -47,16 +47,135 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORK_WDOG_MAX INT32_MAX
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void work_timer_expiry(int argc, wdparm_t arg1, ...);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_remaining
+ *
+ * Description:
+ *   Return the number of clock ticks until delayed work is due (zero if the
+ *   work is already due).
+ *
+ ****************************************************************************/
+
+static clock_t work_remaining(FAR struct work_s *work, clock_t now)
+{
+  clock_t elapsed = now - work->qtime;
+  return elapsed >= work->delay ? 0 : work->delay - elapsed;
+}
+
+/****************************************************************************
+ * Name: work_timer_start
+ *
+ * Description:
+ *   (Re-)start the work queue timer so that it expires when the work at the
+ *   head of the delayed work list is due.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.  The delayed work list is not empty.
+ *
+ ****************************************************************************/
+
+static void work_timer_start(FAR struct kwork_wqueue_s *wqueue, clock_t now)
+{
+  FAR struct work_s *work = (FAR struct work_s *)wqueue->delayed.head;
+  clock_t remaining;
+
+  remaining = work_remaining(work, now);
+  if (remaining > WORK_WDOG_MAX)
+    {
+      remaining = WORK_WDOG_MAX;
+    }
+
+  (void)wd_start(&wqueue->timer, (int32_t)remaining, work_timer_expiry, 1,
+                 (wdparm_t)wqueue);
+}
+
+/****************************************************************************
+ * Name: work_timer_expiry
+ *
+ * Description:
+ *   The work queue timer has expired.  Move all delayed work that is now
+ *   due to the list of work that is ready to be performed and wake up a
+ *   worker thread.
+ *
+ * Input Parameters:
+ *   argc - The number of available arguments (1)
+ *   arg1 - The work queue
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the timer interrupt handler with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void work_timer_expiry(int argc, wdparm_t arg1, ...)
+{
+  FAR struct kwork_wqueue_s *wqueue = (FAR struct kwork_wqueue_s *)arg1;
+  FAR struct work_s *work;
+  irqstate_t flags;
+  clock_t now;
+  bool expired = false;
+
+  flags = enter_critical_section();
+  now   = clock_systimer();
+
+  /* The delayed work is in order of expiration so we are finished at the
+   * first work that is not yet due.
+   */
+
+  while ((work = (FAR struct work_s *)wqueue->delayed.head) != NULL)
+    {
+      if (work_remaining(work, now) > 0)
+        {
+          work_timer_start(wqueue, now);
+          break;
+        }
+
+      dq_rem((FAR dq_entry_t *)work, &wqueue->delayed);
+      work->delay = 0;
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+      expired = true;
+    }
+
+  leave_critical_section(flags);
+
+  if (expired)
+    {
+#if defined(CONFIG_SCHED_HPWORK) && defined(CONFIG_SCHED_LPWORK)
+      (void)work_signal(wqueue == (FAR struct kwork_wqueue_s *)&g_hpwork ?
+                        HPWORK : LPWORK);
+#elif defined(CONFIG_SCHED_HPWORK)
+      (void)work_signal(HPWORK);
+#else
+      (void)work_signal(LPWORK);
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -82,15 +201,18 @@
  *            is invoked. Zero means to perform the work immediately.
  *
  * Returned Value:
- *   None
+ *   True if the work is ready to be performed now and a worker thread must
+ *   be awakened; false if the work was delayed.
  *
  ****************************************************************************/
 
-static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
+static bool work_qqueue(FAR struct kwork_wqueue_s *wqueue,
                         FAR struct work_s *work, worker_t worker,
                         FAR void *arg, clock_t delay)
 {
+  FAR struct work_s *next;
   irqstate_t flags;
+  bool ready = false;
 
   DEBUGASSERT(work != NULL && worker != NULL);
 
@@ -108,7 +230,7 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
        * end of the work queue.
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      dq_rem((FAR dq_entry_t *)work, WORK_LIST(wqueue, work));
     }
 
   /* Initialize the work structure. */
@@ -121,9 +243,45 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 
   work->qtime  = clock_systimer(); /* Time work queued */
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  if (delay == 0)
+    {
+      /* The work is ready to be performed now */
+
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+      ready = true;
+    }
+  else
+    {
+      /* Insert the delayed work after all delayed work that expires at the
+       * same time or earlier.
+       */
+
+      for (next = (FAR struct work_s *)wqueue->delayed.head;
+           next != NULL && work_remaining(next, work->qtime) <= delay;
+           next = (FAR struct work_s *)next->dq.flink);
+
+      if (next != NULL)
+        {
+          dq_addbefore((FAR dq_entry_t *)next, (FAR dq_entry_t *)work,
+                       &wqueue->delayed);
+        }
+      else
+        {
+          dq_addlast((FAR dq_entry_t *)work, &wqueue->delayed);
+        }
+
+      /* If this is now the first delayed work to expire, then the timer
+       * must be restarted.  There is no need to wake up the worker thread.
+       */
+
+      if (wqueue->delayed.head == (FAR dq_entry_t *)work)
+        {
+          work_timer_start(wqueue, work->qtime);
+        }
+    }
 
   leave_critical_section(flags);
+  return ready;
 }
 
 /****************************************************************************
@@ -169,8 +327,13 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue high priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker, arg, delay);
-      return work_signal(HPWORK);
+      if (work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker,
+                      arg, delay))
+        {
+          return work_signal(HPWORK);
+        }
+
+      return OK;
     }
   else
 #endif
@@ -179,8 +342,13 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue low priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker, arg, delay);
-      return work_signal(LPWORK);
+      if (work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker,
+                      arg, delay))
+        {
+          return work_signal(LPWORK);
+        }
+
+      return OK;
     }
   else
 #endif
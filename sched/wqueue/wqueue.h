@@ -47,6 +47,7 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -59,6 +60,12 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* The list that holds queued work.  The delay of delayed work is set to
+ * zero when the work expires and is moved to the 'q' list.
+ */
+
+#define WORK_LIST(wq,w) ((w)->delay != 0 ? &(wq)->delayed : &(wq)->q)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -71,11 +78,20 @@ struct kworker_s
   volatile bool     busy;   /* True: Worker is not available */
 };
 
-/* This structure defines the state of one kernel-mode work queue */
+/* This structure defines the state of one kernel-mode work queue.
+ *
+ * Work that is ready to be performed is kept in the FIFO 'q'.  Delayed work
+ * is kept in 'delayed' in order of expiration and the watchdog 'timer'
+ * expires when the work at the head of 'delayed' is due.  The timer then
+ * moves all expired work to 'q' and wakes up a worker thread.  So the
+ * worker threads only run when there is work to be performed.
+ */
 
 struct kwork_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of work ready to be performed */
+  struct dq_queue_s delayed;   /* Delayed work in order of expiration */
+  struct wdog_s     timer;     /* Expires when delayed work is due */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -86,7 +102,9 @@ struct kwork_wqueue_s
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of work ready to be performed */
+  struct dq_queue_s delayed;   /* Delayed work in order of expiration */
+  struct wdog_s     timer;     /* Expires when delayed work is due */
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -101,7 +119,9 @@ struct hp_wqueue_s
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s
 {
-  struct dq_queue_s q;      /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of work ready to be performed */
+  struct dq_queue_s delayed;   /* Delayed work in order of expiration */
+  struct wdog_s     timer;     /* Expires when delayed work is due */
 
   /* Describes each thread in the low priority queue's thread pool */
 
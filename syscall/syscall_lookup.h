@@ -201,6 +201,8 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(write,                    3, STUB_write)
   SYSCALL_LOOKUP(pread,                    4, STUB_pread)
   SYSCALL_LOOKUP(pwrite,                   4, STUB_pwrite)
+  SYSCALL_LOOKUP(readv,                    3, STUB_readv)
+  SYSCALL_LOOKUP(writev,                   3, STUB_writev)
 #  ifdef CONFIG_FS_AIO
   SYSCALL_LOOKUP(aio_read,                 1, STUB_aio_read)
   SYSCALL_LOOKUP(aio_write,                1, STUB_aio_write)
@@ -261,6 +263,11 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(mkfifo2,                  3, STUB_mkfifo2)
 #  endif
 
+#  if defined(CONFIG_PIPES) && defined(CONFIG_DEV_PIPE_SPLICE)
+  SYSCALL_LOOKUP(splice,                   6, STUB_splice)
+  SYSCALL_LOOKUP(tee,                      4, STUB_tee)
+#  endif
+
 #  if CONFIG_NFILE_STREAMS > 0
   SYSCALL_LOOKUP(fdopen,                   3, STUB_fs_fdopen)
   SYSCALL_LOOKUP(sched_getstreams,         0, STUB_sched_getstreams)
@@ -377,7 +384,9 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(listen,                   2, STUB_listen)
   SYSCALL_LOOKUP(recv,                     4, STUB_recv)
   SYSCALL_LOOKUP(recvfrom,                 6, STUB_recvfrom)
+  SYSCALL_LOOKUP(recvmsg,                  3, STUB_recvmsg)
   SYSCALL_LOOKUP(send,                     4, STUB_send)
+  SYSCALL_LOOKUP(sendmsg,                  3, STUB_sendmsg)
   SYSCALL_LOOKUP(sendto,                   6, STUB_sendto)
   SYSCALL_LOOKUP(setsockopt,               5, STUB_setsockopt)
   SYSCALL_LOOKUP(socket,                   3, STUB_socket)
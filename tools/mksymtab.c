@@ -38,6 +38,7 @@
  ****************************************************************************/
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -57,12 +58,21 @@
  * Private Types
  ****************************************************************************/
 
+/* One symbol of a hashed symbol table */
+
+struct hashsym_s
+{
+  char *name;                    /* Symbol name */
+  char *cond;                    /* Conditional compilation or NULL */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 static const char *g_hdrfiles[MAX_HEADER_FILES];
 static int nhdrfiles;
+static bool g_hashed;
 
 /****************************************************************************
  * Private Functions
@@ -70,11 +80,13 @@ static int nhdrfiles;
 
 static void show_usage(const char *progname)
 {
-  fprintf(stderr, "USAGE: %s <cvs-file> <symtab-file>\n\n", progname);
+  fprintf(stderr, "USAGE: %s [-d] [-h] <cvs-file> <symtab-file>\n\n", progname);
   fprintf(stderr, "Where:\n\n");
   fprintf(stderr, "  <cvs-file>   : The path to the input CSV file\n");
   fprintf(stderr, "  <symtab-file>: The path to the output symbol table file\n");
   fprintf(stderr, "  -d           : Enable debug output\n");
+  fprintf(stderr, "  -h           : Generate a hashed symbol table for use with\n");
+  fprintf(stderr, "                 CONFIG_SYMTAB_HASHED\n");
   exit(EXIT_FAILURE);
 }
 
@@ -111,6 +123,135 @@ static void add_hdrfile(const char *hdrfile)
     }
 }
 
+/* The 32-bit FNV-1a hash.  This must match symtab_hash() in
+ * libs/libc/symtab/symtab_findhashedbyname.c.
+ */
+
+static uint32_t symtab_hash(const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name != '\0')
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/* Output the symbol table as an open-addressed hash table.  The table size
+ * is a power of two at least 1.5 times the number of symbols so that probe
+ * sequences stay short and there is always an unused (NULL) slot to end
+ * an unsuccessful search.  The slot of a symbol that is conditionally
+ * compiled out gets an empty name instead of NULL so that the probe
+ * sequences of other symbols passing through that slot are not broken.
+ */
+
+static void output_hashed(FILE *instream, FILE *outstream)
+{
+  struct hashsym_s *syms = NULL;
+  struct hashsym_s **slots;
+  char *ptr;
+  unsigned int tabsize;
+  unsigned int slot;
+  int nsyms = 0;
+  int i;
+
+  /* Collect all of the symbols */
+
+  while ((ptr = read_line(instream)) != NULL)
+    {
+      int nargs = parse_csvline(ptr);
+      if (nargs < PARM1_INDEX)
+        {
+          fprintf(stderr, "Only %d arguments found: %s\n", nargs, g_line);
+          exit(EXIT_FAILURE);
+        }
+
+      syms = realloc(syms, (nsyms + 1) * sizeof(struct hashsym_s));
+      if (syms == NULL)
+        {
+          fprintf(stderr, "ERROR: Out of memory\n");
+          exit(EXIT_FAILURE);
+        }
+
+      syms[nsyms].name = strdup(g_parm[NAME_INDEX]);
+      syms[nsyms].cond = NULL;
+
+      if (strlen(g_parm[COND_INDEX]) > 0)
+        {
+          syms[nsyms].cond = strdup(g_parm[COND_INDEX]);
+        }
+
+      nsyms++;
+    }
+
+  /* Place each symbol at its hash slot or at the next free slot */
+
+  for (tabsize = 1; tabsize < nsyms + nsyms / 2 + 1; tabsize <<= 1);
+
+  slots = calloc(tabsize, sizeof(struct hashsym_s *));
+  if (slots == NULL)
+    {
+      fprintf(stderr, "ERROR: Out of memory\n");
+      exit(EXIT_FAILURE);
+    }
+
+  for (i = 0; i < nsyms; i++)
+    {
+      slot = symtab_hash(syms[i].name) & (tabsize - 1);
+      while (slots[slot] != NULL)
+        {
+          if (strcmp(slots[slot]->name, syms[i].name) == 0)
+            {
+              fprintf(stderr, "ERROR: Duplicate symbol: %s\n",
+                      syms[i].name);
+              exit(EXIT_FAILURE);
+            }
+
+          slot = (slot + 1) & (tabsize - 1);
+        }
+
+      slots[slot] = &syms[i];
+    }
+
+  /* And output the table in slot order */
+
+  for (slot = 0; slot < tabsize; slot++)
+    {
+      struct hashsym_s *sym = slots[slot];
+
+      if (sym == NULL)
+        {
+          fprintf(outstream, "  { NULL, NULL },\n");
+        }
+      else if (sym->cond != NULL)
+        {
+          fprintf(outstream, "#if %s\n", sym->cond);
+          fprintf(outstream, "  { \"%s\", (FAR const void *)%s },\n",
+                  sym->name, sym->name);
+          fprintf(outstream, "#else\n");
+          fprintf(outstream, "  { \"\", NULL },\n");
+          fprintf(outstream, "#endif\n");
+        }
+      else
+        {
+          fprintf(outstream, "  { \"%s\", (FAR const void *)%s },\n",
+                  sym->name, sym->name);
+        }
+    }
+
+  for (i = 0; i < nsyms; i++)
+    {
+      free(syms[i].name);
+      free(syms[i].cond);
+    }
+
+  free(syms);
+  free(slots);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -130,9 +271,10 @@ int main(int argc, char **argv, char **envp)
 
   /* Parse command line options */
 
-  g_debug = false;
+  g_debug  = false;
+  g_hashed = false;
 
-  while ((ch = getopt(argc, argv, ":d")) > 0)
+  while ((ch = getopt(argc, argv, ":dh")) > 0)
     {
       switch (ch)
         {
@@ -140,6 +282,10 @@ int main(int argc, char **argv, char **envp)
             g_debug = true;
             break;
 
+          case 'h' :
+            g_hashed = true;
+            break;
+
           case '?' :
             fprintf(stderr, "Unrecognized option: %c\n", optopt);
             show_usage(argv[0]);
@@ -237,6 +383,17 @@ int main(int argc, char **argv, char **envp)
   fprintf(outstream, "\nconst struct symtab_s %s[] =\n", SYMTAB_NAME);
   fprintf(outstream, "{\n");
 
+  if (g_hashed)
+    {
+      output_hashed(instream, outstream);
+      fprintf(outstream, "};\n\n");
+      fprintf(outstream, "#define NSYMBOLS (sizeof(%s) / sizeof (struct symtab_s))\n", SYMTAB_NAME);
+
+      fclose(instream);
+      fclose(outstream);
+      return EXIT_SUCCESS;
+    }
+
   /* Parse each line in the CVS file */
 
   nextterm  = "";